@@ -0,0 +1,333 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Headless benchmark for the CPU frustum culling. It reports the number of objects culled per millisecond
+// for groups of different sizes and for each culling kernel supported by the CPU or for the BVH culling.
+// Optionally every n-th object is used as an occluder for the software occlusion culling pass and objects
+// smaller than a given number of pixels in a 1920x1080 viewport are culled by the small feature culling.
+// With more than one view the group is culled against a row of cameras in a single pass, either with one result
+// per view or with the union of all views. The orbit angle controls how far the camera moves between two cull calls
+// to measure the effect of the temporal coherence. With lights the group is additionally culled against a mix of
+// sphere, cone and box volumes in a single call per repetition.
+
+#include <dp/culling/cpu/Manager.h>
+#include <dp/math/Matmnt.h>
+#include <dp/util/Timer.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace options = boost::program_options;
+
+struct Scene
+{
+  std::vector<dp::math::Mat44f>             matrices;
+  std::vector<dp::culling::ObjectSharedPtr> objects;
+  dp::culling::GroupSharedPtr               group;
+};
+
+static void createScene( dp::culling::cpu::Manager * manager, Scene & scene, size_t numberOfObjects, size_t numberOfMatrices, size_t occluderStride )
+{
+  std::mt19937 generator( 4711 );
+  std::uniform_real_distribution<float> position( -1000.0f, 1000.0f );
+  std::uniform_real_distribution<float> size( 0.1f, 10.0f );
+
+  scene.matrices.resize( numberOfMatrices );
+  for ( size_t index = 0; index < numberOfMatrices; ++index )
+  {
+    dp::math::Mat44f & matrix = scene.matrices[index];
+    matrix = dp::math::cIdentity44f;
+    matrix[3] = dp::math::Vec4f( position( generator ), position( generator ), position( generator ), 1.0f );
+  }
+
+  scene.group = manager->groupCreate();
+  scene.objects.resize( numberOfObjects );
+  for ( size_t index = 0; index < numberOfObjects; ++index )
+  {
+    dp::math::Vec3f lower( position( generator ) * 0.05f, position( generator ) * 0.05f, position( generator ) * 0.05f );
+    dp::math::Vec3f extent( size( generator ), size( generator ), size( generator ) );
+
+    scene.objects[index] = manager->objectCreate( dp::culling::PayloadSharedPtr() );
+    manager->objectSetBoundingBox( scene.objects[index], dp::math::Box3f( lower, lower + extent ) );
+    if ( occluderStride && ( index % occluderStride == 0 ) )
+    {
+      manager->objectSetOccluder( scene.objects[index], dp::math::Box3f( lower, lower + extent ) );
+    }
+    manager->objectSetTransformIndex( scene.objects[index], index % numberOfMatrices );
+    manager->groupAddObject( scene.group, scene.objects[index] );
+  }
+  manager->groupSetMatrices( scene.group, scene.matrices.data(), scene.matrices.size(), sizeof(dp::math::Mat44f) );
+}
+
+static char const* getKernelName( dp::culling::cpu::KernelType kernelType )
+{
+  switch ( kernelType )
+  {
+  case dp::culling::cpu::KernelType::SCALAR:
+    return "scalar";
+  case dp::culling::cpu::KernelType::SSE41:
+    return "sse4.1";
+  case dp::culling::cpu::KernelType::AVX2:
+    return "avx2";
+  default:
+    return "auto";
+  }
+}
+
+/** \brief Compute the view-projection matrices of a row of cameras orbiting around the origin at the given angle **/
+static void getViewProjections( float angle, float distance, std::vector<dp::math::Mat44f> & viewProjections )
+{
+  dp::math::Mat44f projection = dp::math::makePerspective( 45.0f, 16.0f / 9.0f, 1.0f, 5000.0f );
+  dp::math::Vec3f direction( sinf( angle ), 0.0f, cosf( angle ) );
+  dp::math::Vec3f right( cosf( angle ), 0.0f, -sinf( angle ) );
+  for ( size_t view = 0; view < viewProjections.size(); ++view )
+  {
+    // cameras are 10 units apart, e.g. the eyes of a stereo pair
+    dp::math::Vec3f offset = right * ( 10.0f * ( float(view) - 0.5f * float(viewProjections.size() - 1) ) );
+    viewProjections[view] = dp::math::makeLookAt( direction * distance + offset, offset, dp::math::Vec3f( 0.0f, 1.0f, 0.0f ) ) * projection;
+  }
+}
+
+/** \brief Cull the scene with cameras orbiting around the origin and return the average time per cull in milliseconds **/
+static double benchmark( dp::culling::Manager * manager, Scene const & scene, unsigned int repetitions, float distance, float orbit, size_t numberOfViews, bool unionOfViews )
+{
+  std::vector<dp::culling::ResultSharedPtr> results( unionOfViews ? 1 : numberOfViews );
+  for ( size_t index = 0; index < results.size(); ++index )
+  {
+    results[index] = manager->groupCreateResult( scene.group );
+  }
+
+  std::vector<dp::math::Mat44f> viewProjections( numberOfViews );
+  auto cull = [&]()
+  {
+    if ( numberOfViews == 1 )
+    {
+      manager->cull( scene.group, results[0], viewProjections[0] );
+    }
+    else if ( unionOfViews )
+    {
+      manager->cullUnion( scene.group, results[0], viewProjections );
+    }
+    else
+    {
+      manager->cullViews( scene.group, results, viewProjections );
+    }
+  };
+
+  // warm up the OBB cache and the result
+  getViewProjections( 0.0f, distance, viewProjections );
+  cull();
+
+  dp::util::Timer timer;
+  timer.start();
+  for ( unsigned int repetition = 0; repetition < repetitions; ++repetition )
+  {
+    getViewProjections( dp::math::degToRad( orbit ) * float(repetition) / float(repetitions), distance, viewProjections );
+    cull();
+  }
+  timer.stop();
+
+  return timer.getTime() * 1000.0 / repetitions;
+}
+
+/** \brief Create random point, spot and box lights within the bounds of the scene **/
+static void createVolumes( size_t numberOfVolumes, std::vector<dp::culling::cpu::Volume> & volumes )
+{
+  std::mt19937 generator( 815 );
+  std::uniform_real_distribution<float> position( -1000.0f, 1000.0f );
+  std::uniform_real_distribution<float> unit( -1.0f, 1.0f );
+  std::uniform_real_distribution<float> range( 20.0f, 200.0f );
+
+  volumes.resize( numberOfVolumes );
+  for ( size_t index = 0; index < numberOfVolumes; ++index )
+  {
+    dp::math::Vec3f center( position( generator ), position( generator ), position( generator ) );
+    switch ( index % 3 )
+    {
+    case 0:
+      volumes[index] = dp::culling::cpu::makeSphereVolume( center, range( generator ) );
+      break;
+    case 1:
+      volumes[index] = dp::culling::cpu::makeConeVolume( center, dp::math::Vec3f( unit( generator ), unit( generator ), unit( generator ) ), range( generator ), 0.5f );
+      break;
+    default:
+      {
+        dp::math::Mat44f cubeToWorld = dp::math::cIdentity44f;
+        cubeToWorld[0][0] = range( generator );
+        cubeToWorld[1][1] = range( generator );
+        cubeToWorld[2][2] = range( generator );
+        cubeToWorld[3] = dp::math::Vec4f( center, 1.0f );
+        volumes[index] = dp::culling::cpu::makeBoxVolume( cubeToWorld );
+      }
+    }
+  }
+}
+
+/** \brief Cull the scene against all volumes once per repetition and return the average time per call in milliseconds **/
+static double benchmarkVolumes( dp::culling::cpu::Manager * manager, Scene const & scene, unsigned int repetitions, std::vector<dp::culling::cpu::Volume> const & volumes )
+{
+  std::vector<std::vector<uint32_t> > visibilities;
+  manager->cullVolumes( scene.group, volumes, visibilities );
+
+  dp::util::Timer timer;
+  timer.start();
+  for ( unsigned int repetition = 0; repetition < repetitions; ++repetition )
+  {
+    manager->cullVolumes( scene.group, volumes, visibilities );
+  }
+  timer.stop();
+
+  return timer.getTime() * 1000.0 / repetitions;
+}
+
+int main( int argc, char *argv[] )
+{
+  options::options_description od( "Usage: CullingBenchmark" );
+  od.add_options()
+    ( "help", "show help")
+    ( "bvh", "cull with the bounding volume hierarchy instead of the flat kernels" )
+    ( "distance", options::value<float>()->default_value( 2000.0f ), "distance of the orbiting camera to the center of the scene" )
+    ( "kernel", options::value<std::string>()->default_value( "all" ), "culling kernel: all, auto, scalar, sse4.1, avx2" )
+    ( "lights", options::value<size_t>()->default_value( 0 ), "number of light volumes culled in a single call, 0 skips the volume culling" )
+    ( "matrices", options::value<size_t>()->default_value( 4096 ), "number of transforms shared by the objects" )
+    ( "minpixelsize", options::value<float>()->default_value( 0.0f ), "minimum size in pixels of visible objects, 0 disables the small feature culling" )
+    ( "nocoherence", "disable the temporal plane coherence" )
+    ( "objects", options::value<std::vector<size_t> >()->multitoken(), "list of group sizes, default is 100k, 250k, 500k, 1M and 2M" )
+    ( "occluders", options::value<size_t>()->default_value( 0 ), "use every n-th object as occluder, 0 disables the occlusion culling" )
+    ( "orbit", options::value<float>()->default_value( 360.0f ), "angle in degrees the camera orbits during the repetitions, 0 keeps the camera still" )
+    ( "repetitions", options::value<unsigned int>()->default_value( 32 ), "number of cull calls per measurement" )
+    ( "threads", options::value<unsigned int>()->default_value( 1 ), "number of culling threads, 0 uses all hardware threads" )
+    ( "union", "cull multiple views into a single result which contains the objects visible in any view" )
+    ( "views", options::value<size_t>()->default_value( 1 ), "number of views culled in a single pass" )
+    ;
+
+  options::variables_map opts;
+  try
+  {
+    options::store( options::parse_command_line( argc, argv, od ), opts );
+  }
+  catch ( options::error const & e )
+  {
+    std::cerr << e.what() << std::endl << od << std::endl;
+    return 1;
+  }
+
+  if ( opts.count( "help" ) )
+  {
+    std::cout << od << std::endl;
+    return 0;
+  }
+
+  std::vector<size_t> sizes;
+  if ( opts.count( "objects" ) )
+  {
+    sizes = opts["objects"].as<std::vector<size_t> >();
+  }
+  else
+  {
+    size_t const defaultSizes[] = { 100000, 250000, 500000, 1000000, 2000000 };
+    sizes.assign( defaultSizes, defaultSizes + sizeof(defaultSizes) / sizeof(defaultSizes[0]) );
+  }
+
+  std::vector<dp::culling::cpu::KernelType> kernelTypes;
+  std::string kernel = opts["kernel"].as<std::string>();
+  if ( kernel == "all" )
+  {
+    kernelTypes.push_back( dp::culling::cpu::KernelType::SCALAR );
+    kernelTypes.push_back( dp::culling::cpu::KernelType::SSE41 );
+    kernelTypes.push_back( dp::culling::cpu::KernelType::AVX2 );
+  }
+  else if ( kernel == "auto" )   { kernelTypes.push_back( dp::culling::cpu::KernelType::AUTO ); }
+  else if ( kernel == "scalar" ) { kernelTypes.push_back( dp::culling::cpu::KernelType::SCALAR ); }
+  else if ( kernel == "sse4.1" ) { kernelTypes.push_back( dp::culling::cpu::KernelType::SSE41 ); }
+  else if ( kernel == "avx2" )   { kernelTypes.push_back( dp::culling::cpu::KernelType::AVX2 ); }
+  else
+  {
+    std::cerr << "unknown kernel " << kernel << std::endl;
+    return 1;
+  }
+
+  unsigned int repetitions = opts["repetitions"].as<unsigned int>();
+  size_t numberOfMatrices = std::max( size_t(1), opts["matrices"].as<size_t>() );
+
+  bool bvh = !!opts.count( "bvh" );
+  if ( bvh )
+  {
+    // the BVH tests partially visible leaves with the scalar kernel only
+    kernelTypes.assign( 1, dp::culling::cpu::KernelType::AUTO );
+  }
+
+  float distance = opts["distance"].as<float>();
+  float orbit = opts["orbit"].as<float>();
+  size_t numberOfViews = std::max( size_t(1), opts["views"].as<size_t>() );
+  bool unionOfViews = !!opts.count( "union" );
+
+  std::unique_ptr<dp::culling::cpu::Manager> manager( bvh ? dp::culling::cpu::Manager::createBVH() : dp::culling::cpu::Manager::create() );
+  manager->setNumberOfThreads( opts["threads"].as<unsigned int>() );
+  manager->setTemporalCoherence( !opts.count( "nocoherence" ) );
+
+  size_t occluderStride = opts["occluders"].as<size_t>();
+  manager->setOcclusionCulling( occluderStride != 0 );
+
+  manager->setViewportSize( dp::math::Vec2ui( 1920, 1080 ) );
+  manager->setMinimumPixelSize( opts["minpixelsize"].as<float>() );
+
+  std::vector<dp::culling::cpu::Volume> volumes;
+  createVolumes( opts["lights"].as<size_t>(), volumes );
+
+  printf( "culling with %u thread(s) and %zu view(s)%s\n", manager->getNumberOfThreads(), numberOfViews, unionOfViews && numberOfViews > 1 ? " into one result" : "" );
+  printf( "%12s %10s %12s %14s\n", "objects", "kernel", "ms/cull", "objects/ms" );
+  for ( size_t sizeIndex = 0; sizeIndex < sizes.size(); ++sizeIndex )
+  {
+    Scene scene;
+    createScene( manager.get(), scene, sizes[sizeIndex], numberOfMatrices, occluderStride );
+
+    for ( size_t kernelIndex = 0; kernelIndex < kernelTypes.size(); ++kernelIndex )
+    {
+      manager->setKernelType( kernelTypes[kernelIndex] );
+      double milliseconds = benchmark( manager.get(), scene, repetitions, distance, orbit, numberOfViews, unionOfViews );
+      // objects/ms counts each object once per view
+      printf( "%12zu %10s %12.3f %14.0f\n", sizes[sizeIndex], bvh ? "bvh" : getKernelName( kernelTypes[kernelIndex] ), milliseconds, double(sizes[sizeIndex] * numberOfViews) / milliseconds );
+    }
+
+    if ( !volumes.empty() )
+    {
+      // objects/ms counts each object once per volume
+      double milliseconds = benchmarkVolumes( manager.get(), scene, repetitions, volumes );
+      printf( "%12zu %10s %12.3f %14.0f\n", sizes[sizeIndex], "volumes", milliseconds, double(sizes[sizeIndex] * volumes.size()) / milliseconds );
+    }
+  }
+
+  return 0;
+}
@@ -508,6 +508,10 @@ int runApp( options::variables_map const& opts )
   {
     cullingMode = dp::culling::Mode::CPU;
   }
+  else if ( cullingEngine == "cpu_bvh" )
+  {
+    cullingMode = dp::culling::Mode::CPU_BVH;
+  }
   else if ( cullingEngine == "gl_compute" )
   {
     cullingMode = dp::culling::Mode::OPENGL_COMPUTE;
@@ -736,7 +740,7 @@ int main(int argc, char *argv[])
       ( "combineVertexAttributes", "combine all vertexattribute into a single buffer" )
       ( "continuous", "enable continuous rendering" )
       ( "culling", options::value<bool>()->default_value("true"), "enable/disable culling")
-      ( "cullingengine", options::value<std::string>()->default_value("auto"), "auto|cpu|cuda|gl_compute")
+      ( "cullingengine", options::value<std::string>()->default_value("auto"), "auto|cpu|cpu_bvh|cuda|gl_compute")
       ( "duration", options::value<double>()->default_value(0.0), "benchmark for a specific duration. The exit code returns the frames per second." )
       ( "effectlibrary", options::value<std::string>(), "effectlibrary to load for replacements" )
       ( "environment", options::value<std::string>(), "environment texture" )
@@ -276,6 +276,7 @@ dp::culling::Mode getCullingMode( std::string const& name )
   static const std::map<std::string,dp::culling::Mode> cullingModes =
   {
     { "cpu",        dp::culling::Mode::CPU             },
+    { "cpu_bvh",    dp::culling::Mode::CPU_BVH         },
     { "gl_compute", dp::culling::Mode::OPENGL_COMPUTE  },
     { "cuda",       dp::culling::Mode::CUDA            },
     { "auto",       dp::culling::Mode::AUTO            }
@@ -548,6 +549,14 @@ int runApp( int argc, char *argv[], options::variables_map const& opts )
 
   dp::sg::ui::setupDefaultViewState( viewState );
 
+  if ( !opts["quantize"].empty() )
+  {
+    dp::sg::algorithm::QuantizeTraverser quantizeTraverser;
+    quantizeTraverser.setErrorBudget( opts["quantize"].as<float>() );
+    quantizeTraverser.apply( viewState->getScene() );
+    std::cout << "quantizing vertex attributes saved " << quantizeTraverser.getSavedBytes() << " bytes" << std::endl;
+  }
+
   if ( !opts["combineVertexAttributes"].empty() )
   {
     combineVertexAttributes( viewState );
@@ -690,7 +699,7 @@ int main(int argc, char *argv[])
     ( "combineVertexAttributes", "combine all vertexattribute into a single buffer" )
     ( "continuous", "enable continuous rendering" )
     ( "culling", options::value<bool>()->default_value(true), "enable/disable culling")
-    ( "cullingengine", options::value<std::string>()->default_value("auto"), "auto|cpu|cuda|gl_compute")
+    ( "cullingengine", options::value<std::string>()->default_value("auto"), "auto|cpu|cpu_bvh|cuda|gl_compute")
     ( "depthPass", options::value<bool>()->default_value(false), "enable depth pass rendering" )
     ( "duration", options::value<double>()->default_value(0.0), "benchmark for a specific duration. The exit code returns the frames per second." )
     ( "effectlibrary", options::value<std::string>(), "effectlibrary to load for replacements" )
@@ -710,6 +719,7 @@ int main(int argc, char *argv[])
     ( "multiSampleCoverage", options::value<unsigned int>()->default_value(0), "AntiAliasing with that number of coverage samples" )
     ( "optionsFile", options::value<std::string>(), "file to load (additional) options from" )
     ( "orbit", options::value<float>(), "orbit around the scene by that many degrees per frame" )
+    ( "quantize", options::value<float>(), "convert texture coordinates to half floats and normals to normalized shorts with that maximal error" )
     ( "renderengine", options::value<std::string>()->default_value("Bindless"), "choose a renderengine from this list: VBO|VAB|BVAB|VBOVAO|Bindless|BindlessVAO" )
     ( "replace", options::value< std::vector<std::string> >()->composing()->multitoken(), "file to load" )
     ( "replaceAll", options::value<std::string>(), "EffectData to replace all EffectData in the scene" )
@@ -0,0 +1,992 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Headless benchmark for the construction of a SceneTree. It creates a scene graph of groups, transforms, billboards,
+// LODs and switches with GeoNodes and light sources as leaves, and measures the time to create the SceneTree and to
+// run the first update, once with the incremental SceneTreeGenerator and once with the bulk build. With --verify the
+// trees of both build modes are compared node by node, including the world matrices of the TransformTree.
+// With --churn the benchmark removes and re-adds the given number of subtrees in random order, which scatters the nodes
+// over the ObjectTree, and measures a traversal of the ObjectTree before and after SceneTree::compact.
+// With --tiles the benchmark streams tiles of transforms: it repeatedly unloads a random tile and loads a new one, which
+// stresses the removal of whole subtrees of transforms and billboards from the TransformTree.
+// With --mutations an application thread records matrix changes and GeoNode additions into a MutationQueue while the
+// main thread applies them and updates the SceneTree, as a render loop would do.
+// With --snapshots the main thread animates a tile and publishes each updated frame through a SceneTreeSnapshot to a
+// render thread, and the published frames are compared with the SceneTree.
+// With --matrices the benchmark sets the matrices of random transforms once with immediate notifications and once inside
+// a dp::util::NotificationBatch, which coalesces the notifications per transform.
+// With --masks the benchmark toggles the given number of traversal masks and the active children of 1% of the dynamic
+// switches per frame and measures SceneTree::update, which collects the changes through the xbar observers.
+// With --arena the scenes are created once on the heap and once in a dp::sg::core::ObjectArena, and the times to create
+// the scene, to compute its bounding volumes and to drop it are measured, followed by the memory used per object type.
+
+#include <dp/sg/core/Billboard.h>
+#include <dp/sg/core/GeoNode.h>
+#include <dp/sg/core/LightSource.h>
+#include <dp/sg/core/LOD.h>
+#include <dp/sg/core/ObjectArena.h>
+#include <dp/sg/core/PerspectiveCamera.h>
+#include <dp/sg/core/Scene.h>
+#include <dp/sg/core/Switch.h>
+#include <dp/sg/core/Transform.h>
+#include <dp/sg/xbar/MutationQueue.h>
+#include <dp/sg/xbar/SceneTree.h>
+#include <dp/sg/xbar/SceneTreeSnapshot.h>
+#include <dp/util/Timer.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace options = boost::program_options;
+
+/** \brief Create a scene with the given number of nodes. Groups get numberOfChildren children in breadth-first order until the
+           scene is complete.
+**/
+static dp::sg::core::SceneSharedPtr createScene( size_t numberOfNodes, size_t numberOfChildren )
+{
+  std::mt19937 generator( 4711 );
+  std::uniform_int_distribution<unsigned int> kind( 0, 99 );
+  std::uniform_real_distribution<float> position( -1000.0f, 1000.0f );
+
+  dp::sg::core::GroupSharedPtr root = dp::sg::core::Group::create();
+  std::deque<dp::sg::core::GroupSharedPtr> groups( 1, root );
+  size_t count = 1;
+  while ( count < numberOfNodes && !groups.empty() )
+  {
+    dp::sg::core::GroupSharedPtr group = groups.front();
+    groups.pop_front();
+
+    for ( size_t child = 0; child < numberOfChildren && count < numberOfNodes; ++child, ++count )
+    {
+      unsigned int k = kind( generator );
+      dp::sg::core::NodeSharedPtr node;
+      if ( k < 20 )
+      {
+        node = dp::sg::core::Group::create();
+      }
+      else if ( k < 40 )
+      {
+        dp::sg::core::TransformSharedPtr transform = dp::sg::core::Transform::create();
+        dp::math::Trafo trafo;
+        trafo.setTranslation( dp::math::Vec3f( position( generator ), position( generator ), position( generator ) ) );
+        transform->setTrafo( trafo );
+        node = transform;
+      }
+      else if ( k < 42 )
+      {
+        node = dp::sg::core::Billboard::create();
+      }
+      else if ( k < 44 )
+      {
+        dp::sg::core::LODSharedPtr lod = dp::sg::core::LOD::create();
+        float ranges[] = { 100.0f, 500.0f };
+        lod->setRanges( ranges, 2 );
+        node = lod;
+      }
+      else if ( k < 46 )
+      {
+        node = dp::sg::core::Switch::create();
+      }
+      else if ( k < 47 )
+      {
+        node = dp::sg::core::LightSource::create();
+      }
+      else
+      {
+        node = dp::sg::core::GeoNode::create();
+      }
+
+      if ( k < 46 )
+      {
+        groups.push_back( std::static_pointer_cast<dp::sg::core::Group>( node ) );
+      }
+      group->addChild( node );
+    }
+  }
+
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+  return scene;
+}
+
+/** \brief Compare the nodes of two SceneTrees in pre-order and return the number of differences **/
+static size_t compareTrees( dp::sg::xbar::SceneTreeSharedPtr const & lhs, dp::sg::xbar::SceneTreeSharedPtr const & rhs )
+{
+  dp::sg::xbar::ObjectTree & lhsTree = lhs->getObjectTree();
+  dp::sg::xbar::ObjectTree & rhsTree = rhs->getObjectTree();
+
+  // start below the sentinels, which are always at index 0
+  size_t differences = 0;
+  std::vector<std::pair<dp::sg::xbar::ObjectTreeIndex, dp::sg::xbar::ObjectTreeIndex> > stack( 1, std::make_pair( lhsTree[0].m_firstChild, rhsTree[0].m_firstChild ) );
+  while ( !stack.empty() )
+  {
+    dp::sg::xbar::ObjectTreeIndex lhsIndex = stack.back().first;
+    dp::sg::xbar::ObjectTreeIndex rhsIndex = stack.back().second;
+    stack.pop_back();
+
+    dp::sg::xbar::ObjectTreeNode const & l = lhsTree[lhsIndex];
+    dp::sg::xbar::ObjectTreeNode const & r = rhsTree[rhsIndex];
+    if ( lhsIndex != rhsIndex || lhsTree.getData( lhsIndex ).m_object != rhsTree.getData( rhsIndex ).m_object || l.m_parentIndex != r.m_parentIndex
+      || l.m_localHints != r.m_localHints || l.m_worldHints != r.m_worldHints
+      || l.m_localMask != r.m_localMask || l.m_worldMask != r.m_worldMask || l.m_localActive != r.m_localActive
+      || l.m_worldActive != r.m_worldActive || l.m_isDrawable != r.m_isDrawable || l.m_isTransform != r.m_isTransform
+      || l.m_isBillboard != r.m_isBillboard
+      || lhs->getTransformTree().getWorldMatrix( l.m_transform ) != rhs->getTransformTree().getWorldMatrix( r.m_transform ) )
+    {
+      ++differences;
+    }
+
+    dp::sg::xbar::ObjectTreeIndex lhsChild = l.m_firstChild;
+    dp::sg::xbar::ObjectTreeIndex rhsChild = r.m_firstChild;
+    while ( lhsChild != ~0 && rhsChild != ~0 )
+    {
+      stack.push_back( std::make_pair( lhsChild, rhsChild ) );
+      lhsChild = lhsTree[lhsChild].m_nextSibling;
+      rhsChild = rhsTree[rhsChild].m_nextSibling;
+    }
+    differences += ( lhsChild != rhsChild );
+  }
+
+  differences += ( lhs->getLightSources() != rhs->getLightSources() );
+  return differences;
+}
+
+/** \brief Visitor summing up the world masks of all nodes to touch each node of the ObjectTree **/
+class MaskVisitor
+{
+public:
+  struct Data {};
+
+  MaskVisitor( dp::sg::xbar::ObjectTree const & objectTree )
+    : m_objectTree( objectTree )
+    , m_sum( 0 )
+  {
+  }
+
+  bool preTraverse( dp::sg::xbar::ObjectTreeIndex index, Data const & data )
+  {
+    m_sum += m_objectTree[index].m_worldMask;
+    return true;
+  }
+
+  void postTraverse( dp::sg::xbar::ObjectTreeIndex index, Data const & data )
+  {
+  }
+
+  size_t getSum() const { return m_sum; }
+
+private:
+  dp::sg::xbar::ObjectTree const & m_objectTree;
+  size_t                           m_sum;
+};
+
+/** \brief Traverse the ObjectTree and return the time in milliseconds **/
+static double traverse( dp::sg::xbar::SceneTreeSharedPtr const & sceneTree, size_t & sum )
+{
+  dp::util::Timer timer;
+  timer.start();
+  MaskVisitor visitor( sceneTree->getObjectTree() );
+  dp::sg::xbar::PreOrderTreeTraverser<dp::sg::xbar::ObjectTree, MaskVisitor> traverser;
+  traverser.traverse( sceneTree->getObjectTree(), visitor );
+  timer.stop();
+  sum = visitor.getSum();
+  return timer.getTime() * 1000.0;
+}
+
+/** \brief Remove the first child of numberOfSubtrees random groups and add them back in random order. Returns the number of differences
+           between the compacted tree and a tree which has been built from scratch.
+**/
+static size_t churn( dp::sg::core::SceneSharedPtr const & scene, size_t numberOfSubtrees )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  sceneTree->update( camera, 1.0f );
+
+  // collect the plain groups with children, switches and LODs would change their active children
+  std::vector<dp::sg::core::GroupSharedPtr> groups;
+  std::vector<dp::sg::core::GroupSharedPtr> stack( 1, std::static_pointer_cast<dp::sg::core::Group>( scene->getRootNode() ) );
+  while ( !stack.empty() )
+  {
+    dp::sg::core::GroupSharedPtr group = stack.back();
+    stack.pop_back();
+    if ( group->getNumberOfChildren() )
+    {
+      groups.push_back( group );
+    }
+    for ( dp::sg::core::Group::ChildrenIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+    {
+      if ( (*it)->getObjectCode() == dp::sg::core::ObjectCode::GROUP )
+      {
+        stack.push_back( std::static_pointer_cast<dp::sg::core::Group>( *it ) );
+      }
+    }
+  }
+
+  std::mt19937 generator( 815 );
+  std::shuffle( groups.begin(), groups.end(), generator );
+  groups.resize( std::min( groups.size(), numberOfSubtrees ) );
+
+  std::vector<dp::sg::core::NodeSharedPtr> children;
+  for ( size_t index = 0; index < groups.size(); ++index )
+  {
+    children.push_back( *groups[index]->beginChildren() );
+    groups[index]->removeChild( children.back() );
+  }
+  sceneTree->update( camera, 1.0f );
+
+  std::vector<size_t> order( groups.size() );
+  for ( size_t index = 0; index < order.size(); ++index )
+  {
+    order[index] = index;
+  }
+  std::shuffle( order.begin(), order.end(), generator );
+  for ( size_t index = 0; index < order.size(); ++index )
+  {
+    groups[order[index]]->addChild( children[order[index]] );
+  }
+  sceneTree->update( camera, 1.0f );
+
+  size_t nodes = sceneTree->getObjectTree().getNumberOfNodes();
+  size_t size = sceneTree->getObjectTree().size();
+  size_t sum, compactedSum;
+  double traverseTime = traverse( sceneTree, sum );
+
+  dp::util::Timer timer;
+  timer.start();
+  sceneTree->compact();
+  timer.stop();
+  double compactTime = timer.getTime() * 1000.0;
+
+  double compactedTraverseTime = traverse( sceneTree, compactedSum );
+  printf( "%12zu %12s %12.3f %12.3f %12.3f   size %zu -> %zu\n", nodes, "compact", traverseTime, compactTime, compactedTraverseTime
+        , size, sceneTree->getObjectTree().size() );
+
+  // the compacted tree must match a tree which has been built from scratch, indices included
+  dp::sg::xbar::SceneTreeSharedPtr fresh = dp::sg::xbar::SceneTree::create( scene );
+  fresh->update( camera, 1.0f );
+  sceneTree->update( camera, 1.0f );
+  return compareTrees( sceneTree, fresh ) + ( sum != compactedSum );
+}
+
+/** \brief Create a tile with the given number of transforms. Every fourth transform has a nested transform, every 16th a
+           billboard, each with a GeoNode as leaf.
+**/
+static dp::sg::core::GroupSharedPtr createTile( size_t numberOfTransforms, std::mt19937 & generator )
+{
+  std::uniform_real_distribution<float> position( -1000.0f, 1000.0f );
+
+  dp::sg::core::GroupSharedPtr tile = dp::sg::core::Group::create();
+  dp::sg::core::GroupSharedPtr parent = tile;
+  for ( size_t index = 0; index < numberOfTransforms; ++index )
+  {
+    dp::sg::core::GroupSharedPtr group;
+    if ( index % 16 == 15 )
+    {
+      group = dp::sg::core::Billboard::create();
+    }
+    else
+    {
+      dp::sg::core::TransformSharedPtr transform = dp::sg::core::Transform::create();
+      dp::math::Trafo trafo;
+      trafo.setTranslation( dp::math::Vec3f( position( generator ), position( generator ), position( generator ) ) );
+      transform->setTrafo( trafo );
+      group = transform;
+    }
+    group->addChild( dp::sg::core::GeoNode::create() );
+
+    // nest every fourth transform below the previous one to get more than one level
+    ( index % 4 == 3 ? parent : tile )->addChild( group );
+    parent = group;
+  }
+  return tile;
+}
+
+/** \brief Stream numberOfLoads tiles through a scene of numberOfTiles tiles. Returns the number of differences between the final tree and a tree
+           which has been built from scratch.
+**/
+static size_t streamTiles( size_t numberOfTiles, size_t numberOfTransforms, size_t numberOfLoads )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  std::mt19937 generator( 42 );
+  dp::sg::core::GroupSharedPtr root = dp::sg::core::Group::create();
+  for ( size_t index = 0; index < numberOfTiles; ++index )
+  {
+    root->addChild( createTile( numberOfTransforms, generator ) );
+  }
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  sceneTree->update( camera, 1.0f );
+
+  double unloadTime = 0.0;
+  double loadTime = 0.0;
+  std::uniform_int_distribution<size_t> tileDistribution( 0, numberOfTiles - 1 );
+  for ( size_t load = 0; load < numberOfLoads; ++load )
+  {
+    dp::sg::core::GroupSharedPtr tile = createTile( numberOfTransforms, generator );
+    dp::sg::core::NodeSharedPtr oldTile = *std::next( root->beginChildren(), tileDistribution( generator ) );
+
+    dp::util::Timer timer;
+    timer.start();
+    root->removeChild( oldTile );
+    sceneTree->update( camera, 1.0f );
+    timer.stop();
+    unloadTime += timer.getTime();
+
+    timer.restart();
+    root->addChild( tile );
+    sceneTree->update( camera, 1.0f );
+    timer.stop();
+    loadTime += timer.getTime();
+
+    // move the camera to update the billboards of all tiles
+    camera->setPosition( dp::math::Vec3f( float(load), 0.0f, 1000.0f ) );
+  }
+  printf( "%12zu %12zu %12zu %12.3f %12.3f\n", numberOfTiles, numberOfTransforms, numberOfLoads, unloadTime * 1000.0 / numberOfLoads, loadTime * 1000.0 / numberOfLoads );
+
+  // compact the tree to get the same indices as a tree which has been built from scratch
+  dp::sg::xbar::SceneTreeSharedPtr fresh = dp::sg::xbar::SceneTree::create( scene );
+  fresh->update( camera, 1.0f );
+  sceneTree->compact();
+  sceneTree->update( camera, 1.0f );
+  return compareTrees( sceneTree, fresh );
+}
+
+/** \brief Get the transforms below the given group, without billboards. **/
+static std::vector<dp::sg::core::TransformSharedPtr> collectTransforms( dp::sg::core::GroupSharedPtr const & root )
+{
+  std::vector<dp::sg::core::TransformSharedPtr> transforms;
+  std::vector<dp::sg::core::GroupSharedPtr> stack( 1, root );
+  while ( !stack.empty() )
+  {
+    dp::sg::core::GroupSharedPtr group = stack.back();
+    stack.pop_back();
+    for ( dp::sg::core::Group::ChildrenIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+    {
+      if ( (*it)->getObjectCode() == dp::sg::core::ObjectCode::TRANSFORM )
+      {
+        transforms.push_back( std::static_pointer_cast<dp::sg::core::Transform>( *it ) );
+      }
+      if ( std::dynamic_pointer_cast<dp::sg::core::Group>( *it ) )
+      {
+        stack.push_back( std::static_pointer_cast<dp::sg::core::Group>( *it ) );
+      }
+    }
+  }
+  return transforms;
+}
+
+/** \brief Record numberOfMutations matrix changes of random transforms on another thread while the SceneTree is being updated.
+           Returns the number of transforms whose matrix differs from the last recorded matrix plus the number of differences
+           between the final tree and a tree which has been built from scratch.
+**/
+static size_t mutate( size_t numberOfTransforms, size_t numberOfMutations )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  std::mt19937 generator( 7 );
+  dp::sg::core::GroupSharedPtr root = createTile( numberOfTransforms, generator );
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+
+  std::vector<dp::sg::core::TransformSharedPtr> transforms = collectTransforms( root );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  dp::sg::xbar::MutationQueueSharedPtr mutationQueue = dp::sg::xbar::MutationQueue::create();
+  sceneTree->setMutationQueue( mutationQueue );
+  sceneTree->update( camera, 1.0f );
+
+  // the application thread only touches the scene through its buffer
+  std::vector<dp::math::Mat44f> expected( transforms.size() );
+  for ( size_t index = 0; index < transforms.size(); ++index )
+  {
+    expected[index] = transforms[index]->getMatrix();
+  }
+  dp::sg::xbar::MutationBufferSharedPtr buffer = mutationQueue->createBuffer();
+  std::atomic<bool> done( false );
+  std::thread application( [&]()
+  {
+    std::mt19937 generator( 11 );
+    std::uniform_int_distribution<size_t> transformDistribution( 0, transforms.size() - 1 );
+    for ( size_t mutation = 0; mutation < numberOfMutations; ++mutation )
+    {
+      size_t index = transformDistribution( generator );
+      dp::math::Trafo trafo;
+      trafo.setTranslation( dp::math::Vec3f( float( mutation % 1000 ), float( index % 1000 ), 0.0f ) );
+      expected[index] = trafo.getMatrix();
+      buffer->setMatrix( transforms[index], expected[index] );
+
+      if ( mutation % 1024 == 0 )
+      {
+        buffer->addChild( transforms[index], dp::sg::core::GeoNode::create() );
+      }
+    }
+    done = true;
+  } );
+
+  // the render loop never waits for the application thread
+  size_t frames = 0;
+  size_t applied = 0;
+  double applyTime = 0.0;
+  double updateTime = 0.0;
+  bool last = false;
+  while ( !last )
+  {
+    last = done;
+
+    dp::util::Timer timer;
+    timer.start();
+    applied += mutationQueue->apply();
+    timer.stop();
+    applyTime += timer.getTime();
+
+    timer.restart();
+    sceneTree->update( camera, 1.0f );
+    timer.stop();
+    updateTime += timer.getTime();
+    ++frames;
+  }
+  application.join();
+  printf( "%12zu %12zu %12zu %12zu %12.3f %12.3f\n", transforms.size(), numberOfMutations, applied, frames, applyTime * 1000.0 / frames, updateTime * 1000.0 / frames );
+
+  size_t differences = 0;
+  for ( size_t index = 0; index < transforms.size(); ++index )
+  {
+    differences += ( transforms[index]->getMatrix() != expected[index] );
+  }
+
+  dp::sg::xbar::SceneTreeSharedPtr fresh = dp::sg::xbar::SceneTree::create( scene );
+  fresh->update( camera, 1.0f );
+  sceneTree->compact();
+  sceneTree->update( camera, 1.0f );
+  return differences + compareTrees( sceneTree, fresh );
+}
+
+/** \brief Set numberOfCalls matrices of random transforms of a tile of numberOfTransforms transforms and update the SceneTree,
+           with the notifications delivered immediately or batched by a NotificationBatch. Returns the time in seconds to set the
+           matrices and the time to update the tree, and the number of differences between the final tree and a fresh tree.
+**/
+static size_t setMatrices( size_t numberOfTransforms, size_t numberOfCalls, bool batched, double & setTime, double & updateTime )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  std::mt19937 generator( 17 );
+  dp::sg::core::GroupSharedPtr root = createTile( numberOfTransforms, generator );
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+
+  std::vector<dp::sg::core::TransformSharedPtr> transforms = collectTransforms( root );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  sceneTree->update( camera, 1.0f );
+
+  std::uniform_int_distribution<size_t> transformDistribution( 0, transforms.size() - 1 );
+  dp::util::Timer timer;
+  timer.start();
+  {
+    std::unique_ptr<dp::util::NotificationBatch> batch( batched ? new dp::util::NotificationBatch() : nullptr );
+    for ( size_t call = 0; call < numberOfCalls; ++call )
+    {
+      size_t index = transformDistribution( generator );
+      dp::math::Mat44f matrix( dp::math::cIdentity44f );
+      matrix[3] = dp::math::Vec4f( float( call % 1000 ), float( index % 1000 ), 0.0f, 1.0f );
+      transforms[index]->setMatrix( matrix );
+    }
+  }
+  timer.stop();
+  setTime = timer.getTime();
+
+  timer.restart();
+  sceneTree->update( camera, 1.0f );
+  timer.stop();
+  updateTime = timer.getTime();
+
+  dp::sg::xbar::SceneTreeSharedPtr fresh = dp::sg::xbar::SceneTree::create( scene );
+  fresh->update( camera, 1.0f );
+  return compareTrees( sceneTree, fresh );
+}
+
+/** \brief Update numberOfFrames frames of a scene of numberOfObjects objects, a dynamic Switch with seven GeoNodes for every eighth
+           object. Every frame toggles the traversal masks of numberOfToggles random objects and one child of 1% of the switches.
+           Returns the time in seconds to change the objects and to update the tree, and the number of differences between the
+           final tree and a fresh tree.
+**/
+static size_t toggleMasks( size_t numberOfObjects, size_t numberOfToggles, size_t numberOfFrames, double & toggleTime, double & updateTime )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  size_t const numberOfChildren = 7;
+  std::vector<dp::sg::core::ObjectSharedPtr> objects;
+  std::vector<dp::sg::core::SwitchSharedPtr> switches;
+  dp::sg::core::GroupSharedPtr root = dp::sg::core::Group::create();
+  while ( objects.size() < numberOfObjects )
+  {
+    dp::sg::core::SwitchSharedPtr s = dp::sg::core::Switch::create();
+    s->addHints( dp::sg::core::Object::DP_SG_HINT_DYNAMIC );
+    objects.push_back( s );
+    switches.push_back( s );
+    for ( size_t child = 0; child < numberOfChildren; ++child )
+    {
+      dp::sg::core::GeoNodeSharedPtr geoNode = dp::sg::core::GeoNode::create();
+      s->addChild( geoNode );
+      objects.push_back( geoNode );
+    }
+    root->addChild( s );
+  }
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  sceneTree->update( camera, 1.0f );
+
+  std::mt19937 generator( 23 );
+  std::uniform_int_distribution<size_t> objectDistribution( 0, objects.size() - 1 );
+  std::uniform_int_distribution<size_t> switchDistribution( 0, switches.size() - 1 );
+  std::uniform_int_distribution<unsigned int> childDistribution( 0, numberOfChildren - 1 );
+  size_t const numberOfSwitchToggles = std::max( size_t(1), switches.size() / 100 );
+
+  dp::util::Timer toggleTimer, updateTimer;
+  for ( size_t frame = 0; frame < numberOfFrames; ++frame )
+  {
+    toggleTimer.start();
+    for ( size_t toggle = 0; toggle < numberOfToggles; ++toggle )
+    {
+      dp::sg::core::ObjectSharedPtr const & object = objects[objectDistribution( generator )];
+      object->setTraversalMask( object->getTraversalMask() ^ ( 1u << ( toggle % 8 ) ) );
+    }
+    for ( size_t toggle = 0; toggle < numberOfSwitchToggles; ++toggle )
+    {
+      dp::sg::core::SwitchSharedPtr const & s = switches[switchDistribution( generator )];
+      unsigned int child = childDistribution( generator );
+      if ( s->isActive( child ) )
+      {
+        s->setInactive( child );
+      }
+      else
+      {
+        s->setActive( child );
+      }
+    }
+    toggleTimer.stop();
+
+    updateTimer.start();
+    sceneTree->update( camera, 1.0f );
+    updateTimer.stop();
+  }
+  toggleTime = toggleTimer.getTime();
+  updateTime = updateTimer.getTime();
+
+  dp::sg::xbar::SceneTreeSharedPtr fresh = dp::sg::xbar::SceneTree::create( scene );
+  fresh->update( camera, 1.0f );
+  return compareTrees( sceneTree, fresh );
+}
+
+/** \brief Animate numberOfFrames frames of a tile of numberOfTransforms transforms and publish each frame through a SceneTreeSnapshot
+           while a render thread reads the published frames. Every frame changes the matrices of 1% of the transforms and the
+           visibility of 1% of the objects. Returns the number of differences between the published frames and the SceneTree.
+**/
+static size_t snapshot( size_t numberOfTransforms, size_t numberOfFrames )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  std::mt19937 generator( 13 );
+  dp::sg::core::GroupSharedPtr root = createTile( numberOfTransforms, generator );
+  dp::sg::core::SceneSharedPtr scene = dp::sg::core::Scene::create();
+  scene->setRootNode( root );
+
+  std::vector<dp::sg::core::TransformSharedPtr> transforms = collectTransforms( root );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree = dp::sg::xbar::SceneTree::create( scene );
+  dp::sg::xbar::SceneTreeSnapshotSharedPtr sceneTreeSnapshot = dp::sg::xbar::SceneTreeSnapshot::create( sceneTree );
+  dp::sg::xbar::ObjectTree & objectTree = sceneTree->getObjectTree();
+  sceneTree->update( camera, 1.0f );
+
+  dp::util::Timer timer;
+  timer.start();
+  sceneTreeSnapshot->publish();
+  timer.stop();
+  double fullTime = timer.getTime();
+
+  // the render thread uploads the changed matrices of each frame it gets
+  std::atomic<bool> done( false );
+  size_t renderedFrames = 0;
+  size_t skippedFrames = 0;
+  float sum = 0.0f;
+  std::thread renderer( [&]()
+  {
+    size_t lastFrameNumber = 0;
+    while ( !done )
+    {
+      dp::sg::xbar::SceneTreeSnapshot::FrameSharedPtr frame = sceneTreeSnapshot->acquire();
+      if ( frame->getFrameNumber() != lastFrameNumber )
+      {
+        skippedFrames += frame->getFrameNumber() - lastFrameNumber - 1;
+        lastFrameNumber = frame->getFrameNumber();
+        frame->getChangedWorldMatrices().traverseBits( [&]( size_t index ) { sum += frame->getWorldMatrix( dp::sg::xbar::TransformIndex(index) )[3][0]; } );
+        frame->getChangedObjects().traverseBits( [&]( size_t index ) { sum += frame->isVisible( dp::sg::xbar::ObjectTreeIndex(index) ) ? 1.0f : 0.0f; } );
+        ++renderedFrames;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  } );
+
+  std::uniform_int_distribution<size_t> transformDistribution( 0, transforms.size() - 1 );
+  std::uniform_int_distribution<size_t> objectDistribution( 0, objectTree.size() - 1 );
+  std::vector<char> visible( objectTree.size(), true );
+  double updateTime = 0.0;
+  double publishTime = 0.0;
+  size_t differences = 0;
+  for ( size_t frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex )
+  {
+    timer.restart();
+    for ( size_t change = 0; change < transforms.size() / 100; ++change )
+    {
+      size_t index = transformDistribution( generator );
+      dp::math::Trafo trafo;
+      trafo.setTranslation( dp::math::Vec3f( float( frameIndex ), float( index % 1000 ), 0.0f ) );
+      transforms[index]->setTrafo( trafo );
+    }
+    sceneTree->update( camera, 1.0f );
+
+    // set the visibility as culling would do
+    for ( size_t change = 0; change < visible.size() / 100; ++change )
+    {
+      size_t index = objectDistribution( generator );
+      visible[index] = !visible[index];
+      sceneTreeSnapshot->setVisible( dp::sg::xbar::ObjectTreeIndex(index), !!visible[index] );
+    }
+    timer.stop();
+    updateTime += timer.getTime();
+
+    timer.restart();
+    sceneTreeSnapshot->publish();
+    timer.stop();
+    publishTime += timer.getTime();
+
+    if ( frameIndex % 16 == 0 || frameIndex + 1 == numberOfFrames )
+    {
+      dp::sg::xbar::SceneTreeSnapshot::FrameSharedPtr frame = sceneTreeSnapshot->acquire();
+      dp::sg::xbar::TransformTree const & transformTree = sceneTree->getTransformTree();
+      for ( size_t index = 0; index < frame->getNumberOfTransforms(); ++index )
+      {
+        differences += frame->getWorldMatrix( dp::sg::xbar::TransformIndex(index) ) != transformTree.getWorldMatrix( dp::sg::xbar::TransformIndex(index) );
+      }
+      for ( size_t index = 0; index < objectTree.size(); ++index )
+      {
+        dp::sg::xbar::ObjectTreeNode const & node = objectTree[dp::sg::xbar::ObjectTreeIndex(index)];
+        differences += frame->isVisible( dp::sg::xbar::ObjectTreeIndex(index) ) != !!visible[index];
+        differences += node.m_isDrawable && frame->isActive( dp::sg::xbar::ObjectTreeIndex(index) ) != node.m_worldActive;
+      }
+    }
+  }
+  done = true;
+  renderer.join();
+
+  printf( "%12zu %12zu %12zu %12zu %12.3f %12.3f %12.3f\n", transforms.size(), numberOfFrames, renderedFrames, skippedFrames
+        , updateTime * 1000.0 / numberOfFrames, publishTime * 1000.0 / numberOfFrames, fullTime * 1000.0 );
+  return differences + ( sum != sum );
+}
+
+/** \brief Create a scene on the heap or in an ObjectArena, compute its bounding volumes, which touches each node, and drop it.
+           Returns the times in milliseconds and the statistics of the arena.
+**/
+static void allocateScene( size_t numberOfNodes, size_t numberOfChildren, bool useArena, double & createTime, double & boundsTime
+                         , double & dropTime, std::vector<dp::sg::core::ObjectStatistics> & statistics )
+{
+  dp::util::Timer timer;
+  timer.start();
+  dp::sg::core::SceneSharedPtr scene;
+  {
+    dp::sg::core::ObjectArena::Scope scope( useArena ? dp::sg::core::ObjectArena::create() : dp::sg::core::ObjectArenaSharedPtr() );
+    scene = createScene( numberOfNodes, numberOfChildren );
+  }
+  timer.stop();
+  createTime = timer.getTime() * 1000.0;
+
+  timer.restart();
+  scene->getBoundingBox();
+  timer.stop();
+  boundsTime = timer.getTime() * 1000.0;
+
+  statistics = useArena ? scene->getObjectArena()->getStatistics() : std::vector<dp::sg::core::ObjectStatistics>();
+
+  timer.restart();
+  scene.reset();
+  timer.stop();
+  dropTime = timer.getTime() * 1000.0;
+}
+
+/** \brief Build the SceneTree and run the first update. Returns the average times in milliseconds and the last tree. **/
+static dp::sg::xbar::SceneTreeSharedPtr benchmark( dp::sg::core::SceneSharedPtr const & scene, dp::sg::xbar::SceneTree::BuildMode buildMode, unsigned int numberOfThreads
+                                                 , unsigned int repetitions, double & createTime, double & updateTime )
+{
+  dp::sg::core::PerspectiveCameraSharedPtr camera = dp::sg::core::PerspectiveCamera::create();
+  camera->setPosition( dp::math::Vec3f( 0.0f, 0.0f, 1000.0f ) );
+
+  dp::sg::xbar::SceneTreeSharedPtr sceneTree;
+  createTime = 0.0;
+  updateTime = 0.0;
+  for ( unsigned int repetition = 0; repetition < repetitions; ++repetition )
+  {
+    // destroy the previous tree first so that its observers do not slow down the next build
+    sceneTree.reset();
+
+    dp::util::Timer timer;
+    timer.start();
+    sceneTree = dp::sg::xbar::SceneTree::create( scene, buildMode, numberOfThreads );
+    timer.stop();
+    createTime += timer.getTime();
+
+    timer.restart();
+    sceneTree->update( camera, 1.0f );
+    timer.stop();
+    updateTime += timer.getTime();
+  }
+  createTime *= 1000.0 / repetitions;
+  updateTime *= 1000.0 / repetitions;
+  return sceneTree;
+}
+
+int main( int argc, char *argv[] )
+{
+  options::options_description od( "Usage: SceneTreeBenchmark" );
+  od.add_options()
+    ( "help", "show help")
+    ( "children", options::value<size_t>()->default_value( 8 ), "number of children per group" )
+    ( "nodes", options::value<std::vector<size_t> >()->multitoken(), "list of scene sizes, default is 100k, 1M and 3M" )
+    ( "repetitions", options::value<unsigned int>()->default_value( 4 ), "number of builds per measurement" )
+    ( "threads", options::value<unsigned int>()->default_value( 0 ), "number of threads of the bulk build, 0 uses all hardware threads" )
+    ( "verify", "compare the trees of both build modes" )
+    ( "churn", options::value<size_t>(), "number of subtrees to remove and re-add before compacting the SceneTree" )
+    ( "tiles", options::value<size_t>(), "number of tiles to stream through the scene" )
+    ( "tileTransforms", options::value<size_t>()->default_value( 50000 ), "number of transforms per tile" )
+    ( "mutations", options::value<size_t>(), "number of matrix changes recorded by an application thread" )
+    ( "snapshots", options::value<size_t>(), "number of frames to publish to a render thread through a SceneTreeSnapshot" )
+    ( "matrices", options::value<size_t>(), "number of Transform::setMatrix calls with immediate and with batched notifications" )
+    ( "masks", options::value<size_t>(), "number of traversal masks to toggle per frame" )
+    ( "maskObjects", options::value<size_t>()->default_value( 400000 ), "number of objects of the scene whose traversal masks are toggled" )
+    ( "maskFrames", options::value<size_t>()->default_value( 16 ), "number of frames to toggle traversal masks" )
+    ( "arena", "compare scenes allocated on the heap with scenes allocated in an ObjectArena" )
+    ;
+
+  options::variables_map opts;
+  try
+  {
+    options::store( options::parse_command_line( argc, argv, od ), opts );
+  }
+  catch ( options::error const & e )
+  {
+    std::cerr << e.what() << std::endl << od << std::endl;
+    return 1;
+  }
+
+  if ( opts.count( "help" ) )
+  {
+    std::cout << od << std::endl;
+    return 0;
+  }
+
+  std::vector<size_t> sizes;
+  if ( opts.count( "nodes" ) )
+  {
+    sizes = opts["nodes"].as<std::vector<size_t> >();
+  }
+  else
+  {
+    size_t const defaultSizes[] = { 100000, 1000000, 3000000 };
+    sizes.assign( defaultSizes, defaultSizes + sizeof(defaultSizes) / sizeof(defaultSizes[0]) );
+  }
+
+  size_t numberOfChildren = std::max( size_t(2), opts["children"].as<size_t>() );
+  unsigned int repetitions = std::max( 1u, opts["repetitions"].as<unsigned int>() );
+  unsigned int numberOfThreads = opts["threads"].as<unsigned int>();
+  bool verify = !!opts.count( "verify" );
+  size_t numberOfSubtrees = opts.count( "churn" ) ? opts["churn"].as<size_t>() : 0;
+  size_t numberOfLoads = opts.count( "tiles" ) ? opts["tiles"].as<size_t>() : 0;
+  size_t numberOfTransforms = opts["tileTransforms"].as<size_t>();
+  size_t numberOfMutations = opts.count( "mutations" ) ? opts["mutations"].as<size_t>() : 0;
+  size_t numberOfSnapshots = opts.count( "snapshots" ) ? opts["snapshots"].as<size_t>() : 0;
+  size_t numberOfMatrices = opts.count( "matrices" ) ? opts["matrices"].as<size_t>() : 0;
+  size_t numberOfToggles = opts.count( "masks" ) ? opts["masks"].as<size_t>() : 0;
+  size_t numberOfMaskObjects = std::max( size_t(1), opts["maskObjects"].as<size_t>() );
+  size_t numberOfFrames = opts["maskFrames"].as<size_t>();
+  bool arena = !!opts.count( "arena" );
+
+  size_t differences = 0;
+  printf( "%12s %12s %12s %12s %12s\n", "nodes", "mode", "create ms", "update ms", "total ms" );
+  for ( size_t sizeIndex = 0; sizeIndex < sizes.size(); ++sizeIndex )
+  {
+    dp::sg::core::SceneSharedPtr scene = createScene( sizes[sizeIndex], numberOfChildren );
+
+    double createTime, updateTime;
+    dp::sg::xbar::SceneTreeSharedPtr incremental = benchmark( scene, dp::sg::xbar::SceneTree::BuildMode::INCREMENTAL, numberOfThreads, repetitions, createTime, updateTime );
+    printf( "%12zu %12s %12.3f %12.3f %12.3f\n", sizes[sizeIndex], "incremental", createTime, updateTime, createTime + updateTime );
+    if ( !verify )
+    {
+      incremental.reset();
+    }
+
+    dp::sg::xbar::SceneTreeSharedPtr bulk = benchmark( scene, dp::sg::xbar::SceneTree::BuildMode::BULK, numberOfThreads, repetitions, createTime, updateTime );
+    printf( "%12zu %12s %12.3f %12.3f %12.3f\n", sizes[sizeIndex], "bulk", createTime, updateTime, createTime + updateTime );
+
+    if ( verify )
+    {
+      size_t sizeDifferences = compareTrees( incremental, bulk );
+      if ( sizeDifferences )
+      {
+        printf( "%12zu trees differ in %zu nodes\n", sizes[sizeIndex], sizeDifferences );
+      }
+      differences += sizeDifferences;
+    }
+  }
+
+  if ( numberOfSubtrees )
+  {
+    printf( "\n%12s %12s %12s %12s %12s\n", "nodes", "mode", "traverse ms", "compact ms", "traverse ms" );
+    for ( size_t sizeIndex = 0; sizeIndex < sizes.size(); ++sizeIndex )
+    {
+      size_t sizeDifferences = churn( createScene( sizes[sizeIndex], numberOfChildren ), numberOfSubtrees );
+      if ( sizeDifferences )
+      {
+        printf( "%12zu compacted tree differs in %zu nodes\n", sizes[sizeIndex], sizeDifferences );
+      }
+      differences += sizeDifferences;
+    }
+  }
+
+  if ( numberOfLoads )
+  {
+    printf( "\n%12s %12s %12s %12s %12s\n", "tiles", "transforms", "loads", "unload ms", "load ms" );
+    size_t const numberOfTiles = 8;
+    size_t tileDifferences = streamTiles( numberOfTiles, numberOfTransforms, numberOfLoads );
+    if ( tileDifferences )
+    {
+      printf( "%12zu streamed tree differs in %zu nodes\n", numberOfTiles, tileDifferences );
+    }
+    differences += tileDifferences;
+  }
+
+  if ( numberOfMutations )
+  {
+    printf( "\n%12s %12s %12s %12s %12s %12s\n", "transforms", "mutations", "applied", "frames", "apply ms", "update ms" );
+    size_t mutationDifferences = mutate( numberOfTransforms, numberOfMutations );
+    if ( mutationDifferences )
+    {
+      printf( "%12zu mutated tree differs in %zu nodes\n", numberOfTransforms, mutationDifferences );
+    }
+    differences += mutationDifferences;
+  }
+
+  if ( numberOfSnapshots )
+  {
+    printf( "\n%12s %12s %12s %12s %12s %12s %12s\n", "transforms", "frames", "rendered", "skipped", "update ms", "publish ms", "full ms" );
+    size_t snapshotDifferences = snapshot( numberOfTransforms, numberOfSnapshots );
+    if ( snapshotDifferences )
+    {
+      printf( "%12zu published frames differ in %zu entries\n", numberOfTransforms, snapshotDifferences );
+    }
+    differences += snapshotDifferences;
+  }
+
+  if ( numberOfMatrices )
+  {
+    printf( "\n%12s %12s %12s %12s %12s %12s\n", "transforms", "calls", "mode", "set ms", "update ms", "total ms" );
+    for ( int batched = 0; batched < 2; ++batched )
+    {
+      double setTime, updateTime;
+      size_t matrixDifferences = setMatrices( numberOfTransforms, numberOfMatrices, !!batched, setTime, updateTime );
+      printf( "%12zu %12zu %12s %12.3f %12.3f %12.3f\n", numberOfTransforms, numberOfMatrices, batched ? "batched" : "immediate"
+            , setTime * 1000.0, updateTime * 1000.0, ( setTime + updateTime ) * 1000.0 );
+      if ( matrixDifferences )
+      {
+        printf( "%12zu tree differs in %zu nodes\n", numberOfTransforms, matrixDifferences );
+      }
+      differences += matrixDifferences;
+    }
+  }
+
+  if ( numberOfToggles )
+  {
+    printf( "\n%12s %12s %12s %12s %12s\n", "objects", "masks", "frames", "toggle ms", "update ms" );
+    double toggleTime, updateTime;
+    size_t maskDifferences = toggleMasks( numberOfMaskObjects, numberOfToggles, numberOfFrames, toggleTime, updateTime );
+    printf( "%12zu %12zu %12zu %12.3f %12.3f\n", numberOfMaskObjects, numberOfToggles, numberOfFrames
+          , toggleTime * 1000.0 / std::max( size_t(1), numberOfFrames ), updateTime * 1000.0 / std::max( size_t(1), numberOfFrames ) );
+    if ( maskDifferences )
+    {
+      printf( "%12zu tree differs in %zu nodes\n", numberOfMaskObjects, maskDifferences );
+    }
+    differences += maskDifferences;
+  }
+
+  if ( arena )
+  {
+    printf( "\n%12s %12s %12s %12s %12s\n", "nodes", "allocation", "create ms", "bounds ms", "drop ms" );
+    std::vector<dp::sg::core::ObjectStatistics> statistics;
+    for ( size_t sizeIndex = 0; sizeIndex < sizes.size(); ++sizeIndex )
+    {
+      for ( int useArena = 0; useArena < 2; ++useArena )
+      {
+        double createTime, boundsTime, dropTime;
+        allocateScene( sizes[sizeIndex], numberOfChildren, !!useArena, createTime, boundsTime, dropTime, statistics );
+        printf( "%12zu %12s %12.3f %12.3f %12.3f\n", sizes[sizeIndex], useArena ? "arena" : "heap", createTime, boundsTime, dropTime );
+      }
+    }
+
+    printf( "\n%32s %12s %12s\n", "type", "objects", "bytes" );
+    for ( size_t index = 0; index < statistics.size(); ++index )
+    {
+      if ( statistics[index].totalObjects )
+      {
+        printf( "%32s %12zu %12zu\n", statistics[index].name.c_str(), statistics[index].totalObjects, statistics[index].bytes );
+      }
+    }
+  }
+
+  return differences ? 1 : 0;
+}
@@ -74,12 +74,20 @@ namespace dp
 
       size_t getObjectIncarnation() const;
 
+      //! \brief Get a counter which is incremented whenever an object, a matrix or a bounding box of the group changes
+      size_t getInputIncarnation() const;
+
       void setBoundingBoxDirty( bool dirty );
       bool isBoundingBoxDirty() const;
 
       void setOBBDirty( bool dirty );
       bool isOBBDirty() const;
 
+      //! \brief Notify that the bounding box or transform index of an object in the group has changed
+      void markObjectBoundsDirty();
+      void setObjectBoundsDirty( bool dirty );
+      bool isObjectBoundsDirty() const;
+
       dp::math::Box3f const& getBoundingBox() const;
       void setBoundingBox( dp::math::Box3f const& boundingBox );
 
@@ -91,7 +99,9 @@ namespace dp
       bool                                m_inputChanged;
       bool                                m_matricesChanged;
       bool                                m_obbDirty;
+      bool                                m_objectBoundsDirty;
       size_t                              m_objectIncarnation; // incremented on add/removeObject, TODO replace by observer
+      size_t                              m_inputIncarnation;  // incremented on any change which might change the culling result
       std::vector<ObjectBitSetSharedPtr>  m_objects;
 
     private:
@@ -137,6 +147,11 @@ namespace dp
       return m_objectIncarnation;
     }
 
+    inline size_t GroupBitSet::getInputIncarnation() const
+    {
+      return m_inputIncarnation;
+    }
+
     inline void GroupBitSet::markMatrixDirty( size_t index )
     {
       // it is legal to call markMatrixDirty with index >= m_matricesCount. In this case
@@ -146,6 +161,7 @@ namespace dp
         m_dirtyMatrices.enableBit( index );
         m_boundingBoxDirty = true;
         m_obbDirty = true;
+        ++m_inputIncarnation;
       }
     }
 
@@ -169,6 +185,25 @@ namespace dp
       return m_obbDirty;
     }
 
+    inline void GroupBitSet::markObjectBoundsDirty()
+    {
+      m_objectBoundsDirty = true;
+      m_inputChanged = true;
+      m_boundingBoxDirty = true;
+      m_obbDirty = true;
+      ++m_inputIncarnation;
+    }
+
+    inline void GroupBitSet::setObjectBoundsDirty( bool dirty )
+    {
+      m_objectBoundsDirty = dirty;
+    }
+
+    inline bool GroupBitSet::isObjectBoundsDirty() const
+    {
+      return m_objectBoundsDirty;
+    }
+
     inline dp::math::Box3f const& GroupBitSet::getBoundingBox() const
     {
       return m_boundingBox;
@@ -30,6 +30,7 @@
 #include <dp/math/Matmnt.h>
 #include <dp/math/Boxnt.h>
 #include <dp/util/PointerTypes.h>
+#include <vector>
 
 namespace dp
 {
@@ -94,6 +95,7 @@ namespace dp
     enum class Mode
     {
         CPU
+      , CPU_BVH // CPU culling with a bounding volume hierarchy, rejects and accepts whole subtrees
       , OPENGL_COMPUTE
       , CUDA
       , AUTO // figure out which culling is best automatically
@@ -116,6 +118,12 @@ namespace dp
       DP_CULLING_API virtual void objectSetUserData( ObjectSharedPtr const & object, PayloadSharedPtr const & userData ) = 0;
       DP_CULLING_API virtual PayloadSharedPtr const & objectGetUserData( ObjectSharedPtr const & object ) = 0;
 
+      /** \brief Assign a dense id to an object, e.g. the index of the object in an array of the application.
+                 The ids are reported by resultGetChangedIds. The default id is ~0.
+      **/
+      DP_CULLING_API virtual void objectSetUserId( ObjectSharedPtr const & object, uint32_t userId ) = 0;
+      DP_CULLING_API virtual uint32_t objectGetUserId( ObjectSharedPtr const & object ) = 0;
+
       DP_CULLING_API virtual GroupSharedPtr groupCreate() = 0;
       DP_CULLING_API virtual void groupAddObject( GroupSharedPtr const & group, const ObjectSharedPtr& object ) = 0;
       DP_CULLING_API virtual ObjectSharedPtr groupGetObject( GroupSharedPtr const & group, size_t index ) = 0;
@@ -128,6 +136,14 @@ namespace dp
       /** \brief Get a list of objects whose visiblity is changed between the last and current draw call **/
       DP_CULLING_API virtual std::vector<ObjectSharedPtr> const & resultGetChanged( ResultSharedPtr const& result ) = 0;
 
+      /** \brief Get the user ids of the objects whose visibility is changed between the last and current draw call.
+                 This is the allocation free variant of resultGetChanged. The ids are written to changedIds which is cleared first
+                 and keeps its capacity, i.e. once the buffer is large enough no memory is allocated per call.
+          \param result The result to query. The group of the result must not have been modified since the last cull.
+          \param changedIds Buffer of the caller which receives the ids set with objectSetUserId.
+      **/
+      DP_CULLING_API virtual void resultGetChangedIds( ResultSharedPtr const& result, std::vector<uint32_t> & changedIds ) = 0;
+
       /** \brief Query if an object is visible within a result. **/
       DP_CULLING_API virtual bool resultObjectIsVisible( ResultSharedPtr const& result, ObjectSharedPtr const& object ) = 0;
 
@@ -138,8 +154,44 @@ namespace dp
       **/
       DP_CULLING_API virtual void cull( GroupSharedPtr const & group, ResultSharedPtr const & result, dp::math::Mat44f const & viewProjection ) = 0;
 
+      /** \brief Cull a given group against multiple views in a single pass, e.g. for stereo or multiple viewports.
+                 The result is identical to calling cull for each view, but the group data is traversed only once.
+          \param group The group which contains the objects to cull
+          \param results One result per view. results[i] stores the visibility for viewProjections[i]. All results must match the given group.
+          \param viewProjections The camera/projection matrices of the views
+      **/
+      DP_CULLING_API virtual void cullViews( GroupSharedPtr const & group, std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & viewProjections ) = 0;
+
+      /** \brief Cull a given group against multiple views and store the union of the visible objects in a single result.
+                 An object is visible if it is visible in at least one of the views. This is useful for stereo pairs or multicast
+                 rendering where all views share the same set of objects.
+          \param group The group which contains the objects to cull
+          \param result The result object which stores the combined visibility. The result must match the given group.
+          \param viewProjections The camera/projection matrices of the views
+      **/
+      DP_CULLING_API virtual void cullUnion( GroupSharedPtr const & group, ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & viewProjections ) = 0;
+
       /** \brief Compute the bounding box for the given group **/
       DP_CULLING_API virtual dp::math::Box3f getBoundingBox( GroupSharedPtr const & group ) const = 0;
+
+      /** \brief Set the size of the viewport in pixels. The viewport size is required by the small feature culling. **/
+      DP_CULLING_API virtual void setViewportSize( dp::math::Vec2ui const & viewportSize ) = 0;
+      DP_CULLING_API virtual dp::math::Vec2ui const & getViewportSize() const = 0;
+
+      /** \brief Enable the small feature culling. Objects whose projected OBB is smaller than the given number of pixels
+                 in x and in y are reported as invisible. Objects crossing the plane w = 0 are never culled by their size.
+          \param minimumPixelSize Minimum size in pixels. 0 disables the small feature culling, which is the default.
+          \remarks The small feature culling is implemented by the CPU culling only.
+      **/
+      DP_CULLING_API virtual void setMinimumPixelSize( float minimumPixelSize ) = 0;
+      DP_CULLING_API virtual float getMinimumPixelSize() const = 0;
+
+      /** \brief Set the hysteresis of the small feature culling. An object which has been culled by its size becomes visible again
+                 once its size exceeds minimumPixelSize * (1 + hysteresis) pixels. This avoids flickering of objects with a size
+                 close to the threshold. The default is 0.25.
+      **/
+      DP_CULLING_API virtual void setPixelSizeHysteresis( float hysteresis ) = 0;
+      DP_CULLING_API virtual float getPixelSizeHysteresis() const = 0;
     };
 
   } // namespace culling
@@ -42,6 +42,8 @@ namespace dp
       DP_CULLING_API virtual void objectSetTransformIndex( const ObjectSharedPtr& object, size_t index );
       DP_CULLING_API virtual void objectSetUserData( const ObjectSharedPtr& object, PayloadSharedPtr const& userData );
       DP_CULLING_API virtual PayloadSharedPtr const& objectGetUserData( const ObjectSharedPtr& object );
+      DP_CULLING_API virtual void objectSetUserId( ObjectSharedPtr const & object, uint32_t userId );
+      DP_CULLING_API virtual uint32_t objectGetUserId( ObjectSharedPtr const & object );
 
       DP_CULLING_API virtual void groupAddObject( const GroupSharedPtr& group, const ObjectSharedPtr& object );
       DP_CULLING_API virtual ObjectSharedPtr groupGetObject( const GroupSharedPtr& group, size_t index );
@@ -51,10 +53,26 @@ namespace dp
       DP_CULLING_API virtual void groupMatrixChanged( GroupSharedPtr const& group, size_t index );
 
       DP_CULLING_API virtual std::vector<ObjectSharedPtr> const & resultGetChanged( ResultSharedPtr const & result );
+      DP_CULLING_API virtual void resultGetChangedIds( ResultSharedPtr const & result, std::vector<uint32_t> & changedIds );
       DP_CULLING_API virtual bool resultObjectIsVisible( ResultSharedPtr const& result, ObjectSharedPtr const& object );
 
+      /** \brief Cull each view separately. Managers which can share work between views override this function. **/
+      DP_CULLING_API virtual void cullViews( GroupSharedPtr const & group, std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & viewProjections );
+
       DP_CULLING_API virtual dp::math::Box3f getBoundingBox( const GroupSharedPtr& group ) const;
       DP_CULLING_API virtual dp::math::Box3f calculateBoundingBox( const GroupSharedPtr& group ) const;
+
+      DP_CULLING_API virtual void setViewportSize( dp::math::Vec2ui const & viewportSize );
+      DP_CULLING_API virtual dp::math::Vec2ui const & getViewportSize() const;
+      DP_CULLING_API virtual void setMinimumPixelSize( float minimumPixelSize );
+      DP_CULLING_API virtual float getMinimumPixelSize() const;
+      DP_CULLING_API virtual void setPixelSizeHysteresis( float hysteresis );
+      DP_CULLING_API virtual float getPixelSizeHysteresis() const;
+
+    protected:
+      dp::math::Vec2ui m_viewportSize;
+      float            m_minimumPixelSize;
+      float            m_pixelSizeHysteresis;
     };
 
   } // namespace culling
@@ -56,6 +56,10 @@ namespace dp
       void setUserData( PayloadSharedPtr const& userData );
       PayloadSharedPtr const& getUserData( ) const;
 
+      /** \brief Dense id chosen by the user, e.g. an index into an array of the user. It is reported by ResultBitSet::getChangedIds. **/
+      void setUserId( uint32_t userId );
+      uint32_t getUserId() const;
+
       void setGroupIndex( size_t groupIndex );
       size_t getGroupIndex() const;
 
@@ -71,6 +75,7 @@ namespace dp
       dp::math::Vec4f     m_extent;
       size_t              m_transformIndex;
       PayloadSharedPtr    m_userData;
+      uint32_t            m_userId;
       size_t              m_groupIndex;
       GroupBitSetWeakPtr  m_group;
     };
@@ -115,6 +120,16 @@ namespace dp
       return m_userData;
     }
 
+    inline void ObjectBitSet::setUserId( uint32_t userId )
+    {
+      m_userId = userId;
+    }
+
+    inline uint32_t ObjectBitSet::getUserId() const
+    {
+      return m_userId;
+    }
+
     inline void ObjectBitSet::setGroupIndex( size_t groupIndex )
     {
       m_groupIndex = groupIndex;
@@ -41,13 +41,33 @@ namespace dp
       DP_CULLING_API static ResultBitSetSharedPtr create( GroupBitSetSharedPtr const& parentGroup );
       DP_CULLING_API virtual ~ResultBitSet();
 
+      /** \brief Get the objects whose visibility has changed during the last update. The list is built on the first call
+                 after an update. Use getChangedIndices or getChangedIds to avoid the reference counting of the objects.
+                 Objects removed from the group after the update are not reported.
+      **/
       DP_CULLING_API std::vector<ObjectSharedPtr> const & getChangedObjects() const;
 
+      /** \brief Get the group indices of the objects whose visibility has changed during the last update.
+                 The indices follow the objects moved by a removal from the group. Removed objects are dropped from the list.
+      **/
+      std::vector<uint32_t> const & getChangedIndices() const;
+
+      /** \brief Write the user ids of the objects whose visibility has changed during the last update into changedIds.
+                 changedIds is cleared first and keeps its capacity so that it can be reused without allocations.
+                 Objects removed from the group after the update are not reported.
+      **/
+      DP_CULLING_API void getChangedIds( std::vector<uint32_t> & changedIds ) const;
+
       /** \brief Update the group of changed objects.
           \param visibility is a bitmask where the visibility for object i is specified in bit i
+          \remarks The changed objects are determined by comparing whole words of the previous and the new visibility.
+                   No memory is allocated unless the group has grown or more objects have changed than ever before.
       **/
       DP_CULLING_API void updateChanged( uint32_t const* visibility );
 
+      /** \brief Keep the visibility of all objects and report that no object has changed since the last update **/
+      DP_CULLING_API void clearChanged();
+
       DP_CULLING_API virtual void onNotify( dp::util::Event const& event, dp::util::Payload* payload );
       DP_CULLING_API virtual void onDestroyed( dp::util::Subject const& subject, dp::util::Payload* payload );
 
@@ -58,21 +78,30 @@ namespace dp
 
     private:
       GroupBitSetSharedPtr m_groupParent;
-      std::vector<ObjectSharedPtr> m_changedObjects;
+      std::vector<uint32_t>                m_changedIndices;
+      mutable std::vector<ObjectSharedPtr> m_changedObjects;
+      mutable bool                         m_changedObjectsValid;
 
       size_t m_objectIncarnation;
       bool   m_groupChanged;
 
-      dp::util::BitArray m_results;
+      // visibility of the last update with one bit per object in the same layout as the visibility passed to updateChanged
+      std::vector<uint32_t> m_results;
+      size_t                m_numberOfResults;
    };
 
+    inline std::vector<uint32_t> const & ResultBitSet::getChangedIndices() const
+    {
+      return m_changedIndices;
+    }
+
     inline bool ResultBitSet::isVisible( ObjectBitSetSharedPtr const & object )
     {
       size_t groupIndex = object->getGroupIndex();
       DP_ASSERT( groupIndex != ~0 );
       // DP_ASSERT( m_groupParent->m_objects[groupIndex] == objectImpl ); befriend GroupBitSet with ResultBitSet?
 
-      return (groupIndex < m_results.getSize()) ? m_results.getBit( groupIndex ) : true;
+      return (groupIndex < m_numberOfResults) ? !!(m_results[groupIndex / 32] & (1u << (groupIndex & 31))) : true;
     }
 
   } // namespace culling
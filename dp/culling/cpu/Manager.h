@@ -28,6 +28,8 @@
 
 #include <dp/culling/Config.h>
 #include <dp/culling/ManagerBitSet.h>
+#include <dp/culling/cpu/OcclusionCulling.h>
+#include <dp/culling/cpu/Volume.h>
 
 namespace dp
 {
@@ -36,10 +38,87 @@ namespace dp
     namespace cpu
     {
 
+      /** \brief Instruction set used by the frustum culling kernel **/
+      enum class KernelType
+      {
+          AUTO    // choose the fastest kernel supported by the CPU
+        , SCALAR
+        , SSE41
+        , AVX2
+      };
+
       class Manager : public dp::culling::ManagerBitSet
       {
       public:
         DP_CULLING_API static Manager* create();
+
+        /** \brief Create a manager which culls a bounding volume hierarchy over the world space boxes of each group.
+                   Subtrees outside of the frustum are rejected and subtrees inside of the frustum are accepted without testing
+                   the objects. The hierarchy is refitted for objects whose matrices have been reported by groupMatrixChanged
+                   and rebuilt when objects are added or removed. The result is identical to the result of the flat manager.
+            \remarks The objects in leaves intersecting the frustum are tested with the scalar kernel, thus the kernel type has no effect.
+        **/
+        DP_CULLING_API static Manager* createBVH();
+
+        /** \brief Choose the instruction set of the culling kernel. If the CPU does not support the requested
+                   instruction set the next best supported one is being used. The default is KernelType::AUTO.
+        **/
+        DP_CULLING_API virtual void setKernelType( KernelType kernelType ) = 0;
+        DP_CULLING_API virtual KernelType getKernelType() const = 0;
+
+        /** \brief Set the number of threads used to update the OBB cache and to cull large groups.
+            \param numberOfThreads Number of threads including the calling thread. 1 culls on the calling thread only,
+                   0 uses one thread per hardware thread. The default is 1.
+            \remarks The result is identical for all thread counts. Each thread computes its own range of 32-bit words
+                     of the visibility mask, thus no synchronization is required.
+        **/
+        DP_CULLING_API virtual void setNumberOfThreads( unsigned int numberOfThreads ) = 0;
+        DP_CULLING_API virtual unsigned int getNumberOfThreads() const = 0;
+
+        /** \brief Enable the temporal plane coherence. Each result remembers the frustum plane which culled an object during the
+                   last cull call and tests this plane first. If the camera moves slowly most culled objects are rejected by the
+                   same plane again at a fraction of the cost of the full test. The result does not depend on this setting.
+                   The temporal coherence is enabled by default.
+            \remarks Independent of this setting a cull call whose view-projection matrix, group and settings did not change since
+                     the last cull of the same result keeps the result and reports no changed objects.
+        **/
+        DP_CULLING_API virtual void setTemporalCoherence( bool enabled ) = 0;
+        DP_CULLING_API virtual bool isTemporalCoherence() const = 0;
+
+        /** \brief Use an object as occluder for the occlusion culling pass.
+            \param object The object to use as occluder.
+            \param occluderBox Box in object space which is completely covered by the geometry of the object.
+                   An invalid box removes the object from the list of occluders.
+        **/
+        DP_CULLING_API virtual void objectSetOccluder( ObjectSharedPtr const & object, dp::math::Box3f const & occluderBox ) = 0;
+
+        /** \brief Enable the occlusion culling pass. After the frustum test the largest visible occluders of the group
+                   are rendered into a depth buffer and visible objects hidden behind them are marked invisible.
+                   The pass is disabled by default.
+        **/
+        DP_CULLING_API virtual void setOcclusionCulling( bool enabled ) = 0;
+        DP_CULLING_API virtual bool isOcclusionCulling() const = 0;
+
+        /** \brief Get the occlusion culling to configure the resolution of the depth buffer and the occluder budget **/
+        DP_CULLING_API virtual OcclusionCulling & getOcclusionCulling() = 0;
+
+        /** \brief Cull a group against a list of volumes, e.g. to find the objects within the range of each light source.
+                   All volumes are tested in a single pass over the cached OBBs of the group.
+            \param group The group which contains the objects to cull
+            \param volumes The volumes to cull against
+            \param visibilities Receives one visibility mask per volume. Bit i of visibilities[v] is set if the object at index i of the group
+                   intersects volumes[v]. The masks are resized to the number of objects and keep their capacity between calls.
+            \remarks The tests are conservative, objects close to the edges of a volume might be reported as intersecting.
+        **/
+        DP_CULLING_API virtual void cullVolumes( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & visibilities ) = 0;
+
+        /** \brief Cull a group against a list of volumes and get the user ids of the objects intersecting each volume.
+            \param group The group which contains the objects to cull
+            \param volumes The volumes to cull against
+            \param objectIds Receives one list per volume with the ids set by objectSetUserId in the order of the group.
+                   The lists keep their capacity between calls.
+        **/
+        DP_CULLING_API virtual void cullVolumesIds( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & objectIds ) = 0;
       };
 
     } // namespace cpu
@@ -0,0 +1,123 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/cpu/Config.h>
+#include <dp/math/Boxnt.h>
+#include <dp/math/Matmnt.h>
+#include <vector>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+      class OBBArray;
+
+      /** \brief Software occlusion culling on the CPU. The largest occluders on screen are rasterized into a low resolution
+                 depth buffer and a max depth hierarchy is built on top of it. Objects whose nearest depth lies behind the
+                 farthest occluder depth in their screen space bounds are occluded.
+                 Occluders are boxes which are completely filled by the geometry of an object, e.g. the inner box of a wall.
+                 Only pixels which are completely covered by an occluder are written and the depth of each pixel is the
+                 farthest depth of the occluder within the pixel, thus the test is conservative.
+                 The class requires only matrices and boxes. The result is deterministic and does not depend on the CPU features.
+      **/
+      class OcclusionCulling
+      {
+      public:
+        struct Occluder
+        {
+          dp::math::Box3f  box;          // object space box which is completely covered by the object
+          dp::math::Mat44f modelMatrix;  // object to world matrix
+        };
+
+        DP_CULLING_API OcclusionCulling( unsigned int width = 256, unsigned int height = 128 );
+        DP_CULLING_API ~OcclusionCulling();
+
+        /** \brief Set the resolution of the depth buffer. The default is 256x128. **/
+        DP_CULLING_API void setResolution( unsigned int width, unsigned int height );
+        DP_CULLING_API unsigned int getWidth() const;
+        DP_CULLING_API unsigned int getHeight() const;
+
+        /** \brief Set the maximum number of occluders being rasterized per frame. The default is 64. **/
+        DP_CULLING_API void setOccluderBudget( unsigned int occluderBudget );
+        DP_CULLING_API unsigned int getOccluderBudget() const;
+
+        /** \brief Select the occluders with the largest screen space area within the budget and render them into the depth buffer.
+                   If the view-projection matrix and the selected occluders did not change since the last call the depth buffer
+                   of the last call is being reused.
+            \param viewProjection The camera/projection matrix
+            \param occluders Candidates for the occluders. Candidates intersecting the near plane are ignored.
+        **/
+        DP_CULLING_API void renderOccluders( dp::math::Mat44f const & viewProjection, std::vector<Occluder> const & occluders );
+
+        /** \brief Returns true if the last call to renderOccluders reused the depth buffer of the previous call **/
+        DP_CULLING_API bool isDepthBufferReused() const;
+
+        /** \brief Test if a box is hidden behind the occluders of the last call to renderOccluders **/
+        DP_CULLING_API bool isOccluded( dp::math::Box3f const & box, dp::math::Mat44f const & modelMatrix ) const;
+
+        /** \brief Disable the visibility bits of all occluded OBBs. Only OBBs whose visibility bit is set are tested. **/
+        void cull( OBBArray const & obbs, uint32_t * visibility ) const;
+
+        /** \brief Get the depth values of a level of the depth hierarchy. Level 0 has the full resolution, each further level
+                   stores the maximum depth of 2x2 texels of the previous level. Depth values are in the range [0,1].
+        **/
+        DP_CULLING_API float const * getDepthBuffer( unsigned int level, unsigned int & width, unsigned int & height ) const;
+        DP_CULLING_API unsigned int getNumberOfLevels() const;
+
+      private:
+        struct Level
+        {
+          unsigned int       width;
+          unsigned int       height;
+          std::vector<float> depth;
+        };
+
+        bool projectCorners( float const clip[8][4], float screen[8][3] ) const;
+        void rasterizeQuad( float const screen[8][3], unsigned int const indices[4] );
+        void buildHierarchy();
+        bool isOccluded( float const clip[8][4] ) const;
+
+      private:
+        unsigned int       m_occluderBudget;
+        std::vector<Level> m_levels;
+
+        dp::math::Mat44f      m_viewProjection;
+        std::vector<Occluder> m_renderedOccluders;
+        bool                  m_valid;
+        bool                  m_reused;
+
+        // temporary data of renderOccluders
+        std::vector<std::pair<float, size_t> > m_candidates;
+        std::vector<Occluder>                  m_selectedOccluders;
+      };
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
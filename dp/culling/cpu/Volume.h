@@ -0,0 +1,116 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/cpu/Config.h>
+#include <dp/math/Matmnt.h>
+#include <dp/math/Vecnt.h>
+#include <cmath>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      /** \brief Convex volume in world space to cull the objects of a group against, e.g. the influence volume of a light source.
+                 Use makeSphereVolume, makeConeVolume and makeBoxVolume to create a volume.
+      **/
+      struct Volume
+      {
+        enum class Type
+        {
+            SPHERE  // point lights
+          , CONE    // spot lights
+          , BOX     // oriented boxes, e.g. area lights, decals or shadow cascades
+        };
+
+        Type            type;
+        dp::math::Vec3f position;   // center of the sphere and of the box, apex of the cone
+        dp::math::Vec3f axes[3];    // box: the three half edges. cone: axes[0] is the normalized direction
+        float           radius;     // radius of the sphere, range of the cone measured from the apex
+        float           cosAngle;   // cosine of the half opening angle of the cone
+        float           sinAngle;   // sine of the half opening angle of the cone
+      };
+
+      /** \brief Create a sphere volume, e.g. for a point light with the given range **/
+      inline Volume makeSphereVolume( dp::math::Vec3f const & center, float radius )
+      {
+        DP_ASSERT( 0.0f <= radius );
+
+        Volume volume;
+        volume.type = Volume::Type::SPHERE;
+        volume.position = center;
+        volume.axes[0] = volume.axes[1] = volume.axes[2] = dp::math::Vec3f( 0.0f, 0.0f, 0.0f );
+        volume.radius = radius;
+        volume.cosAngle = 1.0f;
+        volume.sinAngle = 0.0f;
+        return volume;
+      }
+
+      /** \brief Create a cone volume, e.g. for a spot light.
+          \param apex Position of the light
+          \param direction Direction of the cone axis. It does not need to be normalized.
+          \param range Distance from the apex. The volume is the intersection of the cone with the sphere of this radius around the apex.
+          \param halfAngle Angle between the axis and the surface of the cone in radians, at most pi/2
+      **/
+      inline Volume makeConeVolume( dp::math::Vec3f const & apex, dp::math::Vec3f const & direction, float range, float halfAngle )
+      {
+        DP_ASSERT( 0.0f <= range && 0.0f <= halfAngle && halfAngle <= dp::math::PI_HALF );
+
+        Volume volume;
+        volume.type = Volume::Type::CONE;
+        volume.position = apex;
+        volume.axes[0] = direction;
+        volume.axes[0].normalize();
+        volume.axes[1] = volume.axes[2] = dp::math::Vec3f( 0.0f, 0.0f, 0.0f );
+        volume.radius = range;
+        volume.cosAngle = cosf( halfAngle );
+        volume.sinAngle = sinf( halfAngle );
+        return volume;
+      }
+
+      /** \brief Create an oriented box volume from the matrix which transforms the cube [-1,1]^3 into world space **/
+      inline Volume makeBoxVolume( dp::math::Mat44f const & cubeToWorld )
+      {
+        Volume volume;
+        volume.type = Volume::Type::BOX;
+        volume.position = dp::math::Vec3f( cubeToWorld[3][0], cubeToWorld[3][1], cubeToWorld[3][2] );
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+          volume.axes[axis] = dp::math::Vec3f( cubeToWorld[axis][0], cubeToWorld[axis][1], cubeToWorld[axis][2] );
+        }
+        volume.radius = 0.0f;
+        volume.cosAngle = 1.0f;
+        volume.sinAngle = 0.0f;
+        return volume;
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
@@ -0,0 +1,226 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/Config.h>
+#include <dp/culling/cpu/Manager.h>
+#include <dp/math/Matmnt.h>
+#include <dp/util/Memory.h>
+#include <algorithm>
+#include <vector>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      /** \brief Structure of arrays with the world space OBBs of all objects in a group.
+                 Each OBB is stored as corner point and the three edge vectors. Each component has its own stream
+                 which is aligned to a cache line and padded to a multiple of 32 elements. Thus SIMD kernels can process
+                 full batches and full 32-bit words of the visibility mask without any tail handling.
+      **/
+      class OBBArray
+      {
+      public:
+        enum Component
+        {
+            POINT_X, POINT_Y, POINT_Z, POINT_W
+          , EX_X, EX_Y, EX_Z, EX_W
+          , EY_X, EY_Y, EY_Z, EY_W
+          , EZ_X, EZ_Y, EZ_Z, EZ_W
+          , COMPONENT_COUNT
+        };
+
+        enum { PADDING = 32, ALIGNMENT = 64 };
+
+        OBBArray();
+
+        /** \brief Change the number of OBBs in the array. Padding elements are initialized with zero. **/
+        void resize( size_t count );
+
+        /** \brief Number of OBBs in this array **/
+        size_t size() const;
+
+        /** \brief Number of elements in each stream including padding. This is a multiple of PADDING. **/
+        size_t getStride() const;
+
+        void setOBB( size_t index, dp::math::Vec4f const & point, dp::math::Vec4f const & ex, dp::math::Vec4f const & ey, dp::math::Vec4f const & ez );
+
+        float const* getStream( Component component ) const;
+
+      private:
+        size_t m_size;
+        size_t m_stride;
+        std::vector<float, dp::util::AlignedAllocator<float, ALIGNMENT> > m_data;
+      };
+
+      /** \brief Parameters of the small feature culling. An object is small if its projected OBB is smaller than the threshold
+                 in x and in y. Objects which have been small during the last cull use the larger restore size as threshold.
+      **/
+      struct SizeCulling
+      {
+        float      scale[2];      // scale from normalized device coordinates to pixels, half of the viewport size
+        float      minimumSize;   // threshold in pixels for objects which have been visible
+        float      restoreSize;   // threshold in pixels for objects which have been culled by their size
+        uint32_t const * previousSmallObjects;  // one bit per object which is set if the object has been culled by its size during the last cull
+        uint32_t *       smallObjects;          // new state of the objects. Objects outside of the frustum keep their previous state.
+                                                // This may be the same array as previousSmallObjects.
+      };
+
+      //! \brief Value of a rejecting plane for objects which have not been outside of a frustum plane
+      uint8_t const noRejectingPlane = 0xff;
+
+      /** \brief Kernel which culls the OBBs against the frustum of a view-projection matrix.
+          \param obbs The OBBs to cull
+          \param viewProjection The camera/projection matrix
+          \param sizeCulling Parameters of the small feature culling or nullptr if small objects should not be culled.
+          \param rejectingPlanes One byte per object with the frustum plane which culled the object during the last call or
+                 noRejectingPlane. As long as the camera moves slowly most culled objects stay outside of the same plane. Batches
+                 of objects which have all been culled are tested against their last rejecting plane first, which requires only
+                 half of the transformations. The kernel updates the planes of the objects it tests. nullptr disables the test.
+          \param beginWord first 32-bit word of the visibility mask to compute. Word i contains the visibility of the objects [32*i, 32*i+31].
+          \param endWord One past the last 32-bit word of the visibility mask to compute.
+          \param visibility Visibility mask. Only the words in the range [beginWord, endWord) are being written.
+          \remarks All kernels produce bit-identical results for the same input. The rejecting planes are only a hint and do not change the result.
+      **/
+      typedef void (*CullKernel)( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes
+                                , size_t beginWord, size_t endWord, uint32_t * visibility );
+
+      void cullOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility );
+#if defined(DP_ARCH_X86_64)
+      void cullOBBsSSE41( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility );
+      void cullOBBsAVX2( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility );
+
+      /** \brief Plain data view of an OBBArray and the view-projection matrix for the kernels compiled with extended instruction sets.
+          \remarks Those translation units must not call any inline function of another header. The compiler would emit a copy
+                   of that function using the extended instructions, and the linker may pick that copy for the whole program.
+                   The wrappers cullOBBsSSE41 and cullOBBsAVX2 in CullingKernels.cpp fill this structure.
+      **/
+      struct OBBStreams
+      {
+        float const*  streams[OBBArray::COMPONENT_COUNT];
+        size_t        stride;
+        float         viewProjection[4][4];
+      };
+
+      void cullOBBStreamsSSE41( OBBStreams const & obbs, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility );
+      void cullOBBStreamsAVX2( OBBStreams const & obbs, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility );
+#endif
+
+      /** \brief Cull a list of OBBs with the scalar kernel and enable the visibility bits of the visible ones.
+          \param indices Indices of the OBBs to test.
+          \param count Number of indices.
+          \param visibility Visibility mask. Bits of invisible OBBs are not being touched.
+      **/
+      void cullOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, uint32_t const * indices, size_t count, uint32_t * visibility );
+
+      /** \brief Apply the small feature culling to the objects which are marked visible in the range [beginWord, endWord) of the
+                 visibility mask. The result is identical to culling the OBBs with the small feature culling enabled in the kernel.
+      **/
+      void cullSmallOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const & sizeCulling, size_t beginWord, size_t endWord, uint32_t * visibility );
+
+      //! \brief Number of visibility words whose objects are tested against all volumes before continuing with the next block
+      size_t const volumeBlockWords = 16;
+
+      /** \brief Cull the OBBs against a list of convex volumes. The OBBs are processed in blocks of volumeBlockWords words. The data
+                 derived from the OBBs of a block, like the center and the face normals, is computed once and shared by all volumes.
+          \param volumes Array with numberOfVolumes volumes.
+          \param beginWord First 32-bit word of the visibility masks to compute.
+          \param endWord One past the last 32-bit word of the visibility masks to compute.
+          \param visibilities Array with the visibility mask of each volume. Only the words in the range [beginWord, endWord) are being written.
+          \remarks The tests are conservative, objects close to the edges of a volume might be reported as visible even if they do not
+                   intersect the volume. The OBBs must have been transformed with affine matrices.
+      **/
+      void cullOBBsVolumes( OBBArray const & obbs, Volume const * volumes, size_t numberOfVolumes, size_t beginWord, size_t endWord, uint32_t * const * visibilities );
+
+      /** \brief Get the kernel for the given type. If the CPU does not support the requested
+                 instruction set the next best supported kernel is being returned.
+      **/
+      CullKernel getCullKernel( KernelType kernelType );
+
+      /************************************************************************/
+      /* Inline functions                                                     */
+      /************************************************************************/
+      inline OBBArray::OBBArray()
+        : m_size( 0 )
+        , m_stride( 0 )
+      {
+      }
+
+      inline void OBBArray::resize( size_t count )
+      {
+        size_t stride = ( count + PADDING - 1 ) & ~size_t( PADDING - 1 );
+        if ( stride != m_stride )
+        {
+          m_data.clear();
+          m_data.resize( stride * COMPONENT_COUNT, 0.0f );
+          m_stride = stride;
+        }
+        else
+        {
+          // reset the elements which became padding
+          for ( size_t component = 0; component < COMPONENT_COUNT; ++component )
+          {
+            std::fill( m_data.begin() + component * m_stride + count, m_data.begin() + (component + 1) * m_stride, 0.0f );
+          }
+        }
+        m_size = count;
+      }
+
+      inline size_t OBBArray::size() const
+      {
+        return m_size;
+      }
+
+      inline size_t OBBArray::getStride() const
+      {
+        return m_stride;
+      }
+
+      inline void OBBArray::setOBB( size_t index, dp::math::Vec4f const & point, dp::math::Vec4f const & ex, dp::math::Vec4f const & ey, dp::math::Vec4f const & ez )
+      {
+        DP_ASSERT( index < m_size );
+        float * base = m_data.data() + index;
+        for ( unsigned int i = 0; i < 4; ++i )
+        {
+          base[(POINT_X + i) * m_stride] = point[i];
+          base[(EX_X + i) * m_stride] = ex[i];
+          base[(EY_X + i) * m_stride] = ey[i];
+          base[(EZ_X + i) * m_stride] = ez[i];
+        }
+      }
+
+      inline float const* OBBArray::getStream( Component component ) const
+      {
+        return m_data.data() + component * m_stride;
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
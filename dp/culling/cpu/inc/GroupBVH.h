@@ -0,0 +1,125 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/cpu/inc/GroupCPU.h>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      /************************************************************************/
+      /* GroupBVH                                                             */
+      /* Group with a bounding volume hierarchy over the cached OBBs          */
+      /************************************************************************/
+      DEFINE_PTR_TYPES( GroupBVH );
+
+      class GroupBVH : public GroupCPU
+      {
+      public:
+        static GroupBVHSharedPtr create();
+
+        /** \brief Bring the hierarchy up to date. The hierarchy is rebuilt if objects have been added or removed or if the
+                   quality of the refitted hierarchy degraded too much. Moved objects only refit the nodes above them.
+        **/
+        void updateBVH( dp::util::ThreadPool * threadPool );
+
+        /** \brief Compute the visibility of all objects. Subtrees outside of the frustum are rejected and subtrees inside of the frustum
+                   are accepted without testing the objects. Only objects in leaves intersecting the frustum are tested individually.
+            \param viewProjection The camera/projection matrix
+            \param visibility Visibility mask with one bit per object. The mask must be large enough for all objects.
+        **/
+        void cull( dp::math::Mat44f const & viewProjection, uint32_t * visibility );
+
+      protected:
+        GroupBVH();
+
+      private:
+        /** \brief Node of the hierarchy. Nodes are stored in depth-first order, thus the left child of an inner node is the next node.
+                   Each node references the range [firstObject, firstObject + objectCount) in m_objectIndices.
+        **/
+        struct Node
+        {
+          float    lower[4];
+          float    upper[4];
+          uint32_t firstObject;
+          uint32_t objectCount;
+          uint32_t rightChild; // 0 for leaf nodes
+          uint32_t parent;
+        };
+
+        /** \brief Bounds of an object in homogeneous world space. w is part of the bounds so that arbitrary matrices are supported. **/
+        struct Bounds
+        {
+          float lower[4];
+          float upper[4];
+        };
+
+        //! \brief Object center (times two) and index used during the build
+        struct BuildItem
+        {
+          float    center[3];
+          uint32_t objectIndex;
+        };
+
+        void computeBounds( size_t objectIndex );
+        void build();
+        void buildNode( uint32_t parent, uint32_t firstObject, uint32_t objectCount );
+        void buildTransformObjects();
+        void refitAll();
+        void refitNode( uint32_t nodeIndex );
+        void cullNode( uint32_t nodeIndex, unsigned int planeMask, uint32_t * visibility );
+        void acceptNode( Node const & node, uint32_t * visibility ) const;
+        static float computeArea( Node const & node );
+
+      private:
+        std::vector<Node>      m_nodes;
+        std::vector<Bounds>    m_bounds;                 // bounds per object
+        std::vector<BuildItem> m_buildItems;
+        std::vector<uint32_t>  m_objectIndices;          // object indices in leaf order
+        std::vector<uint32_t>  m_objectLeaf;             // leaf node for each object
+        std::vector<uint32_t>  m_transformObjectOffsets; // objects using transform i are m_transformObjects[offset[i], offset[i+1])
+        std::vector<uint32_t>  m_transformObjects;
+        std::vector<uint32_t>  m_dirtyNodes;
+        std::vector<char>      m_nodeDirty;
+
+        size_t m_objectIncarnationBVH;
+        double m_area;       // sum of the surface area of all nodes
+        double m_buildArea;  // sum of the surface area of all nodes after the last build
+
+        // per cull temporary data
+        float                 m_planes[6][4];
+        float                 m_planeTolerance[6][4];
+        std::vector<uint32_t> m_partialObjects;         // objects in leaves intersecting the frustum
+      };
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
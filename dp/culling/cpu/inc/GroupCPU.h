@@ -0,0 +1,127 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/GroupBitSet.h>
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <dp/culling/cpu/inc/ObjectCPU.h>
+#include <dp/util/ThreadPool.h>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      // Minimum amount of work per task when culling with multiple threads. Smaller groups are culled on the calling thread.
+      size_t const minObjectsPerTask = 16384;
+
+      // Number of visibility words which are culled against all views before continuing with the next block of objects.
+      // The OBBs of 128 words (4096 objects) take 256kb and stay in the L2 cache for all views.
+      size_t const viewBlockWords = 128;
+
+      typedef std::vector<uint32_t, dp::util::AlignedAllocator<uint32_t, 64> > VisibilityArray;
+
+      /************************************************************************/
+      /* GroupCPU                                                             */
+      /* This group stores the cached OBB for each object                     */
+      /************************************************************************/
+      DEFINE_PTR_TYPES( GroupCPU );
+
+      class GroupCPU : public GroupBitSet
+      {
+      public:
+        static GroupCPUSharedPtr create();
+
+        /** \brief Update the OBB cache if required. If threadPool is not nullptr the update is distributed over the threads of the pool. **/
+        void updateOBBs( dp::util::ThreadPool * threadPool );
+
+        OBBArray const & getOBBs() const;
+
+        /** \brief Visibility buffer with one bit per object, kept per group to avoid an allocation per cull call **/
+        VisibilityArray & getVisibility();
+
+        /** \brief Get the indices of all objects which are occluders **/
+        std::vector<uint32_t> const & getOccluders();
+        void setOccludersDirty();
+
+        /** \brief Get the world matrix of the object at the given group index **/
+        dp::math::Mat44f const & getObjectMatrix( size_t index ) const;
+
+      protected:
+        GroupCPU();
+
+        /** \brief Update the cached OBB of the object at the given group index. The OBB array must have the size of the group. **/
+        void updateOBB( size_t index );
+
+      private:
+        void updateOBBs( size_t begin, size_t end );
+
+      private:
+        OBBArray m_obbs;
+        size_t m_objectIncarnationOBB;
+        VisibilityArray m_visibility;
+
+        std::vector<uint32_t> m_occluders;
+        size_t                m_objectIncarnationOccluders;
+        bool                  m_occludersDirty;
+      };
+
+      inline OBBArray const & GroupCPU::getOBBs() const
+      {
+        return m_obbs;
+      }
+
+      inline VisibilityArray & GroupCPU::getVisibility()
+      {
+        return m_visibility;
+      }
+
+      inline void GroupCPU::setOccludersDirty()
+      {
+        m_occludersDirty = true;
+        ++m_inputIncarnation;
+      }
+
+      inline dp::math::Mat44f const & GroupCPU::getObjectMatrix( size_t index ) const
+      {
+        return reinterpret_cast<dp::math::Mat44f const &>( *(reinterpret_cast<char const*>( getMatrices() ) + getObject( index )->getTransformIndex() * getMatricesStride()) );
+      }
+
+      inline void GroupCPU::updateOBB( size_t index )
+      {
+        ObjectBitSetSharedPtr const & objectImpl = getObject( index );
+        dp::math::Mat44f const & modelView = getObjectMatrix( index );
+        dp::math::Vec4f const & extent = objectImpl->getExtent();
+
+        m_obbs.setOBB( index, objectImpl->getLowerLeft() * modelView, extent[0] * modelView[0], extent[1] * modelView[1], extent[2] * modelView[2] );
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
@@ -28,6 +28,11 @@
 
 #include <dp/culling/Config.h>
 #include <dp/culling/ManagerBitSet.h>
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <dp/culling/cpu/inc/GroupCPU.h>
+#include <dp/culling/cpu/inc/ResultCPU.h>
+#include <dp/util/ThreadPool.h>
+#include <memory>
 
 namespace dp
 {
@@ -74,6 +79,72 @@ namespace dp
         virtual ResultSharedPtr groupCreateResult( GroupSharedPtr const& group );
 
         virtual void cull( const GroupSharedPtr& group, const ResultSharedPtr& result, const dp::math::Mat44f& viewProjection );
+        virtual void cullViews( GroupSharedPtr const & group, std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & viewProjections );
+        virtual void cullUnion( GroupSharedPtr const & group, ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & viewProjections );
+
+        virtual void setKernelType( KernelType kernelType );
+        virtual KernelType getKernelType() const;
+
+        virtual void setNumberOfThreads( unsigned int numberOfThreads );
+        virtual unsigned int getNumberOfThreads() const;
+
+        virtual void setTemporalCoherence( bool enabled );
+        virtual bool isTemporalCoherence() const;
+
+        virtual void objectSetOccluder( ObjectSharedPtr const & object, dp::math::Box3f const & occluderBox );
+        virtual void setOcclusionCulling( bool enabled );
+        virtual bool isOcclusionCulling() const;
+        virtual OcclusionCulling & getOcclusionCulling();
+
+        virtual void cullVolumes( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & visibilities );
+        virtual void cullVolumesIds( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & objectIds );
+
+      protected:
+        /** \brief Compute the frustum and size visibility of all objects of the group for multiple views.
+            \param viewProjections Array with numberOfViews view-projection matrices.
+            \param sizeCulling Array with the small feature culling parameters of each view or nullptr if small objects are not being culled.
+            \param rejectingPlanes Array with the rejecting planes of each view or nullptr if the temporal coherence is disabled.
+            \param visibilities Array with the visibility mask of each view.
+        **/
+        virtual void computeVisibility( GroupCPU & group, dp::math::Mat44f const * viewProjections, size_t numberOfViews
+                                      , SizeCulling const * sizeCulling, uint8_t * const * rejectingPlanes, uint32_t * const * visibilities );
+
+        //! \brief Render the visible occluders of the group and disable the visibility bits of occluded objects
+        void cullOccluded( GroupCPU & group, dp::math::Mat44f const & viewProjection, uint32_t * visibility );
+
+        //! \brief Get the parameters of the small feature culling for the result. Returns false if the small feature culling is disabled.
+        bool getSizeCulling( ResultCPU & result, size_t numberOfWords, SizeCulling & sizeCulling );
+
+        //! \brief Resize the temporary per view arrays for the given number of views and visibility words
+        void prepareViews( size_t numberOfViews, size_t numberOfWords );
+
+        //! \brief Compute the visibility masks of the volumes for all objects of the group
+        void computeVolumeVisibility( GroupCPU & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & visibilities );
+
+        //! \brief Store the inputs of a cull call in the result. Returns true if they are identical to the inputs of the last cull call.
+        bool updateCullState( GroupCPU const & group, ResultCPU & result, dp::math::Mat44f const * viewProjections, size_t numberOfViews );
+
+      protected:
+        KernelType m_kernelType;
+        CullKernel m_kernel;
+        std::unique_ptr<dp::util::ThreadPool> m_threadPool;
+        bool m_temporalCoherence;
+        CullState m_cullState; // temporary inputs of the current cull call
+
+        bool                                    m_occlusionCulling;
+        OcclusionCulling                        m_occlusion;
+        std::vector<OcclusionCulling::Occluder> m_occluders; // temporary list of the visible occluders
+
+        // temporary per view data of cullViews and cullUnion
+        std::vector<VisibilityArray> m_viewVisibilities;
+        std::vector<VisibilityArray> m_viewSmallObjects;
+        std::vector<SizeCulling>     m_viewSizeCulling;
+        std::vector<uint32_t*>       m_viewVisibilityWords;
+        std::vector<uint8_t*>        m_viewRejectingPlanes;
+
+        // temporary data of the volume culling
+        std::vector<std::vector<uint32_t> > m_volumeVisibilities;
+        std::vector<uint32_t*>              m_volumeVisibilityWords;
       };
 #endif
 
@@ -0,0 +1,87 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/ObjectBitSet.h>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      DEFINE_PTR_TYPES( ObjectCPU );
+
+      /** \brief Object of the CPU culling managers. In addition to the bounding box it stores an optional occluder box. **/
+      class ObjectCPU : public ObjectBitSet
+      {
+      public:
+        static ObjectCPUSharedPtr create( PayloadSharedPtr const& userData );
+
+        void setOccluderBox( dp::math::Box3f const & occluderBox );
+        dp::math::Box3f const & getOccluderBox() const;
+        bool isOccluder() const;
+
+      protected:
+        ObjectCPU( PayloadSharedPtr const& userData );
+
+      private:
+        dp::math::Box3f m_occluderBox;
+        bool            m_occluder;
+      };
+
+      inline ObjectCPUSharedPtr ObjectCPU::create( PayloadSharedPtr const& userData )
+      {
+        return( std::shared_ptr<ObjectCPU>( new ObjectCPU( userData ) ) );
+      }
+
+      inline ObjectCPU::ObjectCPU( PayloadSharedPtr const& userData )
+        : ObjectBitSet( userData )
+        , m_occluder( false )
+      {
+      }
+
+      inline void ObjectCPU::setOccluderBox( dp::math::Box3f const & occluderBox )
+      {
+        m_occluderBox = occluderBox;
+        m_occluder = dp::math::isValid( occluderBox );
+      }
+
+      inline dp::math::Box3f const & ObjectCPU::getOccluderBox() const
+      {
+        return m_occluderBox;
+      }
+
+      inline bool ObjectCPU::isOccluder() const
+      {
+        return m_occluder;
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
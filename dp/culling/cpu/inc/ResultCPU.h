@@ -0,0 +1,196 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/culling/ResultBitSet.h>
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      /** \brief Inputs of a cull call. A cull call with the same inputs as the last one produces the same result. **/
+      struct CullState
+      {
+        CullState();
+
+        //! \brief Compare all values bitwise
+        bool operator==( CullState const & other ) const;
+
+        std::vector<dp::math::Mat44f> viewProjections;
+        size_t                        inputIncarnation;
+        dp::math::Vec2ui              viewportSize;
+        float                         minimumPixelSize;
+        float                         pixelSizeHysteresis;
+        bool                          occlusionCulling;
+        unsigned int                  occlusionWidth;
+        unsigned int                  occlusionHeight;
+        unsigned int                  occluderBudget;
+      };
+
+      typedef std::vector<uint8_t, dp::util::AlignedAllocator<uint8_t, 64> > RejectingPlaneArray;
+
+      DEFINE_PTR_TYPES( ResultCPU );
+
+      /** \brief Result of the CPU culling managers. In addition to the visibility it stores which objects have been
+                 culled by the small feature culling to apply the hysteresis of the size threshold, the plane which
+                 culled each object for the temporal plane coherence and the inputs of the last cull call.
+      **/
+      class ResultCPU : public ResultBitSet
+      {
+      public:
+        static ResultCPUSharedPtr create( GroupBitSetSharedPtr const& parentGroup );
+
+        /** \brief Get the mask with one bit per object which is set if the object has been culled by its size.
+            \param numberOfWords Number of 32-bit words the mask must have. New words are initialized with zero.
+        **/
+        uint32_t * getSmallObjects( size_t numberOfWords );
+
+        //! \brief Forget which objects have been culled by their size
+        void clearSmallObjects();
+
+        /** \brief Get the plane which culled each object during the last cull of the given view.
+            \param view Index of the view. Results of cullUnion store the planes of each view.
+            \param numberOfObjects Number of objects the array must have. New objects have no rejecting plane.
+        **/
+        uint8_t * getRejectingPlanes( size_t view, size_t numberOfObjects );
+
+        //! \brief Inputs of the last cull call of this result
+        CullState & getCullState();
+
+        virtual void onNotify( dp::util::Event const& event, dp::util::Payload* payload );
+
+      protected:
+        ResultCPU( GroupBitSetSharedPtr const& parentGroup );
+
+      private:
+        std::vector<uint32_t>            m_smallObjects;
+        std::vector<RejectingPlaneArray> m_rejectingPlanes;
+        CullState                        m_cullState;
+      };
+
+      inline CullState::CullState()
+        : inputIncarnation( ~size_t(0) )
+        , viewportSize( 0, 0 )
+        , minimumPixelSize( 0.0f )
+        , pixelSizeHysteresis( 0.0f )
+        , occlusionCulling( false )
+        , occlusionWidth( 0 )
+        , occlusionHeight( 0 )
+        , occluderBudget( 0 )
+      {
+      }
+
+      inline bool CullState::operator==( CullState const & other ) const
+      {
+        // matrices are compared bitwise, the comparison operators of dp::math use an epsilon
+        return viewProjections.size() == other.viewProjections.size()
+            && !memcmp( viewProjections.data(), other.viewProjections.data(), viewProjections.size() * sizeof(dp::math::Mat44f) )
+            && inputIncarnation == other.inputIncarnation
+            && viewportSize[0] == other.viewportSize[0] && viewportSize[1] == other.viewportSize[1]
+            && minimumPixelSize == other.minimumPixelSize
+            && pixelSizeHysteresis == other.pixelSizeHysteresis
+            && occlusionCulling == other.occlusionCulling
+            && occlusionWidth == other.occlusionWidth
+            && occlusionHeight == other.occlusionHeight
+            && occluderBudget == other.occluderBudget;
+      }
+
+      inline ResultCPUSharedPtr ResultCPU::create( GroupBitSetSharedPtr const& parentGroup )
+      {
+        return( std::shared_ptr<ResultCPU>( new ResultCPU( parentGroup ) ) );
+      }
+
+      inline ResultCPU::ResultCPU( GroupBitSetSharedPtr const& parentGroup )
+        : ResultBitSet( parentGroup )
+      {
+      }
+
+      inline uint32_t * ResultCPU::getSmallObjects( size_t numberOfWords )
+      {
+        if ( m_smallObjects.size() < numberOfWords )
+        {
+          m_smallObjects.resize( numberOfWords, 0 );
+        }
+        return m_smallObjects.data();
+      }
+
+      inline void ResultCPU::clearSmallObjects()
+      {
+        m_smallObjects.clear();
+      }
+
+      inline uint8_t * ResultCPU::getRejectingPlanes( size_t view, size_t numberOfObjects )
+      {
+        if ( m_rejectingPlanes.size() <= view )
+        {
+          m_rejectingPlanes.resize( view + 1 );
+        }
+        if ( m_rejectingPlanes[view].size() < numberOfObjects )
+        {
+          m_rejectingPlanes[view].resize( numberOfObjects, noRejectingPlane );
+        }
+        return m_rejectingPlanes[view].data();
+      }
+
+      inline CullState & ResultCPU::getCullState()
+      {
+        return m_cullState;
+      }
+
+      inline void ResultCPU::onNotify( dp::util::Event const& event, dp::util::Payload* payload )
+      {
+        ResultBitSet::onNotify( event, payload );
+
+        // move the small state with the object and clear it at the old location which might be reused by a new object
+        GroupBitSet::Event const& groupEvent = static_cast<GroupBitSet::Event const&>(event);
+        size_t oldIndex = groupEvent.getOldIndex();
+        size_t newIndex = groupEvent.getNewIndex();
+
+        bool culledBySize = false;
+        if ( oldIndex / 32 < m_smallObjects.size() )
+        {
+          uint32_t mask = uint32_t(1) << (oldIndex % 32);
+          culledBySize = !!( m_smallObjects[oldIndex / 32] & mask );
+          m_smallObjects[oldIndex / 32] &= ~mask;
+        }
+        if ( newIndex / 32 < m_smallObjects.size() )
+        {
+          uint32_t mask = uint32_t(1) << (newIndex % 32);
+          m_smallObjects[newIndex / 32] = culledBySize ? ( m_smallObjects[newIndex / 32] | mask ) : ( m_smallObjects[newIndex / 32] & ~mask );
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
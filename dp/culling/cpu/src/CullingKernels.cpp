@@ -0,0 +1,422 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <dp/util/CPUFeatures.h>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      namespace
+      {
+
+        inline void transform( float const m[4][4], float const v[4], float out[4] )
+        {
+          for ( unsigned int j = 0; j < 4; ++j )
+          {
+            out[j] = v[0] * m[0][j] + v[1] * m[1][j] + v[2] * m[2][j] + v[3] * m[3][j];
+          }
+        }
+
+        /** \brief Compute the planes of the frustum the point is outside of. A point can be outside of opposite planes if w <= 0. **/
+        inline unsigned int determineOutsidePlanes( float const p[4] )
+        {
+          unsigned int cf = 0;
+          cf |= ( p[0] <= -p[3] ) ? 0x01 : 0;
+          cf |= ( p[3] <=  p[0] ) ? 0x02 : 0;
+          cf |= ( p[1] <= -p[3] ) ? 0x04 : 0;
+          cf |= ( p[3] <=  p[1] ) ? 0x08 : 0;
+          cf |= ( p[2] <= -p[3] ) ? 0x10 : 0;
+          cf |= ( p[3] <=  p[2] ) ? 0x20 : 0;
+          return cf;
+        }
+
+        inline void add( float const a[4], float const b[4], float out[4] )
+        {
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            out[i] = a[i] + b[i];
+          }
+        }
+
+        inline void getMatrix( dp::math::Mat44f const & viewProjection, float m[4][4] )
+        {
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            for ( unsigned int j = 0; j < 4; ++j )
+            {
+              m[i][j] = viewProjection[i][j];
+            }
+          }
+        }
+
+        inline void getStreams( OBBArray const & obbs, float const* streams[OBBArray::COMPONENT_COUNT] )
+        {
+          for ( unsigned int component = 0; component < OBBArray::COMPONENT_COUNT; ++component )
+          {
+            streams[component] = obbs.getStream( static_cast<OBBArray::Component>(component) );
+          }
+        }
+
+        inline void computeCorners( float const m[4][4], float const* const streams[OBBArray::COMPONENT_COUNT], size_t index, float corners[8][4] )
+        {
+          float v[4][4];
+          for ( unsigned int vector = 0; vector < 4; ++vector )
+          {
+            float input[4];
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              input[i] = streams[vector * 4 + i][index];
+            }
+            transform( m, input, v[vector] );
+          }
+
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            corners[0][i] = v[0][i];
+          }
+          add( corners[0], v[1], corners[1] ); // p + x
+          add( corners[0], v[2], corners[2] ); // p + y
+          add( corners[1], v[2], corners[3] ); // p + x + y
+          add( corners[0], v[3], corners[4] ); // p + z
+          add( corners[1], v[3], corners[5] ); // p + x + z
+          add( corners[2], v[3], corners[6] ); // p + y + z
+          add( corners[3], v[3], corners[7] ); // p + x + y + z
+        }
+
+        /** \brief Compute the planes of the frustum all corners are outside of **/
+        inline unsigned int determineRejectingPlanes( float const corners[8][4] )
+        {
+          unsigned int cfa = ~0u;
+          for ( unsigned int corner = 0; corner < 8; ++corner )
+          {
+            cfa &= determineOutsidePlanes( corners[corner] );
+          }
+          return cfa;
+        }
+
+        inline bool isInFrustum( float const corners[8][4] )
+        {
+          // the object is invisible if all corners are outside of the same plane
+          return !determineRejectingPlanes( corners );
+        }
+
+        /** \brief Get the columns of the view-projection matrix required to test the planes of each axis.
+                   planeColumns[axis][i] contains the elements of row i for the axis and for w.
+        **/
+        inline void getPlaneColumns( float const m[4][4], float planeColumns[3][4][2] )
+        {
+          for ( unsigned int axis = 0; axis < 3; ++axis )
+          {
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              planeColumns[axis][i][0] = m[i][axis];
+              planeColumns[axis][i][1] = m[i][3];
+            }
+          }
+        }
+
+        /** \brief Check if all corners of an OBB are outside of a single frustum plane. Only the two clip space components
+                   required by the plane are being computed. The operations match computeCorners to get bit-identical results.
+        **/
+        inline bool isOutsidePlane( float const planeColumns[3][4][2], float const* const streams[OBBArray::COMPONENT_COUNT], size_t index, unsigned int plane )
+        {
+          float const (&columns)[4][2] = planeColumns[plane / 2];
+
+          // v[vector][0] is the component of the plane axis, v[vector][1] the w component
+          float v[4][2];
+          for ( unsigned int vector = 0; vector < 4; ++vector )
+          {
+            float input[4];
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              input[i] = streams[vector * 4 + i][index];
+            }
+            for ( unsigned int j = 0; j < 2; ++j )
+            {
+              v[vector][j] = input[0] * columns[0][j] + input[1] * columns[1][j] + input[2] * columns[2][j] + input[3] * columns[3][j];
+            }
+          }
+
+          float corners[8][2];
+          for ( unsigned int i = 0; i < 2; ++i )
+          {
+            corners[0][i] = v[0][i];
+            corners[1][i] = corners[0][i] + v[1][i]; // p + x
+            corners[2][i] = corners[0][i] + v[2][i]; // p + y
+            corners[3][i] = corners[1][i] + v[2][i]; // p + x + y
+            corners[4][i] = corners[0][i] + v[3][i]; // p + z
+            corners[5][i] = corners[1][i] + v[3][i]; // p + x + z
+            corners[6][i] = corners[2][i] + v[3][i]; // p + y + z
+            corners[7][i] = corners[3][i] + v[3][i]; // p + x + y + z
+          }
+
+          // test both sides without branches, the side of the planes is hard to predict
+          bool outsideNegative = true;
+          bool outsidePositive = true;
+          for ( unsigned int corner = 0; corner < 8; ++corner )
+          {
+            outsideNegative &= corners[corner][0] <= -corners[corner][1];
+            outsidePositive &= corners[corner][1] <= corners[corner][0];
+          }
+          return ( plane & 1 ) ? outsidePositive : outsideNegative;
+        }
+
+        /** \brief Get the index of the lowest plane in the given mask or noRejectingPlane if the mask is empty **/
+        inline uint8_t getRejectingPlane( unsigned int planes )
+        {
+          for ( uint8_t plane = 0; plane < 6; ++plane )
+          {
+            if ( planes & ( 1 << plane ) )
+            {
+              return plane;
+            }
+          }
+          return noRejectingPlane;
+        }
+
+        /** \brief Check if the projected corners are smaller than the size threshold in x and in y.
+                   The operations match the SIMD kernels to get bit-identical results.
+        **/
+        inline bool isSmall( float const corners[8][4], SizeCulling const & sizeCulling, bool wasSmall )
+        {
+          float lower[2];
+          float upper[2];
+          for ( unsigned int corner = 0; corner < 8; ++corner )
+          {
+            // the projection of an object with corners behind the camera is unbounded
+            if ( !( 0.0f < corners[corner][3] ) )
+            {
+              return false;
+            }
+
+            float invW = 1.0f / corners[corner][3];
+            for ( unsigned int i = 0; i < 2; ++i )
+            {
+              float p = corners[corner][i] * invW;
+              lower[i] = ( corner == 0 || p < lower[i] ) ? p : lower[i];
+              upper[i] = ( corner == 0 || upper[i] < p ) ? p : upper[i];
+            }
+          }
+
+          float threshold = wasSmall ? sizeCulling.restoreSize : sizeCulling.minimumSize;
+          return ( ( upper[0] - lower[0] ) * sizeCulling.scale[0] < threshold ) && ( ( upper[1] - lower[1] ) * sizeCulling.scale[1] < threshold );
+        }
+
+        inline bool isVisible( float const m[4][4], float const* const streams[OBBArray::COMPONENT_COUNT], size_t index )
+        {
+          float corners[8][4];
+          computeCorners( m, streams, index, corners );
+          return isInFrustum( corners );
+        }
+
+      } // namespace anonymous
+
+      void cullOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility )
+      {
+        DP_ASSERT( endWord * 32 <= obbs.getStride() );
+
+        float m[4][4];
+        getMatrix( viewProjection, m );
+
+        float const* streams[OBBArray::COMPONENT_COUNT];
+        getStreams( obbs, streams );
+
+        float planeColumns[3][4][2];
+        getPlaneColumns( m, planeColumns );
+
+        for ( size_t word = beginWord; word < endWord; ++word )
+        {
+          uint32_t bits = 0;
+          uint32_t smallBits = sizeCulling ? sizeCulling->previousSmallObjects[word] : 0;
+          for ( size_t bit = 0; bit < 32; ++bit )
+          {
+            size_t index = word * 32 + bit;
+            if ( rejectingPlanes && rejectingPlanes[index] != noRejectingPlane && isOutsidePlane( planeColumns, streams, index, rejectingPlanes[index] ) )
+            {
+              continue;
+            }
+
+            float corners[8][4];
+            computeCorners( m, streams, index, corners );
+            unsigned int planes = determineRejectingPlanes( corners );
+            if ( rejectingPlanes )
+            {
+              rejectingPlanes[index] = getRejectingPlane( planes );
+            }
+            if ( !planes )
+            {
+              if ( sizeCulling )
+              {
+                uint32_t mask = uint32_t(1) << bit;
+                if ( isSmall( corners, *sizeCulling, !!( smallBits & mask ) ) )
+                {
+                  smallBits |= mask;
+                  continue;
+                }
+                smallBits &= ~mask;
+              }
+              bits |= uint32_t(1) << bit;
+            }
+          }
+          visibility[word] = bits;
+          if ( sizeCulling )
+          {
+            sizeCulling->smallObjects[word] = smallBits;
+          }
+        }
+      }
+
+      void cullOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, uint32_t const * indices, size_t count, uint32_t * visibility )
+      {
+        float m[4][4];
+        getMatrix( viewProjection, m );
+
+        float const* streams[OBBArray::COMPONENT_COUNT];
+        getStreams( obbs, streams );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+          uint32_t index = indices[i];
+          DP_ASSERT( index < obbs.size() );
+          if ( isVisible( m, streams, index ) )
+          {
+            visibility[index / 32] |= uint32_t(1) << (index % 32);
+          }
+        }
+      }
+
+      void cullSmallOBBsScalar( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const & sizeCulling, size_t beginWord, size_t endWord, uint32_t * visibility )
+      {
+        DP_ASSERT( endWord * 32 <= obbs.getStride() );
+
+        float m[4][4];
+        getMatrix( viewProjection, m );
+
+        float const* streams[OBBArray::COMPONENT_COUNT];
+        getStreams( obbs, streams );
+
+        for ( size_t word = beginWord; word < endWord; ++word )
+        {
+          uint32_t bits = visibility[word];
+          uint32_t smallBits = sizeCulling.previousSmallObjects[word];
+          for ( uint32_t remaining = bits; remaining; remaining &= remaining - 1 )
+          {
+            size_t bit = 0;
+            while ( !( remaining & ( uint32_t(1) << bit ) ) )
+            {
+              ++bit;
+            }
+
+            uint32_t mask = uint32_t(1) << bit;
+            float corners[8][4];
+            computeCorners( m, streams, word * 32 + bit, corners );
+            if ( isSmall( corners, sizeCulling, !!( smallBits & mask ) ) )
+            {
+              smallBits |= mask;
+              bits &= ~mask;
+            }
+            else
+            {
+              smallBits &= ~mask;
+            }
+          }
+          visibility[word] = bits;
+          sizeCulling.smallObjects[word] = smallBits;
+        }
+      }
+
+#if defined(DP_ARCH_X86_64)
+      namespace
+      {
+        void getOBBStreams( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, OBBStreams & obbStreams )
+        {
+          for ( unsigned int component = 0; component < OBBArray::COMPONENT_COUNT; ++component )
+          {
+            obbStreams.streams[component] = obbs.getStream( static_cast<OBBArray::Component>(component) );
+          }
+          obbStreams.stride = obbs.getStride();
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            for ( unsigned int j = 0; j < 4; ++j )
+            {
+              obbStreams.viewProjection[i][j] = viewProjection[i][j];
+            }
+          }
+        }
+      }
+
+      void cullOBBsSSE41( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility )
+      {
+        OBBStreams obbStreams;
+        getOBBStreams( obbs, viewProjection, obbStreams );
+        cullOBBStreamsSSE41( obbStreams, sizeCulling, rejectingPlanes, beginWord, endWord, visibility );
+      }
+
+      void cullOBBsAVX2( OBBArray const & obbs, dp::math::Mat44f const & viewProjection, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility )
+      {
+        OBBStreams obbStreams;
+        getOBBStreams( obbs, viewProjection, obbStreams );
+        cullOBBStreamsAVX2( obbStreams, sizeCulling, rejectingPlanes, beginWord, endWord, visibility );
+      }
+#endif
+
+      CullKernel getCullKernel( KernelType kernelType )
+      {
+#if defined(DP_ARCH_X86_64)
+        bool avx2 = dp::util::isAVX2Supported();
+        bool sse41 = dp::util::isSSE41Supported();
+
+        switch ( kernelType )
+        {
+        case KernelType::AUTO:
+        case KernelType::AVX2:
+          if ( avx2 )
+          {
+            return &cullOBBsAVX2;
+          }
+          // fall through
+        case KernelType::SSE41:
+          if ( sse41 )
+          {
+            return &cullOBBsSSE41;
+          }
+          // fall through
+        default:
+          return &cullOBBsScalar;
+        }
+#else
+        return &cullOBBsScalar;
+#endif
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
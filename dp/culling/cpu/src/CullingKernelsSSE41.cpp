@@ -0,0 +1,318 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/inc/CullingKernels.h>
+
+#if defined(DP_ARCH_X86_64)
+
+#include <smmintrin.h>
+#include <cstring>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      namespace
+      {
+
+        inline void transform( __m128 const m[4][4], __m128 const v[4], __m128 out[4] )
+        {
+          for ( unsigned int j = 0; j < 4; ++j )
+          {
+            out[j] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( v[0], m[0][j] ), _mm_mul_ps( v[1], m[1][j] ) ), _mm_mul_ps( v[2], m[2][j] ) ), _mm_mul_ps( v[3], m[3][j] ) );
+          }
+        }
+
+        inline void add( __m128 const a[4], __m128 const b[4], __m128 out[4] )
+        {
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            out[i] = _mm_add_ps( a[i], b[i] );
+          }
+        }
+
+        /** \brief Accumulate for each plane if all corners seen so far are outside of the plane **/
+        inline void determineOutsidePlanes( __m128 const p[4], __m128 outside[6] )
+        {
+          __m128 negW = _mm_xor_ps( p[3], _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) ) );
+          outside[0] = _mm_and_ps( outside[0], _mm_cmple_ps( p[0], negW ) );
+          outside[1] = _mm_and_ps( outside[1], _mm_cmple_ps( p[3], p[0] ) );
+          outside[2] = _mm_and_ps( outside[2], _mm_cmple_ps( p[1], negW ) );
+          outside[3] = _mm_and_ps( outside[3], _mm_cmple_ps( p[3], p[1] ) );
+          outside[4] = _mm_and_ps( outside[4], _mm_cmple_ps( p[2], negW ) );
+          outside[5] = _mm_and_ps( outside[5], _mm_cmple_ps( p[3], p[2] ) );
+        }
+
+        /** \brief Accumulate the bounds of the projected corners and if all corners are in front of the camera **/
+        inline void updateProjectedBounds( __m128 const p[4], __m128 lower[2], __m128 upper[2], __m128 & inFront )
+        {
+          inFront = _mm_and_ps( inFront, _mm_cmplt_ps( _mm_setzero_ps(), p[3] ) );
+          __m128 invW = _mm_div_ps( _mm_set1_ps( 1.0f ), p[3] );
+          for ( unsigned int i = 0; i < 2; ++i )
+          {
+            __m128 projected = _mm_mul_ps( p[i], invW );
+            lower[i] = _mm_min_ps( projected, lower[i] );
+            upper[i] = _mm_max_ps( projected, upper[i] );
+          }
+        }
+
+        /** \brief Load the rejecting planes of a batch of objects **/
+        inline __m128i loadPlanes( uint8_t const * rejectingPlanes )
+        {
+          int planes;
+          memcpy( &planes, rejectingPlanes, sizeof(planes) );
+          return _mm_cvtepu8_epi32( _mm_cvtsi32_si128( planes ) );
+        }
+
+        /** \brief Store the rejecting planes of a batch of objects **/
+        inline void storePlanes( uint8_t * rejectingPlanes, __m128i planes )
+        {
+          __m128i packed = _mm_packus_epi32( planes, planes );
+          int value = _mm_cvtsi128_si32( _mm_packus_epi16( packed, packed ) );
+          memcpy( rejectingPlanes, &value, sizeof(value) );
+        }
+
+        /** \brief Check for each lane if all corners of the OBB are outside of the frustum plane given for the lane. Only the two
+                   clip space components required by the planes are being computed. The operations match the full test to get
+                   bit-identical results.
+        **/
+        inline __m128 isOutsidePlane( __m128 const m[4][4], float const* const streams[OBBArray::COMPONENT_COUNT], size_t index, __m128i planes )
+        {
+          __m128i axis = _mm_srli_epi32( planes, 1 );
+          __m128 useY = _mm_castsi128_ps( _mm_cmpeq_epi32( axis, _mm_set1_epi32( 1 ) ) );
+          __m128 useZ = _mm_castsi128_ps( _mm_cmpeq_epi32( axis, _mm_set1_epi32( 2 ) ) );
+          __m128 positive = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( planes, _mm_set1_epi32( 1 ) ), _mm_set1_epi32( 1 ) ) );
+
+          __m128 mAxis[4];
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            mAxis[i] = _mm_blendv_ps( _mm_blendv_ps( m[i][0], m[i][1], useY ), m[i][2], useZ );
+          }
+
+          // v[vector][0] is the component of the plane axis, v[vector][1] the w component
+          __m128 v[4][2];
+          for ( unsigned int vector = 0; vector < 4; ++vector )
+          {
+            __m128 input[4];
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              input[i] = _mm_load_ps( streams[vector * 4 + i] + index );
+            }
+            v[vector][0] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( input[0], mAxis[0] ), _mm_mul_ps( input[1], mAxis[1] ) ), _mm_mul_ps( input[2], mAxis[2] ) ), _mm_mul_ps( input[3], mAxis[3] ) );
+            v[vector][1] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( input[0], m[0][3] ), _mm_mul_ps( input[1], m[1][3] ) ), _mm_mul_ps( input[2], m[2][3] ) ), _mm_mul_ps( input[3], m[3][3] ) );
+          }
+
+          __m128 corners[8][2];
+          for ( unsigned int i = 0; i < 2; ++i )
+          {
+            corners[0][i] = v[0][i];
+            corners[1][i] = _mm_add_ps( corners[0][i], v[1][i] ); // p + x
+            corners[2][i] = _mm_add_ps( corners[0][i], v[2][i] ); // p + y
+            corners[3][i] = _mm_add_ps( corners[1][i], v[2][i] ); // p + x + y
+            corners[4][i] = _mm_add_ps( corners[0][i], v[3][i] ); // p + z
+            corners[5][i] = _mm_add_ps( corners[1][i], v[3][i] ); // p + x + z
+            corners[6][i] = _mm_add_ps( corners[2][i], v[3][i] ); // p + y + z
+            corners[7][i] = _mm_add_ps( corners[3][i], v[3][i] ); // p + x + y + z
+          }
+
+          __m128 outside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+          for ( unsigned int corner = 0; corner < 8; ++corner )
+          {
+            __m128 negW = _mm_xor_ps( corners[corner][1], _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) ) );
+            outside = _mm_and_ps( outside, _mm_blendv_ps( _mm_cmple_ps( corners[corner][0], negW ), _mm_cmple_ps( corners[corner][1], corners[corner][0] ), positive ) );
+          }
+          return outside;
+        }
+
+        /** \brief Get the lowest plane each lane is outside of or noRejectingPlane **/
+        inline __m128i getRejectingPlanes( __m128 const outside[6] )
+        {
+          __m128i planes = _mm_set1_epi32( noRejectingPlane );
+          for ( int plane = 5; plane >= 0; --plane )
+          {
+            planes = _mm_blendv_epi8( planes, _mm_set1_epi32( plane ), _mm_castps_si128( outside[plane] ) );
+          }
+          return planes;
+        }
+
+        template <bool sizeCulling, bool coherence>
+        inline void cullOBBs( OBBStreams const & obbs, SizeCulling const * sc, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility )
+        {
+          DP_ASSERT( endWord * 32 <= obbs.stride );
+
+          __m128 m[4][4];
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            for ( unsigned int j = 0; j < 4; ++j )
+            {
+              m[i][j] = _mm_set1_ps( obbs.viewProjection[i][j] );
+            }
+          }
+
+          float const* const* streams = obbs.streams;
+
+          __m128 const allOnes = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+
+          __m128 scale[2], minimumSize, restoreSize;
+          __m128i const laneBits = _mm_setr_epi32( 1, 2, 4, 8 );
+          if ( sizeCulling )
+          {
+            scale[0] = _mm_set1_ps( sc->scale[0] );
+            scale[1] = _mm_set1_ps( sc->scale[1] );
+            minimumSize = _mm_set1_ps( sc->minimumSize );
+            restoreSize = _mm_set1_ps( sc->restoreSize );
+          }
+
+          for ( size_t word = beginWord; word < endWord; ++word )
+          {
+            uint32_t bits = 0;
+            uint32_t smallBits = 0;
+            for ( size_t batch = 0; batch < 32; batch += 4 )
+            {
+              size_t index = word * 32 + batch;
+
+              int previousNone = 0;
+              if ( coherence )
+              {
+                // skip the full test if all objects of the batch are still outside of the plane which culled them the last time
+                __m128i previousPlanes = loadPlanes( rejectingPlanes + index );
+                previousNone = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( previousPlanes, _mm_set1_epi32( noRejectingPlane ) ) ) );
+                if ( !previousNone && _mm_movemask_ps( isOutsidePlane( m, streams, index, previousPlanes ) ) == 0xf )
+                {
+                  // culled objects keep their small state
+                  if ( sizeCulling )
+                  {
+                    smallBits |= sc->previousSmallObjects[word] & ( uint32_t(0xf) << batch );
+                  }
+                  continue;
+                }
+              }
+
+              __m128 v[4][4];
+              for ( unsigned int vector = 0; vector < 4; ++vector )
+              {
+                __m128 input[4];
+                for ( unsigned int i = 0; i < 4; ++i )
+                {
+                  input[i] = _mm_load_ps( streams[vector * 4 + i] + index );
+                }
+                transform( m, input, v[vector] );
+              }
+
+              __m128 outside[6] = { allOnes, allOnes, allOnes, allOnes, allOnes, allOnes };
+              __m128 cx[4], cy[4], cxy[4], c[4];
+
+              // the projected bounds start with the first corner
+              __m128 inFront = allOnes;
+              __m128 lower[2], upper[2];
+              if ( sizeCulling )
+              {
+                __m128 invW = _mm_div_ps( _mm_set1_ps( 1.0f ), v[0][3] );
+                lower[0] = _mm_mul_ps( v[0][0], invW );
+                lower[1] = _mm_mul_ps( v[0][1], invW );
+                upper[0] = lower[0];
+                upper[1] = lower[1];
+                inFront = _mm_cmplt_ps( _mm_setzero_ps(), v[0][3] );
+              }
+
+              determineOutsidePlanes( v[0], outside );                          // p
+              add( v[0], v[1], cx );  determineOutsidePlanes( cx, outside );    // p + x
+              if ( sizeCulling ) { updateProjectedBounds( cx, lower, upper, inFront ); }
+              add( v[0], v[2], cy );  determineOutsidePlanes( cy, outside );    // p + y
+              if ( sizeCulling ) { updateProjectedBounds( cy, lower, upper, inFront ); }
+              add( cx, v[2], cxy );   determineOutsidePlanes( cxy, outside );   // p + x + y
+              if ( sizeCulling ) { updateProjectedBounds( cxy, lower, upper, inFront ); }
+              add( v[0], v[3], c );   determineOutsidePlanes( c, outside );     // p + z
+              if ( sizeCulling ) { updateProjectedBounds( c, lower, upper, inFront ); }
+              add( cx, v[3], c );     determineOutsidePlanes( c, outside );     // p + x + z
+              if ( sizeCulling ) { updateProjectedBounds( c, lower, upper, inFront ); }
+              add( cy, v[3], c );     determineOutsidePlanes( c, outside );     // p + y + z
+              if ( sizeCulling ) { updateProjectedBounds( c, lower, upper, inFront ); }
+              add( cxy, v[3], c );    determineOutsidePlanes( c, outside );     // p + x + y + z
+              if ( sizeCulling ) { updateProjectedBounds( c, lower, upper, inFront ); }
+
+              __m128 culled = _mm_or_ps( _mm_or_ps( _mm_or_ps( outside[0], outside[1] ), _mm_or_ps( outside[2], outside[3] ) ), _mm_or_ps( outside[4], outside[5] ) );
+              if ( coherence && ( previousNone != 0xf || _mm_movemask_ps( culled ) ) )
+              {
+                storePlanes( rejectingPlanes + index, getRejectingPlanes( outside ) );
+              }
+              if ( sizeCulling )
+              {
+                // objects outside of the frustum keep their small state
+                __m128 wasSmall = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( _mm_set1_epi32( int( sc->previousSmallObjects[word] >> batch ) ), laneBits ), laneBits ) );
+                __m128 threshold = _mm_blendv_ps( minimumSize, restoreSize, wasSmall );
+                __m128 isSmall = _mm_and_ps( inFront, _mm_and_ps( _mm_cmplt_ps( _mm_mul_ps( _mm_sub_ps( upper[0], lower[0] ), scale[0] ), threshold )
+                                                               , _mm_cmplt_ps( _mm_mul_ps( _mm_sub_ps( upper[1], lower[1] ), scale[1] ), threshold ) ) );
+                isSmall = _mm_blendv_ps( isSmall, wasSmall, culled );
+                smallBits |= uint32_t( _mm_movemask_ps( isSmall ) ) << batch;
+                culled = _mm_or_ps( culled, isSmall );
+              }
+              bits |= uint32_t( ~_mm_movemask_ps( culled ) & 0xf ) << batch;
+            }
+            visibility[word] = bits;
+            if ( sizeCulling )
+            {
+              sc->smallObjects[word] = smallBits;
+            }
+          }
+        }
+
+      } // namespace anonymous
+
+      void cullOBBStreamsSSE41( OBBStreams const & obbs, SizeCulling const * sizeCulling, uint8_t * rejectingPlanes, size_t beginWord, size_t endWord, uint32_t * visibility )
+      {
+        if ( sizeCulling )
+        {
+          if ( rejectingPlanes )
+          {
+            cullOBBs<true, true>( obbs, sizeCulling, rejectingPlanes, beginWord, endWord, visibility );
+          }
+          else
+          {
+            cullOBBs<true, false>( obbs, sizeCulling, nullptr, beginWord, endWord, visibility );
+          }
+        }
+        else
+        {
+          if ( rejectingPlanes )
+          {
+            cullOBBs<false, true>( obbs, nullptr, rejectingPlanes, beginWord, endWord, visibility );
+          }
+          else
+          {
+            cullOBBs<false, false>( obbs, nullptr, nullptr, beginWord, endWord, visibility );
+          }
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
+
+#endif
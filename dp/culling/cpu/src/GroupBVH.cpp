@@ -0,0 +1,463 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/inc/GroupBVH.h>
+#include <dp/util/FrameProfiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      namespace
+      {
+        // Maximum number of objects in a leaf node
+        uint32_t const maxLeafSize = 8;
+
+        // The hierarchy is rebuilt once refitting increased the sum of the node surface areas by this factor
+        double const rebuildFactor = 2.0;
+
+        // Relative tolerance for the conservative box/plane tests. Boxes within the tolerance of a plane are treated as intersecting,
+        // thus their objects are tested individually with the same kernel the flat culling uses and rounding cannot change the result.
+        float const tolerance = 1e-5f;
+
+        uint32_t const invalidIndex = ~0u;
+      }
+
+      GroupBVHSharedPtr GroupBVH::create()
+      {
+        return( std::shared_ptr<GroupBVH>( new GroupBVH() ) );
+      }
+
+      GroupBVH::GroupBVH()
+        : GroupCPU()
+        , m_objectIncarnationBVH( m_objectIncarnation - 1 )
+        , m_area( 0.0 )
+        , m_buildArea( 0.0 )
+      {
+      }
+
+      void GroupBVH::updateBVH( dp::util::ThreadPool * threadPool )
+      {
+        dp::util::ProfileEntry p("cull::updateBVH");
+
+        bool rebuild = ( m_objectIncarnationBVH != m_objectIncarnation );
+        if ( rebuild || m_objectBoundsDirty || m_matricesChanged )
+        {
+          // all OBBs are potentially invalid
+          setOBBDirty( true );
+          updateOBBs( threadPool );
+
+          m_bounds.resize( m_objects.size() );
+          if ( threadPool && m_objects.size() > minObjectsPerTask )
+          {
+            threadPool->executeRange( 0, m_objects.size(), minObjectsPerTask, 1, [this]( size_t begin, size_t end )
+            {
+              for ( size_t index = begin; index < end; ++index )
+              {
+                computeBounds( index );
+              }
+            } );
+          }
+          else
+          {
+            for ( size_t index = 0; index < m_objects.size(); ++index )
+            {
+              computeBounds( index );
+            }
+          }
+
+          buildTransformObjects();
+
+          if ( rebuild )
+          {
+            build();
+          }
+          else
+          {
+            refitAll();
+          }
+        }
+        else if ( m_obbDirty )
+        {
+          // update the OBBs of the objects referencing a changed matrix and mark their leaves dirty
+          size_t const numberOfTransforms = m_transformObjectOffsets.size() - 1;
+          m_dirtyMatrices.traverseBits( [&]( size_t transformIndex )
+          {
+            if ( transformIndex < numberOfTransforms )
+            {
+              for ( uint32_t offset = m_transformObjectOffsets[transformIndex]; offset < m_transformObjectOffsets[transformIndex + 1]; ++offset )
+              {
+                uint32_t objectIndex = m_transformObjects[offset];
+                updateOBB( objectIndex );
+                computeBounds( objectIndex );
+
+                uint32_t leaf = m_objectLeaf[objectIndex];
+                if ( !m_nodeDirty[leaf] )
+                {
+                  m_nodeDirty[leaf] = true;
+                  m_dirtyNodes.push_back( leaf );
+                }
+              }
+            }
+          } );
+
+          // mark the path to the root dirty
+          size_t numberOfDirtyLeaves = m_dirtyNodes.size();
+          for ( size_t index = 0; index < numberOfDirtyLeaves; ++index )
+          {
+            uint32_t parent = m_nodes[m_dirtyNodes[index]].parent;
+            while ( parent != invalidIndex && !m_nodeDirty[parent] )
+            {
+              m_nodeDirty[parent] = true;
+              m_dirtyNodes.push_back( parent );
+              parent = m_nodes[parent].parent;
+            }
+          }
+
+          // children are stored behind their parent, refit in reverse order to process them first
+          std::sort( m_dirtyNodes.begin(), m_dirtyNodes.end(), std::greater<uint32_t>() );
+          for ( uint32_t nodeIndex : m_dirtyNodes )
+          {
+            m_area -= computeArea( m_nodes[nodeIndex] );
+            refitNode( nodeIndex );
+            m_area += computeArea( m_nodes[nodeIndex] );
+            m_nodeDirty[nodeIndex] = false;
+          }
+          m_dirtyNodes.clear();
+
+          if ( m_area > rebuildFactor * m_buildArea )
+          {
+            build();
+          }
+        }
+
+        m_dirtyMatrices.clear();
+        m_matricesChanged = false;
+        m_objectBoundsDirty = false;
+        m_obbDirty = false;
+      }
+
+      void GroupBVH::computeBounds( size_t objectIndex )
+      {
+        OBBArray const & obbs = getOBBs();
+        Bounds & bounds = m_bounds[objectIndex];
+        for ( unsigned int i = 0; i < 4; ++i )
+        {
+          float point = obbs.getStream( static_cast<OBBArray::Component>( OBBArray::POINT_X + i ) )[objectIndex];
+          float ex = obbs.getStream( static_cast<OBBArray::Component>( OBBArray::EX_X + i ) )[objectIndex];
+          float ey = obbs.getStream( static_cast<OBBArray::Component>( OBBArray::EY_X + i ) )[objectIndex];
+          float ez = obbs.getStream( static_cast<OBBArray::Component>( OBBArray::EZ_X + i ) )[objectIndex];
+
+          // enlarge the bounds by the rounding error of the corner computation
+          float pad = tolerance * ( std::abs( point ) + std::abs( ex ) + std::abs( ey ) + std::abs( ez ) );
+          bounds.lower[i] = point + std::min( ex, 0.0f ) + std::min( ey, 0.0f ) + std::min( ez, 0.0f ) - pad;
+          bounds.upper[i] = point + std::max( ex, 0.0f ) + std::max( ey, 0.0f ) + std::max( ez, 0.0f ) + pad;
+        }
+      }
+
+      void GroupBVH::buildTransformObjects()
+      {
+        size_t const numberOfTransforms = getMatricesCount();
+        m_transformObjectOffsets.assign( numberOfTransforms + 1, 0 );
+        for ( size_t index = 0; index < m_objects.size(); ++index )
+        {
+          size_t transformIndex = m_objects[index]->getTransformIndex();
+          if ( transformIndex < numberOfTransforms )
+          {
+            ++m_transformObjectOffsets[transformIndex + 1];
+          }
+        }
+        for ( size_t index = 0; index < numberOfTransforms; ++index )
+        {
+          m_transformObjectOffsets[index + 1] += m_transformObjectOffsets[index];
+        }
+
+        m_transformObjects.resize( m_transformObjectOffsets.back() );
+        std::vector<uint32_t> offsets( m_transformObjectOffsets.begin(), m_transformObjectOffsets.end() - 1 );
+        for ( size_t index = 0; index < m_objects.size(); ++index )
+        {
+          size_t transformIndex = m_objects[index]->getTransformIndex();
+          if ( transformIndex < numberOfTransforms )
+          {
+            m_transformObjects[offsets[transformIndex]++] = checked_cast<uint32_t>( index );
+          }
+        }
+      }
+
+      void GroupBVH::build()
+      {
+        dp::util::ProfileEntry p("cull::buildBVH");
+
+        uint32_t const numberOfObjects = checked_cast<uint32_t>( m_objects.size() );
+
+        // sort the centers instead of indices into m_bounds to keep the memory accesses of the build local
+        m_buildItems.resize( numberOfObjects );
+        for ( uint32_t index = 0; index < numberOfObjects; ++index )
+        {
+          BuildItem & item = m_buildItems[index];
+          for ( unsigned int i = 0; i < 3; ++i )
+          {
+            item.center[i] = m_bounds[index].lower[i] + m_bounds[index].upper[i];
+          }
+          item.objectIndex = index;
+        }
+
+        m_nodes.clear();
+        m_nodes.reserve( 2 * ( numberOfObjects / maxLeafSize ) + 1 );
+        if ( numberOfObjects )
+        {
+          buildNode( invalidIndex, 0, numberOfObjects );
+        }
+
+        m_objectIndices.resize( numberOfObjects );
+        m_objectLeaf.resize( numberOfObjects );
+        for ( size_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex )
+        {
+          Node const & node = m_nodes[nodeIndex];
+          if ( !node.rightChild )
+          {
+            for ( uint32_t index = node.firstObject; index < node.firstObject + node.objectCount; ++index )
+            {
+              uint32_t objectIndex = m_buildItems[index].objectIndex;
+              m_objectIndices[index] = objectIndex;
+              m_objectLeaf[objectIndex] = checked_cast<uint32_t>( nodeIndex );
+            }
+          }
+        }
+        std::vector<BuildItem>().swap( m_buildItems );
+
+        refitAll();
+
+        m_nodeDirty.assign( m_nodes.size(), false );
+        m_dirtyNodes.clear();
+
+        m_buildArea = m_area;
+        m_objectIncarnationBVH = m_objectIncarnation;
+      }
+
+      void GroupBVH::buildNode( uint32_t parent, uint32_t firstObject, uint32_t objectCount )
+      {
+        uint32_t nodeIndex = checked_cast<uint32_t>( m_nodes.size() );
+        m_nodes.push_back( Node() );
+        m_nodes.back().firstObject = firstObject;
+        m_nodes.back().objectCount = objectCount;
+        m_nodes.back().rightChild = 0;
+        m_nodes.back().parent = parent;
+
+        if ( objectCount > maxLeafSize )
+        {
+          // split in the middle of the axis with the largest extent of the object centers
+          std::vector<BuildItem>::iterator first = m_buildItems.begin() + firstObject;
+          std::vector<BuildItem>::iterator last = first + objectCount;
+
+          float centerLower[3] = {  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max() };
+          float centerUpper[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+          for ( std::vector<BuildItem>::const_iterator it = first; it != last; ++it )
+          {
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              centerLower[i] = std::min( centerLower[i], it->center[i] );
+              centerUpper[i] = std::max( centerUpper[i], it->center[i] );
+            }
+          }
+
+          unsigned int axis = 0;
+          for ( unsigned int i = 1; i < 3; ++i )
+          {
+            if ( centerUpper[i] - centerLower[i] > centerUpper[axis] - centerLower[axis] )
+            {
+              axis = i;
+            }
+          }
+
+          float split = 0.5f * ( centerLower[axis] + centerUpper[axis] );
+          uint32_t leftCount = checked_cast<uint32_t>( std::partition( first, last, [axis, split]( BuildItem const & item ) { return item.center[axis] < split; } ) - first );
+          if ( leftCount == 0 || leftCount == objectCount )
+          {
+            // all centers are at the same position on the axis, split by count
+            leftCount = objectCount / 2;
+          }
+
+          buildNode( nodeIndex, firstObject, leftCount );
+          // the recursion might have reallocated m_nodes, thus access the node by index
+          m_nodes[nodeIndex].rightChild = checked_cast<uint32_t>( m_nodes.size() );
+          buildNode( nodeIndex, firstObject + leftCount, objectCount - leftCount );
+        }
+      }
+
+      void GroupBVH::refitAll()
+      {
+        m_area = 0.0;
+        for ( size_t index = m_nodes.size(); index > 0; --index )
+        {
+          refitNode( checked_cast<uint32_t>( index - 1 ) );
+          m_area += computeArea( m_nodes[index - 1] );
+        }
+      }
+
+      void GroupBVH::refitNode( uint32_t nodeIndex )
+      {
+        Node & node = m_nodes[nodeIndex];
+        if ( node.rightChild )
+        {
+          Node const & left = m_nodes[nodeIndex + 1];
+          Node const & right = m_nodes[node.rightChild];
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            node.lower[i] = std::min( left.lower[i], right.lower[i] );
+            node.upper[i] = std::max( left.upper[i], right.upper[i] );
+          }
+        }
+        else
+        {
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            node.lower[i] = std::numeric_limits<float>::max();
+            node.upper[i] = -std::numeric_limits<float>::max();
+          }
+          for ( uint32_t index = node.firstObject; index < node.firstObject + node.objectCount; ++index )
+          {
+            Bounds const & bounds = m_bounds[m_objectIndices[index]];
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              node.lower[i] = std::min( node.lower[i], bounds.lower[i] );
+              node.upper[i] = std::max( node.upper[i], bounds.upper[i] );
+            }
+          }
+        }
+      }
+
+      float GroupBVH::computeArea( Node const & node )
+      {
+        float dx = node.upper[0] - node.lower[0];
+        float dy = node.upper[1] - node.lower[1];
+        float dz = node.upper[2] - node.lower[2];
+        return 2.0f * ( dx * dy + dy * dz + dz * dx );
+      }
+
+      void GroupBVH::cull( dp::math::Mat44f const & viewProjection, uint32_t * visibility )
+      {
+        dp::util::ProfileEntry p("cull::cullBVH");
+
+        std::fill( visibility, visibility + ( m_objects.size() + 31 ) / 32, 0 );
+        if ( m_nodes.empty() )
+        {
+          return;
+        }
+
+        // A point v is outside of the frustum plane k if dot(v, plane[k]) <= 0. The planes are the sums and differences of the
+        // x, y, z and w columns of the matrix. This is the same condition as x <= -w, w <= x, ... in clip space.
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+          for ( unsigned int side = 0; side < 2; ++side )
+          {
+            float sign = side ? -1.0f : 1.0f;
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              m_planes[2 * axis + side][i] = sign * viewProjection[i][axis] + viewProjection[i][3];
+              m_planeTolerance[2 * axis + side][i] = tolerance * ( std::abs( viewProjection[i][axis] ) + std::abs( viewProjection[i][3] ) );
+            }
+          }
+        }
+
+        m_partialObjects.clear();
+        cullNode( 0, 0x3f, visibility );
+
+        if ( !m_partialObjects.empty() )
+        {
+          cullOBBsScalar( getOBBs(), viewProjection, m_partialObjects.data(), m_partialObjects.size(), visibility );
+        }
+      }
+
+      void GroupBVH::cullNode( uint32_t nodeIndex, unsigned int planeMask, uint32_t * visibility )
+      {
+        Node const & node = m_nodes[nodeIndex];
+
+        for ( unsigned int plane = 0; plane < 6; ++plane )
+        {
+          if ( planeMask & (1 << plane) )
+          {
+            // distance of the corners with the maximum and the minimum distance to the plane
+            float maxDistance = 0.0f;
+            float minDistance = 0.0f;
+            float error = 0.0f;
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              float a = m_planes[plane][i];
+              maxDistance += a * ( a > 0.0f ? node.upper[i] : node.lower[i] );
+              minDistance += a * ( a > 0.0f ? node.lower[i] : node.upper[i] );
+              error += m_planeTolerance[plane][i] * std::max( std::abs( node.lower[i] ), std::abs( node.upper[i] ) );
+            }
+
+            if ( maxDistance < -error )
+            {
+              // all objects of the subtree are outside of this plane
+              return;
+            }
+            if ( minDistance > error )
+            {
+              // all objects of the subtree are inside of this plane, children don't need to test it anymore
+              planeMask &= ~(1 << plane);
+            }
+          }
+        }
+
+        if ( !planeMask )
+        {
+          acceptNode( node, visibility );
+        }
+        else if ( !node.rightChild )
+        {
+          m_partialObjects.insert( m_partialObjects.end(), m_objectIndices.begin() + node.firstObject, m_objectIndices.begin() + node.firstObject + node.objectCount );
+        }
+        else
+        {
+          uint32_t rightChild = node.rightChild;
+          cullNode( nodeIndex + 1, planeMask, visibility );
+          cullNode( rightChild, planeMask, visibility );
+        }
+      }
+
+      void GroupBVH::acceptNode( Node const & node, uint32_t * visibility ) const
+      {
+        for ( uint32_t index = node.firstObject; index < node.firstObject + node.objectCount; ++index )
+        {
+          uint32_t objectIndex = m_objectIndices[index];
+          visibility[objectIndex / 32] |= uint32_t(1) << (objectIndex % 32);
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
@@ -0,0 +1,103 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/inc/GroupCPU.h>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      GroupCPUSharedPtr GroupCPU::create()
+      {
+        return( std::shared_ptr<GroupCPU>( new GroupCPU() ) );
+      }
+
+      GroupCPU::GroupCPU()
+        : GroupBitSet()
+        , m_objectIncarnationOBB( m_objectIncarnation - 1)
+        , m_objectIncarnationOccluders( m_objectIncarnation - 1 )
+        , m_occludersDirty( true )
+      {
+      }
+
+      std::vector<uint32_t> const & GroupCPU::getOccluders()
+      {
+        if ( m_occludersDirty || m_objectIncarnationOccluders != m_objectIncarnation )
+        {
+          m_occluders.clear();
+          for ( size_t index = 0; index < m_objects.size(); ++index )
+          {
+            if ( std::static_pointer_cast<ObjectCPU>( m_objects[index] )->isOccluder() )
+            {
+              m_occluders.push_back( checked_cast<uint32_t>( index ) );
+            }
+          }
+          m_objectIncarnationOccluders = m_objectIncarnation;
+          m_occludersDirty = false;
+        }
+        return m_occluders;
+      }
+
+      void GroupCPU::updateOBBs( dp::util::ThreadPool * threadPool )
+      {
+        m_obbDirty |= (m_objectIncarnationOBB != m_objectIncarnation);
+
+        if ( m_obbDirty )
+        {
+          m_obbs.resize( m_objects.size() );
+
+          if ( threadPool && m_objects.size() > minObjectsPerTask )
+          {
+            // chunks are a multiple of 32 objects so that no two threads write to the same cache line of a stream
+            threadPool->executeRange( 0, m_objects.size(), minObjectsPerTask, OBBArray::PADDING, [this]( size_t begin, size_t end )
+            {
+              updateOBBs( begin, end );
+            } );
+          }
+          else
+          {
+            updateOBBs( 0, m_objects.size() );
+          }
+
+          m_objectIncarnationOBB = m_objectIncarnation;
+          m_obbDirty = false;
+        }
+      }
+
+      void GroupCPU::updateOBBs( size_t begin, size_t end )
+      {
+        for ( size_t index = begin; index < end;++index )
+        {
+          updateOBB( index );
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
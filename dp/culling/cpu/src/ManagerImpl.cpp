@@ -26,23 +26,15 @@
 
 #include <dp/culling/cpu/Manager.h>
 #include <dp/culling/cpu/inc/ManagerImpl.h>
+#include <dp/culling/cpu/inc/GroupCPU.h>
+#include <dp/culling/cpu/inc/ResultCPU.h>
 #include <dp/culling/GroupBitSet.h>
 #include <dp/culling/ObjectBitSet.h>
 #include <dp/culling/ResultBitSet.h>
 #include <dp/util/FrameProfiler.h>
 
-// TODO figure out alignment issues on linux
-#if defined(DP_ARCH_X86_64) && defined(DP_OS_WINDOWS)
-  #define SSE
-#endif
-
-#if defined(SSE)
-#include <dp/math/sse/Vecnt.h>
-#include <dp/math/sse/Matmnt.h>
-static bool useSSE = true;
-#else
-static bool useSSE = false;
-#endif
+#include <algorithm>
+#include <thread>
 
 #if defined(DP_ARCH_ARM_32)
 #define NEON
@@ -63,106 +55,6 @@ namespace dp
     namespace cpu
     {
 
-      namespace {
-
-        struct OBB
-        {
-          dp::math::Vec4f point;
-          dp::math::Vec4f ex;
-          dp::math::Vec4f ey;
-          dp::math::Vec4f ez;
-        };
-
-        /************************************************************************/
-        /* GroupCPU                                                             */
-        /* This group stores the cached OBB for each object                     */
-        /************************************************************************/
-        DEFINE_PTR_TYPES( GroupCPU );
-
-        class GroupCPU : public GroupBitSet
-        {
-        public:
-          static GroupCPUSharedPtr create();
-          void updateOBBs();
-
-          std::vector<OBB> const & getOBBs() const;
-
-        protected:
-          GroupCPU();
-
-        private:
-          std::vector<OBB> m_obbs;
-          size_t m_objectIncarnationOBB;
-        };
-
-        GroupCPUSharedPtr GroupCPU::create()
-        {
-          return( std::shared_ptr<GroupCPU>( new GroupCPU() ) );
-        }
-
-        GroupCPU::GroupCPU()
-          : GroupBitSet()
-          , m_objectIncarnationOBB( m_objectIncarnation - 1)
-        {
-        }
-
-        std::vector<OBB> const & GroupCPU::getOBBs() const
-        {
-          return m_obbs;
-        }
-
-        void GroupCPU::updateOBBs()
-        {
-          m_obbDirty |= (m_objectIncarnationOBB != m_objectIncarnation);
-
-          if ( m_obbDirty )
-          {
-            m_obbs.resize( m_objects.size() );
-
-            char const* basePtr = reinterpret_cast<char const*>( getMatrices() );
-            size_t matricesStride = getMatricesStride();
-
-            for ( size_t index = 0; index < m_objects.size();++index )
-            {
-              OBB &obb = m_obbs[index];
-              ObjectBitSetSharedPtr const & objectImpl = getObject( index );
-              dp::math::Mat44f const & modelView = reinterpret_cast<dp::math::Mat44f const &>(*(basePtr + objectImpl->getTransformIndex() * matricesStride) );
-
-              obb.point = m_objects[index]->getLowerLeft() * modelView;
-
-              dp::math::Vec4f const & extent = m_objects[index]->getExtent();
-
-#if defined(SSE)
-              if ( useSSE )
-              {
-                reinterpret_cast<dp::math::sse::Vec4f&>(obb.ex) = extent[0] * reinterpret_cast<dp::math::sse::Vec4f const&>(modelView[0]);
-                reinterpret_cast<dp::math::sse::Vec4f&>(obb.ey) = extent[1] * reinterpret_cast<dp::math::sse::Vec4f const&>(modelView[1]);
-                reinterpret_cast<dp::math::sse::Vec4f&>(obb.ez) = extent[2] * reinterpret_cast<dp::math::sse::Vec4f const&>(modelView[2]);
-              }
-              else
-#elif defined(NEON)
-                if ( useNEON )
-                {
-                  reinterpret_cast<dp::math::neon::Vec4f&>(obb.ex) = extent[0] * reinterpret_cast<dp::math::neon::Vec4f const&>(modelView[0]);
-                  reinterpret_cast<dp::math::neon::Vec4f&>(obb.ey) = extent[1] * reinterpret_cast<dp::math::neon::Vec4f const&>(modelView[1]);
-                  reinterpret_cast<dp::math::neon::Vec4f&>(obb.ez) = extent[2] * reinterpret_cast<dp::math::neon::Vec4f const&>(modelView[2]);
-                }
-                else
-#endif
-              {
-                obb.ex = extent[0] * modelView[0];
-                obb.ey = extent[1] * modelView[1];
-                obb.ez = extent[2] * modelView[2];
-              }
-            }
-
-            m_objectIncarnationOBB = m_objectIncarnation;
-            m_obbDirty = false;
-          }
-        }
-
-      } // namespace anonymous
-
       /************************************************************************/
       /* ManagerImpl                                                          */
       /************************************************************************/
@@ -173,6 +65,10 @@ namespace dp
       }
 
       ManagerImpl::ManagerImpl()
+        : m_kernelType( KernelType::AUTO )
+        , m_kernel( getCullKernel( KernelType::AUTO ) )
+        , m_temporalCoherence( true )
+        , m_occlusionCulling( false )
       {
       }
 
@@ -183,7 +79,7 @@ namespace dp
 
       ObjectSharedPtr ManagerImpl::objectCreate( PayloadSharedPtr const& userData )
       {
-        return ObjectBitSet::create( userData );
+        return ObjectCPU::create( userData );
       }
 
       GroupSharedPtr ManagerImpl::groupCreate()
@@ -193,195 +89,139 @@ namespace dp
 
       ResultSharedPtr ManagerImpl::groupCreateResult( GroupSharedPtr const& group )
       {
-        return ResultBitSet::create(std::static_pointer_cast<GroupBitSet>(group));
+        return ResultCPU::create(std::static_pointer_cast<GroupBitSet>(group));
       }
 
-      inline void determineCullFlags( const dp::math::Vec4f &p, unsigned int & cfo, unsigned int & cfa )
+      void ManagerImpl::setKernelType( KernelType kernelType )
       {
-        unsigned int cf = 0;
+        m_kernelType = kernelType;
+        m_kernel = getCullKernel( kernelType );
+      }
 
-        if ( p[0] <= -p[3] )
-        {
-          cf |= 0x01;
-        }
-        else if ( p[3] <= p[0] )
-        {
-          cf |= 0x02;
-        }
-        if ( p[1] <= -p[3] )
-        {
-          cf |= 0x04;
-        }
-        else if ( p[3] <= p[1] )
+      KernelType ManagerImpl::getKernelType() const
+      {
+        return m_kernelType;
+      }
+
+      void ManagerImpl::setNumberOfThreads( unsigned int numberOfThreads )
+      {
+        if ( !numberOfThreads )
         {
-          cf |= 0x08;
+          numberOfThreads = std::max( 1u, std::thread::hardware_concurrency() );
         }
-        if ( p[2] <= -p[3] )
+
+        if ( numberOfThreads == 1 )
         {
-          cf |= 0x10;
+          m_threadPool.reset();
         }
-        else if ( p[3] <= p[2] )
+        else if ( !m_threadPool || m_threadPool->getNumberOfThreads() != numberOfThreads )
         {
-          cf |= 0x20;
+          m_threadPool.reset( new dp::util::ThreadPool( numberOfThreads ) );
         }
-        cfo |= cf;
-        cfa &= cf;
       }
 
-      inline bool isVisible( const dp::math::Mat44f& projection, const dp::math::Mat44f &modelView, const dp::math::Vec4f &lower, const dp::math::Vec4f &extent)
+      unsigned int ManagerImpl::getNumberOfThreads() const
       {
-        unsigned int cfo = 0;
-        unsigned int cfa = ~0;
-
-        dp::math::Vec4f vectors[8];
-        vectors[0] = (lower * modelView) * projection;
-
-        dp::math::Vec4f x( extent[0] * modelView[0] );
-        dp::math::Vec4f y( extent[1] * modelView[1] );
-        dp::math::Vec4f z( extent[2] * modelView[2] );
-
-        x = x * projection;
-        y = y * projection;
-        z = z * projection;
-
-        vectors[1] = vectors[0] + x;
-        vectors[2] = vectors[0] + y;
-        vectors[3] = vectors[1] + y;
-        vectors[4] = vectors[0] + z;
-        vectors[5] = vectors[1] + z;
-        vectors[6] = vectors[2] + z;
-        vectors[7] = vectors[3] + z;
-
-        for ( unsigned int i = 0;i < 8; ++i )
-        {
-          determineCullFlags( vectors[i], cfo, cfa );
-        }
-
-        return !cfo || !cfa;
+        return m_threadPool ? m_threadPool->getNumberOfThreads() : 1;
       }
 
-      inline bool isVisible( const dp::math::Mat44f& projection, OBB const & obb)
+      void ManagerImpl::setTemporalCoherence( bool enabled )
       {
-        unsigned int cfo = 0;
-        unsigned int cfa = ~0;
-
-        dp::math::Vec4f vectors[8];
-        vectors[0] = obb.point * projection;
+        m_temporalCoherence = enabled;
+      }
 
-        dp::math::Vec4f x = obb.ex * projection;
-        dp::math::Vec4f y = obb.ey * projection;
-        dp::math::Vec4f z = obb.ez * projection;
+      bool ManagerImpl::isTemporalCoherence() const
+      {
+        return m_temporalCoherence;
+      }
 
-        vectors[1] = vectors[0] + x;
-        vectors[2] = vectors[0] + y;
-        vectors[3] = vectors[1] + y;
-        vectors[4] = vectors[0] + z;
-        vectors[5] = vectors[1] + z;
-        vectors[6] = vectors[2] + z;
-        vectors[7] = vectors[3] + z;
+      void ManagerImpl::objectSetOccluder( ObjectSharedPtr const & object, dp::math::Box3f const & occluderBox )
+      {
+        ObjectCPUSharedPtr const & objectImpl = std::static_pointer_cast<ObjectCPU>(object);
+        objectImpl->setOccluderBox( occluderBox );
 
-        for ( unsigned int i = 0;i < 8; ++i )
+        GroupBitSetSharedPtr group = objectImpl->getGroup();
+        if ( group )
         {
-          determineCullFlags( vectors[i], cfo, cfa );
+          std::static_pointer_cast<GroupCPU>(group)->setOccludersDirty();
         }
-
-        return !cfo || !cfa;
       }
 
-#if defined(SSE)
-      inline void determineCullFlagsSSE( const dp::math::sse::Vec4f& point, unsigned int &cfa )
+      void ManagerImpl::setOcclusionCulling( bool enabled )
       {
-        __m128 homogen = _mm_shuffle_ps( point.sse(), point.sse(), _MM_SHUFFLE( 3,3,3,3 ) );
-
-        // compare each component point with the w coordinate and generate the corresponding bitmask
-        unsigned int mask = _mm_movemask_ps( _mm_cmpgt_ps( point.sse(), homogen ) ) << 4;
-
-        // IEEE 754 specifies that the highest bit of a float is the sign bit. Toggle it to get the negative value.
-        __m128 signBits =  _mm_castsi128_ps(_mm_set1_epi32( 0x80000000 ));
-        __m128 negHomogen = _mm_xor_ps( homogen, signBits );
-
-        mask |= _mm_movemask_ps( _mm_cmpgt_ps( negHomogen, point.sse() ) );
-
-        cfa &= mask;
+        m_occlusionCulling = enabled;
       }
 
-      inline bool isVisibleSSE( const dp::math::sse::Mat44f& projection, const dp::math::sse::Mat44f &modelView, const dp::math::sse::Vec4f &lower, const dp::math::sse::Vec4f &extent)
+      bool ManagerImpl::isOcclusionCulling() const
       {
-        unsigned int cfa = ~0;
+        return m_occlusionCulling;
+      }
 
-        dp::math::sse::Vec4f v = (lower * modelView) * projection;
+      OcclusionCulling & ManagerImpl::getOcclusionCulling()
+      {
+        return m_occlusion;
+      }
 
-        determineCullFlagsSSE( v, cfa); // v
+      void ManagerImpl::cullOccluded( GroupCPU & group, dp::math::Mat44f const & viewProjection, uint32_t * visibility )
+      {
+        // the NEON path does not update the OBB cache
+        group.updateOBBs( m_threadPool.get() );
 
-        // cfa != 0 -> trivial out.
-        // check for trivial out until each plane has one vertex which is not trivial out.
-        if ( cfa )
+        // occluders outside of the frustum cannot hide visible objects
+        std::vector<uint32_t> const & occluders = group.getOccluders();
+        m_occluders.clear();
+        for ( size_t index = 0; index < occluders.size(); ++index )
         {
-          // Compute x,z,y only if the first vertex is trivial out and the other vertices have to be checked.
-          // Compute all of them at once to avoid redundant loads later on.
-          dp::math::sse::Vec4f x( (modelView[0] * extent[0] ) * projection );
-          dp::math::sse::Vec4f y( (modelView[1] * extent[1] ) * projection );
-          dp::math::sse::Vec4f z( (modelView[2] * extent[2] ) * projection );
-          v += x; determineCullFlagsSSE( v, cfa); // v + x
-          if ( cfa )
+          uint32_t objectIndex = occluders[index];
+          if ( visibility[objectIndex / 32] & ( uint32_t(1) << (objectIndex % 32) ) )
           {
-            v += y; determineCullFlagsSSE( v, cfa); // v + x + y
-            if ( cfa )
-            {
-              v -= x; determineCullFlagsSSE( v, cfa); // v + y
-              if ( cfa )
-              {
-                v += z; determineCullFlagsSSE( v, cfa); // v + y + z
-                if ( cfa )
-                {
-                  v += x; determineCullFlagsSSE( v, cfa); // v + x + y + z
-                  if ( cfa )
-                  {
-                    v -= y; determineCullFlagsSSE( v, cfa); // v + x + z
-                    if ( cfa )
-                    {
-                      v -= x; determineCullFlagsSSE( v, cfa); // v + z
-                    }
-                  }
-                }
-              }
-            }
+            OcclusionCulling::Occluder occluder;
+            occluder.box = std::static_pointer_cast<ObjectCPU>( group.getObject( objectIndex ) )->getOccluderBox();
+            occluder.modelMatrix = group.getObjectMatrix( objectIndex );
+            m_occluders.push_back( occluder );
           }
         }
 
-        return !cfa;
+        m_occlusion.renderOccluders( viewProjection, m_occluders );
+        m_occlusion.cull( group.getOBBs(), visibility );
       }
 
-      inline bool isVisibleSSE( dp::math::sse::Mat44f const & projection, OBB const & obb )
+      bool ManagerImpl::getSizeCulling( ResultCPU & result, size_t numberOfWords, SizeCulling & sizeCulling )
       {
-        unsigned int cfa = ~0;
-
-        dp::math::sse::Vec4f v = reinterpret_cast<dp::math::sse::Vec4f const &>(obb.point) * projection;
+        if ( m_minimumPixelSize <= 0.0f || !m_viewportSize[0] || !m_viewportSize[1] )
+        {
+          result.clearSmallObjects();
+          return false;
+        }
 
-        determineCullFlagsSSE( v, cfa); // v
+        sizeCulling.scale[0] = 0.5f * float(m_viewportSize[0]);
+        sizeCulling.scale[1] = 0.5f * float(m_viewportSize[1]);
+        sizeCulling.minimumSize = m_minimumPixelSize;
+        sizeCulling.restoreSize = m_minimumPixelSize * ( 1.0f + m_pixelSizeHysteresis );
+        sizeCulling.smallObjects = result.getSmallObjects( numberOfWords );
+        sizeCulling.previousSmallObjects = sizeCulling.smallObjects;
+        return true;
+      }
 
-        // cfa != 0 -> trivial out.
-        // check for trivial out until each plane has one vertex which is not trivial out.
-        if ( cfa )
+      bool ManagerImpl::updateCullState( GroupCPU const & group, ResultCPU & result, dp::math::Mat44f const * viewProjections, size_t numberOfViews )
+      {
+        m_cullState.viewProjections.assign( viewProjections, viewProjections + numberOfViews );
+        m_cullState.inputIncarnation = group.getInputIncarnation();
+        m_cullState.viewportSize = m_viewportSize;
+        m_cullState.minimumPixelSize = m_minimumPixelSize;
+        m_cullState.pixelSizeHysteresis = m_pixelSizeHysteresis;
+        m_cullState.occlusionCulling = m_occlusionCulling;
+        m_cullState.occlusionWidth = m_occlusionCulling ? m_occlusion.getWidth() : 0;
+        m_cullState.occlusionHeight = m_occlusionCulling ? m_occlusion.getHeight() : 0;
+        m_cullState.occluderBudget = m_occlusionCulling ? m_occlusion.getOccluderBudget() : 0;
+
+        if ( result.getCullState() == m_cullState )
         {
-          // Compute x,z,y only if the first vertex is trivial out and the other vertices have to be checked.
-          // Compute all of them at once to avoid redundant loads later on.
-          dp::math::sse::Vec4f x( reinterpret_cast<dp::math::sse::Vec4f const &>(obb.ex) * projection );
-          dp::math::sse::Vec4f y( reinterpret_cast<dp::math::sse::Vec4f const &>(obb.ey) * projection );
-          dp::math::sse::Vec4f z( reinterpret_cast<dp::math::sse::Vec4f const &>(obb.ez) * projection );
-
-          v += x; determineCullFlagsSSE( v, cfa); // v + x
-          v += y; determineCullFlagsSSE( v, cfa); // v + x + y
-          v -= x; determineCullFlagsSSE( v, cfa); // v + y
-          v += z; determineCullFlagsSSE( v, cfa); // v + y + z
-          v += x; determineCullFlagsSSE( v, cfa); // v + x + y + z
-          v -= y; determineCullFlagsSSE( v, cfa); // v + x + z
-          v -= x; determineCullFlagsSSE( v, cfa); // v + z
+          return true;
         }
-
-        return !cfa;
+        result.getCullState() = m_cullState;
+        return false;
       }
-#endif
 
 #if defined(NEON)
 
@@ -464,57 +304,315 @@ namespace dp
       }
 #endif
 
+      void ManagerImpl::computeVisibility( GroupCPU & group, dp::math::Mat44f const * viewProjections, size_t numberOfViews
+                                         , SizeCulling const * sizeCulling, uint8_t * const * rejectingPlanes, uint32_t * const * visibilities )
+      {
+        size_t const count = group.getObjectCount();
+        size_t const numberOfWords = ( count + 31 ) / 32;
+
+#if defined(NEON)
+        if ( useNEON )
+        {
+          char const* basePtr = reinterpret_cast<char const*>(group.getMatrices());
+          size_t matricesStride = group.getMatricesStride();
+
+          for ( size_t view = 0; view < numberOfViews; ++view )
+          {
+            dp::math::neon::Mat44f vp = *reinterpret_cast<dp::math::neon::Mat44f const*>(&viewProjections[view]);
+            uint32_t * visibility = visibilities[view];
+
+            std::fill( visibility, visibility + numberOfWords, 0 );
+            for ( size_t index = 0;index < count; ++index )
+            {
+              const ObjectBitSetSharedPtr& objectImpl = group.getObject( index );
+              const dp::math::neon::Mat44f &modelView = reinterpret_cast<const dp::math::neon::Mat44f&>(*(basePtr + objectImpl->getTransformIndex() * matricesStride) );
+              bool visible = isVisibleNEON( vp, modelView, *reinterpret_cast<dp::math::neon::Vec4f const*>(&objectImpl->getLowerLeft())
+                                          , *reinterpret_cast<dp::math::neon::Vec4f const*>(&objectImpl->getExtent()) );
+              visibility[index / 32] |= uint32_t(visible) << (index % 32);
+            }
+
+            if ( sizeCulling )
+            {
+              // the NEON path does not use the OBB cache
+              group.updateOBBs( m_threadPool.get() );
+              cullSmallOBBsScalar( group.getOBBs(), viewProjections[view], sizeCulling[view], 0, numberOfWords, visibility );
+            }
+          }
+        }
+        else
+#endif
+        {
+          group.updateOBBs( m_threadPool.get() );
+
+          OBBArray const & obbs = group.getOBBs();
+          CullKernel kernel = m_kernel;
+
+          // Cull small blocks of objects against all views before moving on to the next block. Thus the OBBs of a block are being
+          // loaded from memory only once and stay in the cache for the other views.
+          auto cullRange = [&]( size_t beginWord, size_t endWord )
+          {
+            for ( size_t blockBegin = beginWord; blockBegin < endWord; blockBegin += viewBlockWords )
+            {
+              size_t blockEnd = std::min( blockBegin + viewBlockWords, endWord );
+              for ( size_t view = 0; view < numberOfViews; ++view )
+              {
+                kernel( obbs, viewProjections[view], sizeCulling ? &sizeCulling[view] : nullptr, rejectingPlanes ? rejectingPlanes[view] : nullptr
+                      , blockBegin, blockEnd, visibilities[view] );
+              }
+            }
+          };
+
+          if ( m_threadPool && count > minObjectsPerTask )
+          {
+            // Each task writes its own range of visibility words. Ranges are a multiple of 16 words to keep them on separate cache lines.
+            m_threadPool->executeRange( 0, numberOfWords, minObjectsPerTask / 32, 16, cullRange );
+          }
+          else
+          {
+            cullRange( 0, numberOfWords );
+          }
+        }
+      }
+
       void ManagerImpl::cull( GroupSharedPtr const& group, ResultSharedPtr const& result, const dp::math::Mat44f& viewProjection )
       {
         dp::util::ProfileEntry p("cull");
         GroupCPUSharedPtr const & groupImpl = std::static_pointer_cast<GroupCPU>(group);
+        ResultCPUSharedPtr const & resultImpl = std::static_pointer_cast<ResultCPU>(result);
+
+        // nothing can change if the camera and the group are the same as during the last cull
+        if ( updateCullState( *groupImpl, *resultImpl, &viewProjection, 1 ) )
+        {
+          resultImpl->clearChanged();
+          return;
+        }
+
+        VisibilityArray & visibility = groupImpl->getVisibility();
+        visibility.resize( (groupImpl->getObjectCount() + 31) / 32 );
+
+        SizeCulling sizeCulling;
+        bool useSizeCulling = getSizeCulling( *resultImpl, visibility.size(), sizeCulling );
 
-        groupImpl->updateOBBs();
-        std::vector<OBB> const &obbs = groupImpl->getOBBs();
+        uint8_t * rejectingPlanes = m_temporalCoherence ? resultImpl->getRejectingPlanes( 0, visibility.size() * 32 ) : nullptr;
 
-        // TODO this is an allocation which is potential slow. Keep memory allocated per group?
-        DP_STATIC_ASSERT( sizeof( dp::util::BitArray::BitStorageType) % sizeof(uint32_t) == 0 );
-        dp::util::BitArray visible( groupImpl->getObjectCount() );
+        uint32_t * visibilityWords = visibility.data();
+        computeVisibility( *groupImpl, &viewProjection, 1, useSizeCulling ? &sizeCulling : nullptr, m_temporalCoherence ? &rejectingPlanes : nullptr, &visibilityWords );
 
-        char const* basePtr = reinterpret_cast<char const*>(groupImpl->getMatrices());
-        size_t matricesStride = groupImpl->getMatricesStride();
-        size_t const count = groupImpl->getObjectCount();
+        if ( m_occlusionCulling )
+        {
+          cullOccluded( *groupImpl, viewProjection, visibilityWords );
+        }
+
+        resultImpl->updateChanged( visibilityWords );
+      }
 
-#if defined(SSE)
-        if ( useSSE )
+      void ManagerImpl::cullViews( GroupSharedPtr const & group, std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & viewProjections )
+      {
+        dp::util::ProfileEntry p("cullViews");
+        DP_ASSERT( results.size() == viewProjections.size() );
+        if ( viewProjections.empty() )
         {
-          dp::math::sse::Mat44f vp = *reinterpret_cast<dp::math::sse::Mat44f const*>(&viewProjection);
+          return;
+        }
+
+        GroupCPUSharedPtr const & groupImpl = std::static_pointer_cast<GroupCPU>(group);
+        size_t const numberOfViews = viewProjections.size();
+        size_t const numberOfWords = (groupImpl->getObjectCount() + 31) / 32;
 
-          for ( int index = 0;index < count; ++index )
+        // the views are culled together, thus they can be skipped only if none of them changed
+        bool unchanged = true;
+        for ( size_t view = 0; view < numberOfViews; ++view )
+        {
+          unchanged = updateCullState( *groupImpl, *std::static_pointer_cast<ResultCPU>(results[view]), &viewProjections[view], 1 ) && unchanged;
+        }
+        if ( unchanged )
+        {
+          for ( size_t view = 0; view < numberOfViews; ++view )
           {
-            visible.setBit( index, isVisibleSSE( vp, obbs[index] ) );
+            std::static_pointer_cast<ResultCPU>(results[view])->clearChanged();
           }
+          return;
         }
-        else
-#elif defined(NEON)
-        if ( useNEON )
+
+        prepareViews( numberOfViews, numberOfWords );
+
+        // the small feature culling is either enabled or disabled for all results
+        bool useSizeCulling = false;
+        for ( size_t view = 0; view < numberOfViews; ++view )
         {
-          dp::math::neon::Mat44f vp = *reinterpret_cast<dp::math::neon::Mat44f const*>(&viewProjection);
+          ResultCPU & result = *std::static_pointer_cast<ResultCPU>(results[view]);
+          useSizeCulling = getSizeCulling( result, numberOfWords, m_viewSizeCulling[view] );
+          m_viewRejectingPlanes[view] = m_temporalCoherence ? result.getRejectingPlanes( 0, numberOfWords * 32 ) : nullptr;
+        }
 
-          for ( int index = 0;index < count; ++index )
+        computeVisibility( *groupImpl, viewProjections.data(), numberOfViews, useSizeCulling ? m_viewSizeCulling.data() : nullptr
+                         , m_temporalCoherence ? m_viewRejectingPlanes.data() : nullptr, m_viewVisibilityWords.data() );
+
+        for ( size_t view = 0; view < numberOfViews; ++view )
+        {
+          if ( m_occlusionCulling )
           {
-            const ObjectBitSetSharedPtr& objectImpl = groupImpl->getObject( index );
-            const dp::math::neon::Mat44f &modelView = reinterpret_cast<const dp::math::neon::Mat44f&>(*(basePtr + objectImpl->getTransformIndex() * matricesStride) );
-            visible.setBit( index, isVisibleNEON( vp, modelView, *reinterpret_cast<dp::math::neon::Vec4f const*>(&objectImpl->getLowerLeft())
-              , *reinterpret_cast<dp::math::neon::Vec4f const*>(&objectImpl->getExtent()) ) );
+            cullOccluded( *groupImpl, viewProjections[view], m_viewVisibilityWords[view] );
           }
+          std::static_pointer_cast<ResultCPU>(results[view])->updateChanged( m_viewVisibilityWords[view] );
+        }
+      }
+
+      void ManagerImpl::cullUnion( GroupSharedPtr const & group, ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & viewProjections )
+      {
+        dp::util::ProfileEntry p("cullUnion");
+
+        GroupCPUSharedPtr const & groupImpl = std::static_pointer_cast<GroupCPU>(group);
+        ResultCPUSharedPtr const & resultImpl = std::static_pointer_cast<ResultCPU>(result);
+        size_t const numberOfViews = viewProjections.size();
+        size_t const numberOfWords = (groupImpl->getObjectCount() + 31) / 32;
+
+        if ( updateCullState( *groupImpl, *resultImpl, viewProjections.data(), numberOfViews ) )
+        {
+          resultImpl->clearChanged();
+          return;
+        }
+
+        prepareViews( numberOfViews, numberOfWords );
+
+        // All views start with the small state of the result, but each view writes its own new state.
+        SizeCulling sizeCulling;
+        bool useSizeCulling = getSizeCulling( *resultImpl, numberOfWords, sizeCulling );
+        for ( size_t view = 0; view < numberOfViews; ++view )
+        {
+          m_viewSizeCulling[view] = sizeCulling;
+          m_viewSizeCulling[view].smallObjects = m_viewSmallObjects[view].data();
+          m_viewRejectingPlanes[view] = m_temporalCoherence ? resultImpl->getRejectingPlanes( view, numberOfWords * 32 ) : nullptr;
+        }
+
+        computeVisibility( *groupImpl, viewProjections.data(), numberOfViews, useSizeCulling ? m_viewSizeCulling.data() : nullptr
+                         , m_temporalCoherence ? m_viewRejectingPlanes.data() : nullptr, m_viewVisibilityWords.data() );
+
+        VisibilityArray & visibility = groupImpl->getVisibility();
+        visibility.assign( numberOfWords, 0 );
+        for ( size_t view = 0; view < numberOfViews; ++view )
+        {
+          if ( m_occlusionCulling )
+          {
+            cullOccluded( *groupImpl, viewProjections[view], m_viewVisibilityWords[view] );
+          }
+          for ( size_t word = 0; word < numberOfWords; ++word )
+          {
+            visibility[word] |= m_viewVisibilityWords[view][word];
+          }
+        }
+
+        if ( useSizeCulling )
+        {
+          // An object is small if it has been culled by its size in at least one view and is not visible in any other view
+          for ( size_t word = 0; word < numberOfWords; ++word )
+          {
+            uint32_t smallBits = numberOfViews ? 0 : sizeCulling.previousSmallObjects[word];
+            for ( size_t view = 0; view < numberOfViews; ++view )
+            {
+              smallBits |= m_viewSmallObjects[view][word];
+            }
+            sizeCulling.smallObjects[word] = smallBits & ~visibility[word];
+          }
+        }
+
+        resultImpl->updateChanged( visibility.data() );
+      }
+
+      void ManagerImpl::cullVolumes( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & visibilities )
+      {
+        dp::util::ProfileEntry p("cullVolumes");
+        computeVolumeVisibility( *std::static_pointer_cast<GroupCPU>(group), volumes, visibilities );
+      }
+
+      void ManagerImpl::cullVolumesIds( GroupSharedPtr const & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & objectIds )
+      {
+        dp::util::ProfileEntry p("cullVolumesIds");
+        GroupCPUSharedPtr const & groupImpl = std::static_pointer_cast<GroupCPU>(group);
+        computeVolumeVisibility( *groupImpl, volumes, m_volumeVisibilities );
+
+        objectIds.resize( volumes.size() );
+        for ( size_t volume = 0; volume < volumes.size(); ++volume )
+        {
+          std::vector<uint32_t> & ids = objectIds[volume];
+          ids.clear();
+          std::vector<uint32_t> const & visibility = m_volumeVisibilities[volume];
+          for ( size_t word = 0; word < visibility.size(); ++word )
+          {
+            uint32_t bits = visibility[word];
+            while ( bits )
+            {
+              size_t bit = dp::util::ctz( bits );
+              ids.push_back( groupImpl->getObject( word * 32 + bit )->getUserId() );
+              bits &= bits - 1;
+            }
+          }
+        }
+      }
+
+      void ManagerImpl::computeVolumeVisibility( GroupCPU & group, std::vector<Volume> const & volumes, std::vector<std::vector<uint32_t> > & visibilities )
+      {
+        size_t const count = group.getObjectCount();
+        size_t const numberOfWords = ( count + 31 ) / 32;
+
+        group.updateOBBs( m_threadPool.get() );
+
+        visibilities.resize( volumes.size() );
+        m_volumeVisibilityWords.resize( volumes.size() );
+        for ( size_t volume = 0; volume < volumes.size(); ++volume )
+        {
+          visibilities[volume].resize( numberOfWords );
+          m_volumeVisibilityWords[volume] = visibilities[volume].data();
+        }
+        if ( volumes.empty() || !count )
+        {
+          return;
+        }
+
+        OBBArray const & obbs = group.getOBBs();
+        auto cullRange = [&]( size_t beginWord, size_t endWord )
+        {
+          cullOBBsVolumes( obbs, volumes.data(), volumes.size(), beginWord, endWord, m_volumeVisibilityWords.data() );
+        };
+
+        if ( m_threadPool && count * volumes.size() > minObjectsPerTask )
+        {
+          // each task tests whole blocks of objects against all volumes
+          size_t minWordsPerTask = std::max( volumeBlockWords, minObjectsPerTask / ( 32 * volumes.size() ) );
+          m_threadPool->executeRange( 0, numberOfWords, minWordsPerTask, volumeBlockWords, cullRange );
         }
         else
-#endif
         {
-//#pragma omp parallel for
-          for ( size_t index = 0;index < count; ++index )
+          cullRange( 0, numberOfWords );
+        }
+
+        // the padding OBBs behind the last object might intersect a volume
+        if ( count % 32 )
+        {
+          uint32_t mask = ~( ~0u << ( count % 32 ) );
+          for ( size_t volume = 0; volume < volumes.size(); ++volume )
           {
-            visible.setBit( index, isVisible( viewProjection, obbs[index] ) );
+            visibilities[volume][numberOfWords - 1] &= mask;
           }
         }
+      }
 
-        std::static_pointer_cast<ResultBitSet>(result)->updateChanged( reinterpret_cast<uint32_t const*>( visible.getBits() ) );
+      void ManagerImpl::prepareViews( size_t numberOfViews, size_t numberOfWords )
+      {
+        // the arrays are padded to full cache lines to avoid false sharing between the culling threads
+        size_t paddedWords = ( numberOfWords + 15 ) & ~size_t(15);
+
+        m_viewVisibilities.resize( std::max( m_viewVisibilities.size(), numberOfViews ) );
+        m_viewSmallObjects.resize( std::max( m_viewSmallObjects.size(), numberOfViews ) );
+        m_viewSizeCulling.resize( numberOfViews );
+        m_viewVisibilityWords.resize( numberOfViews );
+        m_viewRejectingPlanes.resize( numberOfViews );
+        for ( size_t view = 0; view < numberOfViews; ++view )
+        {
+          m_viewVisibilities[view].resize( paddedWords );
+          m_viewSmallObjects[view].resize( paddedWords );
+          m_viewVisibilityWords[view] = m_viewVisibilities[view].data();
+        }
       }
 
     } // namespace cpu
@@ -0,0 +1,538 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/OcclusionCulling.h>
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <dp/util/FrameProfiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(DP_ARCH_X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      namespace
+      {
+        // corners of a box are numbered by the bits of the index, bit 0 adds the x edge, bit 1 the y edge and bit 2 the z edge
+        unsigned int const boxFaces[6][4] =
+        {
+            { 0, 1, 3, 2 }, { 4, 5, 7, 6 } // -z, +z
+          , { 0, 1, 5, 4 }, { 2, 3, 7, 6 } // -y, +y
+          , { 0, 2, 6, 4 }, { 1, 3, 7, 5 } // -x, +x
+        };
+
+        inline void transform( dp::math::Mat44f const & m, float const v[4], float out[4] )
+        {
+          for ( unsigned int j = 0; j < 4; ++j )
+          {
+            out[j] = v[0] * m[0][j] + v[1] * m[1][j] + v[2] * m[2][j] + v[3] * m[3][j];
+          }
+        }
+
+        /** \brief Compute the clip space corners of a box given by a corner point and the three edge vectors **/
+        inline void computeCorners( float const p[4], float const ex[4], float const ey[4], float const ez[4], float corners[8][4] )
+        {
+          for ( unsigned int corner = 0; corner < 8; ++corner )
+          {
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+              corners[corner][i] = p[i];
+              if ( corner & 1 ) corners[corner][i] += ex[i];
+              if ( corner & 2 ) corners[corner][i] += ey[i];
+              if ( corner & 4 ) corners[corner][i] += ez[i];
+            }
+          }
+        }
+
+        inline void computeCorners( dp::math::Box3f const & box, dp::math::Mat44f const & modelViewProjection, float corners[8][4] )
+        {
+          dp::math::Vec3f const & lower = box.getLower();
+          dp::math::Vec3f size = box.getSize();
+
+          float const p[4] = { lower[0], lower[1], lower[2], 1.0f };
+          float const x[4] = { size[0], 0.0f, 0.0f, 0.0f };
+          float const y[4] = { 0.0f, size[1], 0.0f, 0.0f };
+          float const z[4] = { 0.0f, 0.0f, size[2], 0.0f };
+
+          float pc[4], xc[4], yc[4], zc[4];
+          transform( modelViewProjection, p, pc );
+          transform( modelViewProjection, x, xc );
+          transform( modelViewProjection, y, yc );
+          transform( modelViewProjection, z, zc );
+          computeCorners( pc, xc, yc, zc, corners );
+        }
+
+        inline bool isEqual( OcclusionCulling::Occluder const & lhs, OcclusionCulling::Occluder const & rhs )
+        {
+          return memcmp( &lhs.box.getLower()[0], &rhs.box.getLower()[0], 3 * sizeof(float) ) == 0
+              && memcmp( &lhs.box.getUpper()[0], &rhs.box.getUpper()[0], 3 * sizeof(float) ) == 0
+              && memcmp( lhs.modelMatrix.getPtr(), rhs.modelMatrix.getPtr(), 16 * sizeof(float) ) == 0;
+        }
+
+        /** \brief Rasterize a span of pixels of a convex polygon. A pixel is written only if it is completely inside of all edges.
+            \param edges Edge functions a * x + b * y + c, the row part b * y + c is already contained in rowEdge.
+            \param margin Minimum value of each edge function at the pixel center for a completely covered pixel.
+            \param depth Depth row of the buffer.
+        **/
+        inline void rasterizeSpan( int begin, int end, float const a[4], float const rowEdge[4], float const margin[4]
+                                 , float dzdx, float rowDepth, float maxDepth, float * depth )
+        {
+          int x = begin;
+#if defined(DP_ARCH_X86_64)
+          __m128 const half = _mm_set1_ps( 0.5f );
+          __m128 const maxZ = _mm_set1_ps( maxDepth );
+          __m128 const slopeZ = _mm_set1_ps( dzdx );
+          __m128 const rowZ = _mm_set1_ps( rowDepth );
+          __m128 edgeA[4], edgeRow[4], edgeMargin[4];
+          for ( unsigned int edge = 0; edge < 4; ++edge )
+          {
+            edgeA[edge] = _mm_set1_ps( a[edge] );
+            edgeRow[edge] = _mm_set1_ps( rowEdge[edge] );
+            edgeMargin[edge] = _mm_set1_ps( margin[edge] );
+          }
+
+          for ( ; x + 4 <= end; x += 4 )
+          {
+            __m128 center = _mm_add_ps( _mm_cvtepi32_ps( _mm_setr_epi32( x, x + 1, x + 2, x + 3 ) ), half );
+
+            __m128 covered = _mm_cmpge_ps( _mm_add_ps( _mm_mul_ps( edgeA[0], center ), edgeRow[0] ), edgeMargin[0] );
+            for ( unsigned int edge = 1; edge < 4; ++edge )
+            {
+              covered = _mm_and_ps( covered, _mm_cmpge_ps( _mm_add_ps( _mm_mul_ps( edgeA[edge], center ), edgeRow[edge] ), edgeMargin[edge] ) );
+            }
+
+            __m128 z = _mm_min_ps( _mm_add_ps( _mm_mul_ps( slopeZ, center ), rowZ ), maxZ );
+            __m128 old = _mm_loadu_ps( depth + x );
+            __m128 result = _mm_min_ps( old, z );
+            _mm_storeu_ps( depth + x, _mm_or_ps( _mm_and_ps( covered, result ), _mm_andnot_ps( covered, old ) ) );
+          }
+#endif
+          for ( ; x < end; ++x )
+          {
+            float center = float(x) + 0.5f;
+            bool covered = true;
+            for ( unsigned int edge = 0; edge < 4; ++edge )
+            {
+              covered &= ( a[edge] * center + rowEdge[edge] >= margin[edge] );
+            }
+            if ( covered )
+            {
+              depth[x] = std::min( depth[x], std::min( dzdx * center + rowDepth, maxDepth ) );
+            }
+          }
+        }
+      }
+
+      OcclusionCulling::OcclusionCulling( unsigned int width, unsigned int height )
+        : m_occluderBudget( 64 )
+        , m_valid( false )
+        , m_reused( false )
+      {
+        setResolution( width, height );
+      }
+
+      OcclusionCulling::~OcclusionCulling()
+      {
+      }
+
+      void OcclusionCulling::setResolution( unsigned int width, unsigned int height )
+      {
+        DP_ASSERT( width && height );
+
+        m_levels.clear();
+        do
+        {
+          Level level;
+          level.width = width;
+          level.height = height;
+          level.depth.resize( width * height, 1.0f );
+          m_levels.push_back( level );
+
+          width = ( width + 1 ) / 2;
+          height = ( height + 1 ) / 2;
+        } while ( m_levels.back().width > 1 || m_levels.back().height > 1 );
+
+        m_valid = false;
+      }
+
+      unsigned int OcclusionCulling::getWidth() const
+      {
+        return m_levels.front().width;
+      }
+
+      unsigned int OcclusionCulling::getHeight() const
+      {
+        return m_levels.front().height;
+      }
+
+      void OcclusionCulling::setOccluderBudget( unsigned int occluderBudget )
+      {
+        m_occluderBudget = occluderBudget;
+      }
+
+      unsigned int OcclusionCulling::getOccluderBudget() const
+      {
+        return m_occluderBudget;
+      }
+
+      bool OcclusionCulling::isDepthBufferReused() const
+      {
+        return m_reused;
+      }
+
+      unsigned int OcclusionCulling::getNumberOfLevels() const
+      {
+        return static_cast<unsigned int>( m_levels.size() );
+      }
+
+      float const * OcclusionCulling::getDepthBuffer( unsigned int level, unsigned int & width, unsigned int & height ) const
+      {
+        DP_ASSERT( level < m_levels.size() );
+        width = m_levels[level].width;
+        height = m_levels[level].height;
+        return m_levels[level].depth.data();
+      }
+
+      bool OcclusionCulling::projectCorners( float const clip[8][4], float screen[8][3] ) const
+      {
+        float const width = float( getWidth() );
+        float const height = float( getHeight() );
+        for ( unsigned int corner = 0; corner < 8; ++corner )
+        {
+          float const * c = clip[corner];
+          // points in front of the near plane would require clipping
+          if ( c[3] <= 0.0f || c[2] < -c[3] )
+          {
+            return false;
+          }
+          float invW = 1.0f / c[3];
+          screen[corner][0] = ( c[0] * invW * 0.5f + 0.5f ) * width;
+          screen[corner][1] = ( c[1] * invW * 0.5f + 0.5f ) * height;
+          screen[corner][2] = c[2] * invW * 0.5f + 0.5f;
+        }
+        return true;
+      }
+
+      void OcclusionCulling::renderOccluders( dp::math::Mat44f const & viewProjection, std::vector<Occluder> const & occluders )
+      {
+        dp::util::ProfileEntry p("cull::renderOccluders");
+
+        float const width = float( getWidth() );
+        float const height = float( getHeight() );
+
+        // select the occluders with the largest area on screen, ties are resolved by the index to keep the selection deterministic
+        m_candidates.clear();
+        for ( size_t index = 0; index < occluders.size(); ++index )
+        {
+          float clip[8][4], screen[8][3];
+          computeCorners( occluders[index].box, occluders[index].modelMatrix * viewProjection, clip );
+          if ( projectCorners( clip, screen ) )
+          {
+            float lower[2] = { width, height };
+            float upper[2] = { 0.0f, 0.0f };
+            for ( unsigned int corner = 0; corner < 8; ++corner )
+            {
+              for ( unsigned int i = 0; i < 2; ++i )
+              {
+                lower[i] = std::min( lower[i], screen[corner][i] );
+                upper[i] = std::max( upper[i], screen[corner][i] );
+              }
+            }
+            float area = std::max( 0.0f, std::min( upper[0], width ) - std::max( lower[0], 0.0f ) )
+                       * std::max( 0.0f, std::min( upper[1], height ) - std::max( lower[1], 0.0f ) );
+            if ( area > 0.0f )
+            {
+              m_candidates.push_back( std::make_pair( -area, index ) );
+            }
+          }
+        }
+        size_t numberOfOccluders = std::min( m_candidates.size(), size_t( m_occluderBudget ) );
+        std::partial_sort( m_candidates.begin(), m_candidates.begin() + numberOfOccluders, m_candidates.end() );
+
+        m_selectedOccluders.resize( numberOfOccluders );
+        for ( size_t index = 0; index < numberOfOccluders; ++index )
+        {
+          m_selectedOccluders[index] = occluders[m_candidates[index].second];
+        }
+
+        // reuse the depth buffer of the last frame if nothing has changed
+        m_reused = m_valid
+                && memcmp( m_viewProjection.getPtr(), viewProjection.getPtr(), 16 * sizeof(float) ) == 0
+                && m_selectedOccluders.size() == m_renderedOccluders.size()
+                && std::equal( m_selectedOccluders.begin(), m_selectedOccluders.end(), m_renderedOccluders.begin(), isEqual );
+        if ( m_reused )
+        {
+          return;
+        }
+
+        std::fill( m_levels.front().depth.begin(), m_levels.front().depth.end(), 1.0f );
+        for ( size_t index = 0; index < m_selectedOccluders.size(); ++index )
+        {
+          float clip[8][4], screen[8][3];
+          computeCorners( m_selectedOccluders[index].box, m_selectedOccluders[index].modelMatrix * viewProjection, clip );
+          projectCorners( clip, screen );
+          for ( unsigned int face = 0; face < 6; ++face )
+          {
+            rasterizeQuad( screen, boxFaces[face] );
+          }
+        }
+        buildHierarchy();
+
+        m_viewProjection = viewProjection;
+        m_renderedOccluders.swap( m_selectedOccluders );
+        m_valid = true;
+      }
+
+      void OcclusionCulling::rasterizeQuad( float const screen[8][3], unsigned int const indices[4] )
+      {
+        float const * v[4] = { screen[indices[0]], screen[indices[1]], screen[indices[2]], screen[indices[3]] };
+
+        // the projection of a box face in front of the near plane is a convex quad, its orientation depends on the view
+        float area = 0.0f;
+        for ( unsigned int i = 0; i < 4; ++i )
+        {
+          float const * v0 = v[i];
+          float const * v1 = v[(i + 1) % 4];
+          area += v0[0] * v1[1] - v1[0] * v0[1];
+        }
+        if ( std::abs( area ) < 1e-6f )
+        {
+          return;
+        }
+        float const orientation = area > 0.0f ? 1.0f : -1.0f;
+
+        // edge functions are positive inside of the quad, a pixel is completely inside if the value at its center exceeds the margin
+        float a[4], b[4], c[4], margin[4];
+        for ( unsigned int i = 0; i < 4; ++i )
+        {
+          float const * v0 = v[i];
+          float const * v1 = v[(i + 1) % 4];
+          float ex = v1[0] - v0[0];
+          float ey = v1[1] - v0[1];
+          a[i] = -orientation * ey;
+          b[i] = orientation * ex;
+          c[i] = orientation * ( ey * v0[0] - ex * v0[1] );
+          margin[i] = 0.5f * ( std::abs( a[i] ) + std::abs( b[i] ) );
+        }
+
+        // the depth is linear in screen space, use the triangle with the larger area for the plane equation
+        unsigned int const triangles[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+        float bestDet = 0.0f;
+        float dzdx = 0.0f;
+        float dzdy = 0.0f;
+        for ( unsigned int triangle = 0; triangle < 2; ++triangle )
+        {
+          float const * p0 = v[triangles[triangle][0]];
+          float const * p1 = v[triangles[triangle][1]];
+          float const * p2 = v[triangles[triangle][2]];
+          float d1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+          float d2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+          float det = d1[0] * d2[1] - d2[0] * d1[1];
+          if ( std::abs( det ) > std::abs( bestDet ) )
+          {
+            bestDet = det;
+            dzdx = ( d1[2] * d2[1] - d2[2] * d1[1] ) / det;
+            dzdy = ( d2[2] * d1[0] - d1[2] * d2[0] ) / det;
+          }
+        }
+
+        // farthest depth within a pixel, but not farther than the farthest corner
+        float z0 = v[0][2] - dzdx * v[0][0] - dzdy * v[0][1] + 0.5f * ( std::abs( dzdx ) + std::abs( dzdy ) );
+        float maxDepth = std::max( std::max( v[0][2], v[1][2] ), std::max( v[2][2], v[3][2] ) );
+
+        float lower[2] = { v[0][0], v[0][1] };
+        float upper[2] = { v[0][0], v[0][1] };
+        for ( unsigned int i = 1; i < 4; ++i )
+        {
+          for ( unsigned int j = 0; j < 2; ++j )
+          {
+            lower[j] = std::min( lower[j], v[i][j] );
+            upper[j] = std::max( upper[j], v[i][j] );
+          }
+        }
+
+        Level & level = m_levels.front();
+        // only pixels completely inside of the bounds can be covered
+        int x0 = std::max( 0, int( std::ceil( std::max( lower[0], 0.0f ) ) ) );
+        int x1 = std::min( int( level.width ), int( std::floor( std::min( upper[0], float( level.width ) ) ) ) );
+        int y0 = std::max( 0, int( std::ceil( std::max( lower[1], 0.0f ) ) ) );
+        int y1 = std::min( int( level.height ), int( std::floor( std::min( upper[1], float( level.height ) ) ) ) );
+
+        for ( int y = y0; y < y1; ++y )
+        {
+          float center = float(y) + 0.5f;
+          float rowEdge[4];
+          for ( unsigned int i = 0; i < 4; ++i )
+          {
+            rowEdge[i] = b[i] * center + c[i];
+          }
+          float rowDepth = dzdy * center + z0;
+          rasterizeSpan( x0, x1, a, rowEdge, margin, dzdx, rowDepth, maxDepth, level.depth.data() + y * level.width );
+        }
+      }
+
+      void OcclusionCulling::buildHierarchy()
+      {
+        for ( size_t index = 1; index < m_levels.size(); ++index )
+        {
+          Level const & source = m_levels[index - 1];
+          Level & destination = m_levels[index];
+          for ( unsigned int y = 0; y < destination.height; ++y )
+          {
+            unsigned int y0 = 2 * y;
+            unsigned int y1 = std::min( 2 * y + 1, source.height - 1 );
+            float const * row0 = source.depth.data() + y0 * source.width;
+            float const * row1 = source.depth.data() + y1 * source.width;
+            for ( unsigned int x = 0; x < destination.width; ++x )
+            {
+              unsigned int x0 = 2 * x;
+              unsigned int x1 = std::min( 2 * x + 1, source.width - 1 );
+              destination.depth[y * destination.width + x] = std::max( std::max( row0[x0], row0[x1] ), std::max( row1[x0], row1[x1] ) );
+            }
+          }
+        }
+      }
+
+      bool OcclusionCulling::isOccluded( float const clip[8][4] ) const
+      {
+        float screen[8][3];
+        if ( !m_valid || !projectCorners( clip, screen ) )
+        {
+          return false;
+        }
+
+        Level const & base = m_levels.front();
+        float lower[3] = { screen[0][0], screen[0][1], screen[0][2] };
+        float upper[2] = { screen[0][0], screen[0][1] };
+        for ( unsigned int corner = 1; corner < 8; ++corner )
+        {
+          for ( unsigned int i = 0; i < 2; ++i )
+          {
+            lower[i] = std::min( lower[i], screen[corner][i] );
+            upper[i] = std::max( upper[i], screen[corner][i] );
+          }
+          lower[2] = std::min( lower[2], screen[corner][2] );
+        }
+
+        // all pixels touched by the screen space bounds
+        int x0 = int( std::floor( std::max( lower[0], 0.0f ) ) );
+        int x1 = std::min( int( base.width ) - 1, int( std::floor( std::min( upper[0], float( base.width ) ) ) ) );
+        int y0 = int( std::floor( std::max( lower[1], 0.0f ) ) );
+        int y1 = std::min( int( base.height ) - 1, int( std::floor( std::min( upper[1], float( base.height ) ) ) ) );
+        if ( x1 < x0 || y1 < y0 )
+        {
+          return false;
+        }
+
+        // choose the level where the bounds cover at most 2x2 texels
+        unsigned int levelIndex = 0;
+        while ( ( x1 >> levelIndex ) - ( x0 >> levelIndex ) > 1 || ( y1 >> levelIndex ) - ( y0 >> levelIndex ) > 1 )
+        {
+          ++levelIndex;
+        }
+        DP_ASSERT( levelIndex < m_levels.size() );
+
+        Level const & level = m_levels[levelIndex];
+        float maxDepth = 0.0f;
+        for ( int y = y0 >> levelIndex; y <= ( y1 >> levelIndex ); ++y )
+        {
+          for ( int x = x0 >> levelIndex; x <= ( x1 >> levelIndex ); ++x )
+          {
+            maxDepth = std::max( maxDepth, level.depth[y * level.width + x] );
+          }
+        }
+        return lower[2] > maxDepth;
+      }
+
+      bool OcclusionCulling::isOccluded( dp::math::Box3f const & box, dp::math::Mat44f const & modelMatrix ) const
+      {
+        float clip[8][4];
+        computeCorners( box, modelMatrix * m_viewProjection, clip );
+        return isOccluded( clip );
+      }
+
+      void OcclusionCulling::cull( OBBArray const & obbs, uint32_t * visibility ) const
+      {
+        dp::util::ProfileEntry p("cull::occlusion");
+
+        if ( !m_valid || m_renderedOccluders.empty() )
+        {
+          return;
+        }
+
+        float const* streams[OBBArray::COMPONENT_COUNT];
+        for ( unsigned int component = 0; component < OBBArray::COMPONENT_COUNT; ++component )
+        {
+          streams[component] = obbs.getStream( static_cast<OBBArray::Component>(component) );
+        }
+
+        size_t const numberOfWords = ( obbs.size() + 31 ) / 32;
+        for ( size_t word = 0; word < numberOfWords; ++word )
+        {
+          uint32_t bits = visibility[word];
+          while ( bits )
+          {
+            unsigned int bit = 0;
+            while ( !( bits & ( uint32_t(1) << bit ) ) )
+            {
+              ++bit;
+            }
+            bits &= ~( uint32_t(1) << bit );
+
+            size_t index = word * 32 + bit;
+            float vectors[4][4];
+            for ( unsigned int vector = 0; vector < 4; ++vector )
+            {
+              float input[4];
+              for ( unsigned int i = 0; i < 4; ++i )
+              {
+                input[i] = streams[vector * 4 + i][index];
+              }
+              transform( m_viewProjection, input, vectors[vector] );
+            }
+
+            float clip[8][4];
+            computeCorners( vectors[0], vectors[1], vectors[2], vectors[3], clip );
+            if ( isOccluded( clip ) )
+            {
+              visibility[word] &= ~( uint32_t(1) << bit );
+            }
+          }
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
@@ -0,0 +1,367 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/culling/cpu/inc/CullingKernels.h>
+#include <cmath>
+
+namespace dp
+{
+  namespace culling
+  {
+    namespace cpu
+    {
+
+      namespace
+      {
+
+        /** \brief Data derived from the OBBs of a block of objects which is shared by the tests of all volumes.
+                   Each field is a stream with one element per object to allow the compiler to vectorize the tests.
+        **/
+        struct BlockBounds
+        {
+          enum { SIZE = volumeBlockWords * 32 };
+
+          float center[3][SIZE];        // center of the OBB
+          float halfExtent[3][SIZE];    // half extent of the world space box around the OBB
+          float normal[3][3][SIZE];     // normalized face normals of the OBB, normal[face][component]
+          float thickness[3][SIZE];     // half thickness of the OBB along each face normal
+          float radius[SIZE];           // radius of the bounding sphere around the center
+        };
+
+        inline float dot( float const a[3], float const b[3] )
+        {
+          return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        inline void cross( float const a[3], float const b[3], float out[3] )
+        {
+          out[0] = a[1] * b[2] - a[2] * b[1];
+          out[1] = a[2] * b[0] - a[0] * b[2];
+          out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        void computeBlockBounds( OBBArray const & obbs, size_t begin, size_t count, BlockBounds & bounds )
+        {
+          float const* streams[OBBArray::COMPONENT_COUNT];
+          for ( unsigned int component = 0; component < OBBArray::COMPONENT_COUNT; ++component )
+          {
+            streams[component] = obbs.getStream( static_cast<OBBArray::Component>(component) ) + begin;
+          }
+
+          for ( size_t index = 0; index < count; ++index )
+          {
+            float edges[3][3];
+            for ( unsigned int edge = 0; edge < 3; ++edge )
+            {
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                edges[edge][i] = streams[OBBArray::EX_X + edge * 4 + i][index];
+              }
+            }
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              bounds.center[i][index] = streams[OBBArray::POINT_X + i][index] + 0.5f * ( edges[0][i] + edges[1][i] + edges[2][i] );
+              bounds.halfExtent[i][index] = 0.5f * ( fabsf( edges[0][i] ) + fabsf( edges[1][i] ) + fabsf( edges[2][i] ) );
+            }
+
+            // The face normal of a pair of edges is perpendicular to both, thus only the third edge contributes to the thickness.
+            // Degenerated OBBs get a zero normal with zero thickness which never rejects anything.
+            for ( unsigned int face = 0; face < 3; ++face )
+            {
+              float n[3];
+              cross( edges[(face + 1) % 3], edges[(face + 2) % 3], n );
+              float length = sqrtf( dot( n, n ) );
+              float scale = ( 0.0f < length ) ? 1.0f / length : 0.0f;
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                bounds.normal[face][i][index] = n[i] * scale;
+              }
+              bounds.thickness[face][index] = 0.5f * fabsf( dot( edges[face], n ) ) * scale;
+            }
+
+            // the bounding sphere has to contain the longest of the four diagonals
+            float diagonal = 0.0f;
+            for ( unsigned int sign = 0; sign < 4; ++sign )
+            {
+              float d[3];
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                d[i] = ( sign == 1 ? -edges[0][i] : edges[0][i] ) + ( sign == 2 ? -edges[1][i] : edges[1][i] ) + ( sign == 3 ? -edges[2][i] : edges[2][i] );
+              }
+              diagonal = std::max( diagonal, dot( d, d ) );
+            }
+            bounds.radius[index] = 0.5f * sqrtf( diagonal );
+          }
+        }
+
+        /** \brief Test if a point is farther away from the center of the OBB than the OBB extent plus the given distance along any
+                   of the axes of the world space box and the face normals of the OBB.
+        **/
+        inline bool isSeparated( BlockBounds const & bounds, size_t index, float const d[3], float const distance[3], float const normalDistance[3] )
+        {
+          bool separated = false;
+          for ( unsigned int i = 0; i < 3; ++i )
+          {
+            separated |= bounds.halfExtent[i][index] + distance[i] < fabsf( d[i] );
+          }
+          for ( unsigned int face = 0; face < 3; ++face )
+          {
+            float projection = d[0] * bounds.normal[face][0][index] + d[1] * bounds.normal[face][1][index] + d[2] * bounds.normal[face][2][index];
+            separated |= bounds.thickness[face][index] + normalDistance[face] < fabsf( projection );
+          }
+          return separated;
+        }
+
+        /** \brief Compute the bounding sphere of a volume **/
+        void getBoundingSphere( Volume const & volume, float center[3], float & radius )
+        {
+          for ( unsigned int i = 0; i < 3; ++i )
+          {
+            center[i] = volume.position[i];
+          }
+
+          switch ( volume.type )
+          {
+          case Volume::Type::CONE:
+            // The sphere through the apex and the rim of the cap is smaller than the range up to an opening angle of 60 degrees
+            radius = volume.radius;
+            if ( 0.5f < volume.cosAngle )
+            {
+              radius = 0.5f * volume.radius / volume.cosAngle;
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                center[i] += volume.axes[0][i] * radius;
+              }
+            }
+            break;
+          case Volume::Type::BOX:
+            radius = 0.0f;
+            for ( unsigned int sign = 0; sign < 4; ++sign )
+            {
+              dp::math::Vec3f diagonal = ( sign == 1 ? -volume.axes[0] : volume.axes[0] ) + ( sign == 2 ? -volume.axes[1] : volume.axes[1] )
+                                       + ( sign == 3 ? -volume.axes[2] : volume.axes[2] );
+              radius = std::max( radius, diagonal * diagonal );
+            }
+            radius = sqrtf( radius );
+            break;
+          default:
+            radius = volume.radius;
+          }
+        }
+
+        /** \brief Call test( index ) for each object whose bounding sphere intersects the bounding sphere of the volume and store
+                   the result as visibility bit. All other objects are invisible. Most objects are far away from a volume, thus
+                   the sphere test rejects the majority of the objects before the more expensive test of the volume.
+        **/
+        template <typename Test>
+        void cullVolume( BlockBounds const & bounds, size_t count, Volume const & volume, Test const & test, uint32_t * visibility )
+        {
+          float center[3];
+          float radius;
+          getBoundingSphere( volume, center, radius );
+
+          for ( size_t word = 0; word < count / 32; ++word )
+          {
+            uint32_t bits = 0;
+            for ( size_t bit = 0; bit < 32; ++bit )
+            {
+              size_t index = word * 32 + bit;
+              float d[3];
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                d[i] = center[i] - bounds.center[i][index];
+              }
+              float distance = radius + bounds.radius[index];
+              if ( dot( d, d ) <= distance * distance && test( index ) )
+              {
+                bits |= 1u << bit;
+              }
+            }
+            visibility[word] = bits;
+          }
+        }
+
+        //! \brief Test the OBB against the sphere with the axes of the world space box and the face normals of the OBB
+        struct SphereTest
+        {
+          SphereTest( BlockBounds const & bounds, Volume const & volume )
+            : m_bounds( bounds )
+            , m_volume( volume )
+          {
+          }
+
+          bool operator()( size_t index ) const
+          {
+            float const radius[3] = { m_volume.radius, m_volume.radius, m_volume.radius };
+            float d[3];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              d[i] = m_volume.position[i] - m_bounds.center[i][index];
+            }
+            return !isSeparated( m_bounds, index, d, radius, radius );
+          }
+
+        private:
+          BlockBounds const & m_bounds;
+          Volume const &      m_volume;
+        };
+
+        //! \brief Test the bounding sphere of the OBB against the cone and the OBB against the sphere of the range
+        struct ConeTest
+        {
+          ConeTest( BlockBounds const & bounds, Volume const & volume )
+            : m_bounds( bounds )
+            , m_volume( volume )
+            , m_sphereTest( bounds, volume )
+          {
+          }
+
+          bool operator()( size_t index ) const
+          {
+            float v[3];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              v[i] = m_bounds.center[i][index] - m_volume.position[i];
+            }
+
+            // The distance of the center to the surface of the cone is computed in the plane spanned by the axis and the center.
+            // Spheres behind the apex are culled separately since the distance to the infinite double cone is not sufficient.
+            float radius = m_bounds.radius[index];
+            float axial = dot( v, &m_volume.axes[0][0] );
+            float radial = sqrtf( std::max( dot( v, v ) - axial * axial, 0.0f ) );
+            float distance = m_volume.cosAngle * radial - m_volume.sinAngle * axial;
+            return distance <= radius && -radius <= axial && m_sphereTest( index );
+          }
+
+        private:
+          BlockBounds const & m_bounds;
+          Volume const &      m_volume;
+          SphereTest          m_sphereTest;
+        };
+
+        //! \brief Test the OBB against the box with the axes of the world space boxes and the face normals of both boxes
+        struct BoxTest
+        {
+          BoxTest( BlockBounds const & bounds, Volume const & volume )
+            : m_bounds( bounds )
+            , m_volume( volume )
+          {
+            // the extent of the volume along the world axes
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              m_halfExtent[i] = fabsf( volume.axes[0][i] ) + fabsf( volume.axes[1][i] ) + fabsf( volume.axes[2][i] );
+            }
+
+            // the face normals and half thickness of the volume
+            for ( unsigned int face = 0; face < 3; ++face )
+            {
+              cross( &volume.axes[(face + 1) % 3][0], &volume.axes[(face + 2) % 3][0], m_normals[face] );
+              float length = sqrtf( dot( m_normals[face], m_normals[face] ) );
+              float scale = ( 0.0f < length ) ? 1.0f / length : 0.0f;
+              for ( unsigned int i = 0; i < 3; ++i )
+              {
+                m_normals[face][i] *= scale;
+              }
+              m_thickness[face] = fabsf( dot( &volume.axes[face][0], m_normals[face] ) );
+            }
+          }
+
+          bool operator()( size_t index ) const
+          {
+            float d[3];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+              d[i] = m_volume.position[i] - m_bounds.center[i][index];
+            }
+
+            // extent of the volume along the face normals of the OBB
+            float normalExtent[3];
+            for ( unsigned int face = 0; face < 3; ++face )
+            {
+              normalExtent[face] = 0.0f;
+              for ( unsigned int axis = 0; axis < 3; ++axis )
+              {
+                normalExtent[face] += fabsf( m_volume.axes[axis][0] * m_bounds.normal[face][0][index] + m_volume.axes[axis][1] * m_bounds.normal[face][1][index]
+                                           + m_volume.axes[axis][2] * m_bounds.normal[face][2][index] );
+              }
+            }
+            bool separated = isSeparated( m_bounds, index, d, m_halfExtent, normalExtent );
+
+            // the extent of the OBB along the face normals of the volume is taken from its world space box, which is conservative
+            for ( unsigned int face = 0; face < 3; ++face )
+            {
+              float extent = m_bounds.halfExtent[0][index] * fabsf( m_normals[face][0] ) + m_bounds.halfExtent[1][index] * fabsf( m_normals[face][1] )
+                           + m_bounds.halfExtent[2][index] * fabsf( m_normals[face][2] );
+              separated |= m_thickness[face] + extent < fabsf( dot( d, m_normals[face] ) );
+            }
+            return !separated;
+          }
+
+        private:
+          BlockBounds const & m_bounds;
+          Volume const &      m_volume;
+          float               m_halfExtent[3];
+          float               m_normals[3][3];
+          float               m_thickness[3];
+        };
+
+      } // namespace
+
+      void cullOBBsVolumes( OBBArray const & obbs, Volume const * volumes, size_t numberOfVolumes, size_t beginWord, size_t endWord, uint32_t * const * visibilities )
+      {
+        BlockBounds bounds;
+        for ( size_t blockBegin = beginWord; blockBegin < endWord; blockBegin += volumeBlockWords )
+        {
+          size_t blockEnd = std::min( blockBegin + volumeBlockWords, endWord );
+          size_t count = ( blockEnd - blockBegin ) * 32;
+          computeBlockBounds( obbs, blockBegin * 32, count, bounds );
+
+          for ( size_t volume = 0; volume < numberOfVolumes; ++volume )
+          {
+            uint32_t * visibility = visibilities[volume] + blockBegin;
+            switch ( volumes[volume].type )
+            {
+            case Volume::Type::SPHERE:
+              cullVolume( bounds, count, volumes[volume], SphereTest( bounds, volumes[volume] ), visibility );
+              break;
+            case Volume::Type::CONE:
+              cullVolume( bounds, count, volumes[volume], ConeTest( bounds, volumes[volume] ), visibility );
+              break;
+            case Volume::Type::BOX:
+              cullVolume( bounds, count, volumes[volume], BoxTest( bounds, volumes[volume] ), visibility );
+              break;
+            default:
+              DP_ASSERT( !"unknown volume type" );
+              std::fill( visibility, visibility + ( blockEnd - blockBegin ), ~0u );
+            }
+          }
+        }
+      }
+
+    } // namespace cpu
+  } // namespace culling
+} // namespace dp
@@ -49,15 +49,21 @@ namespace dp
         virtual ResultSharedPtr groupCreateResult( GroupSharedPtr const& group );
 
         virtual void cull( const GroupSharedPtr& group, const ResultSharedPtr& result, const dp::math::Mat44f& viewProjection );
+        virtual void cullUnion( GroupSharedPtr const & group, ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & viewProjections );
       private:
         void initializeComputeShader();
 
+        //! \brief Run the culling shader for the group. The visibility is written to the output buffer of the group.
+        void dispatch( GroupImplSharedPtr const & group, dp::math::Mat44f const & viewProjection );
+
         /************************************************************************/
         /* OpenGL resources                                                     */
         /************************************************************************/
         dp::gl::ProgramInstanceSharedPtr  m_program;
         GLint                             m_uniformViewProjection;
         bool                              m_shaderInitialized;
+
+        std::vector<uint32_t>             m_unionVisibility;
       };
 
     } // namespace opengl
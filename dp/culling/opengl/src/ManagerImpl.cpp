@@ -218,15 +218,8 @@ namespace dp
         }
       }
 
-      void ManagerImpl::cull( const GroupSharedPtr& group, const ResultSharedPtr& result, const dp::math::Mat44f& viewProjection )
+      void ManagerImpl::dispatch( GroupImplSharedPtr const & groupImpl, dp::math::Mat44f const & viewProjection )
       {
-        dp::util::ProfileEntry p("cull");
-
-        GroupImplSharedPtr groupImpl = std::static_pointer_cast<GroupImpl>(group);
-
-        dp::math::Mat44f vp = viewProjection;
-        dp::math::Mat44f modelViewProjection;
-
         initializeComputeShader();
         groupImpl->update( WORKGROUP_SIZE );
 
@@ -242,10 +235,41 @@ namespace dp
         glDispatchCompute( static_cast<GLuint>(numberOfWorkingGroups), 1, 1 );
         glMemoryBarrier( GL_BUFFER_UPDATE_BARRIER_BIT ); // TODO This is way too slow to use, but correct.
         glMemoryBarrier( GL_SHADER_STORAGE_BARRIER_BIT );
+      }
+
+      void ManagerImpl::cull( const GroupSharedPtr& group, const ResultSharedPtr& result, const dp::math::Mat44f& viewProjection )
+      {
+        dp::util::ProfileEntry p("cull");
+
+        GroupImplSharedPtr groupImpl = std::static_pointer_cast<GroupImpl>(group);
+        dispatch( groupImpl, viewProjection );
+
         dp::gl::MappedBuffer<uint32_t> visibleShader( groupImpl->getOutputBuffer(), GL_MAP_READ_BIT );
         std::static_pointer_cast<ResultBitSet>(result)->updateChanged( visibleShader );
       }
 
+      void ManagerImpl::cullUnion( GroupSharedPtr const & group, ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & viewProjections )
+      {
+        dp::util::ProfileEntry p("cullUnion");
+
+        GroupImplSharedPtr groupImpl = std::static_pointer_cast<GroupImpl>(group);
+
+        m_unionVisibility.assign( ( groupImpl->getObjectCount() + 31 ) / 32, 0 );
+        for ( size_t view = 0; view < viewProjections.size(); ++view )
+        {
+          dispatch( groupImpl, viewProjections[view] );
+
+          dp::gl::MappedBuffer<uint32_t> visibleShader( groupImpl->getOutputBuffer(), GL_MAP_READ_BIT );
+          uint32_t const * visibility = visibleShader;
+          for ( size_t word = 0; word < m_unionVisibility.size(); ++word )
+          {
+            m_unionVisibility[word] |= visibility[word];
+          }
+        }
+
+        std::static_pointer_cast<ResultBitSet>(result)->updateChanged( m_unionVisibility.data() );
+      }
+
       Manager* Manager::create()
       {
         return new ManagerImpl;
@@ -58,9 +58,11 @@ namespace dp
         , m_inputChanged( true )
         , m_matricesChanged( true )
         , m_objectIncarnation( 0 )
+        , m_inputIncarnation( 0 )
         , m_dirtyMatrices( 0 )
         , m_boundingBoxDirty( true )
         , m_obbDirty( true )
+        , m_objectBoundsDirty( true )
       {
       }
 
@@ -78,9 +80,11 @@ namespace dp
         if ( object->getGroupIndex() == ~0 )
         {
           object->setGroupIndex( m_objects.size() );
+          object->setGroup( std::static_pointer_cast<GroupBitSet>( shared_from_this() ) );
           m_objects.push_back(object);
           m_inputChanged = true;
           ++m_objectIncarnation;
+          ++m_inputIncarnation;
           m_boundingBoxDirty = true;
           m_obbDirty = true;
         }
@@ -111,6 +115,7 @@ namespace dp
           m_boundingBoxDirty = true;
           m_obbDirty = true;
           ++m_objectIncarnation;
+          ++m_inputIncarnation;
         }
         else
         {
@@ -131,6 +136,7 @@ namespace dp
           m_dirtyMatrices.fill();
           m_boundingBoxDirty = true;
           m_obbDirty = true;
+          ++m_inputIncarnation;
         }
       }
 
@@ -139,6 +145,7 @@ namespace dp
         m_objects.clear();
         m_boundingBoxDirty = true;
         m_obbDirty = true;
+        ++m_inputIncarnation;
       }
 
   } // namespace culling
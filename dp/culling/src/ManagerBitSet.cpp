@@ -67,6 +67,9 @@ namespace dp
   {
 
     ManagerBitSet::ManagerBitSet()
+      : m_viewportSize( 0, 0 )
+      , m_minimumPixelSize( 0.0f )
+      , m_pixelSizeHysteresis( 0.25f )
     {
 
     }
@@ -85,6 +88,16 @@ namespace dp
       return( std::static_pointer_cast<ObjectBitSet>(object)->getUserData() );
     }
 
+    void ManagerBitSet::objectSetUserId( ObjectSharedPtr const & object, uint32_t userId )
+    {
+      std::static_pointer_cast<ObjectBitSet>(object)->setUserId( userId );
+    }
+
+    uint32_t ManagerBitSet::objectGetUserId( ObjectSharedPtr const & object )
+    {
+      return( std::static_pointer_cast<ObjectBitSet>(object)->getUserId() );
+    }
+
     void ManagerBitSet::objectSetTransformIndex( const ObjectSharedPtr& object, size_t index )
     {
       ObjectBitSetSharedPtr objectImpl = std::static_pointer_cast<ObjectBitSet>(object);
@@ -92,7 +105,7 @@ namespace dp
       objectImpl->setTransformIndex( index );
       if ( objectImpl->getGroup() )
       {
-        objectImpl->getGroup()->setOBBDirty( true );
+        objectImpl->getGroup()->markObjectBoundsDirty();
       }
     }
 
@@ -104,7 +117,7 @@ namespace dp
 
       if ( objectImpl->getGroup() )
       {
-        objectImpl->getGroup()->setOBBDirty( true );
+        objectImpl->getGroup()->markObjectBoundsDirty();
       }
     }
 
@@ -143,6 +156,11 @@ namespace dp
       return( std::static_pointer_cast<ResultBitSet>(result)->getChangedObjects() );
     }
 
+    void ManagerBitSet::resultGetChangedIds( ResultSharedPtr const & result, std::vector<uint32_t> & changedIds )
+    {
+      std::static_pointer_cast<ResultBitSet>(result)->getChangedIds( changedIds );
+    }
+
     bool ManagerBitSet::resultObjectIsVisible( ResultSharedPtr const& result, ObjectSharedPtr const& object )
     {
       return( std::static_pointer_cast<ResultBitSet>(result)->isVisible( std::static_pointer_cast<ObjectBitSet>(object) ) );
@@ -306,5 +324,46 @@ namespace dp
       }
     }
 
+    void ManagerBitSet::cullViews( GroupSharedPtr const & group, std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & viewProjections )
+    {
+      DP_ASSERT( results.size() == viewProjections.size() );
+      for ( size_t index = 0; index < viewProjections.size(); ++index )
+      {
+        cull( group, results[index], viewProjections[index] );
+      }
+    }
+
+    void ManagerBitSet::setViewportSize( dp::math::Vec2ui const & viewportSize )
+    {
+      m_viewportSize = viewportSize;
+    }
+
+    dp::math::Vec2ui const & ManagerBitSet::getViewportSize() const
+    {
+      return m_viewportSize;
+    }
+
+    void ManagerBitSet::setMinimumPixelSize( float minimumPixelSize )
+    {
+      DP_ASSERT( 0.0f <= minimumPixelSize );
+      m_minimumPixelSize = minimumPixelSize;
+    }
+
+    float ManagerBitSet::getMinimumPixelSize() const
+    {
+      return m_minimumPixelSize;
+    }
+
+    void ManagerBitSet::setPixelSizeHysteresis( float hysteresis )
+    {
+      DP_ASSERT( 0.0f <= hysteresis );
+      m_pixelSizeHysteresis = hysteresis;
+    }
+
+    float ManagerBitSet::getPixelSizeHysteresis() const
+    {
+      return m_pixelSizeHysteresis;
+    }
+
   } // namespace culling
 } // namespace dp
@@ -39,6 +39,7 @@ namespace dp
       ObjectBitSet::ObjectBitSet( PayloadSharedPtr const& userData )
       : m_userData( userData )
       , m_transformIndex( ~0 )
+      , m_userId( ~0 )
       , m_groupIndex( ~0 )
       {
       };
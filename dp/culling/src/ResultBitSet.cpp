@@ -28,6 +28,7 @@
 #include <dp/util/BitArray.h>
 
 #include <dp/util/FrameProfiler.h>
+#include <algorithm>
 
 namespace dp
 {
@@ -40,8 +41,9 @@ namespace dp
 
       ResultBitSet::ResultBitSet( GroupBitSetSharedPtr const& parentGroup )
         : m_groupParent( parentGroup )
+        , m_changedObjectsValid( true )
         , m_objectIncarnation(~0)
-        , m_results(0)
+        , m_numberOfResults(0)
       {
         DP_ASSERT( m_groupParent );
 
@@ -55,9 +57,27 @@ namespace dp
 
       std::vector<ObjectSharedPtr> const & ResultBitSet::getChangedObjects() const
       {
+        if ( !m_changedObjectsValid )
+        {
+          m_changedObjects.clear();
+          for ( size_t index = 0; index < m_changedIndices.size(); ++index )
+          {
+            m_changedObjects.push_back( m_groupParent->getObject( m_changedIndices[index] ) );
+          }
+          m_changedObjectsValid = true;
+        }
         return m_changedObjects;
       }
 
+      void ResultBitSet::getChangedIds( std::vector<uint32_t> & changedIds ) const
+      {
+        changedIds.resize( m_changedIndices.size() );
+        for ( size_t index = 0; index < m_changedIndices.size(); ++index )
+        {
+          changedIds[index] = m_groupParent->getObject( m_changedIndices[index] )->getUserId();
+        }
+      }
+
       void ResultBitSet::updateChanged( uint32_t const* visibility )
       {
         dp::util::ProfileEntry p("ResultBitSet::updateChanged");
@@ -65,46 +85,68 @@ namespace dp
         if ( m_objectIncarnation != m_groupParent->getObjectIncarnation() )
         {
           m_objectIncarnation = m_groupParent->getObjectIncarnation();
-          m_groupParent->getObjectCount();
-
-          size_t numberOfResultChunks = ( m_groupParent->getObjectCount() + 31 ) / 32;
-          size_t oldSize = m_results.getSize();
-          m_results.resize( m_groupParent->getObjectCount() );
 
           // objects are visible by default, TODO required?
-          for ( size_t index = oldSize; index < m_results.getSize(); ++index )
+          size_t numberOfObjects = m_groupParent->getObjectCount();
+          m_results.resize( (numberOfObjects + 31) / 32, ~0u );
+          if ( m_numberOfResults < numberOfObjects && (m_numberOfResults & 31) )
           {
-            m_results.enableBit( index );
+            m_results[m_numberOfResults / 32] |= ~0u << (m_numberOfResults & 31);
           }
+          m_numberOfResults = numberOfObjects;
         }
-        /** \brief Visitor which adds changed objects to the changed group **/
+
+        /** \brief Visitor which adds the group index of changed objects to the list of changed indices **/
         struct Visitor
         {
-          inline Visitor( GroupBitSetSharedPtr const & group, std::vector<ObjectSharedPtr> & changed )
-            : m_group( group )
-            , m_changed( changed )
+          inline Visitor( std::vector<uint32_t> & changed, uint32_t offset )
+            : m_changed( changed )
+            , m_offset( offset )
           {
-            m_changed.clear();
           }
 
           inline void operator()( size_t index )
           {
-            const ObjectBitSetSharedPtr& objectImpl = m_group->getObject( index );
-            m_changed.push_back( objectImpl );
+            m_changed.push_back( m_offset + uint32_t(index) );
           }
         private:
-          GroupBitSetSharedPtr const & m_group;
-          std::vector<ObjectSharedPtr> & m_changed;
+          std::vector<uint32_t> & m_changed;
+          uint32_t                m_offset;
         };
 
-        dp::util::BitArray newVisible( m_groupParent->getObjectCount() );
-        newVisible.setBits( visibility, m_groupParent->getObjectCount() );
+        m_changedIndices.clear();
+        m_changedObjectsValid = false;
 
-        dp::util::BitArray changed = newVisible ^ m_results;
+        // compare the visibility word by word and keep the new visibility. Bits beyond the last object are ignored.
+        size_t numberOfWords = m_numberOfResults / 32;
+        for ( size_t word = 0; word < numberOfWords; ++word )
+        {
+          uint32_t changed = visibility[word] ^ m_results[word];
+          if ( changed )
+          {
+            m_results[word] = visibility[word];
+            Visitor visitor( m_changedIndices, uint32_t(word * 32) );
+            dp::util::bitTraverse( changed, visitor );
+          }
+        }
+        if ( m_numberOfResults & 31 )
+        {
+          uint32_t mask = ~(~0u << (m_numberOfResults & 31));
+          uint32_t changed = (visibility[numberOfWords] ^ m_results[numberOfWords]) & mask;
+          if ( changed )
+          {
+            m_results[numberOfWords] ^= changed;
+            Visitor visitor( m_changedIndices, uint32_t(numberOfWords * 32) );
+            dp::util::bitTraverse( changed, visitor );
+          }
+        }
+      }
 
-        Visitor visitorBase( m_groupParent, m_changedObjects );
-        changed.traverseBits(visitorBase);
-        m_results = newVisible;
+      void ResultBitSet::clearChanged()
+      {
+        m_changedIndices.clear();
+        m_changedObjects.clear();
+        m_changedObjectsValid = true;
       }
 
       void ResultBitSet::onNotify( dp::util::Event const & event, dp::util::Payload * payload )
@@ -112,19 +154,30 @@ namespace dp
         // If an object is being moved in the internal array move the visibility bit in the result to the new location.
         GroupBitSet::Event const& groupEvent = static_cast<GroupBitSet::Event const&>(event);
 
-        if ( groupEvent.getNewIndex() < m_results.getSize() )
+        size_t newIndex = groupEvent.getNewIndex();
+        if ( newIndex < m_numberOfResults )
         {
-          if ( groupEvent.getOldIndex() < m_results.getSize() )
+          // an object from a not yet known location is assumed to be visible
+          size_t oldIndex = groupEvent.getOldIndex();
+          bool visible = (oldIndex < m_numberOfResults) ? !!(m_results[oldIndex / 32] & (1u << (oldIndex & 31))) : true;
+
+          // transfer visibility bit
+          if ( visible )
           {
-            // transfer visibility bit
-            m_results.setBit( groupEvent.getNewIndex(), m_results.getBit( groupEvent.getOldIndex() ) );
+            m_results[newIndex / 32] |= 1u << (newIndex & 31);
           }
           else
           {
-            // object from not yet known location. assume visiblity true
-            m_results.enableBit( groupEvent.getNewIndex() );
+            m_results[newIndex / 32] &= ~(1u << (newIndex & 31));
           }
         }
+
+        // The changed objects are resolved from the group indices on demand. Keep those indices valid: the object at newIndex
+        // has been removed and the last object has been moved from oldIndex to newIndex.
+        uint32_t removedIndex = uint32_t(newIndex);
+        uint32_t movedIndex = uint32_t(groupEvent.getOldIndex());
+        m_changedIndices.erase( std::remove( m_changedIndices.begin(), m_changedIndices.end(), removedIndex ), m_changedIndices.end() );
+        std::replace( m_changedIndices.begin(), m_changedIndices.end(), movedIndex, removedIndex );
       }
 
       void ResultBitSet::onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload )
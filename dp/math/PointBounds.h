@@ -0,0 +1,99 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+/** \file */
+
+#include <dp/math/Config.h>
+#include <dp/math/Boxnt.h>
+#include <dp/math/Spherent.h>
+#include <cstddef>
+
+namespace dp
+{
+  namespace math
+  {
+
+    /*! \brief Description of a set of three component float points, optionally accessed through an index array.
+     *  \remarks The points may be interleaved with other data, as long as \a stride is at least twelve bytes.
+     *  Indices equal to \a restartIndex and indices not less than \a numberOfPoints are skipped. */
+    struct PointSet
+    {
+      PointSet()
+        : points( nullptr )
+        , stride( 3 * sizeof(float) )
+        , numberOfPoints( 0 )
+        , indices( nullptr )
+        , indexSize( 0 )
+        , restartIndex( ~0 )
+      {}
+
+      const void *  points;         //!< Pointer to the first point
+      size_t        stride;         //!< Distance between two points in bytes
+      unsigned int  numberOfPoints; //!< Number of points addressable by the indices
+      const void *  indices;        //!< Pointer to the first index, or nullptr to access the points sequentially
+      unsigned int  indexSize;      //!< Size of an index in bytes: 1, 2, or 4
+      unsigned int  restartIndex;   //!< Primitive restart index to skip
+    };
+
+    /*! \brief The axis aligned bounding box of a point set together with the points on its faces. */
+    struct ExtremalPoints
+    {
+      Box3f box;          //!< Axis aligned bounding box; invalid if no point has been added
+      Vec3f lower[3];     //!< Points with the smallest x, y, and z coordinate
+      Vec3f upper[3];     //!< Points with the largest x, y, and z coordinate
+    };
+
+    /*! \brief Determine the extremal points of the elements [\a begin, \a end) of a PointSet.
+     *  \param pointSet The PointSet to process.
+     *  \param begin Index of the first element, counted in indices for indexed and in points for sequential access.
+     *  \param end Index one past the last element.
+     *  \param extremalPoints Receives the bounding box and the extremal points of the range.
+     *  \return The number of skipped out of range indices.
+     *  \remarks Uses SSE2 on x86-64. The results of several ranges are combined with mergeExtremalPoints. */
+    DP_MATH_API unsigned int calculateExtremalPoints( const PointSet & pointSet, size_t begin, size_t end, ExtremalPoints & extremalPoints );
+
+    /*! \brief Combine the ExtremalPoints \a src of a range into \a dst. */
+    DP_MATH_API void mergeExtremalPoints( ExtremalPoints & dst, const ExtremalPoints & src );
+
+    /*! \brief Initial sphere of Ritter's algorithm: the sphere around the pair of extremal points with the largest distance. */
+    DP_MATH_API Sphere3f initialBoundingSphere( const ExtremalPoints & extremalPoints );
+
+    /*! \brief Grow a sphere over the elements [\a begin, \a end) of a PointSet.
+     *  \param pointSet The PointSet to process.
+     *  \param begin Index of the first element.
+     *  \param end Index one past the last element.
+     *  \param sphere The sphere to grow by Ritter's algorithm until it contains all points of the range.
+     *  \param center A fixed center, typically the center of the bounding box.
+     *  \param maxDistanceSquared Updated to the largest squared distance of a point in the range from \a center.
+     *  \remarks Both spheres are computed in a single pass. Neither is optimal, but taking the smaller one is never worse
+     *  than the sphere around the box center. Spheres of several ranges started from the same initial sphere are combined
+     *  with boundingSphere( s0, s1 ). */
+    DP_MATH_API void growBoundingSphere( const PointSet & pointSet, size_t begin, size_t end, Sphere3f & sphere
+                                       , const Vec3f & center, float & maxDistanceSquared );
+
+  } // namespace math
+} // namespace dp
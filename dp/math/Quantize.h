@@ -0,0 +1,66 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+/** \file */
+
+#include <dp/math/Config.h>
+#include <cstddef>
+
+namespace dp
+{
+  namespace math
+  {
+
+    /*! \brief Convert floats to IEEE 754 half floats.
+     *  \param src Pointer to \a count floats.
+     *  \param dst Pointer to \a count half floats, stored as unsigned short.
+     *  \param count The number of values to convert.
+     *  \remarks Values are rounded to nearest even. Values too large for a half float are converted to infinity. */
+    DP_MATH_API void convertFloatToHalf( const float * src, unsigned short * dst, size_t count );
+
+    /*! \brief Convert IEEE 754 half floats to floats.
+     *  \param src Pointer to \a count half floats, stored as unsigned short.
+     *  \param dst Pointer to \a count floats.
+     *  \param count The number of values to convert. */
+    DP_MATH_API void convertHalfToFloat( const unsigned short * src, float * dst, size_t count );
+
+    /*! \brief Convert floats to signed normalized 16 bit integers.
+     *  \param src Pointer to \a count floats.
+     *  \param dst Pointer to \a count shorts.
+     *  \param count The number of values to convert.
+     *  \remarks Values are clamped to [-1,1] and rounded to the nearest multiple of 1/32767, which is the encoding
+     *  OpenGL expects for normalized \c GL_SHORT vertex attributes. */
+    DP_MATH_API void convertFloatToSnorm16( const float * src, short * dst, size_t count );
+
+    /*! \brief Convert signed normalized 16 bit integers to floats.
+     *  \param src Pointer to \a count shorts.
+     *  \param dst Pointer to \a count floats.
+     *  \param count The number of values to convert. */
+    DP_MATH_API void convertSnorm16ToFloat( const short * src, float * dst, size_t count );
+
+  } // namespace math
+} // namespace dp
@@ -0,0 +1,396 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/math/PointBounds.h>
+#include <limits>
+
+#if defined(DP_ARCH_X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace dp
+{
+  namespace math
+  {
+
+    namespace
+    {
+      // Call visitor( index, point ) for each point referenced by the elements [begin, end) of the PointSet.
+      template <typename IndexType, typename Visitor>
+      unsigned int forEachIndexedPoint( const PointSet & pointSet, size_t begin, size_t end, Visitor & visitor )
+      {
+        const char * points = reinterpret_cast<const char *>( pointSet.points );
+        const IndexType * indices = reinterpret_cast<const IndexType *>( pointSet.indices );
+        unsigned int skipped = 0;
+        for ( size_t i = begin; i < end; ++i )
+        {
+          unsigned int index = indices[i];
+          if ( index != pointSet.restartIndex )
+          {
+            if ( index < pointSet.numberOfPoints )
+            {
+              visitor( index, reinterpret_cast<const float *>( points + index * pointSet.stride ) );
+            }
+            else
+            {
+              ++skipped;
+            }
+          }
+        }
+        return( skipped );
+      }
+
+      template <typename Visitor>
+      unsigned int forEachPoint( const PointSet & pointSet, size_t begin, size_t end, Visitor & visitor )
+      {
+        DP_ASSERT( pointSet.points && ( 3 * sizeof(float) <= pointSet.stride ) );
+        switch ( pointSet.indexSize )
+        {
+          case 0 :
+            {
+              DP_ASSERT( end <= pointSet.numberOfPoints );
+              const char * points = reinterpret_cast<const char *>( pointSet.points );
+              for ( size_t i = begin; i < end; ++i )
+              {
+                visitor( static_cast<unsigned int>( i ), reinterpret_cast<const float *>( points + i * pointSet.stride ) );
+              }
+              return( 0 );
+            }
+          case 1 :
+            return( forEachIndexedPoint<unsigned char>( pointSet, begin, end, visitor ) );
+          case 2 :
+            return( forEachIndexedPoint<unsigned short>( pointSet, begin, end, visitor ) );
+          case 4 :
+            return( forEachIndexedPoint<unsigned int>( pointSet, begin, end, visitor ) );
+          default :
+            DP_ASSERT( !"unsupported index size" );
+            return( 0 );
+        }
+      }
+
+      inline Vec3f getPoint( const PointSet & pointSet, unsigned int index )
+      {
+        const float * p = reinterpret_cast<const float *>( reinterpret_cast<const char *>( pointSet.points ) + index * pointSet.stride );
+        return( Vec3f( p[0], p[1], p[2] ) );
+      }
+
+#if defined(DP_ARCH_X86_64)
+      // Load x, y, z of a point into the lower three lanes. Reading all four lanes at once is only safe
+      // if the point is followed by another one.
+      inline __m128 loadPoint( const float * p, bool last )
+      {
+        if ( last )
+        {
+          return( _mm_movelh_ps( _mm_loadl_pi( _mm_setzero_ps(), reinterpret_cast<const __m64 *>( p ) ), _mm_load_ss( p + 2 ) ) );
+        }
+        return( _mm_loadu_ps( p ) );
+      }
+
+      // x*x + y*y + z*z in the lowest lane
+      inline __m128 lengthSquared3( __m128 v )
+      {
+        v = _mm_mul_ps( v, v );
+        return( _mm_add_ss( _mm_add_ss( v, _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ), _mm_movehl_ps( v, v ) ) );
+      }
+
+      // Per axis minimum and maximum in lanes 0 to 2, together with the indices of the points attaining them.
+      // The indices only need to be updated if a point extends the box, which gets rare quickly.
+      class ExtremalPointsVisitor
+      {
+      public:
+        ExtremalPointsVisitor( unsigned int numberOfPoints )
+          : m_lower( _mm_set1_ps( std::numeric_limits<float>::max() ) )
+          , m_upper( _mm_set1_ps( -std::numeric_limits<float>::max() ) )
+          , m_lastIndex( numberOfPoints - 1 )
+        {
+          for ( unsigned int axis = 0; axis < 3; ++axis )
+          {
+            m_lowerIndex[axis] = 0;
+            m_upperIndex[axis] = 0;
+          }
+        }
+
+        void operator()( unsigned int index, const float * p )
+        {
+          __m128 v = loadPoint( p, index == m_lastIndex );
+          int lowerMask = _mm_movemask_ps( _mm_cmplt_ps( v, m_lower ) );
+          int upperMask = _mm_movemask_ps( _mm_cmpgt_ps( v, m_upper ) );
+          if ( ( lowerMask | upperMask ) & 7 )
+          {
+            for ( unsigned int axis = 0; axis < 3; ++axis )
+            {
+              if ( lowerMask & ( 1 << axis ) )
+              {
+                m_lowerIndex[axis] = index;
+              }
+              if ( upperMask & ( 1 << axis ) )
+              {
+                m_upperIndex[axis] = index;
+              }
+            }
+            m_lower = _mm_min_ps( m_lower, v );
+            m_upper = _mm_max_ps( m_upper, v );
+          }
+        }
+
+        void getResult( const PointSet & pointSet, ExtremalPoints & extremalPoints ) const
+        {
+          float lower[4], upper[4];
+          _mm_storeu_ps( lower, m_lower );
+          _mm_storeu_ps( upper, m_upper );
+
+          extremalPoints.box = Box3f();
+          if ( lower[0] <= upper[0] )
+          {
+            extremalPoints.box = Box3f( Vec3f( lower[0], lower[1], lower[2] ), Vec3f( upper[0], upper[1], upper[2] ) );
+            for ( unsigned int axis = 0; axis < 3; ++axis )
+            {
+              extremalPoints.lower[axis] = getPoint( pointSet, m_lowerIndex[axis] );
+              extremalPoints.upper[axis] = getPoint( pointSet, m_upperIndex[axis] );
+            }
+          }
+        }
+
+      private:
+        __m128        m_lower;
+        __m128        m_upper;
+        unsigned int  m_lowerIndex[3];
+        unsigned int  m_upperIndex[3];
+        unsigned int  m_lastIndex;
+      };
+
+      // Ritter's growing sphere and the largest distance from a fixed center.
+      class GrowSphereVisitor
+      {
+      public:
+        GrowSphereVisitor( unsigned int numberOfPoints, const Sphere3f & sphere, const Vec3f & center, float maxDistanceSquared )
+          : m_center( _mm_setr_ps( center[0], center[1], center[2], 0.0f ) )
+          , m_maxDistanceSquared( _mm_set_ss( maxDistanceSquared ) )
+          , m_sphereCenter( _mm_setr_ps( sphere.getCenter()[0], sphere.getCenter()[1], sphere.getCenter()[2], 0.0f ) )
+          , m_sphereRadius( sphere.getRadius() )
+          , m_sphereRadiusSquared( sphere.getRadius() * sphere.getRadius() )
+          , m_lastIndex( numberOfPoints - 1 )
+        {
+          DP_ASSERT( isValid( sphere ) );
+        }
+
+        void operator()( unsigned int index, const float * p )
+        {
+          __m128 v = loadPoint( p, index == m_lastIndex );
+          m_maxDistanceSquared = _mm_max_ss( m_maxDistanceSquared, lengthSquared3( _mm_sub_ps( v, m_center ) ) );
+
+          __m128 d = _mm_sub_ps( v, m_sphereCenter );
+          float distanceSquared = _mm_cvtss_f32( lengthSquared3( d ) );
+          if ( m_sphereRadiusSquared < distanceSquared )
+          {
+            // move the center towards the point, such that the new sphere touches the opposite side of the old one
+            float distance = sqrt( distanceSquared );
+            float radius = 0.5f * ( m_sphereRadius + distance );
+            m_sphereCenter = _mm_add_ps( m_sphereCenter, _mm_mul_ps( _mm_set1_ps( ( distance - radius ) / distance ), d ) );
+            m_sphereRadius = radius;
+            m_sphereRadiusSquared = radius * radius;
+          }
+        }
+
+        void getResult( Sphere3f & sphere, float & maxDistanceSquared ) const
+        {
+          float center[4];
+          _mm_storeu_ps( center, m_sphereCenter );
+          sphere = Sphere3f( Vec3f( center[0], center[1], center[2] ), m_sphereRadius );
+          maxDistanceSquared = _mm_cvtss_f32( m_maxDistanceSquared );
+        }
+
+      private:
+        __m128  m_center;
+        __m128  m_maxDistanceSquared;
+        __m128  m_sphereCenter;
+        float   m_sphereRadius;
+        float   m_sphereRadiusSquared;
+        unsigned int m_lastIndex;
+      };
+#else
+      class ExtremalPointsVisitor
+      {
+      public:
+        ExtremalPointsVisitor( unsigned int numberOfPoints )
+        {
+          for ( unsigned int axis = 0; axis < 3; ++axis )
+          {
+            m_lower[axis] = std::numeric_limits<float>::max();
+            m_upper[axis] = -std::numeric_limits<float>::max();
+            m_lowerIndex[axis] = 0;
+            m_upperIndex[axis] = 0;
+          }
+        }
+
+        void operator()( unsigned int index, const float * p )
+        {
+          for ( unsigned int axis = 0; axis < 3; ++axis )
+          {
+            if ( p[axis] < m_lower[axis] )
+            {
+              m_lower[axis] = p[axis];
+              m_lowerIndex[axis] = index;
+            }
+            if ( m_upper[axis] < p[axis] )
+            {
+              m_upper[axis] = p[axis];
+              m_upperIndex[axis] = index;
+            }
+          }
+        }
+
+        void getResult( const PointSet & pointSet, ExtremalPoints & extremalPoints ) const
+        {
+          extremalPoints.box = Box3f();
+          if ( m_lower[0] <= m_upper[0] )
+          {
+            extremalPoints.box = Box3f( Vec3f( m_lower[0], m_lower[1], m_lower[2] ), Vec3f( m_upper[0], m_upper[1], m_upper[2] ) );
+            for ( unsigned int axis = 0; axis < 3; ++axis )
+            {
+              extremalPoints.lower[axis] = getPoint( pointSet, m_lowerIndex[axis] );
+              extremalPoints.upper[axis] = getPoint( pointSet, m_upperIndex[axis] );
+            }
+          }
+        }
+
+      private:
+        float         m_lower[3];
+        float         m_upper[3];
+        unsigned int  m_lowerIndex[3];
+        unsigned int  m_upperIndex[3];
+      };
+
+      class GrowSphereVisitor
+      {
+      public:
+        GrowSphereVisitor( unsigned int numberOfPoints, const Sphere3f & sphere, const Vec3f & center, float maxDistanceSquared )
+          : m_center( center )
+          , m_maxDistanceSquared( maxDistanceSquared )
+          , m_sphereCenter( sphere.getCenter() )
+          , m_sphereRadius( sphere.getRadius() )
+          , m_sphereRadiusSquared( sphere.getRadius() * sphere.getRadius() )
+        {
+          DP_ASSERT( isValid( sphere ) );
+        }
+
+        void operator()( unsigned int index, const float * p )
+        {
+          Vec3f v( p[0], p[1], p[2] );
+          m_maxDistanceSquared = std::max( m_maxDistanceSquared, lengthSquared( v - m_center ) );
+
+          Vec3f d = v - m_sphereCenter;
+          float distanceSquared = lengthSquared( d );
+          if ( m_sphereRadiusSquared < distanceSquared )
+          {
+            float distance = sqrt( distanceSquared );
+            float radius = 0.5f * ( m_sphereRadius + distance );
+            m_sphereCenter += ( ( distance - radius ) / distance ) * d;
+            m_sphereRadius = radius;
+            m_sphereRadiusSquared = radius * radius;
+          }
+        }
+
+        void getResult( Sphere3f & sphere, float & maxDistanceSquared ) const
+        {
+          sphere = Sphere3f( m_sphereCenter, m_sphereRadius );
+          maxDistanceSquared = m_maxDistanceSquared;
+        }
+
+      private:
+        Vec3f m_center;
+        float m_maxDistanceSquared;
+        Vec3f m_sphereCenter;
+        float m_sphereRadius;
+        float m_sphereRadiusSquared;
+      };
+#endif
+    } // namespace
+
+    unsigned int calculateExtremalPoints( const PointSet & pointSet, size_t begin, size_t end, ExtremalPoints & extremalPoints )
+    {
+      ExtremalPointsVisitor visitor( pointSet.numberOfPoints );
+      unsigned int skipped = forEachPoint( pointSet, begin, end, visitor );
+      visitor.getResult( pointSet, extremalPoints );
+      return( skipped );
+    }
+
+    void mergeExtremalPoints( ExtremalPoints & dst, const ExtremalPoints & src )
+    {
+      if ( isValid( src.box ) )
+      {
+        // on ties keep the points of dst, so merging ranges in order gives the same points as a single range
+        bool valid = isValid( dst.box );
+        Vec3f lower = dst.box.getLower();
+        Vec3f upper = dst.box.getUpper();
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+          if ( !valid || ( src.box.getLower()[axis] < lower[axis] ) )
+          {
+            lower[axis] = src.box.getLower()[axis];
+            dst.lower[axis] = src.lower[axis];
+          }
+          if ( !valid || ( upper[axis] < src.box.getUpper()[axis] ) )
+          {
+            upper[axis] = src.box.getUpper()[axis];
+            dst.upper[axis] = src.upper[axis];
+          }
+        }
+        dst.box = Box3f( lower, upper );
+      }
+    }
+
+    Sphere3f initialBoundingSphere( const ExtremalPoints & extremalPoints )
+    {
+      if ( !isValid( extremalPoints.box ) )
+      {
+        return( Sphere3f() );
+      }
+
+      unsigned int axis = 0;
+      float maxDistanceSquared = lengthSquared( extremalPoints.upper[0] - extremalPoints.lower[0] );
+      for ( unsigned int i = 1; i < 3; ++i )
+      {
+        float distanceSquared = lengthSquared( extremalPoints.upper[i] - extremalPoints.lower[i] );
+        if ( maxDistanceSquared < distanceSquared )
+        {
+          maxDistanceSquared = distanceSquared;
+          axis = i;
+        }
+      }
+      return( Sphere3f( 0.5f * ( extremalPoints.lower[axis] + extremalPoints.upper[axis] ), 0.5f * sqrt( maxDistanceSquared ) ) );
+    }
+
+    void growBoundingSphere( const PointSet & pointSet, size_t begin, size_t end, Sphere3f & sphere
+                           , const Vec3f & center, float & maxDistanceSquared )
+    {
+      GrowSphereVisitor visitor( pointSet.numberOfPoints, sphere, center, maxDistanceSquared );
+      forEachPoint( pointSet, begin, end, visitor );
+      visitor.getResult( sphere, maxDistanceSquared );
+    }
+
+  } // namespace math
+} // namespace dp
@@ -0,0 +1,240 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/math/Quantize.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(DP_ARCH_X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace dp
+{
+  namespace math
+  {
+
+    namespace
+    {
+      inline unsigned int asUInt( float f )
+      {
+        unsigned int u;
+        memcpy( &u, &f, sizeof(u) );
+        return( u );
+      }
+
+      inline float asFloat( unsigned int u )
+      {
+        float f;
+        memcpy( &f, &u, sizeof(f) );
+        return( f );
+      }
+
+      // The conversions follow the branch free formulations by Fabian Giesen, so the scalar and the SSE2 versions
+      // produce identical results.
+      const unsigned int halfMaxAsFloat     = ( 127 + 16 ) << 23;                       // all floats >= this become infinity
+      const unsigned int minNormalAsFloat   = ( 127 - 14 ) << 23;                       // smallest float giving a normalized half
+      const unsigned int subnormalMagic     = ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23;
+      const unsigned int normalBias         = 0xfff - ( ( 127 - 15 ) << 23 );          // rebias exponent and round mantissa
+      const unsigned int infinityAsFloat    = 255 << 23;
+      const unsigned int halfToFloatMagic   = ( 254 - 15 ) << 23;
+
+      inline unsigned short floatToHalf( float f )
+      {
+        unsigned int u = asUInt( f );
+        unsigned int sign = u & 0x80000000;
+        u ^= sign;
+
+        unsigned int h;
+        if ( halfMaxAsFloat <= u )
+        {
+          h = ( infinityAsFloat < u ) ? 0x7e00 : 0x7c00;     // NaN stays NaN, infinity stays infinity
+        }
+        else if ( u < minNormalAsFloat )
+        {
+          h = asUInt( asFloat( u ) + asFloat( subnormalMagic ) ) - subnormalMagic;
+        }
+        else
+        {
+          h = ( u + normalBias + ( ( u >> 13 ) & 1 ) ) >> 13;
+        }
+        return( static_cast<unsigned short>( h | ( sign >> 16 ) ) );
+      }
+
+      inline float halfToFloat( unsigned short h )
+      {
+        unsigned int expMant = h & 0x7fff;
+        unsigned int u = asUInt( asFloat( expMant << 13 ) * asFloat( halfToFloatMagic ) );
+        if ( 0x7bff < expMant )
+        {
+          u |= infinityAsFloat;
+        }
+        return( asFloat( u | ( ( h & 0x8000 ) << 16 ) ) );
+      }
+
+      inline short floatToSnorm16( float f )
+      {
+        f = ( f != f ) ? 0.0f : std::min( std::max( f, -1.0f ), 1.0f );     // NaN maps to zero
+        float scaled = f * 32767.0f;
+        return( static_cast<short>( scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f ) );
+      }
+
+      inline float snorm16ToFloat( short s )
+      {
+        return( std::max( s / 32767.0f, -1.0f ) );
+      }
+    }
+
+    void convertFloatToHalf( const float * src, unsigned short * dst, size_t count )
+    {
+      size_t i = 0;
+#if defined(DP_ARCH_X86_64)
+      const __m128i signMask    = _mm_set1_epi32( 0x80000000 );
+      const __m128i halfMax     = _mm_set1_epi32( halfMaxAsFloat - 1 );
+      const __m128i infinity    = _mm_set1_epi32( infinityAsFloat );
+      const __m128i minNormal   = _mm_set1_epi32( minNormalAsFloat );
+      const __m128i magic       = _mm_set1_epi32( subnormalMagic );
+      const __m128i bias        = _mm_set1_epi32( normalBias );
+      const __m128i one         = _mm_set1_epi32( 1 );
+      const __m128i halfInf     = _mm_set1_epi32( 0x7c00 );
+      const __m128i halfNaNBit  = _mm_set1_epi32( 0x0200 );
+      for ( ; i + 8 <= count ; i += 8 )
+      {
+        __m128i packed[2];
+        for ( unsigned int j = 0 ; j < 2 ; ++j )
+        {
+          __m128i u = _mm_castps_si128( _mm_loadu_ps( src + i + 4 * j ) );
+          __m128i sign = _mm_and_si128( u, signMask );
+          u = _mm_xor_si128( u, sign );
+
+          __m128i isInfNaN = _mm_cmpgt_epi32( u, halfMax );
+          __m128i isSubnormal = _mm_cmpgt_epi32( minNormal, u );
+
+          __m128i infNaN = _mm_or_si128( halfInf, _mm_and_si128( _mm_cmpgt_epi32( u, infinity ), halfNaNBit ) );
+          __m128i subnormal = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( _mm_castsi128_ps( u ), _mm_castsi128_ps( magic ) ) ), magic );
+          __m128i normal = _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( u, bias ), _mm_and_si128( _mm_srli_epi32( u, 13 ), one ) ), 13 );
+
+          __m128i h = _mm_or_si128( _mm_and_si128( isSubnormal, subnormal ), _mm_andnot_si128( isSubnormal, normal ) );
+          h = _mm_or_si128( _mm_and_si128( isInfNaN, infNaN ), _mm_andnot_si128( isInfNaN, h ) );
+          h = _mm_or_si128( h, _mm_srli_epi32( sign, 16 ) );
+
+          // sign extend the lower 16 bits, so the saturating pack keeps them unchanged
+          packed[j] = _mm_srai_epi32( _mm_slli_epi32( h, 16 ), 16 );
+        }
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( dst + i ), _mm_packs_epi32( packed[0], packed[1] ) );
+      }
+#endif
+      for ( ; i < count ; ++i )
+      {
+        dst[i] = floatToHalf( src[i] );
+      }
+    }
+
+    void convertHalfToFloat( const unsigned short * src, float * dst, size_t count )
+    {
+      size_t i = 0;
+#if defined(DP_ARCH_X86_64)
+      const __m128i zero      = _mm_setzero_si128();
+      const __m128i noSign    = _mm_set1_epi32( 0x7fff );
+      const __m128i maxFinite = _mm_set1_epi32( 0x7bff );
+      const __m128i infinity  = _mm_set1_epi32( infinityAsFloat );
+      const __m128  magic     = _mm_castsi128_ps( _mm_set1_epi32( halfToFloatMagic ) );
+      for ( ; i + 8 <= count ; i += 8 )
+      {
+        __m128i h8 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src + i ) );
+        __m128i h[2] = { _mm_unpacklo_epi16( h8, zero ), _mm_unpackhi_epi16( h8, zero ) };
+        for ( unsigned int j = 0 ; j < 2 ; ++j )
+        {
+          __m128i expMant = _mm_and_si128( h[j], noSign );
+          __m128i sign = _mm_slli_epi32( _mm_xor_si128( h[j], expMant ), 16 );
+          __m128 scaled = _mm_mul_ps( _mm_castsi128_ps( _mm_slli_epi32( expMant, 13 ) ), magic );
+          __m128i infNaN = _mm_and_si128( _mm_cmpgt_epi32( expMant, maxFinite ), infinity );
+          _mm_storeu_ps( dst + i + 4 * j, _mm_or_ps( scaled, _mm_castsi128_ps( _mm_or_si128( sign, infNaN ) ) ) );
+        }
+      }
+#endif
+      for ( ; i < count ; ++i )
+      {
+        dst[i] = halfToFloat( src[i] );
+      }
+    }
+
+    void convertFloatToSnorm16( const float * src, short * dst, size_t count )
+    {
+      size_t i = 0;
+#if defined(DP_ARCH_X86_64)
+      const __m128 minusOne = _mm_set1_ps( -1.0f );
+      const __m128 plusOne  = _mm_set1_ps( 1.0f );
+      const __m128 scale    = _mm_set1_ps( 32767.0f );
+      const __m128 half     = _mm_set1_ps( 0.5f );
+      const __m128 signMask = _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) );
+      for ( ; i + 8 <= count ; i += 8 )
+      {
+        __m128i packed[2];
+        for ( unsigned int j = 0 ; j < 2 ; ++j )
+        {
+          // max/min return the second operand for NaN, so NaN maps to -1 here; and-ing with the ordered mask maps it to zero
+          __m128 f = _mm_loadu_ps( src + i + 4 * j );
+          __m128 clamped = _mm_and_ps( _mm_cmpord_ps( f, f ), _mm_min_ps( _mm_max_ps( f, minusOne ), plusOne ) );
+          __m128 scaled = _mm_mul_ps( clamped, scale );
+          // round half away from zero and truncate, matching the scalar version
+          scaled = _mm_add_ps( scaled, _mm_or_ps( half, _mm_and_ps( scaled, signMask ) ) );
+          packed[j] = _mm_cvttps_epi32( scaled );
+        }
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( dst + i ), _mm_packs_epi32( packed[0], packed[1] ) );
+      }
+#endif
+      for ( ; i < count ; ++i )
+      {
+        dst[i] = floatToSnorm16( src[i] );
+      }
+    }
+
+    void convertSnorm16ToFloat( const short * src, float * dst, size_t count )
+    {
+      size_t i = 0;
+#if defined(DP_ARCH_X86_64)
+      const __m128 minusOne = _mm_set1_ps( -1.0f );
+      const __m128 scale    = _mm_set1_ps( 32767.0f );
+      for ( ; i + 8 <= count ; i += 8 )
+      {
+        __m128i s8 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src + i ) );
+        // interleave with itself and shift right arithmetically to sign extend
+        __m128i s[2] = { _mm_srai_epi32( _mm_unpacklo_epi16( s8, s8 ), 16 ), _mm_srai_epi32( _mm_unpackhi_epi16( s8, s8 ), 16 ) };
+        for ( unsigned int j = 0 ; j < 2 ; ++j )
+        {
+          _mm_storeu_ps( dst + i + 4 * j, _mm_max_ps( _mm_div_ps( _mm_cvtepi32_ps( s[j] ), scale ), minusOne ) );
+        }
+      }
+#endif
+      for ( ; i < count ; ++i )
+      {
+        dst[i] = snorm16ToFloat( src[i] );
+      }
+    }
+
+  } // namespace math
+} // namespace dp
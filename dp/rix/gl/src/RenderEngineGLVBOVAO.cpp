@@ -75,7 +75,7 @@ namespace dp
             const VertexDataGL::Data& data = vertexAttributes->getVertexDataGLHandle()->m_data[format.m_streamId];
             dp::gl::bind( GL_ARRAY_BUFFER, data.m_buffer->getBuffer() );
             glEnableVertexAttribArray( index );
-            glVertexAttribPointer( index, format.m_numComponents, getGLDataType(format.m_dataType), format.m_numComponents, format.m_stride, (GLvoid*)(data.m_offset + format.m_offset) );
+            glVertexAttribPointer( index, format.m_numComponents, getGLDataType(format.m_dataType), format.m_normalized, format.m_stride, (GLvoid*)(data.m_offset + format.m_offset) );
             vertexAttributeEnabledMask |= 1 << index;
           }
           else
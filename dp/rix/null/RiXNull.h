@@ -0,0 +1,193 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/rix/null/Config.h>
+#include <dp/rix/core/RiX.h>
+
+#include <string>
+
+extern "C"
+{
+  RIX_NULL_API dp::rix::core::Renderer* createRenderer( const char *options );
+};
+
+namespace dp
+{
+  namespace rix
+  {
+    namespace null
+    {
+
+      /** \brief Counters gathered by RiXNull. All sizes are in bytes. A value initialized Statistics is all zero.
+       **/
+      struct Statistics
+      {
+        size_t    m_buffersCreated;
+        size_t    m_texturesCreated;
+        size_t    m_samplersCreated;
+        size_t    m_containersCreated;
+        size_t    m_geometriesCreated;
+        size_t    m_geometryInstancesCreated;
+        size_t    m_programsCreated;
+        size_t    m_renderGroupsCreated;
+        size_t    m_otherObjectsCreated;   // descriptors, formats, vertex data, indices, pipelines, ...
+
+        uint64_t  m_bufferBytesAllocated;  // sum of all buffer sizes ever set
+        uint64_t  m_bufferBytesUploaded;   // bufferUpdateData and write mapped buffers
+        uint64_t  m_textureBytesUploaded;  // base level of textureSetData with TextureDataPtr
+        uint64_t  m_containerBytesUploaded;// raw data passed to containerSetData
+
+        size_t    m_renderCalls;           // calls to render
+        size_t    m_drawCalls;             // visible GeometryInstances processed by render
+        size_t    m_programSwitches;       // ProgramPipeline changes between two draw calls
+        size_t    m_containerSwitches;     // Container changes between two draw calls
+        uint64_t  m_verticesDrawn;         // number of indices or vertices times number of instances
+      };
+
+      /** \brief RiXNull is a renderer which does not talk to any graphics API. It implements the complete
+                 dp::rix::core::Renderer interface on the CPU: all objects are created, buffer, texture and
+                 container data is copied and render traverses the GeometryInstances of the RenderGroup, but
+                 nothing is drawn. Use it to measure the CPU cost of the code driving a RiX renderer on
+                 machines without a GPU.
+          \remarks If the options string passed to createRenderer contains "statistics" the Statistics
+                   are printed to std::cout when the renderer is deleted.
+       **/
+      class RiXNull : public dp::rix::core::Renderer
+      {
+      protected:
+        RiXNull( const char *options );
+
+      public:
+        virtual ~RiXNull();
+        friend RIX_NULL_API dp::rix::core::Renderer* ::createRenderer( char const * );
+
+        RIX_NULL_API Statistics const& getStatistics() const;
+        RIX_NULL_API void resetStatistics();
+
+        // delete the renderer
+        RIX_NULL_API virtual void deleteThis( void );
+
+        RIX_NULL_API virtual void update();
+        RIX_NULL_API virtual void beginRender();
+        RIX_NULL_API virtual void render( dp::rix::core::RenderGroupSharedHandle const & group, dp::rix::core::RenderOptions const & renderOptions = dp::rix::core::RenderOptions() );
+        RIX_NULL_API virtual void render( dp::rix::core::RenderGroupSharedHandle const & group, dp::rix::core::GeometryInstanceSharedHandle const * gis, size_t numGIs, dp::rix::core::RenderOptions const & renderOptions = dp::rix::core::RenderOptions() );
+        RIX_NULL_API virtual void endRender();
+
+        /** VertexFormat **/
+        RIX_NULL_API virtual dp::rix::core::VertexFormatSharedHandle vertexFormatCreate( dp::rix::core::VertexFormatDescription const & vertexFormatDescription );
+
+        /** VertexData **/
+        RIX_NULL_API virtual dp::rix::core::VertexDataSharedHandle vertexDataCreate();
+        RIX_NULL_API virtual void vertexDataSet( dp::rix::core::VertexDataSharedHandle const & handle, unsigned int index, dp::rix::core::BufferSharedHandle const & bufferHandle, size_t offset, size_t numberOfVertices );
+
+        /** VertexAttributes **/
+        RIX_NULL_API virtual dp::rix::core::VertexAttributesSharedHandle vertexAttributesCreate();
+        RIX_NULL_API virtual void vertexAttributesSet( dp::rix::core::VertexAttributesSharedHandle const & handle, dp::rix::core::VertexDataSharedHandle const & vertexData, dp::rix::core::VertexFormatSharedHandle const & vertexFormat );
+
+        /** Indices **/
+        RIX_NULL_API virtual dp::rix::core::IndicesSharedHandle indicesCreate();
+        RIX_NULL_API virtual void indicesSetData( dp::rix::core::IndicesSharedHandle const & handle, dp::DataType dataType, dp::rix::core::BufferSharedHandle const & bufferHandle, size_t offset, size_t count );
+
+        /** Buffer **/
+        RIX_NULL_API virtual dp::rix::core::BufferSharedHandle bufferCreate( dp::rix::core::BufferDescription const & bufferDescription = dp::rix::core::BufferDescription() );
+        RIX_NULL_API virtual void bufferSetSize( dp::rix::core::BufferSharedHandle const & handle, size_t width, size_t height = 0, size_t depth = 0 );
+        RIX_NULL_API virtual void bufferSetElementSize( dp::rix::core::BufferSharedHandle const & handle, size_t elementSize );
+        RIX_NULL_API virtual void bufferSetFormat( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::BufferFormat bufferFormat );
+        RIX_NULL_API virtual void bufferUpdateData( dp::rix::core::BufferSharedHandle const & handle, size_t offset, void const * data, size_t size );
+        RIX_NULL_API virtual void bufferInitReferences( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::BufferReferences const & refinfo );
+        RIX_NULL_API virtual void bufferSetReference( dp::rix::core::BufferSharedHandle const & handle, size_t slot, dp::rix::core::ContainerData const & data, dp::rix::core::BufferStoredReference & stored );
+        RIX_NULL_API virtual void* bufferMap( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::AccessType accessType );
+        RIX_NULL_API virtual bool  bufferUnmap( dp::rix::core::BufferSharedHandle const & handle );
+
+        /** Texture **/
+        RIX_NULL_API virtual dp::rix::core::TextureSharedHandle textureCreate( dp::rix::core::TextureDescription const & description );
+        RIX_NULL_API virtual void textureSetData( dp::rix::core::TextureSharedHandle const & texture, dp::rix::core::TextureData const & data );
+        RIX_NULL_API virtual void textureSetDefaultSamplerState( dp::rix::core::TextureSharedHandle const & texture, dp::rix::core::SamplerStateSharedHandle const & samplerState );
+
+        /** Sampler **/
+        RIX_NULL_API virtual dp::rix::core::SamplerSharedHandle samplerCreate( );
+        RIX_NULL_API virtual void samplerSetSamplerState( dp::rix::core::SamplerSharedHandle const & sampler, dp::rix::core::SamplerStateSharedHandle const & samplerState );
+        RIX_NULL_API virtual void samplerSetTexture( dp::rix::core::SamplerSharedHandle const & sampler, dp::rix::core::TextureSharedHandle const & texture);
+
+        /** SamplerState **/
+        RIX_NULL_API virtual dp::rix::core::SamplerStateSharedHandle samplerStateCreate( dp::rix::core::SamplerStateData const & data );
+
+        /** GeometryDescription **/
+        RIX_NULL_API virtual dp::rix::core::GeometryDescriptionSharedHandle geometryDescriptionCreate();
+        RIX_NULL_API virtual void geometryDescriptionSet( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, GeometryPrimitiveType type, unsigned int primitiveRestartIndex = ~0 );
+        RIX_NULL_API virtual void geometryDescriptionSetBaseVertex( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, unsigned int baseVertex );
+        RIX_NULL_API virtual void geometryDescriptionSetIndexRange( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, unsigned int first, unsigned int count );
+
+        /** Geometry **/
+        RIX_NULL_API virtual dp::rix::core::GeometrySharedHandle geometryCreate();
+        RIX_NULL_API virtual void geometrySetData( dp::rix::core::GeometrySharedHandle const & geometry, dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription
+                                                 , dp::rix::core::VertexAttributesSharedHandle const & vertexAttributes, dp::rix::core::IndicesSharedHandle const & indices = 0 );
+
+        /** GeometryInstance **/
+        RIX_NULL_API virtual dp::rix::core::GeometryInstanceSharedHandle geometryInstanceCreate( dp::rix::core::GeometryInstanceDescription const & geometryInstanceDescription = dp::rix::core::GeometryInstanceDescription() );
+        RIX_NULL_API virtual bool geometryInstanceUseContainer( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::ContainerSharedHandle const & containerHandle );
+        RIX_NULL_API virtual void geometryInstanceSetGeometry( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::GeometrySharedHandle const & geometry );
+        RIX_NULL_API virtual void geometryInstanceSetProgramPipeline( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::ProgramPipelineSharedHandle const & programPipelineHandle );
+        RIX_NULL_API virtual void geometryInstanceSetVisible( dp::rix::core::GeometryInstanceSharedHandle const & handle, bool visible );
+
+        /** Program **/
+        RIX_NULL_API virtual dp::rix::core::ProgramSharedHandle programCreate( dp::rix::core::ProgramDescription const & description );
+
+        /** ProgramPipeline **/
+        RIX_NULL_API virtual dp::rix::core::ProgramPipelineSharedHandle programPipelineCreate( dp::rix::core::ProgramSharedHandle const * programs, unsigned int numPrograms );
+
+        /** Container **/
+        RIX_NULL_API virtual dp::rix::core::ContainerSharedHandle containerCreate( dp::rix::core::ContainerDescriptorSharedHandle const & desc );
+        RIX_NULL_API virtual void containerSetData(dp::rix::core::ContainerSharedHandle const & containerHandle, dp::rix::core::ContainerEntry entry, dp::rix::core::ContainerData const & containerData );
+
+        /** ContainerDescriptor **/
+        RIX_NULL_API virtual dp::rix::core::ContainerDescriptorSharedHandle containerDescriptorCreate( dp::rix::core::ProgramParameterDescriptor const & programParameterDescriptor );
+        RIX_NULL_API virtual unsigned int containerDescriptorGetNumberOfEntries( dp::rix::core::ContainerDescriptorSharedHandle const & desc );
+        RIX_NULL_API virtual dp::rix::core::ContainerEntry containerDescriptorGetEntry( dp::rix::core::ContainerDescriptorSharedHandle const & desc, unsigned int index );
+        RIX_NULL_API virtual dp::rix::core::ContainerEntry containerDescriptorGetEntry( dp::rix::core::ContainerDescriptorSharedHandle const & desc, char const * name );
+
+        /** RenderGroup **/
+        RIX_NULL_API virtual dp::rix::core::RenderGroupSharedHandle renderGroupCreate();
+        RIX_NULL_API virtual void renderGroupAddGeometryInstance( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::GeometryInstanceSharedHandle const & geometryHandle );
+        RIX_NULL_API virtual void renderGroupRemoveGeometryInstance( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::GeometryInstanceSharedHandle const & geometryHandle );
+        RIX_NULL_API virtual void renderGroupSetProgramPipeline( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::ProgramPipelineSharedHandle const & programPipelineHandle );
+        RIX_NULL_API virtual void renderGroupUseContainer( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::ContainerSharedHandle const & containerHandle );
+
+      private:
+        template <typename Iterator>
+        void renderGeometryInstances( Iterator begin, Iterator end, size_t numInstances );
+
+      private:
+        Statistics  m_statistics;
+        bool        m_printStatistics;
+        bool        m_isRendering;
+      };
+
+    } // namespace null
+  } // namespace rix
+} // namespace dp
@@ -0,0 +1,257 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/rix/null/RiXNull.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dp
+{
+  namespace rix
+  {
+    namespace null
+    {
+      class BufferNull : public dp::rix::core::Buffer
+      {
+      public:
+        BufferNull()
+          : m_format( dp::rix::core::BufferFormat::UNKNOWN )
+          , m_elementSize( 1 )
+          , m_width( 0 )
+          , m_height( 0 )
+          , m_depth( 0 )
+          , m_accessType( dp::rix::core::AccessType::NONE )
+        {}
+
+        std::vector<char>                               m_data;
+        dp::rix::core::BufferFormat                     m_format;
+        size_t                                          m_elementSize;
+        size_t                                          m_width;
+        size_t                                          m_height;
+        size_t                                          m_depth;
+        dp::rix::core::AccessType                       m_accessType;
+        std::vector<dp::rix::core::SmartHandledObject>  m_references;
+      };
+
+      class TextureNull : public dp::rix::core::Texture
+      {
+      public:
+        TextureNull( dp::rix::core::TextureDescription const & description )
+          : m_description( description )
+        {}
+
+        dp::rix::core::TextureDescription         m_description;
+        std::vector<char>                         m_data;
+        dp::rix::core::BufferSharedHandle         m_buffer;
+        dp::rix::core::SamplerStateSharedHandle   m_defaultSamplerState;
+      };
+
+      class SamplerStateNull : public dp::rix::core::SamplerState
+      {
+      public:
+        SamplerStateNull( dp::rix::core::SamplerStateDataType type )
+          : m_type( type )
+        {}
+
+        dp::rix::core::SamplerStateDataType m_type;
+      };
+
+      class SamplerNull : public dp::rix::core::Sampler
+      {
+      public:
+        dp::rix::core::SamplerStateSharedHandle m_samplerState;
+        dp::rix::core::TextureSharedHandle      m_texture;
+      };
+
+      class VertexFormatNull : public dp::rix::core::VertexFormat
+      {
+      public:
+        std::vector<dp::rix::core::VertexFormatInfo> m_infos;
+      };
+
+      class VertexDataNull : public dp::rix::core::VertexData
+      {
+      public:
+        struct Stream
+        {
+          Stream()
+            : m_offset( 0 )
+            , m_numberOfVertices( 0 )
+          {}
+
+          dp::rix::core::BufferSharedHandle m_buffer;
+          size_t                            m_offset;
+          size_t                            m_numberOfVertices;
+        };
+
+        std::vector<Stream> m_streams;
+      };
+
+      class VertexAttributesNull : public dp::rix::core::VertexAttributes
+      {
+      public:
+        dp::rix::core::VertexDataSharedHandle   m_vertexData;
+        dp::rix::core::VertexFormatSharedHandle m_vertexFormat;
+      };
+
+      class IndicesNull : public dp::rix::core::Indices
+      {
+      public:
+        IndicesNull()
+          : m_dataType( dp::DataType::UNKNOWN )
+          , m_offset( 0 )
+          , m_count( 0 )
+        {}
+
+        dp::DataType                      m_dataType;
+        dp::rix::core::BufferSharedHandle m_buffer;
+        size_t                            m_offset;
+        size_t                            m_count;
+      };
+
+      class GeometryDescriptionNull : public dp::rix::core::GeometryDescription
+      {
+      public:
+        GeometryDescriptionNull()
+          : m_primitiveType( GeometryPrimitiveType::TRIANGLES )
+          , m_primitiveRestartIndex( ~0 )
+          , m_baseVertex( 0 )
+          , m_indexFirst( 0 )
+          , m_indexCount( ~0 )
+        {}
+
+        GeometryPrimitiveType m_primitiveType;
+        unsigned int          m_primitiveRestartIndex;
+        unsigned int          m_baseVertex;
+        unsigned int          m_indexFirst;
+        unsigned int          m_indexCount;
+      };
+
+      class GeometryNull : public dp::rix::core::Geometry
+      {
+      public:
+        GeometryNull()
+          : m_numberOfElements( 0 )
+        {}
+
+        dp::rix::core::GeometryDescriptionSharedHandle  m_geometryDescription;
+        dp::rix::core::VertexAttributesSharedHandle     m_vertexAttributes;
+        dp::rix::core::IndicesSharedHandle              m_indices;
+        size_t                                          m_numberOfElements;   // indices or vertices drawn per instance
+      };
+
+      class ContainerDescriptorNull : public dp::rix::core::ContainerDescriptor
+      {
+      public:
+        struct ParameterInfo
+        {
+          std::string                           m_name;
+          dp::rix::core::ContainerParameterType m_type;
+          size_t                                m_offset;
+          size_t                                m_size;
+        };
+
+      public:
+        ContainerDescriptorNull( dp::rix::core::ProgramParameter const * parameters, size_t numParameters );
+
+        dp::rix::core::ContainerEntry generateEntry( unsigned short index ) const
+        {
+          return (dp::rix::core::ContainerEntry)(m_id | index);
+        }
+
+        dp::rix::core::ContainerEntry getEntry( char const * name ) const;
+
+        unsigned short getIndex( dp::rix::core::ContainerEntry entry ) const
+        {
+          DP_ASSERT( m_id == ( entry & ( ~0u << 16 ) ) );
+          return (unsigned short)( entry & 0xFFFF );
+        }
+
+        std::vector<ParameterInfo>  m_parameterInfos;
+        unsigned int                m_id;
+        size_t                      m_size;
+
+      private:
+        static unsigned int m_freeId;
+      };
+
+      class ContainerNull : public dp::rix::core::Container
+      {
+      public:
+        ContainerNull( dp::rix::core::ContainerDescriptorSharedHandle const & descriptor );
+
+        dp::rix::core::ContainerDescriptorSharedHandle  m_descriptor;
+        std::vector<char>                               m_data;
+        std::vector<dp::rix::core::SmartHandledObject>  m_references;   // one per parameter, used by SAMPLER, IMAGE and BUFFER parameters
+      };
+
+      class ProgramNull : public dp::rix::core::Program
+      {
+      public:
+        std::vector<dp::rix::core::ContainerDescriptorSharedHandle> m_descriptors;
+        std::vector<std::string>                                    m_codes;
+      };
+
+      class ProgramPipelineNull : public dp::rix::core::ProgramPipeline
+      {
+      public:
+        std::vector<dp::rix::core::ProgramSharedHandle> m_programs;
+      };
+
+      class GeometryInstanceNull : public dp::rix::core::GeometryInstance
+      {
+      public:
+        GeometryInstanceNull()
+          : m_visible( true )
+        {}
+
+        dp::rix::core::GeometrySharedHandle               m_geometry;
+        dp::rix::core::ProgramPipelineSharedHandle        m_programPipeline;
+        std::vector<dp::rix::core::ContainerSharedHandle> m_containers;
+        bool                                              m_visible;
+      };
+
+      class RenderGroupNull : public dp::rix::core::RenderGroup
+      {
+      public:
+        dp::rix::core::ProgramPipelineSharedHandle                                m_programPipeline;
+        std::vector<dp::rix::core::ContainerSharedHandle>                         m_containers;
+        std::vector<dp::rix::core::GeometryInstanceSharedHandle>                  m_geometryInstances;
+        std::unordered_map<dp::rix::core::GeometryInstanceHandle, size_t>         m_geometryInstanceIndices;  // position in m_geometryInstances
+      };
+
+      /** \brief Set containerHandle in containers, replacing a Container with the same ContainerDescriptor.
+          \return true if the Container has been added or replaced another one.
+      **/
+      bool useContainer( std::vector<dp::rix::core::ContainerSharedHandle> & containers, dp::rix::core::ContainerSharedHandle const & containerHandle );
+
+    } // namespace null
+  } // namespace rix
+} // namespace dp
@@ -0,0 +1,850 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/rix/null/RiXNull.h>
+#include <dp/rix/null/inc/HandlesNull.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+dp::rix::core::Renderer* createRenderer( const char *options )
+{
+  return new dp::rix::null::RiXNull( options );
+}
+
+namespace dp
+{
+  namespace rix
+  {
+    namespace null
+    {
+      using dp::rix::core::handleCast;
+      using dp::rix::core::handleIsTypeOf;
+      using dp::rix::core::ContainerParameterType;
+
+      size_t getSizeOf( ContainerParameterType parameterType )
+      {
+        switch ( parameterType )
+        {
+        case ContainerParameterType::INT_8:
+        case ContainerParameterType::UINT_8:
+        case ContainerParameterType::BOOL:
+          return 1;
+        case ContainerParameterType::INT2_8:
+        case ContainerParameterType::UINT2_8:
+        case ContainerParameterType::BOOL2:
+        case ContainerParameterType::INT_16:
+        case ContainerParameterType::UINT_16:
+          return 2;
+        case ContainerParameterType::INT3_8:
+        case ContainerParameterType::UINT3_8:
+        case ContainerParameterType::BOOL3:
+          return 3;
+        case ContainerParameterType::INT4_8:
+        case ContainerParameterType::UINT4_8:
+        case ContainerParameterType::BOOL4:
+        case ContainerParameterType::INT2_16:
+        case ContainerParameterType::UINT2_16:
+        case ContainerParameterType::FLOAT:
+        case ContainerParameterType::INT_32:
+        case ContainerParameterType::UINT_32:
+          return 4;
+        case ContainerParameterType::INT3_16:
+        case ContainerParameterType::UINT3_16:
+          return 6;
+        case ContainerParameterType::INT4_16:
+        case ContainerParameterType::UINT4_16:
+        case ContainerParameterType::FLOAT2:
+        case ContainerParameterType::INT2_32:
+        case ContainerParameterType::UINT2_32:
+        case ContainerParameterType::INT_64:
+        case ContainerParameterType::UINT_64:
+        case ContainerParameterType::BUFFER_ADDRESS:
+          return 8;
+        case ContainerParameterType::FLOAT3:
+        case ContainerParameterType::INT3_32:
+        case ContainerParameterType::UINT3_32:
+          return 12;
+        case ContainerParameterType::FLOAT4:
+        case ContainerParameterType::INT4_32:
+        case ContainerParameterType::UINT4_32:
+        case ContainerParameterType::INT2_64:
+        case ContainerParameterType::UINT2_64:
+        case ContainerParameterType::MAT2X2:
+          return 16;
+        case ContainerParameterType::INT3_64:
+        case ContainerParameterType::UINT3_64:
+        case ContainerParameterType::MAT2X3:
+        case ContainerParameterType::MAT3X2:
+          return 24;
+        case ContainerParameterType::INT4_64:
+        case ContainerParameterType::UINT4_64:
+        case ContainerParameterType::MAT2X4:
+        case ContainerParameterType::MAT4X2:
+          return 32;
+        case ContainerParameterType::MAT3X3:
+          return 36;
+        case ContainerParameterType::MAT3X4:
+        case ContainerParameterType::MAT4X3:
+          return 48;
+        case ContainerParameterType::MAT4X4:
+          return 64;
+        case ContainerParameterType::CALLBACK_:
+          return sizeof(dp::rix::core::CallbackObject);
+        case ContainerParameterType::SAMPLER:
+        case ContainerParameterType::IMAGE:
+        case ContainerParameterType::BUFFER:
+        case ContainerParameterType::NATIVE:
+          return 0;   // stored as reference, see ContainerNull::m_references
+        default:
+          DP_ASSERT( !"unsupported parameter type" );
+          return 0;
+        }
+      }
+
+      bool useContainer( std::vector<dp::rix::core::ContainerSharedHandle> & containers, dp::rix::core::ContainerSharedHandle const & containerHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerNull>( containerHandle ) );
+        dp::rix::core::ContainerDescriptorHandle descriptor = handleCast<ContainerNull>( containerHandle.get() )->m_descriptor.get();
+
+        for ( size_t i = 0; i < containers.size(); ++i )
+        {
+          if ( handleCast<ContainerNull>( containers[i].get() )->m_descriptor.get() == descriptor )
+          {
+            containers[i] = containerHandle;
+            return true;
+          }
+        }
+        containers.push_back( containerHandle );
+        return true;
+      }
+
+      /************************************************************************/
+      /* ContainerDescriptorNull                                              */
+      /************************************************************************/
+      // initialize the first used id to something > 0
+      unsigned int ContainerDescriptorNull::m_freeId = 42;
+
+      ContainerDescriptorNull::ContainerDescriptorNull( dp::rix::core::ProgramParameter const * parameters, size_t numParameters )
+        : m_id( m_freeId++ << 16 )
+        , m_size( 0 )
+      {
+        m_parameterInfos.resize( numParameters );
+        for ( size_t i = 0; i < numParameters; ++i )
+        {
+          ParameterInfo & pi = m_parameterInfos[i];
+          pi.m_name   = parameters[i].m_name;
+          pi.m_type   = parameters[i].m_type;
+          pi.m_offset = m_size;
+          pi.m_size   = getSizeOf( pi.m_type ) * std::max<unsigned int>( parameters[i].m_arraySize, 1 );
+          m_size += pi.m_size;
+        }
+      }
+
+      dp::rix::core::ContainerEntry ContainerDescriptorNull::getEntry( char const * name ) const
+      {
+        for ( size_t i = 0; i < m_parameterInfos.size(); ++i )
+        {
+          if ( m_parameterInfos[i].m_name == name )
+          {
+            return generateEntry( static_cast<unsigned short>(i) );
+          }
+        }
+        return generateEntry( static_cast<unsigned short>(~0) );
+      }
+
+      /************************************************************************/
+      /* ContainerNull                                                        */
+      /************************************************************************/
+      ContainerNull::ContainerNull( dp::rix::core::ContainerDescriptorSharedHandle const & descriptor )
+        : m_descriptor( descriptor )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerDescriptorNull>( descriptor ) );
+        ContainerDescriptorNull const * cdn = handleCast<ContainerDescriptorNull>( descriptor.get() );
+        m_data.resize( cdn->m_size );
+        m_references.resize( cdn->m_parameterInfos.size() );
+      }
+
+      /************************************************************************/
+      /* RiXNull                                                              */
+      /************************************************************************/
+      RiXNull::RiXNull( const char *options )
+        : m_statistics()
+        , m_printStatistics( options && strstr( options, "statistics" ) )
+        , m_isRendering( false )
+      {
+      }
+
+      RiXNull::~RiXNull()
+      {
+        if ( m_printStatistics )
+        {
+          std::cout << "RiXNull statistics" << std::endl
+                    << "  buffers created:             " << m_statistics.m_buffersCreated << std::endl
+                    << "  textures created:            " << m_statistics.m_texturesCreated << std::endl
+                    << "  samplers created:            " << m_statistics.m_samplersCreated << std::endl
+                    << "  containers created:          " << m_statistics.m_containersCreated << std::endl
+                    << "  geometries created:          " << m_statistics.m_geometriesCreated << std::endl
+                    << "  geometry instances created:  " << m_statistics.m_geometryInstancesCreated << std::endl
+                    << "  programs created:            " << m_statistics.m_programsCreated << std::endl
+                    << "  render groups created:       " << m_statistics.m_renderGroupsCreated << std::endl
+                    << "  other objects created:       " << m_statistics.m_otherObjectsCreated << std::endl
+                    << "  buffer bytes allocated:      " << m_statistics.m_bufferBytesAllocated << std::endl
+                    << "  buffer bytes uploaded:       " << m_statistics.m_bufferBytesUploaded << std::endl
+                    << "  texture bytes uploaded:      " << m_statistics.m_textureBytesUploaded << std::endl
+                    << "  container bytes uploaded:    " << m_statistics.m_containerBytesUploaded << std::endl
+                    << "  render calls:                " << m_statistics.m_renderCalls << std::endl
+                    << "  draw calls:                  " << m_statistics.m_drawCalls << std::endl
+                    << "  program switches:            " << m_statistics.m_programSwitches << std::endl
+                    << "  container switches:          " << m_statistics.m_containerSwitches << std::endl
+                    << "  vertices drawn:              " << m_statistics.m_verticesDrawn << std::endl;
+        }
+      }
+
+      Statistics const& RiXNull::getStatistics() const
+      {
+        return m_statistics;
+      }
+
+      void RiXNull::resetStatistics()
+      {
+        m_statistics = Statistics();
+      }
+
+      void RiXNull::deleteThis()
+      {
+        delete this;
+      }
+
+      void RiXNull::update()
+      {
+      }
+
+      void RiXNull::beginRender()
+      {
+        DP_ASSERT( !m_isRendering );
+        m_isRendering = true;
+      }
+
+      void RiXNull::endRender()
+      {
+        DP_ASSERT( m_isRendering );
+        m_isRendering = false;
+      }
+
+      inline size_t getNumberOfElements( GeometryNull const * geometry )
+      {
+        size_t count = 0;
+        if ( geometry->m_indices )
+        {
+          count = handleCast<IndicesNull>( geometry->m_indices.get() )->m_count;
+        }
+        else if ( geometry->m_vertexAttributes )
+        {
+          VertexAttributesNull const * vertexAttributes = handleCast<VertexAttributesNull>( geometry->m_vertexAttributes.get() );
+          if ( vertexAttributes->m_vertexData )
+          {
+            std::vector<VertexDataNull::Stream> const & streams = handleCast<VertexDataNull>( vertexAttributes->m_vertexData.get() )->m_streams;
+            if ( !streams.empty() )
+            {
+              count = streams[0].m_numberOfVertices;
+            }
+          }
+        }
+
+        if ( geometry->m_geometryDescription )
+        {
+          GeometryDescriptionNull const * description = handleCast<GeometryDescriptionNull>( geometry->m_geometryDescription.get() );
+          if ( description->m_indexCount != ~0u )
+          {
+            count = description->m_indexCount;
+          }
+          else
+          {
+            count -= std::min<size_t>( count, description->m_indexFirst );
+          }
+        }
+        return count;
+      }
+
+      template <typename Iterator>
+      void RiXNull::renderGeometryInstances( Iterator begin, Iterator end, size_t numInstances )
+      {
+        GeometryInstanceNull const * previous = nullptr;
+        for ( Iterator it = begin; it != end; ++it )
+        {
+          DP_ASSERT( handleIsTypeOf<GeometryInstanceNull>( *it ) );
+          GeometryInstanceNull const * gi = handleCast<GeometryInstanceNull>( it->get() );
+          if ( !gi->m_visible || !gi->m_geometry )
+          {
+            continue;
+          }
+
+          if ( !previous || ( previous->m_programPipeline.get() != gi->m_programPipeline.get() ) )
+          {
+            ++m_statistics.m_programSwitches;
+          }
+          for ( size_t i = 0; i < gi->m_containers.size(); ++i )
+          {
+            if ( !previous || ( previous->m_containers.size() <= i ) || ( previous->m_containers[i].get() != gi->m_containers[i].get() ) )
+            {
+              ++m_statistics.m_containerSwitches;
+            }
+          }
+
+          ++m_statistics.m_drawCalls;
+          m_statistics.m_verticesDrawn += getNumberOfElements( handleCast<GeometryNull>( gi->m_geometry.get() ) ) * numInstances;
+          previous = gi;
+        }
+      }
+
+      void RiXNull::render( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::RenderOptions const & renderOptions )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        RenderGroupNull const * group = handleCast<RenderGroupNull>( groupHandle.get() );
+
+        ++m_statistics.m_renderCalls;
+        m_statistics.m_containerSwitches += group->m_containers.size();
+        renderGeometryInstances( group->m_geometryInstances.begin(), group->m_geometryInstances.end(), renderOptions.m_numInstances );
+      }
+
+      void RiXNull::render( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::GeometryInstanceSharedHandle const * gis, size_t numGIs, dp::rix::core::RenderOptions const & renderOptions )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        RenderGroupNull const * group = handleCast<RenderGroupNull>( groupHandle.get() );
+
+        ++m_statistics.m_renderCalls;
+        m_statistics.m_containerSwitches += group->m_containers.size();
+        renderGeometryInstances( gis, gis + numGIs, renderOptions.m_numInstances );
+      }
+
+      /** VertexFormat **/
+      dp::rix::core::VertexFormatSharedHandle RiXNull::vertexFormatCreate( dp::rix::core::VertexFormatDescription const & vertexFormatDescription )
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        VertexFormatNull * vertexFormat = new VertexFormatNull;
+        vertexFormat->m_infos.assign( vertexFormatDescription.m_vertexFormatInfos, vertexFormatDescription.m_vertexFormatInfos + vertexFormatDescription.m_numVertexFormatInfos );
+        return vertexFormat;
+      }
+
+      /** VertexData **/
+      dp::rix::core::VertexDataSharedHandle RiXNull::vertexDataCreate()
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        return new VertexDataNull;
+      }
+
+      void RiXNull::vertexDataSet( dp::rix::core::VertexDataSharedHandle const & handle, unsigned int index, dp::rix::core::BufferSharedHandle const & bufferHandle, size_t offset, size_t numberOfVertices )
+      {
+        DP_ASSERT( handleIsTypeOf<VertexDataNull>( handle ) );
+        VertexDataNull * vertexData = handleCast<VertexDataNull>( handle.get() );
+
+        if ( vertexData->m_streams.size() <= index )
+        {
+          vertexData->m_streams.resize( index + 1 );
+        }
+        VertexDataNull::Stream & stream = vertexData->m_streams[index];
+        stream.m_buffer           = bufferHandle;
+        stream.m_offset           = offset;
+        stream.m_numberOfVertices = numberOfVertices;
+      }
+
+      /** VertexAttributes **/
+      dp::rix::core::VertexAttributesSharedHandle RiXNull::vertexAttributesCreate()
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        return new VertexAttributesNull;
+      }
+
+      void RiXNull::vertexAttributesSet( dp::rix::core::VertexAttributesSharedHandle const & handle, dp::rix::core::VertexDataSharedHandle const & vertexData, dp::rix::core::VertexFormatSharedHandle const & vertexFormat )
+      {
+        DP_ASSERT( handleIsTypeOf<VertexAttributesNull>( handle ) );
+        VertexAttributesNull * vertexAttributes = handleCast<VertexAttributesNull>( handle.get() );
+        vertexAttributes->m_vertexData   = vertexData;
+        vertexAttributes->m_vertexFormat = vertexFormat;
+      }
+
+      /** Indices **/
+      dp::rix::core::IndicesSharedHandle RiXNull::indicesCreate()
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        return new IndicesNull;
+      }
+
+      void RiXNull::indicesSetData( dp::rix::core::IndicesSharedHandle const & handle, dp::DataType dataType, dp::rix::core::BufferSharedHandle const & bufferHandle, size_t offset, size_t count )
+      {
+        DP_ASSERT( handleIsTypeOf<IndicesNull>( handle ) );
+        IndicesNull * indices = handleCast<IndicesNull>( handle.get() );
+        indices->m_dataType = dataType;
+        indices->m_buffer   = bufferHandle;
+        indices->m_offset   = offset;
+        indices->m_count    = count;
+      }
+
+      /** Buffer **/
+      dp::rix::core::BufferSharedHandle RiXNull::bufferCreate( dp::rix::core::BufferDescription const & /*bufferDescription*/ )
+      {
+        // native descriptions reference data of another API, just create an empty buffer for them
+        ++m_statistics.m_buffersCreated;
+        return new BufferNull;
+      }
+
+      void RiXNull::bufferSetSize( dp::rix::core::BufferSharedHandle const & handle, size_t width, size_t height, size_t depth )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+        DP_ASSERT( buffer->m_accessType == dp::rix::core::AccessType::NONE );
+
+        buffer->m_width  = width;
+        buffer->m_height = height;
+        buffer->m_depth  = depth;
+
+        size_t size = buffer->m_elementSize * width * std::max<size_t>( height, 1 ) * std::max<size_t>( depth, 1 );
+        if ( size != buffer->m_data.size() )
+        {
+          buffer->m_data.resize( size );
+          m_statistics.m_bufferBytesAllocated += size;
+        }
+      }
+
+      void RiXNull::bufferSetElementSize( dp::rix::core::BufferSharedHandle const & handle, size_t elementSize )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        handleCast<BufferNull>( handle.get() )->m_elementSize = elementSize;
+      }
+
+      void RiXNull::bufferSetFormat( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::BufferFormat bufferFormat )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        handleCast<BufferNull>( handle.get() )->m_format = bufferFormat;
+      }
+
+      void RiXNull::bufferUpdateData( dp::rix::core::BufferSharedHandle const & handle, size_t offset, void const * data, size_t size )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+        DP_ASSERT( buffer->m_accessType == dp::rix::core::AccessType::NONE );
+        DP_ASSERT( offset + size <= buffer->m_data.size() );
+
+        if ( size )
+        {
+          memcpy( &buffer->m_data[offset], data, size );
+          m_statistics.m_bufferBytesUploaded += size;
+        }
+      }
+
+      void RiXNull::bufferInitReferences( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::BufferReferences const & refinfo )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+
+        size_t numSlots = 0;
+        switch ( refinfo.getBufferReferenceType() )
+        {
+        case dp::rix::core::BufferReferenceType::BUFFER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::BufferReferencesBuffer const *>(&refinfo) );
+          numSlots = static_cast<dp::rix::core::BufferReferencesBuffer const &>(refinfo).m_numSlots;
+          break;
+        case dp::rix::core::BufferReferenceType::SAMPLER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::BufferReferencesSampler const *>(&refinfo) );
+          numSlots = static_cast<dp::rix::core::BufferReferencesSampler const &>(refinfo).m_numSlots;
+          break;
+        default:
+          DP_ASSERT( !"Unsupported BufferReferenceType type." );
+          break;
+        }
+        buffer->m_references.assign( numSlots, dp::rix::core::SmartHandledObject() );
+      }
+
+      void RiXNull::bufferSetReference( dp::rix::core::BufferSharedHandle const & handle, size_t slot, dp::rix::core::ContainerData const & data, dp::rix::core::BufferStoredReference & /*stored*/ )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+        DP_ASSERT( slot < buffer->m_references.size() );
+
+        switch ( data.getContainerDataType() )
+        {
+        case dp::rix::core::ContainerDataType::BUFFER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataBuffer const *>(&data) );
+          buffer->m_references[slot] = static_cast<dp::rix::core::ContainerDataBuffer const &>(data).m_bufferHandle.get();
+          break;
+        case dp::rix::core::ContainerDataType::SAMPLER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataSampler const *>(&data) );
+          buffer->m_references[slot] = static_cast<dp::rix::core::ContainerDataSampler const &>(data).m_samplerHandle.get();
+          break;
+        default:
+          DP_ASSERT( !"Unsupported ContainerData type." );
+          break;
+        }
+      }
+
+      void* RiXNull::bufferMap( dp::rix::core::BufferSharedHandle const & handle, dp::rix::core::AccessType accessType )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+        DP_ASSERT( buffer->m_accessType == dp::rix::core::AccessType::NONE );
+
+        buffer->m_accessType = accessType;
+        return buffer->m_data.empty() ? nullptr : &buffer->m_data[0];
+      }
+
+      bool RiXNull::bufferUnmap( dp::rix::core::BufferSharedHandle const & handle )
+      {
+        DP_ASSERT( handleIsTypeOf<BufferNull>( handle ) );
+        BufferNull * buffer = handleCast<BufferNull>( handle.get() );
+        DP_ASSERT( buffer->m_accessType != dp::rix::core::AccessType::NONE );
+
+        if ( ( buffer->m_accessType == dp::rix::core::AccessType::WRITE_ONLY ) || ( buffer->m_accessType == dp::rix::core::AccessType::READ_WRITE ) )
+        {
+          m_statistics.m_bufferBytesUploaded += buffer->m_data.size();
+        }
+        buffer->m_accessType = dp::rix::core::AccessType::NONE;
+        return true;
+      }
+
+      /** Texture **/
+      dp::rix::core::TextureSharedHandle RiXNull::textureCreate( dp::rix::core::TextureDescription const & description )
+      {
+        ++m_statistics.m_texturesCreated;
+        return new TextureNull( description );
+      }
+
+      void RiXNull::textureSetData( dp::rix::core::TextureSharedHandle const & textureHandle, dp::rix::core::TextureData const & data )
+      {
+        DP_ASSERT( handleIsTypeOf<TextureNull>( textureHandle ) );
+        TextureNull * texture = handleCast<TextureNull>( textureHandle.get() );
+
+        switch ( data.getTextureDataType() )
+        {
+        case dp::rix::core::TextureDataType::POINTER:
+          {
+            DP_ASSERT( dynamic_cast<dp::rix::core::TextureDataPtr const *>(&data) );
+            dp::rix::core::TextureDataPtr const & dataPtr = static_cast<dp::rix::core::TextureDataPtr const &>(data);
+
+            // keep a copy of the base level of each layer, like a driver does before uploading it
+            size_t pixelSize = ( dataPtr.m_pixelFormat < dp::PixelFormat::NATIVE ) ? dp::getComponentCount( dataPtr.m_pixelFormat ) * dp::getSizeOf( dataPtr.m_pixelDataType ) : 0;
+            size_t layerSize = pixelSize * texture->m_description.m_width * std::max<size_t>( texture->m_description.m_height, 1 ) * std::max<size_t>( texture->m_description.m_depth, 1 );
+            unsigned int numLayers = std::max( dataPtr.m_numLayers, 1u );
+            unsigned int numLevels = std::max( dataPtr.m_numMipMapLevels, 1u );
+
+            texture->m_data.resize( layerSize * numLayers );
+            if ( layerSize && dataPtr.m_data )
+            {
+              for ( unsigned int layer = 0; layer < numLayers; ++layer )
+              {
+                if ( dataPtr.m_data[layer * numLevels] )
+                {
+                  memcpy( &texture->m_data[layer * layerSize], dataPtr.m_data[layer * numLevels], layerSize );
+                }
+              }
+              m_statistics.m_textureBytesUploaded += texture->m_data.size();
+            }
+          }
+          break;
+        case dp::rix::core::TextureDataType::BUFFER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::TextureDataBuffer const *>(&data) );
+          texture->m_buffer = static_cast<dp::rix::core::TextureDataBuffer const &>(data).m_buffer;
+          break;
+        default:
+          // native data is owned by another API, nothing to copy
+          break;
+        }
+      }
+
+      void RiXNull::textureSetDefaultSamplerState( dp::rix::core::TextureSharedHandle const & texture, dp::rix::core::SamplerStateSharedHandle const & samplerState )
+      {
+        DP_ASSERT( handleIsTypeOf<TextureNull>( texture ) );
+        handleCast<TextureNull>( texture.get() )->m_defaultSamplerState = samplerState;
+      }
+
+      /** Sampler **/
+      dp::rix::core::SamplerSharedHandle RiXNull::samplerCreate()
+      {
+        ++m_statistics.m_samplersCreated;
+        return new SamplerNull;
+      }
+
+      void RiXNull::samplerSetSamplerState( dp::rix::core::SamplerSharedHandle const & sampler, dp::rix::core::SamplerStateSharedHandle const & samplerState )
+      {
+        DP_ASSERT( handleIsTypeOf<SamplerNull>( sampler ) );
+        handleCast<SamplerNull>( sampler.get() )->m_samplerState = samplerState;
+      }
+
+      void RiXNull::samplerSetTexture( dp::rix::core::SamplerSharedHandle const & sampler, dp::rix::core::TextureSharedHandle const & texture )
+      {
+        DP_ASSERT( handleIsTypeOf<SamplerNull>( sampler ) );
+        handleCast<SamplerNull>( sampler.get() )->m_texture = texture;
+      }
+
+      /** SamplerState **/
+      dp::rix::core::SamplerStateSharedHandle RiXNull::samplerStateCreate( dp::rix::core::SamplerStateData const & data )
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        return new SamplerStateNull( data.getSamplerStateDataType() );
+      }
+
+      /** GeometryDescription **/
+      dp::rix::core::GeometryDescriptionSharedHandle RiXNull::geometryDescriptionCreate()
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        return new GeometryDescriptionNull;
+      }
+
+      void RiXNull::geometryDescriptionSet( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, GeometryPrimitiveType type, unsigned int primitiveRestartIndex )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryDescriptionNull>( geometryDescription ) );
+        GeometryDescriptionNull * description = handleCast<GeometryDescriptionNull>( geometryDescription.get() );
+        description->m_primitiveType         = type;
+        description->m_primitiveRestartIndex = primitiveRestartIndex;
+      }
+
+      void RiXNull::geometryDescriptionSetBaseVertex( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, unsigned int baseVertex )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryDescriptionNull>( geometryDescription ) );
+        handleCast<GeometryDescriptionNull>( geometryDescription.get() )->m_baseVertex = baseVertex;
+      }
+
+      void RiXNull::geometryDescriptionSetIndexRange( dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription, unsigned int first, unsigned int count )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryDescriptionNull>( geometryDescription ) );
+        GeometryDescriptionNull * description = handleCast<GeometryDescriptionNull>( geometryDescription.get() );
+        description->m_indexFirst = first;
+        description->m_indexCount = count;
+      }
+
+      /** Geometry **/
+      dp::rix::core::GeometrySharedHandle RiXNull::geometryCreate()
+      {
+        ++m_statistics.m_geometriesCreated;
+        return new GeometryNull;
+      }
+
+      void RiXNull::geometrySetData( dp::rix::core::GeometrySharedHandle const & geometryHandle, dp::rix::core::GeometryDescriptionSharedHandle const & geometryDescription
+                                   , dp::rix::core::VertexAttributesSharedHandle const & vertexAttributes, dp::rix::core::IndicesSharedHandle const & indices )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryNull>( geometryHandle ) );
+        GeometryNull * geometry = handleCast<GeometryNull>( geometryHandle.get() );
+        geometry->m_geometryDescription = geometryDescription;
+        geometry->m_vertexAttributes    = vertexAttributes;
+        geometry->m_indices             = indices;
+      }
+
+      /** GeometryInstance **/
+      dp::rix::core::GeometryInstanceSharedHandle RiXNull::geometryInstanceCreate( dp::rix::core::GeometryInstanceDescription const & /*geometryInstanceDescription*/ )
+      {
+        ++m_statistics.m_geometryInstancesCreated;
+        return new GeometryInstanceNull;
+      }
+
+      bool RiXNull::geometryInstanceUseContainer( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::ContainerSharedHandle const & containerHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryInstanceNull>( handle ) );
+        return useContainer( handleCast<GeometryInstanceNull>( handle.get() )->m_containers, containerHandle );
+      }
+
+      void RiXNull::geometryInstanceSetGeometry( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::GeometrySharedHandle const & geometry )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryInstanceNull>( handle ) );
+        handleCast<GeometryInstanceNull>( handle.get() )->m_geometry = geometry;
+      }
+
+      void RiXNull::geometryInstanceSetProgramPipeline( dp::rix::core::GeometryInstanceSharedHandle const & handle, dp::rix::core::ProgramPipelineSharedHandle const & programPipelineHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryInstanceNull>( handle ) );
+        handleCast<GeometryInstanceNull>( handle.get() )->m_programPipeline = programPipelineHandle;
+      }
+
+      void RiXNull::geometryInstanceSetVisible( dp::rix::core::GeometryInstanceSharedHandle const & handle, bool visible )
+      {
+        DP_ASSERT( handleIsTypeOf<GeometryInstanceNull>( handle ) );
+        handleCast<GeometryInstanceNull>( handle.get() )->m_visible = visible;
+      }
+
+      /** Program **/
+      dp::rix::core::ProgramSharedHandle RiXNull::programCreate( dp::rix::core::ProgramDescription const & description )
+      {
+        ++m_statistics.m_programsCreated;
+        ProgramNull * program = new ProgramNull;
+        program->m_descriptors.assign( description.m_descriptors, description.m_descriptors + description.m_numDescriptors );
+        if ( description.m_shader.m_type == dp::rix::core::ProgramShaderType::CODE )
+        {
+          DP_ASSERT( dynamic_cast<dp::rix::core::ProgramShaderCode const *>(&description.m_shader) );
+          dp::rix::core::ProgramShaderCode const & shaderCode = static_cast<dp::rix::core::ProgramShaderCode const &>(description.m_shader);
+          program->m_codes.assign( shaderCode.m_codes, shaderCode.m_codes + shaderCode.m_numShaders );
+        }
+        return program;
+      }
+
+      /** ProgramPipeline **/
+      dp::rix::core::ProgramPipelineSharedHandle RiXNull::programPipelineCreate( dp::rix::core::ProgramSharedHandle const * programs, unsigned int numPrograms )
+      {
+        ++m_statistics.m_otherObjectsCreated;
+        ProgramPipelineNull * programPipeline = new ProgramPipelineNull;
+        programPipeline->m_programs.assign( programs, programs + numPrograms );
+        return programPipeline;
+      }
+
+      /** Container **/
+      dp::rix::core::ContainerSharedHandle RiXNull::containerCreate( dp::rix::core::ContainerDescriptorSharedHandle const & desc )
+      {
+        ++m_statistics.m_containersCreated;
+        return new ContainerNull( desc );
+      }
+
+      void RiXNull::containerSetData( dp::rix::core::ContainerSharedHandle const & containerHandle, dp::rix::core::ContainerEntry entry, dp::rix::core::ContainerData const & containerData )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerNull>( containerHandle ) );
+        ContainerNull * container = handleCast<ContainerNull>( containerHandle.get() );
+        ContainerDescriptorNull const * descriptor = handleCast<ContainerDescriptorNull>( container->m_descriptor.get() );
+
+        unsigned short index = descriptor->getIndex( entry );
+        DP_ASSERT( index < descriptor->m_parameterInfos.size() );
+        ContainerDescriptorNull::ParameterInfo const & parameterInfo = descriptor->m_parameterInfos[index];
+
+        switch ( containerData.getContainerDataType() )
+        {
+        case dp::rix::core::ContainerDataType::RAW:
+          {
+            DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataRaw const *>(&containerData) );
+            dp::rix::core::ContainerDataRaw const & raw = static_cast<dp::rix::core::ContainerDataRaw const &>(containerData);
+            DP_ASSERT( raw.m_offset + raw.m_size <= parameterInfo.m_size );
+            if ( raw.m_size )
+            {
+              memcpy( &container->m_data[parameterInfo.m_offset + raw.m_offset], raw.m_data, raw.m_size );
+              m_statistics.m_containerBytesUploaded += raw.m_size;
+            }
+          }
+          break;
+        case dp::rix::core::ContainerDataType::BUFFER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataBuffer const *>(&containerData) );
+          container->m_references[index] = static_cast<dp::rix::core::ContainerDataBuffer const &>(containerData).m_bufferHandle.get();
+          break;
+        case dp::rix::core::ContainerDataType::SAMPLER:
+          DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataSampler const *>(&containerData) );
+          container->m_references[index] = static_cast<dp::rix::core::ContainerDataSampler const &>(containerData).m_samplerHandle.get();
+          break;
+        case dp::rix::core::ContainerDataType::IMAGE:
+          DP_ASSERT( dynamic_cast<dp::rix::core::ContainerDataImage const *>(&containerData) );
+          container->m_references[index] = static_cast<dp::rix::core::ContainerDataImage const &>(containerData).m_textureHandle.get();
+          break;
+        default:
+          DP_ASSERT( !"Unsupported ContainerData type." );
+          break;
+        }
+      }
+
+      /** ContainerDescriptor **/
+      dp::rix::core::ContainerDescriptorSharedHandle RiXNull::containerDescriptorCreate( dp::rix::core::ProgramParameterDescriptor const & programParameterDescriptor )
+      {
+        switch ( programParameterDescriptor.getType() )
+        {
+        case dp::rix::core::ProgramParameterDescriptorType::COMMON:
+          {
+            DP_ASSERT( dynamic_cast<dp::rix::core::ProgramParameterDescriptorCommon const *>(&programParameterDescriptor) );
+            dp::rix::core::ProgramParameterDescriptorCommon const & ppdc = static_cast<dp::rix::core::ProgramParameterDescriptorCommon const &>(programParameterDescriptor);
+            ++m_statistics.m_otherObjectsCreated;
+            return new ContainerDescriptorNull( ppdc.m_parameters, ppdc.m_numParameters );
+          }
+        default:
+          DP_ASSERT( !"unsupported ProgramParameterDescriptor type" );
+          return nullptr;
+        }
+      }
+
+      unsigned int RiXNull::containerDescriptorGetNumberOfEntries( dp::rix::core::ContainerDescriptorSharedHandle const & desc )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerDescriptorNull>( desc ) );
+        return static_cast<unsigned int>( handleCast<ContainerDescriptorNull>( desc.get() )->m_parameterInfos.size() );
+      }
+
+      dp::rix::core::ContainerEntry RiXNull::containerDescriptorGetEntry( dp::rix::core::ContainerDescriptorSharedHandle const & desc, unsigned int index )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerDescriptorNull>( desc ) );
+        ContainerDescriptorNull const * descriptor = handleCast<ContainerDescriptorNull>( desc.get() );
+        DP_ASSERT( index < descriptor->m_parameterInfos.size() );
+        return descriptor->generateEntry( static_cast<unsigned short>(index) );
+      }
+
+      dp::rix::core::ContainerEntry RiXNull::containerDescriptorGetEntry( dp::rix::core::ContainerDescriptorSharedHandle const & desc, char const * name )
+      {
+        DP_ASSERT( handleIsTypeOf<ContainerDescriptorNull>( desc ) );
+        return handleCast<ContainerDescriptorNull>( desc.get() )->getEntry( name );
+      }
+
+      /** RenderGroup **/
+      dp::rix::core::RenderGroupSharedHandle RiXNull::renderGroupCreate()
+      {
+        ++m_statistics.m_renderGroupsCreated;
+        return new RenderGroupNull;
+      }
+
+      void RiXNull::renderGroupAddGeometryInstance( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::GeometryInstanceSharedHandle const & geometryHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        RenderGroupNull * group = handleCast<RenderGroupNull>( groupHandle.get() );
+
+        if ( group->m_geometryInstanceIndices.insert( std::make_pair( geometryHandle.get(), group->m_geometryInstances.size() ) ).second )
+        {
+          group->m_geometryInstances.push_back( geometryHandle );
+        }
+      }
+
+      void RiXNull::renderGroupRemoveGeometryInstance( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::GeometryInstanceSharedHandle const & geometryHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        RenderGroupNull * group = handleCast<RenderGroupNull>( groupHandle.get() );
+
+        std::unordered_map<dp::rix::core::GeometryInstanceHandle, size_t>::iterator it = group->m_geometryInstanceIndices.find( geometryHandle.get() );
+        if ( it != group->m_geometryInstanceIndices.end() )
+        {
+          // move the last GeometryInstance into the gap
+          size_t index = it->second;
+          group->m_geometryInstanceIndices.erase( it );
+          if ( index + 1 != group->m_geometryInstances.size() )
+          {
+            group->m_geometryInstances[index] = group->m_geometryInstances.back();
+            group->m_geometryInstanceIndices[group->m_geometryInstances[index].get()] = index;
+          }
+          group->m_geometryInstances.pop_back();
+        }
+      }
+
+      void RiXNull::renderGroupSetProgramPipeline( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::ProgramPipelineSharedHandle const & programPipelineHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        handleCast<RenderGroupNull>( groupHandle.get() )->m_programPipeline = programPipelineHandle;
+      }
+
+      void RiXNull::renderGroupUseContainer( dp::rix::core::RenderGroupSharedHandle const & groupHandle, dp::rix::core::ContainerSharedHandle const & containerHandle )
+      {
+        DP_ASSERT( handleIsTypeOf<RenderGroupNull>( groupHandle ) );
+        useContainer( handleCast<RenderGroupNull>( groupHandle.get() )->m_containers, containerHandle );
+      }
+
+    } // namespace null
+  } // namespace rix
+} // namespace dp
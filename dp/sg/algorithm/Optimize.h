@@ -34,6 +34,7 @@
 #include <dp/sg/algorithm/EliminateTraverser.h>
 #include <dp/sg/algorithm/IdentityToGroupTraverser.h>
 #include <dp/sg/algorithm/NormalizeTraverser.h>
+#include <dp/sg/algorithm/QuantizeTraverser.h>
 #include <dp/sg/algorithm/SearchTraverser.h>
 #include <dp/sg/algorithm/StatisticsTraverser.h>
 #include <dp/sg/algorithm/TriangulateTraverser.h>
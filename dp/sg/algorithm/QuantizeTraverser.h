@@ -0,0 +1,154 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+/** \file */
+
+#include <set>
+#include <dp/sg/algorithm/Config.h>
+#include <dp/sg/algorithm/OptimizeTraverser.h>
+#include <dp/sg/core/VertexAttributeSet.h>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace algorithm
+    {
+
+      /*! \brief OptimizeTraverser that converts float vertex attributes to packed formats under an error budget.
+       *  \remarks Vertex attributes selected by setHalfFloatAttributes are converted to dp::DataType::FLOAT_16.
+       *  Vertex attributes selected by setNormalizedShortAttributes are converted to normalized dp::DataType::INT_16,
+       *  which is suited for unit vectors like normals and tangents. An attribute is only converted if no component
+       *  changes by more than the error budget, set by setErrorBudget. Only attributes of type dp::DataType::FLOAT_32
+       *  are converted, and VertexAttributeSets marked as dynamic are skipped. In the attribute bit masks, the bits of
+       *  the generic attributes ATTR0 to ATTR15 select the conventional attributes they alias.\n
+       *  By default, TEXCOORD0 to TEXCOORD5 are converted to half floats, NORMAL, TANGENT, and BINORMAL are converted
+       *  to normalized shorts, and the error budget is 1/1024.
+       *  \note Traversers operating on the vertex data, like the SmoothTraverser, expect floats. Run the
+       *  QuantizeTraverser after them, as the last step before saving or rendering a scene. */
+      class QuantizeTraverser : public OptimizeTraverser
+      {
+        public:
+          DP_SG_ALGORITHM_API QuantizeTraverser( void );
+          DP_SG_ALGORITHM_API virtual ~QuantizeTraverser( void );
+
+          /*! \brief Get the maximal absolute error per component accepted for a converted attribute. */
+          DP_SG_ALGORITHM_API float getErrorBudget() const;
+
+          /*! \brief Set the maximal absolute error per component accepted for a converted attribute. */
+          DP_SG_ALGORITHM_API void setErrorBudget( float budget );
+
+          /*! \brief Get the bit mask of attributes to convert to half floats. Bit \c i selects attribute \c i. */
+          DP_SG_ALGORITHM_API unsigned int getHalfFloatAttributes() const;
+
+          /*! \brief Set the bit mask of attributes to convert to half floats. Bit \c i selects attribute \c i. */
+          DP_SG_ALGORITHM_API void setHalfFloatAttributes( unsigned int attributes );
+
+          /*! \brief Get the bit mask of attributes to convert to normalized shorts. Bit \c i selects attribute \c i. */
+          DP_SG_ALGORITHM_API unsigned int getNormalizedShortAttributes() const;
+
+          /*! \brief Set the bit mask of attributes to convert to normalized shorts. Bit \c i selects attribute \c i. */
+          DP_SG_ALGORITHM_API void setNormalizedShortAttributes( unsigned int attributes );
+
+          /*! \brief Get the number of bytes of vertex data saved by the last traversal. */
+          DP_SG_ALGORITHM_API size_t getSavedBytes() const;
+
+          REFLECTION_INFO_API( DP_SG_ALGORITHM_API, QuantizeTraverser );
+          BEGIN_DECLARE_STATIC_PROPERTIES
+              DP_SG_ALGORITHM_API DECLARE_STATIC_PROPERTY( ErrorBudget );
+              DP_SG_ALGORITHM_API DECLARE_STATIC_PROPERTY( HalfFloatAttributes );
+              DP_SG_ALGORITHM_API DECLARE_STATIC_PROPERTY( NormalizedShortAttributes );
+          END_DECLARE_STATIC_PROPERTIES
+
+        protected:
+          DP_SG_ALGORITHM_API virtual void doApply( const dp::sg::core::NodeSharedPtr & root );
+
+          //! Convert the selected attributes of a VertexAttributeSet.
+          DP_SG_ALGORITHM_API virtual void handleVertexAttributeSet( dp::sg::core::VertexAttributeSet * p );
+
+        private:
+          bool quantize( dp::sg::core::VertexAttributeSet * p, dp::sg::core::VertexAttributeSet::AttributeID id, dp::DataType type );
+
+        private:
+          float                   m_errorBudget;
+          unsigned int            m_halfFloatAttributes;
+          unsigned int            m_normalizedShortAttributes;
+          size_t                  m_savedBytes;
+          std::set<const void *>  m_objects;      //!< A set of pointers to hold all objects already encountered.
+      };
+
+      inline float QuantizeTraverser::getErrorBudget() const
+      {
+        return( m_errorBudget );
+      }
+
+      inline void QuantizeTraverser::setErrorBudget( float budget )
+      {
+        DP_ASSERT( 0.0f <= budget );
+        if ( m_errorBudget != budget )
+        {
+          m_errorBudget = budget;
+          notify( PropertyEvent( this, PID_ErrorBudget ) );
+        }
+      }
+
+      inline unsigned int QuantizeTraverser::getHalfFloatAttributes() const
+      {
+        return( m_halfFloatAttributes );
+      }
+
+      inline void QuantizeTraverser::setHalfFloatAttributes( unsigned int attributes )
+      {
+        if ( m_halfFloatAttributes != attributes )
+        {
+          m_halfFloatAttributes = attributes;
+          notify( PropertyEvent( this, PID_HalfFloatAttributes ) );
+        }
+      }
+
+      inline unsigned int QuantizeTraverser::getNormalizedShortAttributes() const
+      {
+        return( m_normalizedShortAttributes );
+      }
+
+      inline void QuantizeTraverser::setNormalizedShortAttributes( unsigned int attributes )
+      {
+        if ( m_normalizedShortAttributes != attributes )
+        {
+          m_normalizedShortAttributes = attributes;
+          notify( PropertyEvent( this, PID_NormalizedShortAttributes ) );
+        }
+      }
+
+      inline size_t QuantizeTraverser::getSavedBytes() const
+      {
+        return( m_savedBytes );
+      }
+
+    } // namespace algorithm
+  } // namespace sg
+} // namespace dp
@@ -604,11 +604,8 @@ namespace dp
             }
             DP_ASSERT( newPrimitiveType != PrimitiveType::UNINITIALIZED )
             DP_ASSERT( !newIndices.empty() );
-            IndexSetSharedPtr newIndexSet = IndexSet::create();
-            if ( p->getIndexSet() )
-            {
-              *newIndexSet = *p->getIndexSet();
-            }
+            // clone the IndexSet, an assigned one would write the new indices into the buffer of the original
+            IndexSetSharedPtr newIndexSet = p->getIndexSet() ? std::static_pointer_cast<IndexSet>( p->getIndexSet()->clone() ) : IndexSet::create();
             newIndexSet->setData( &newIndices[0], dp::checked_cast<unsigned int>(newIndices.size()) );
             newIndexSet->setPrimitiveRestartIndex( ~0 );
             PrimitiveSharedPtr primitive = Primitive::create( newPrimitiveType );
@@ -0,0 +1,174 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <dp/math/Quantize.h>
+#include <dp/sg/algorithm/QuantizeTraverser.h>
+#include <dp/util/Memory.h>
+
+using namespace dp::sg::core;
+
+using std::pair;
+using std::set;
+using std::vector;
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace algorithm
+    {
+
+      DEFINE_STATIC_PROPERTY( QuantizeTraverser, ErrorBudget );
+      DEFINE_STATIC_PROPERTY( QuantizeTraverser, HalfFloatAttributes );
+      DEFINE_STATIC_PROPERTY( QuantizeTraverser, NormalizedShortAttributes );
+
+      BEGIN_REFLECTION_INFO( QuantizeTraverser )
+        DERIVE_STATIC_PROPERTIES( QuantizeTraverser, OptimizeTraverser );
+
+        INIT_STATIC_PROPERTY_RW( QuantizeTraverser, ErrorBudget,               float,        Semantic::VALUE, value, value );
+        INIT_STATIC_PROPERTY_RW( QuantizeTraverser, HalfFloatAttributes,       unsigned int, Semantic::VALUE, value, value );
+        INIT_STATIC_PROPERTY_RW( QuantizeTraverser, NormalizedShortAttributes, unsigned int, Semantic::VALUE, value, value );
+      END_REFLECTION_INFO
+
+      QuantizeTraverser::QuantizeTraverser(void)
+      : m_errorBudget( 1.0f / 1024.0f )
+      , m_halfFloatAttributes( 0 )
+      , m_normalizedShortAttributes( 0 )
+      , m_savedBytes( 0 )
+      {
+        for ( unsigned int i = static_cast<unsigned int>(VertexAttributeSet::AttributeID::TEXCOORD0) ; i <= static_cast<unsigned int>(VertexAttributeSet::AttributeID::TEXCOORD5) ; ++i )
+        {
+          m_halfFloatAttributes |= 1 << i;
+        }
+        m_normalizedShortAttributes = ( 1 << static_cast<unsigned int>(VertexAttributeSet::AttributeID::NORMAL) )
+                                    | ( 1 << static_cast<unsigned int>(VertexAttributeSet::AttributeID::TANGENT) )
+                                    | ( 1 << static_cast<unsigned int>(VertexAttributeSet::AttributeID::BINORMAL) );
+      }
+
+      QuantizeTraverser::~QuantizeTraverser(void)
+      {
+      }
+
+      void QuantizeTraverser::doApply( const NodeSharedPtr & root )
+      {
+        DP_ASSERT( root );
+
+        m_savedBytes = 0;
+        OptimizeTraverser::doApply( root );
+
+        m_objects.clear();
+      }
+
+      void QuantizeTraverser::handleVertexAttributeSet( VertexAttributeSet * p )
+      {
+        pair<set<const void *>::iterator,bool> pitb = m_objects.insert( p );
+        if ( pitb.second && optimizationAllowed( p->getSharedPtr<VertexAttributeSet>() ) )
+        {
+          // generic attributes alias the conventional ones, so their bits select the same attributes
+          unsigned int halfFloatAttributes = ( m_halfFloatAttributes | ( m_halfFloatAttributes >> 16 ) ) & 0xFFFF;
+          unsigned int normalizedShortAttributes = ( m_normalizedShortAttributes | ( m_normalizedShortAttributes >> 16 ) ) & 0xFFFF;
+          for ( unsigned int i = 0 ; i < static_cast<unsigned int>(VertexAttributeSet::AttributeID::VERTEX_ATTRIB_COUNT) ; ++i )
+          {
+            VertexAttributeSet::AttributeID id = static_cast<VertexAttributeSet::AttributeID>(i);
+            if ( p->getSizeOfVertexData( id ) && ( p->getTypeOfVertexData( id ) == dp::DataType::FLOAT_32 ) )
+            {
+              bool quantized = false;
+              if ( halfFloatAttributes & ( 1 << i ) )
+              {
+                quantized = quantize( p, id, dp::DataType::FLOAT_16 );
+              }
+              else if ( normalizedShortAttributes & ( 1 << i ) )
+              {
+                quantized = quantize( p, id, dp::DataType::INT_16 );
+                if ( quantized )
+                {
+                  // the normalize flag is stored with the aliased generic attribute
+                  p->setNormalizeEnabled( static_cast<VertexAttributeSet::AttributeID>( static_cast<unsigned int>(VertexAttributeSet::AttributeID::ATTR0) + i ), true );
+                }
+              }
+              if ( quantized )
+              {
+                setTreeModified();
+              }
+            }
+          }
+        }
+      }
+
+      bool QuantizeTraverser::quantize( VertexAttributeSet * p, VertexAttributeSet::AttributeID id, dp::DataType type )
+      {
+        const VertexAttribute & va = p->getVertexAttribute( id );
+        unsigned int count = va.getVertexDataCount();
+        if ( !count )
+        {
+          return( false );
+        }
+        size_t numValues = size_t(va.getVertexDataSize()) * count;
+
+        // gather the data tightly packed
+        vector<float> values( numValues );
+        {
+          Buffer::DataReadLock lock( va.getBuffer(), va.getVertexDataOffsetInBytes()
+                                   , ( count - 1 ) * va.getVertexDataStrideInBytes() + va.getVertexDataBytes() );
+          dp::util::stridedMemcpy( values.data(), 0, va.getVertexDataBytes(), lock.getPtr(), 0, va.getVertexDataStrideInBytes()
+                                 , va.getVertexDataBytes(), count );
+        }
+
+        // encode and decode again to determine the error
+        vector<unsigned short> packed( numValues );
+        vector<float> decoded( numValues );
+        if ( type == dp::DataType::FLOAT_16 )
+        {
+          dp::math::convertFloatToHalf( values.data(), packed.data(), numValues );
+          dp::math::convertHalfToFloat( packed.data(), decoded.data(), numValues );
+        }
+        else
+        {
+          DP_ASSERT( type == dp::DataType::INT_16 );
+          short * packedShorts = reinterpret_cast<short *>( packed.data() );
+          dp::math::convertFloatToSnorm16( values.data(), packedShorts, numValues );
+          dp::math::convertSnorm16ToFloat( packedShorts, decoded.data(), numValues );
+        }
+        for ( size_t i = 0 ; i < numValues ; ++i )
+        {
+          // the negated comparison rejects NaN as well
+          if ( !( std::abs( decoded[i] - values[i] ) <= m_errorBudget ) )
+          {
+            return( false );
+          }
+        }
+
+        p->setVertexData( id, va.getVertexDataSize(), type, packed.data(), 0, count, p->isEnabled( id ) );
+        m_savedBytes += numValues * ( sizeof(float) - sizeof(unsigned short) );
+        return( true );
+      }
+
+    } // namespace algorithm
+  } // namespace sg
+} // namespace dp
@@ -33,6 +33,7 @@
 #include <dp/sg/core/HandledObject.h>
 #include <dp/util/BitMask.h>
 #include <dp/util/Flags.h>
+#include <dp/util/HashGenerator.h>
 #include <dp/util/StridedIterator.h>
 #include <cstring>
 
@@ -109,6 +110,12 @@ namespace dp
         **/
         DP_SG_CORE_API bool isManagedBySystem() const;
 
+        /** \brief Get the 128 bit hash of the data of the Buffer.
+            \remarks The hash is computed by HashGeneratorMurMur3::hashTree on first use and cached until the data of the
+                     Buffer is written. Large buffers are hashed in parallel.
+        **/
+        DP_SG_CORE_API dp::util::HashKey128 const& getContentHash() const;
+
         /** \brief Object to acquire a thread-safe read access to the buffer's data.
          *  \sa WriteLock
         **/
@@ -244,6 +251,14 @@ namespace dp
       protected:
         DP_SG_CORE_API Buffer();
 
+        /** \brief Notify the observers that the data of the Buffer has been written and invalidate the cached content hash.
+        **/
+        DP_SG_CORE_API void notifyDataChanged();
+
+        /** \brief Invalidate the cached content hash without notifying the observers.
+        **/
+        void invalidateContentHash();
+
         /**
          * \brief Retrieve pointer to a range within buffer data. Only use the pointers the way the MapMode describes it!
             \param mode desired MapMode to the buffer
@@ -275,9 +290,11 @@ namespace dp
         void unlockRead() const;
 
       private:
-        mutable int   m_lockCount;
-        mutable void* m_mappedPtr;
-        bool          m_managedBySystem;
+        mutable int                   m_lockCount;
+        mutable void*                 m_mappedPtr;
+        bool                          m_managedBySystem;
+        mutable dp::util::HashKey128  m_contentHash;
+        mutable bool                  m_contentHashValid;
       };
 
       inline Buffer::MapModeMask operator|( Buffer::MapMode bit0, Buffer::MapMode bit1 )
@@ -290,6 +307,11 @@ namespace dp
         return m_managedBySystem;
       }
 
+      inline void Buffer::invalidateContentHash()
+      {
+        m_contentHashValid = false;
+      }
+
       inline void* Buffer::map(MapMode mode)
       {
         return map( mode, 0, getSize() );
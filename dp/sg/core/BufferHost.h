@@ -28,6 +28,7 @@
 /** @file */
 
 #include <dp/sg/core/Buffer.h>
+#include <memory>
 
 namespace dp
 {
@@ -37,6 +38,9 @@ namespace dp
     {
 
       /** \brief Buffer implementation using memory on the host as storage.
+       *  \remarks Clones of a BufferHost share the managed storage until one of them is mapped with MapMode::WRITE
+       *  (copy-on-write). The data is copied on the first write, unless setData overwrites the whole buffer.
+       *  Only the Buffer being written notifies its observers.
        *  \sa Buffer
       **/
       class BufferHost : public Buffer
@@ -54,8 +58,17 @@ namespace dp
         DP_SG_CORE_API virtual void setSize(size_t size);
         DP_SG_CORE_API virtual size_t getSize() const;
 
+        using Buffer::setData;
+        DP_SG_CORE_API virtual void setData( size_t dst_offset, size_t length, const void* src_data );
+
+        /** \brief Check if the storage of this BufferHost is shared with clones of it.
+         *  \remarks The result is only reliable if no other thread clones or releases a BufferHost sharing this storage
+         *  at the same time. **/
+        DP_SG_CORE_API bool isStorageShared() const;
+
       protected:
         DP_SG_CORE_API BufferHost( );
+        DP_SG_CORE_API BufferHost( const BufferHost & rhs );
 
         using Buffer::map;
         DP_SG_CORE_API virtual void *map( MapMode mode, size_t offset, size_t length );
@@ -65,8 +78,13 @@ namespace dp
         DP_SG_CORE_API virtual const void *mapRead(size_t offset, size_t length ) const;
         DP_SG_CORE_API virtual void unmapRead() const;
 
+      private:
+        void detachStorage( bool copyData );
+
+      protected:
 
         size_t                      m_sizeInBytes;
+        std::shared_ptr<char>       m_storage;    // managed data, shared between clones until written
         char*                       m_data;
         mutable Buffer::MapModeMask m_mapMode;
         bool                        m_managed;
@@ -0,0 +1,164 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+/** @file */
+
+#include <dp/sg/core/Buffer.h>
+#include <dp/util/FileMapping.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace core
+    {
+
+      DEFINE_PTR_TYPES( MappedFile );
+
+      /** \brief A file which is mapped into memory on demand by BufferMapped objects.
+       *  \remarks MappedFile::open returns the same MappedFile for all requests of a file as long as it is in use, so scenes
+       *  loaded from the same file share the mapping. The MappedFile keeps the data of the buffers resident, which have
+       *  been mapped recently, until the residency budget is exceeded. Then the least recently used buffers, which are not
+       *  currently mapped, are mapped out again. The operating system loads the pages of a mapped range on first access.
+       *  \note A MappedFile and its BufferMapped objects can be used from multiple threads.
+       *  \sa BufferMapped
+      **/
+      class MappedFile
+      {
+      public:
+        /** \brief Open a file for read-only mapping.
+         *  \param fileName The name of the file to map.
+         *  \return The MappedFile of \a fileName. If the file is already open, the existing MappedFile is returned.
+         *  \note Check isValid before using the returned MappedFile.
+        **/
+        DP_SG_CORE_API static MappedFileSharedPtr open( std::string const& fileName );
+        DP_SG_CORE_API ~MappedFile();
+
+        DP_SG_CORE_API bool isValid() const;
+        DP_SG_CORE_API std::string const& getFileName() const;
+
+        /** \brief Set the number of bytes of the buffers that may stay resident after they have been unmapped.
+            \remarks The default budget is 512 MB. Buffers currently mapped are never evicted, so the resident bytes may
+                     exceed the budget temporarily.
+        **/
+        DP_SG_CORE_API void setResidencyBudget( size_t budget );
+        DP_SG_CORE_API size_t getResidencyBudget() const;
+
+        /** \brief Get the number of bytes of the buffers currently mapped into memory. **/
+        DP_SG_CORE_API size_t getResidentBytes() const;
+
+      protected:
+        MappedFile( std::string const& fileName );
+
+      private:
+        MappedFile( MappedFile const& );
+        MappedFile & operator=( MappedFile const& );
+
+        friend class BufferMapped;
+
+        const void * acquire( BufferMapped const* buffer );
+        void release( BufferMapped const* buffer );
+        void evict( BufferMapped const* buffer );
+        void evict( std::list<BufferMapped const*>::iterator it );
+        void enforceBudget();
+
+      private:
+        std::string                     m_fileName;
+        dp::util::ReadMapping           m_mapping;
+        size_t                          m_residencyBudget;
+        size_t                          m_residentBytes;
+        std::list<BufferMapped const*>  m_residentBuffers;    // most recently used first
+        mutable std::mutex              m_mutex;
+      };
+
+      /** \brief Buffer implementation referencing a byte range of a MappedFile as storage.
+       *  \remarks A BufferMapped maps its range of the file only while it is being accessed or kept resident by its
+       *  MappedFile, which allows working with scenes larger than the available memory. The file is never written.
+       *  Mapping the buffer with MapMode::WRITE or resizing it copies the data to host memory and detaches the buffer
+       *  from the file. Clones of a BufferMapped share the file range.
+       *  \sa Buffer, BufferHost, MappedFile
+      **/
+      class BufferMapped : public Buffer
+      {
+      public:
+        /** \brief Create a Buffer referencing \a size bytes at \a offset of \a file. **/
+        DP_SG_CORE_API static BufferMappedSharedPtr create( MappedFileSharedPtr const& file, size_t offset, size_t size );
+
+        DP_SG_CORE_API virtual HandledObjectSharedPtr clone() const;
+
+        DP_SG_CORE_API virtual ~BufferMapped();
+
+      public:
+        DP_SG_CORE_API virtual void setSize( size_t size );
+        DP_SG_CORE_API virtual size_t getSize() const;
+
+        /** \brief Get the MappedFile referenced by this buffer, or nullptr if the buffer has been detached from the file. **/
+        DP_SG_CORE_API MappedFileSharedPtr const& getFile() const;
+
+        /** \brief Get the offset of the data of this buffer in its MappedFile. **/
+        DP_SG_CORE_API size_t getFileOffset() const;
+
+        /** \brief Check if the data of this buffer is currently mapped into memory. **/
+        DP_SG_CORE_API bool isResident() const;
+
+      protected:
+        DP_SG_CORE_API BufferMapped( MappedFileSharedPtr const& file, size_t offset, size_t size );
+        DP_SG_CORE_API BufferMapped( BufferMapped const& rhs );
+
+        using Buffer::map;
+        DP_SG_CORE_API virtual void *map( MapMode mode, size_t offset, size_t length );
+        DP_SG_CORE_API virtual void unmap( );
+
+        using Buffer::mapRead;
+        DP_SG_CORE_API virtual const void *mapRead( size_t offset, size_t length ) const;
+        DP_SG_CORE_API virtual void unmapRead() const;
+
+      private:
+        void detachFile();
+
+      private:
+        friend class MappedFile;
+
+        MappedFileSharedPtr         m_file;
+        size_t                      m_offset;
+        size_t                      m_size;
+        std::vector<char>           m_data;     // the data after detaching from the file
+        mutable Buffer::MapModeMask m_mapMode;
+
+        // residency state, guarded by the mutex of m_file
+        mutable const void                                * m_residentPtr;
+        mutable unsigned int                                m_pinCount;
+        mutable std::list<BufferMapped const*>::iterator    m_residentIterator;
+      };
+
+    } // namespace core
+  } // namespace sg
+} // namespace dp
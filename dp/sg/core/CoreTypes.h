@@ -75,6 +75,7 @@ namespace dp
       DEFINE_PTR_TYPES( Billboard );
       DEFINE_PTR_TYPES( Buffer );
       DEFINE_PTR_TYPES( BufferHost );
+      DEFINE_PTR_TYPES( BufferMapped );
       DEFINE_PTR_TYPES( Camera );
       DEFINE_PTR_TYPES( ClipPlane );
       DEFINE_PTR_TYPES( FrustumCamera );
@@ -87,6 +88,7 @@ namespace dp
       DEFINE_PTR_TYPES( MatrixCamera );
       DEFINE_PTR_TYPES( Node );
       DEFINE_PTR_TYPES( Object );
+      DEFINE_PTR_TYPES( ObjectArena );
       DEFINE_PTR_TYPES( ParallelCamera );
       DEFINE_PTR_TYPES( ParameterGroupData );
       DEFINE_PTR_TYPES( Path );
@@ -138,6 +140,7 @@ namespace dp
     SHARED_OBJECT_TRAITS( dp::sg::core::Scene,               dp::sg::core::Object );
     SHARED_OBJECT_TRAITS( dp::sg::core::Buffer,              dp::sg::core::HandledObject );
     SHARED_OBJECT_TRAITS( dp::sg::core::BufferHost,          dp::sg::core::Buffer );
+    SHARED_OBJECT_TRAITS( dp::sg::core::BufferMapped,        dp::sg::core::Buffer );
     SHARED_OBJECT_TRAITS( dp::sg::core::Sampler,             dp::sg::core::Object );
     SHARED_OBJECT_TRAITS( dp::sg::core::Texture,             dp::sg::core::HandledObject );
     SHARED_OBJECT_TRAITS( dp::sg::core::TextureFile,         dp::sg::core::Texture );
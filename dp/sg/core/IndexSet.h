@@ -50,6 +50,8 @@ namespace dp
           /*! \brief Creates a new IndexSet */
           static DP_SG_CORE_API IndexSetSharedPtr create();
 
+          /*! \brief Create a copy of this IndexSet.
+           *  \remarks The copy references a clone of the buffer, which shares the storage until written. */
           DP_SG_CORE_API virtual HandledObjectSharedPtr clone() const;
 
           DP_SG_CORE_API ~IndexSet();
@@ -487,6 +487,15 @@ namespace dp
 
         Object const* getObject() const { return m_object; }
 
+        // only signals that the object has changed and can be deferred
+        virtual bool getCoalescingKey( dp::util::Subject const & subject, size_t & key ) const
+        {
+          key = size_t(core::Event::Type::OBJECT);
+          return( m_object == &subject );
+        }
+
+        virtual dp::util::Event * clone() const { return new Event( m_object ); }
+
       private:
         Object const* m_object;
       };
@@ -0,0 +1,315 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+/** @file */
+
+#include <dp/sg/core/Config.h>
+#include <dp/sg/core/CoreTypes.h>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace core
+    {
+
+      /*! \brief Allocation counters of one object type.
+       *  \sa getObjectStatistics, ObjectArena::getStatistics */
+      struct ObjectStatistics
+      {
+        ObjectStatistics()
+          : objects( 0 )
+          , bytes( 0 )
+          , totalObjects( 0 )
+        {
+        }
+
+        std::string name;           //!< The demangled class name of the type.
+        size_t      objects;        //!< The number of living objects of the type.
+        size_t      bytes;          //!< The number of bytes of the living objects, including their shared_ptr control blocks.
+        size_t      totalObjects;   //!< The number of objects of the type which have been allocated so far.
+      };
+
+      /*! \brief Process wide record of one type created by createObject.
+       *  \remarks There's exactly one ObjectType per C++ type, returned by objectType<T>(). It assigns a dense index to
+       *  the type, which the ObjectArena uses for its per type accounting, and counts the living objects of the type
+       *  independent of the arena they have been allocated in. */
+      class ObjectType
+      {
+        public:
+          DP_SG_CORE_API explicit ObjectType( char const* name );
+
+          unsigned int getIndex() const { return( m_index ); }
+          char const* getName() const { return( m_name ); }
+          size_t getObjects() const { return( m_objects ); }
+          size_t getBytes() const { return( m_bytes ); }
+          size_t getTotalObjects() const { return( m_totalObjects ); }
+
+          void allocated( size_t bytes )
+          {
+            ++m_objects;
+            ++m_totalObjects;
+            m_bytes += bytes;
+          }
+
+          void deallocated( size_t bytes )
+          {
+            --m_objects;
+            m_bytes -= bytes;
+          }
+
+        private:
+          char const*         m_name;
+          unsigned int        m_index;
+          std::atomic<size_t> m_objects;
+          std::atomic<size_t> m_bytes;
+          std::atomic<size_t> m_totalObjects;
+      };
+
+      /*! \brief Get the ObjectType of the type T. */
+      template <typename T>
+      inline ObjectType & objectType()
+      {
+        static ObjectType type( typeid(T).name() );
+        return( type );
+      }
+
+      /*! \brief Get the allocation counters of all types which have been created by createObject so far.
+       *  \return A vector with one entry per type, counting the objects of all arenas and those on the heap. */
+      DP_SG_CORE_API std::vector<ObjectStatistics> getObjectStatistics();
+
+      /*! \brief Pool allocator for the objects of a Scene.
+       *  \remarks The create() functions of the objects in dp::sg::core allocate the object together with its
+       *  shared_ptr control block in one block. While an ObjectArena is active on the current thread, those blocks are
+       *  taken from the large chunks of the arena instead of the heap. This saves most of the calls to malloc when
+       *  loading large scenes and places objects which are created one after the other next to each other in memory.
+       *  \par
+       *  Each object holds a reference to its arena. Freed blocks are kept in free lists per size of the arena and are
+       *  reused by the next objects of that size, and the chunks are released in bulk once the last object and the last
+       *  reference to the arena are gone, that is usually when the Scene created in the arena is dropped.
+       *  \par Example
+       *  \code
+       *  SceneSharedPtr scene;
+       *  {
+       *    ObjectArena::Scope scope( ObjectArena::create() );
+       *    scene = loadScene( filename );
+       *  }
+       *  std::vector<ObjectStatistics> statistics = scene->getObjectArena()->getStatistics();
+       *  \endcode
+       *  \note Allocating and freeing objects of one arena is thread safe.
+       *  \sa createObject, Scene::getObjectArena */
+      class ObjectArena : public std::enable_shared_from_this<ObjectArena>
+      {
+        public:
+          /*! \brief Activates an ObjectArena for the current thread for the lifetime of the Scope.
+           *  \remarks Scopes can be nested. The previously active arena is restored on destruction. Passing a nullptr
+           *  allocates the objects created within the Scope on the heap. */
+          class Scope
+          {
+            public:
+              DP_SG_CORE_API explicit Scope( ObjectArenaSharedPtr const& arena );
+              DP_SG_CORE_API ~Scope();
+
+            private:
+              Scope( Scope const& );
+              Scope & operator=( Scope const& );
+
+            private:
+              ObjectArenaSharedPtr  m_arena;
+              ObjectArena         * m_previous;
+          };
+
+        public:
+          /*! \brief Create an ObjectArena.
+           *  \param chunkSize The size in bytes of the chunks requested from the heap. */
+          DP_SG_CORE_API static ObjectArenaSharedPtr create( size_t chunkSize = 1 << 20 );
+          DP_SG_CORE_API ~ObjectArena();
+
+          /*! \brief Get the ObjectArena active on the current thread, or nullptr if there is none. */
+          DP_SG_CORE_API static ObjectArenaSharedPtr getCurrent();
+
+          DP_SG_CORE_API void * allocate( size_t size, ObjectType & type );
+          DP_SG_CORE_API void deallocate( void * ptr, size_t size, ObjectType & type );
+
+          /*! \brief Get the number of bytes requested from the heap. */
+          DP_SG_CORE_API size_t getReservedBytes() const;
+
+          /*! \brief Get the number of bytes of the living objects. */
+          DP_SG_CORE_API size_t getUsedBytes() const;
+
+          /*! \brief Get the allocation counters of all types which have been allocated in this arena. */
+          DP_SG_CORE_API std::vector<ObjectStatistics> getStatistics() const;
+
+        protected:
+          ObjectArena( size_t chunkSize );
+
+        private:
+          ObjectArena( ObjectArena const& );
+          ObjectArena & operator=( ObjectArena const& );
+
+          struct FreeBlock
+          {
+            FreeBlock * next;
+          };
+
+        private:
+          size_t                          m_chunkSize;
+          std::vector<void*>              m_chunks;
+          char                          * m_current;
+          char                          * m_end;
+          std::vector<FreeBlock*>         m_freeLists;
+          std::vector<ObjectStatistics>   m_statistics;
+          size_t                          m_reservedBytes;
+          size_t                          m_usedBytes;
+          mutable std::mutex              m_mutex;
+      };
+
+      /*! \brief Standard conforming allocator for std::allocate_shared, which takes the memory from an ObjectArena or,
+       *  if there's none, from the heap, and counts the allocations of the ObjectType it has been created for. */
+      template <typename T>
+      class ObjectAllocator
+      {
+        public:
+          typedef T         value_type;
+          typedef T*        pointer;
+          typedef T const*  const_pointer;
+          typedef T&        reference;
+          typedef T const&  const_reference;
+          typedef size_t    size_type;
+          typedef ptrdiff_t difference_type;
+
+          template <typename U> struct rebind { typedef ObjectAllocator<U> other; };
+
+          ObjectAllocator( ObjectArenaSharedPtr const& arena, ObjectType & type )
+            : m_arena( arena )
+            , m_type( &type )
+          {
+          }
+
+          template <typename U>
+          ObjectAllocator( ObjectAllocator<U> const& rhs )
+            : m_arena( rhs.getArena() )
+            , m_type( &rhs.getType() )
+          {
+          }
+
+          pointer allocate( size_type count, void const* = nullptr )
+          {
+            if ( count > max_size() )
+            {
+              throw std::bad_alloc();
+            }
+            size_t size = count * sizeof(T);
+            if ( m_arena )
+            {
+              return( static_cast<pointer>( m_arena->allocate( size, *m_type ) ) );
+            }
+            pointer ptr = static_cast<pointer>( ::operator new( size ) );
+            m_type->allocated( size );
+            return( ptr );
+          }
+
+          void deallocate( pointer ptr, size_type count )
+          {
+            size_t size = count * sizeof(T);
+            if ( m_arena )
+            {
+              m_arena->deallocate( ptr, size, *m_type );
+            }
+            else
+            {
+              ::operator delete( ptr );
+              m_type->deallocated( size );
+            }
+          }
+
+          size_type max_size() const
+          {
+            return( std::numeric_limits<size_type>::max() / sizeof(T) );
+          }
+
+          template <typename U, typename... Args>
+          void construct( U* ptr, Args&&... args )
+          {
+            ::new(static_cast<void*>(ptr)) U( std::forward<Args>(args)... );
+          }
+
+          template <typename U>
+          void destroy( U* ptr )
+          {
+            ptr->~U();
+          }
+
+          ObjectArenaSharedPtr const& getArena() const { return( m_arena ); }
+          ObjectType & getType() const { return( *m_type ); }
+
+          template <typename U> bool operator==( ObjectAllocator<U> const& rhs ) const { return( m_arena == rhs.getArena() ); }
+          template <typename U> bool operator!=( ObjectAllocator<U> const& rhs ) const { return( m_arena != rhs.getArena() ); }
+
+        private:
+          ObjectArenaSharedPtr  m_arena;
+          ObjectType          * m_type;
+      };
+
+      /*! \brief Helper to construct objects with protected constructors through std::allocate_shared. */
+      template <typename T>
+      class ObjectConstructor : public T
+      {
+        public:
+          template <typename... Args>
+          ObjectConstructor( Args&&... args )
+            : T( std::forward<Args>(args)... )
+          {
+          }
+      };
+
+      /*! \brief Create an object of type T and its shared_ptr control block in a single allocation.
+       *  \param args The arguments passed to the constructor of T, which may be protected.
+       *  \return A shared_ptr to the new object.
+       *  \remarks The object is allocated in the ObjectArena active on the current thread, or on the heap if there is
+       *  none. The create() and clone() functions of the objects in dp::sg::core use this function.
+       *  \sa ObjectArena */
+      template <typename T, typename... Args>
+      inline std::shared_ptr<T> createObject( Args&&... args )
+      {
+        return( std::allocate_shared<ObjectConstructor<T>>( ObjectAllocator<ObjectConstructor<T>>( ObjectArena::getCurrent(), objectType<T>() )
+                                                          , std::forward<Args>(args)... ) );
+      }
+
+    } // namespace core
+  } // namespace sg
+} // namespace dp
@@ -192,6 +192,14 @@ namespace dp
            *  is invalid. */
           DP_SG_CORE_API virtual dp::math::Sphere3f getBoundingSphere() const;
 
+          /*! \brief Get the ObjectArena the Scene has been created in.
+           *  \return The ObjectArena which has been active on the creating thread when this Scene was created or
+           *  cloned, or nullptr if it has been allocated on the heap.
+           *  \remarks The arena provides the memory accounting of the objects loaded with the Scene. Its memory is
+           *  released when the Scene and all objects allocated in the arena have been dropped.
+           *  \sa ObjectArena */
+          DP_SG_CORE_API const ObjectArenaSharedPtr & getObjectArena() const;
+
         protected:
           /*! \brief Default-constructs a Scene.
            *  \remarks The Scene initially has an ambient color of light grey (0.2, 0.2, 0.2), and a
@@ -214,8 +222,14 @@ namespace dp
           TextureHostSharedPtr        m_backImage;
           CameraContainer             m_cameras;
           NodeSharedPtr               m_root;
+          ObjectArenaSharedPtr        m_objectArena;
       };
 
+      inline const ObjectArenaSharedPtr & Scene::getObjectArena() const
+      {
+        return( m_objectArena );
+      }
+
       inline unsigned int Scene::getNumberOfCameras() const
       {
         return( dp::checked_cast<unsigned int>(m_cameras.size()) );
@@ -57,6 +57,9 @@ namespace dp
         public:
           DP_SG_CORE_API static VertexAttributeSetSharedPtr create();
 
+          /*! \brief Create a copy of this VertexAttributeSet.
+           *  \remarks The copy references clones of the buffers, which share the storage until written. Attributes sharing
+           *  a buffer share the cloned buffer as well. */
           DP_SG_CORE_API virtual HandledObjectSharedPtr clone() const;
 
           DP_SG_CORE_API virtual ~VertexAttributeSet(void);
@@ -714,6 +717,7 @@ namespace dp
            *  \param vertexAttribute VertexAttribute which should be copied over the given attrib
            *  \param enable Optional bool to enable this vertex attribute. Default is \c true.
            *  \remarks The given attribute will not be enabled. Call \sa setEnabled to enable the attribute
+           *  The buffer of \a vertexAttribute is referenced, not cloned.
            */
           DP_SG_CORE_API void setVertexAttribute( AttributeID attrib, const VertexAttribute &vertexAttribute, bool enable = true );
 
@@ -752,6 +756,7 @@ namespace dp
           typedef std::map<AttributeID,VertexAttribute> AttributeContainer;
 
         private:
+          void cloneBuffers();
           void subscribeBuffer( const AttributeContainer::const_iterator & it );
           void unsubscribeBuffer( const AttributeContainer::const_iterator & it );
 
@@ -893,7 +898,7 @@ namespace dp
       {
         DP_ASSERT(attrib>=AttributeID::ATTR0 && attrib<=AttributeID::ATTR15); // only for generic attributes!
         m_normalizeEnableFlags &= ~(1<<static_cast<size_t>(attrib));
-        m_normalizeEnableFlags |= ~((!!enable)<<static_cast<size_t>(attrib));
+        m_normalizeEnableFlags |= ((!!enable)<<static_cast<size_t>(attrib));
         notify( Event( this ) );
       }
 
@@ -26,6 +26,7 @@
 
 #include <dp/sg/core/Billboard.h>
 #include <dp/sg/core/Camera.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -47,12 +48,12 @@ namespace dp
 
       BillboardSharedPtr Billboard::create()
       {
-        return( std::shared_ptr<Billboard>( new Billboard() ) );
+        return( createObject<Billboard>() );
       }
 
       HandledObjectSharedPtr Billboard::clone() const
       {
-        return( std::shared_ptr<Billboard>( new Billboard( *this ) ) );
+        return( createObject<Billboard>( *this ) );
       }
 
       Billboard::Billboard( void )
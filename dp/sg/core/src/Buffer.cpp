@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/Buffer.h>
+#include <dp/util/HashGeneratorMurMur3.h>
 
 namespace dp
 {
@@ -37,6 +38,7 @@ namespace dp
         : m_lockCount(0)
         , m_mappedPtr(nullptr)
         , m_managedBySystem(true)
+        , m_contentHashValid(false)
       {
       }
 
@@ -44,6 +46,32 @@ namespace dp
       {
       }
 
+      dp::util::HashKey128 const& Buffer::getContentHash() const
+      {
+        if ( !m_contentHashValid )
+        {
+          size_t size = getSize();
+          if ( size )
+          {
+            const unsigned char * data = reinterpret_cast<const unsigned char *>( lockRead() );
+            dp::util::HashGeneratorMurMur3::hashTree( data, size, m_contentHash );
+            unlockRead();
+          }
+          else
+          {
+            dp::util::HashGeneratorMurMur3::hashTree( nullptr, 0, m_contentHash );
+          }
+          m_contentHashValid = true;
+        }
+        return( m_contentHash );
+      }
+
+      void Buffer::notifyDataChanged()
+      {
+        m_contentHashValid = false;
+        notify( Event( this ) );
+      }
+
       void Buffer::getData( size_t src_offset, size_t size, void* dst_data) const
       {
         DP_ASSERT( dst_data );
@@ -26,6 +26,8 @@
 
 #include <dp/sg/core/BufferHost.h>
 #include <dp/sg/core/Object.h>
+#include <dp/sg/core/ObjectArena.h>
+#include <cstring>
 
 namespace dp
 {
@@ -36,12 +38,12 @@ namespace dp
 
       BufferHostSharedPtr BufferHost::create()
       {
-        return( std::shared_ptr<BufferHost>( new BufferHost() ) );
+        return( createObject<BufferHost>() );
       }
 
       HandledObjectSharedPtr BufferHost::clone() const
       {
-        return( std::shared_ptr<BufferHost>( new BufferHost( *this ) ) );
+        return( createObject<BufferHost>( *this ) );
       }
 
       BufferHost::BufferHost( )
@@ -52,22 +54,31 @@ namespace dp
       {
       }
 
-      BufferHost::~BufferHost()
+      BufferHost::BufferHost( const BufferHost & rhs )
+        : Buffer( rhs )
+        , m_sizeInBytes( rhs.m_sizeInBytes )
+        , m_storage( rhs.m_storage )
+        , m_data( rhs.m_data )
+        , m_mapMode( MapMode::NONE )
+        , m_managed( true )
       {
-        if ( m_managed )
+        if ( !rhs.m_managed && m_sizeInBytes )
         {
-          delete[] m_data;
+          // unmanaged data is owned by the user, so it can't be shared
+          detachStorage( true );
         }
       }
 
+      BufferHost::~BufferHost()
+      {
+      }
+
       void BufferHost::setUnmanagedDataPtr( void *data )
       {
-        if (m_managed)
-        {
-          delete[] m_data;
-          m_managed = false;
-        }
+        m_storage.reset();
+        m_managed = false;
         m_data = reinterpret_cast<char*>(data);
+        invalidateContentHash();
       }
 
       void *BufferHost::map( MapMode mapMode, size_t offset, size_t size )
@@ -77,17 +88,32 @@ namespace dp
         DP_ASSERT( (offset + size) >= offset && (offset + size) <= m_sizeInBytes );
 
         m_mapMode = mapMode;
+        if ( ( m_mapMode & MapMode::WRITE ) && isStorageShared() )
+        {
+          // a write map keeps the bytes which are not written, e.g. the other attributes of an interleaved buffer
+          detachStorage( true );
+        }
         char* data = reinterpret_cast<char*>( m_data );
         return reinterpret_cast<void*>( data + offset );
       }
 
+      void BufferHost::setData( size_t dst_offset, size_t length, const void* src_data )
+      {
+        if ( ( dst_offset == 0 ) && ( length == m_sizeInBytes ) && isStorageShared() )
+        {
+          // the old data is not needed as it gets overwritten completely
+          detachStorage( false );
+        }
+        Buffer::setData( dst_offset, length, src_data );
+      }
+
       void BufferHost::unmap( )
       {
         DP_ASSERT( m_mapMode != MapMode::NONE );
 
         if ( m_mapMode & MapMode::WRITE )
         {
-          notify( Event( this ) );
+          notifyDataChanged();
         }
         m_mapMode = MapMode::NONE;
       }
@@ -122,15 +148,33 @@ namespace dp
         if ( m_sizeInBytes != size)
         {
           m_sizeInBytes = size;
+          invalidateContentHash();
           if ( m_managed )
           {
-            delete[] m_data;
-            m_data = new char[m_sizeInBytes];
+            m_storage.reset( new char[m_sizeInBytes], std::default_delete<char[]>() );
+            m_data = m_storage.get();
           }
           // TODO: notify about changes? data is currently crap.
         }
       }
 
+      bool BufferHost::isStorageShared() const
+      {
+        return( m_storage && m_storage.use_count() != 1 );
+      }
+
+      void BufferHost::detachStorage( bool copyData )
+      {
+        std::shared_ptr<char> storage( new char[m_sizeInBytes], std::default_delete<char[]>() );
+        if ( copyData )
+        {
+          memcpy( storage.get(), m_data, m_sizeInBytes );
+        }
+        m_storage = storage;
+        m_data = m_storage.get();
+        m_managed = true;
+      }
+
     } // namespace core
   } // namespace sg
 } // namespace dp
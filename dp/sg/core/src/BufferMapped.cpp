@@ -0,0 +1,345 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/core/BufferMapped.h>
+#include <dp/sg/core/ObjectArena.h>
+#include <cstring>
+#include <map>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace core
+    {
+
+      namespace
+      {
+        // the MappedFiles currently in use, to share the mappings of a file
+        std::mutex                                      mappedFilesMutex;
+        std::map<std::string, std::weak_ptr<MappedFile>> mappedFiles;
+      }
+
+      MappedFileSharedPtr MappedFile::open( std::string const& fileName )
+      {
+        std::lock_guard<std::mutex> lock( mappedFilesMutex );
+
+        std::map<std::string, std::weak_ptr<MappedFile>>::iterator it = mappedFiles.find( fileName );
+        MappedFileSharedPtr mappedFile = ( it != mappedFiles.end() ) ? it->second.lock() : MappedFileSharedPtr();
+        if ( !mappedFile )
+        {
+          mappedFile = MappedFileSharedPtr( new MappedFile( fileName ) );
+          mappedFiles[fileName] = mappedFile;
+        }
+        return( mappedFile );
+      }
+
+      MappedFile::MappedFile( std::string const& fileName )
+        : m_fileName( fileName )
+        , m_mapping( fileName )
+        , m_residencyBudget( 512 * 1024 * 1024 )
+        , m_residentBytes( 0 )
+      {
+      }
+
+      MappedFile::~MappedFile()
+      {
+        DP_ASSERT( m_residentBuffers.empty() );
+
+        std::lock_guard<std::mutex> lock( mappedFilesMutex );
+        std::map<std::string, std::weak_ptr<MappedFile>>::iterator it = mappedFiles.find( m_fileName );
+        if ( ( it != mappedFiles.end() ) && it->second.expired() )
+        {
+          mappedFiles.erase( it );
+        }
+      }
+
+      bool MappedFile::isValid() const
+      {
+        return( m_mapping.isValid() );
+      }
+
+      std::string const& MappedFile::getFileName() const
+      {
+        return( m_fileName );
+      }
+
+      void MappedFile::setResidencyBudget( size_t budget )
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_residencyBudget = budget;
+        enforceBudget();
+      }
+
+      size_t MappedFile::getResidencyBudget() const
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return( m_residencyBudget );
+      }
+
+      size_t MappedFile::getResidentBytes() const
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return( m_residentBytes );
+      }
+
+      const void * MappedFile::acquire( BufferMapped const* buffer )
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if ( buffer->m_residentPtr )
+        {
+          // move the buffer to the front of the LRU list
+          m_residentBuffers.splice( m_residentBuffers.begin(), m_residentBuffers, buffer->m_residentIterator );
+        }
+        else
+        {
+          buffer->m_residentPtr = m_mapping.mapIn( buffer->m_offset, buffer->m_size );
+          if ( !buffer->m_residentPtr )
+          {
+            return( nullptr );
+          }
+          buffer->m_residentIterator = m_residentBuffers.insert( m_residentBuffers.begin(), buffer );
+          m_residentBytes += buffer->m_size;
+        }
+        buffer->m_pinCount++;
+        enforceBudget();
+        return( buffer->m_residentPtr );
+      }
+
+      void MappedFile::release( BufferMapped const* buffer )
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        DP_ASSERT( buffer->m_residentPtr && buffer->m_pinCount );
+        if ( buffer->m_pinCount )
+        {
+          buffer->m_pinCount--;
+        }
+        enforceBudget();
+      }
+
+      void MappedFile::evict( BufferMapped const* buffer )
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        DP_ASSERT( buffer->m_pinCount == 0 );
+        if ( buffer->m_residentPtr )
+        {
+          evict( buffer->m_residentIterator );
+        }
+      }
+
+      void MappedFile::evict( std::list<BufferMapped const*>::iterator it )
+      {
+        BufferMapped const* buffer = *it;
+        m_mapping.mapOut( buffer->m_residentPtr );
+        m_residentBytes -= buffer->m_size;
+        m_residentBuffers.erase( it );
+        buffer->m_residentPtr = nullptr;
+      }
+
+      void MappedFile::enforceBudget()
+      {
+        // evict the least recently used buffers not currently mapped until the budget is met
+        std::list<BufferMapped const*>::iterator it = m_residentBuffers.end();
+        while ( ( m_residencyBudget < m_residentBytes ) && ( it != m_residentBuffers.begin() ) )
+        {
+          --it;
+          if ( (*it)->m_pinCount == 0 )
+          {
+            evict( it++ );
+          }
+        }
+      }
+
+
+      BufferMappedSharedPtr BufferMapped::create( MappedFileSharedPtr const& file, size_t offset, size_t size )
+      {
+        return( createObject<BufferMapped>( file, offset, size ) );
+      }
+
+      HandledObjectSharedPtr BufferMapped::clone() const
+      {
+        return( createObject<BufferMapped>( *this ) );
+      }
+
+      BufferMapped::BufferMapped( MappedFileSharedPtr const& file, size_t offset, size_t size )
+        : m_file( file )
+        , m_offset( offset )
+        , m_size( size )
+        , m_mapMode( MapMode::NONE )
+        , m_residentPtr( nullptr )
+        , m_pinCount( 0 )
+      {
+        DP_ASSERT( m_file && m_file->isValid() );
+        if ( !m_size )
+        {
+          // nothing to map for an empty range
+          m_file.reset();
+        }
+      }
+
+      BufferMapped::BufferMapped( BufferMapped const& rhs )
+        : Buffer( rhs )
+        , m_file( rhs.m_file )
+        , m_offset( rhs.m_offset )
+        , m_size( rhs.m_size )
+        , m_data( rhs.m_data )
+        , m_mapMode( MapMode::NONE )
+        , m_residentPtr( nullptr )
+        , m_pinCount( 0 )
+      {
+      }
+
+      BufferMapped::~BufferMapped()
+      {
+        if ( m_file )
+        {
+          m_file->evict( this );
+        }
+      }
+
+      void BufferMapped::detachFile()
+      {
+        DP_ASSERT( m_file );
+
+        m_data.resize( m_size );
+        const void * ptr = m_file->acquire( this );
+        DP_ASSERT( ptr );
+        if ( ptr )
+        {
+          memcpy( m_data.data(), ptr, m_size );
+          m_file->release( this );
+        }
+        m_file->evict( this );
+        m_file.reset();
+      }
+
+      void *BufferMapped::map( MapMode mapMode, size_t offset, size_t size )
+      {
+        DP_ASSERT( m_mapMode == MapMode::NONE );
+        DP_ASSERT( (offset + size) >= offset && (offset + size) <= m_size );
+
+        m_mapMode = mapMode;
+        if ( m_file && ( m_mapMode & MapMode::WRITE ) )
+        {
+          detachFile();
+        }
+
+        if ( m_file )
+        {
+          const char * data = reinterpret_cast<const char *>( m_file->acquire( this ) );
+          // the file is never written, so handing out a non-const pointer for reading is fine
+          return( data ? const_cast<char *>( data ) + offset : nullptr );
+        }
+        return( m_data.data() + offset );
+      }
+
+      void BufferMapped::unmap( )
+      {
+        DP_ASSERT( m_mapMode != MapMode::NONE );
+
+        if ( m_file )
+        {
+          m_file->release( this );
+        }
+        if ( m_mapMode & MapMode::WRITE )
+        {
+          notifyDataChanged();
+        }
+        m_mapMode = MapMode::NONE;
+      }
+
+      const void *BufferMapped::mapRead( size_t offset, size_t size ) const
+      {
+        DP_ASSERT( m_mapMode == MapMode::NONE );
+        DP_ASSERT( (offset + size) >= offset && (offset + size) <= m_size );
+
+        m_mapMode = MapMode::READ;
+        if ( m_file )
+        {
+          const char * data = reinterpret_cast<const char *>( m_file->acquire( this ) );
+          return( data ? data + offset : nullptr );
+        }
+        return( m_data.data() + offset );
+      }
+
+      void BufferMapped::unmapRead( ) const
+      {
+        DP_ASSERT( m_mapMode == MapMode::READ );
+
+        if ( m_file )
+        {
+          m_file->release( this );
+        }
+        m_mapMode = MapMode::NONE;
+      }
+
+      size_t BufferMapped::getSize() const
+      {
+        return( m_size );
+      }
+
+      void BufferMapped::setSize( size_t size )
+      {
+        DP_ASSERT( m_mapMode == MapMode::NONE );
+
+        if ( m_size != size )
+        {
+          if ( m_file )
+          {
+            detachFile();
+          }
+          m_size = size;
+          m_data.resize( m_size );
+          invalidateContentHash();
+        }
+      }
+
+      MappedFileSharedPtr const& BufferMapped::getFile() const
+      {
+        return( m_file );
+      }
+
+      size_t BufferMapped::getFileOffset() const
+      {
+        return( m_offset );
+      }
+
+      bool BufferMapped::isResident() const
+      {
+        if ( !m_file )
+        {
+          return( true );
+        }
+        std::lock_guard<std::mutex> lock( m_file->m_mutex );
+        return( m_residentPtr != nullptr );
+      }
+
+    } // namespace core
+  } // namespace sg
+} // namespace dp
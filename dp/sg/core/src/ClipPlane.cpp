@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/ClipPlane.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -41,12 +42,12 @@ namespace dp
 
       ClipPlaneSharedPtr ClipPlane::create()
       {
-        return( std::shared_ptr<ClipPlane>( new ClipPlane() ) );
+        return( createObject<ClipPlane>() );
       }
 
       HandledObjectSharedPtr ClipPlane::clone() const
       {
-        return( std::shared_ptr<ClipPlane>( new ClipPlane( *this ) ) );
+        return( createObject<ClipPlane>( *this ) );
       }
 
       ClipPlane::ClipPlane()
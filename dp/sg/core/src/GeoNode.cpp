@@ -27,6 +27,7 @@
 #include <dp/sg/core/GeoNode.h>
 #include <dp/sg/core/PipelineData.h>
 #include <dp/sg/core/Primitive.h>
+#include <dp/sg/core/ObjectArena.h>
 
 namespace dp
 {
@@ -41,12 +42,12 @@ namespace dp
 
       GeoNodeSharedPtr GeoNode::create()
       {
-        return( std::shared_ptr<GeoNode>( new GeoNode() ) );
+        return( createObject<GeoNode>() );
       }
 
       HandledObjectSharedPtr GeoNode::clone() const
       {
-        return( std::shared_ptr<GeoNode>( new GeoNode( *this ) ) );
+        return( createObject<GeoNode>( *this ) );
       }
 
       GeoNode::GeoNode()
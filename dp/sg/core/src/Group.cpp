@@ -27,6 +27,7 @@
 #include <dp/sg/core/Group.h>
 #include <dp/sg/core/ClipPlane.h>
 #include <dp/sg/core/LightSource.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -43,12 +44,12 @@ namespace dp
 
       GroupSharedPtr Group::create()
       {
-        return( std::shared_ptr<Group>( new Group() ) );
+        return( createObject<Group>() );
       }
 
       HandledObjectSharedPtr Group::clone() const
       {
-        return( std::shared_ptr<Group>( new Group( *this ) ) );
+        return( createObject<Group>( *this ) );
       }
 
       Group::Group()
@@ -27,6 +27,7 @@
 #include <dp/sg/core/CoreTypes.h>
 #include <dp/sg/core/IndexSet.h>
 #include <dp/sg/core/BufferHost.h>
+#include <dp/sg/core/ObjectArena.h>
 
 namespace dp
 {
@@ -41,12 +42,18 @@ namespace dp
 
       IndexSetSharedPtr IndexSet::create()
       {
-        return( std::shared_ptr<IndexSet>( new IndexSet() ) );
+        return( createObject<IndexSet>() );
       }
 
       HandledObjectSharedPtr IndexSet::clone() const
       {
-        return( std::shared_ptr<IndexSet>( new IndexSet( *this ) ) );
+        // the clone gets a clone of the buffer, a BufferHost clone shares the storage until one of them is written
+        IndexSetSharedPtr indexSet = createObject<IndexSet>( *this );
+        if ( m_buffer )
+        {
+          indexSet->setBuffer( std::static_pointer_cast<Buffer>( m_buffer->clone() ), m_numberOfIndices, m_dataType, m_primitiveRestartIndex );
+        }
+        return( indexSet );
       }
 
       IndexSet::IndexSet()
@@ -214,10 +221,10 @@ namespace dp
         hg.update( reinterpret_cast<const unsigned char *>(&m_dataType), sizeof(m_dataType) );
         hg.update( reinterpret_cast<const unsigned char *>(&m_numberOfIndices), sizeof(m_numberOfIndices) );
         hg.update( reinterpret_cast<const unsigned char *>(&m_primitiveRestartIndex), sizeof(m_primitiveRestartIndex) );
-        // TODO: should we add hash key handling to Buffer ?
         if ( m_buffer )
         {
-          hg.update( m_buffer );
+          dp::util::HashKey128 const& contentHash = m_buffer->getContentHash();
+          hg.update( reinterpret_cast<const unsigned char *>(&contentHash), sizeof(contentHash) );
         }
       }
 
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/LOD.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <cstring>
 
 using namespace dp::math;
@@ -45,12 +46,12 @@ namespace dp
 
       LODSharedPtr LOD::create()
       {
-        return( std::shared_ptr<LOD>( new LOD() ) );
+        return( createObject<LOD>() );
       }
 
       HandledObjectSharedPtr LOD::clone() const
       {
-        return( std::shared_ptr<LOD>( new LOD( *this ) ) );
+        return( createObject<LOD>( *this ) );
       }
 
       LOD::LOD( void )
@@ -25,6 +25,7 @@
 
 #include <dp/sg/core/PipelineData.h>
 #include <dp/sg/core/LightSource.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -51,12 +52,12 @@ namespace dp
 
       LightSourceSharedPtr LightSource::create()
       {
-        return( std::shared_ptr<LightSource>( new LightSource() ) );
+        return( createObject<LightSource>() );
       }
 
       HandledObjectSharedPtr LightSource::clone() const
       {
-        return( std::shared_ptr<LightSource>( new LightSource( *this ) ) );
+        return( createObject<LightSource>( *this ) );
       }
 
       LightSource::LightSource()
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/MatrixCamera.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <cstring>
 
 #if defined(_M_IX86) || defined(_X86_) || defined(_M_X64) || defined(__x86_64__)
@@ -150,12 +151,12 @@ namespace dp
 
       MatrixCameraSharedPtr MatrixCamera::create()
       {
-        return( std::shared_ptr<MatrixCamera>( new MatrixCamera() ) );
+        return( createObject<MatrixCamera>() );
       }
 
       HandledObjectSharedPtr MatrixCamera::clone() const
       {
-        return( std::shared_ptr<MatrixCamera>( new MatrixCamera( *this ) ) );
+        return( createObject<MatrixCamera>( *this ) );
       }
 
       MatrixCamera::MatrixCamera(void)
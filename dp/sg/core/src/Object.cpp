@@ -31,7 +31,7 @@
 #include <dp/sg/core/PipelineData.h>
 #include <dp/sg/core/Switch.h>
 #include <dp/sg/core/Transform.h>
-#include <dp/util/HashGeneratorMurMur.h>
+#include <dp/util/HashGeneratorMurMur3.h>
 
 namespace dp
 {
@@ -221,9 +221,11 @@ namespace dp
       {
         if (m_dirtyState & DP_SG_HASH_KEY)
         {
-          util::HashGeneratorMurMur hg;
+          util::HashGeneratorMurMur3 hg;
           feedHashGenerator(hg);
-          hg.finalize((unsigned int *)&m_hashKey);
+          util::HashKey128 hashKey;
+          hg.finalize(&hashKey);
+          m_hashKey = static_cast<util::HashKey>(hashKey.low);
           m_dirtyState &= ~DP_SG_HASH_KEY;
         }
         return(m_hashKey);
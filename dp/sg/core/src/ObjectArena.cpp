@@ -0,0 +1,279 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/core/ObjectArena.h>
+#include <dp/Assert.h>
+#include <dp/util/Memory.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(DP_COMPILER_GCC)
+# include <cxxabi.h>
+# include <cstdlib>
+#endif
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace core
+    {
+
+      namespace
+      {
+        // blocks are aligned and rounded up to this size
+        size_t const blockAlignment = 16;
+
+        // larger blocks are taken from the heap, smaller ones from the chunks and the free lists
+        size_t const maxPooledSize = 4096;
+
+        // the ObjectArena of the innermost ObjectArena::Scope of each thread
+        thread_local ObjectArena * currentArena = nullptr;
+
+        std::mutex & typesMutex()
+        {
+          static std::mutex mutex;
+          return( mutex );
+        }
+
+        std::vector<ObjectType*> & types()
+        {
+          static std::vector<ObjectType*> types;
+          return( types );
+        }
+
+        std::string demangle( char const* name )
+        {
+#if defined(DP_COMPILER_GCC)
+          int status = 0;
+          char * demangled = abi::__cxa_demangle( name, nullptr, nullptr, &status );
+          if ( demangled )
+          {
+            std::string result( demangled );
+            free( demangled );
+            return( result );
+          }
+#elif defined(DP_COMPILER_MSVC)
+          // strip the "class " prefix of the type names
+          char const* space = strchr( name, ' ' );
+          if ( space )
+          {
+            return( std::string( space + 1 ) );
+          }
+#endif
+          return( std::string( name ) );
+        }
+
+        inline size_t blockSize( size_t size )
+        {
+          return( ( size + blockAlignment - 1 ) & ~( blockAlignment - 1 ) );
+        }
+      }
+
+      /************************************************************************/
+      /* ObjectType                                                           */
+      /************************************************************************/
+
+      ObjectType::ObjectType( char const* name )
+        : m_name( name )
+        , m_objects( 0 )
+        , m_bytes( 0 )
+        , m_totalObjects( 0 )
+      {
+        std::lock_guard<std::mutex> lock( typesMutex() );
+        m_index = dp::checked_cast<unsigned int>( types().size() );
+        types().push_back( this );
+      }
+
+      std::vector<ObjectStatistics> getObjectStatistics()
+      {
+        std::lock_guard<std::mutex> lock( typesMutex() );
+        std::vector<ObjectStatistics> statistics( types().size() );
+        for ( size_t index = 0; index < types().size(); ++index )
+        {
+          statistics[index].name         = demangle( types()[index]->getName() );
+          statistics[index].objects      = types()[index]->getObjects();
+          statistics[index].bytes        = types()[index]->getBytes();
+          statistics[index].totalObjects = types()[index]->getTotalObjects();
+        }
+        return( statistics );
+      }
+
+      /************************************************************************/
+      /* ObjectArena::Scope                                                   */
+      /************************************************************************/
+
+      ObjectArena::Scope::Scope( ObjectArenaSharedPtr const& arena )
+        : m_arena( arena )
+        , m_previous( currentArena )
+      {
+        currentArena = m_arena.get();
+      }
+
+      ObjectArena::Scope::~Scope()
+      {
+        DP_ASSERT( currentArena == m_arena.get() && "ObjectArena::Scopes destroyed out of order" );
+        currentArena = m_previous;
+      }
+
+      /************************************************************************/
+      /* ObjectArena                                                          */
+      /************************************************************************/
+
+      ObjectArenaSharedPtr ObjectArena::create( size_t chunkSize )
+      {
+        return( std::shared_ptr<ObjectArena>( new ObjectArena( chunkSize ) ) );
+      }
+
+      ObjectArena::ObjectArena( size_t chunkSize )
+        : m_chunkSize( std::max( blockSize( chunkSize ), maxPooledSize ) )
+        , m_current( nullptr )
+        , m_end( nullptr )
+        , m_freeLists( maxPooledSize / blockAlignment + 1, nullptr )
+        , m_reservedBytes( 0 )
+        , m_usedBytes( 0 )
+      {
+      }
+
+      ObjectArena::~ObjectArena()
+      {
+        DP_ASSERT( m_usedBytes == 0 );
+        for ( size_t index = 0; index < m_chunks.size(); ++index )
+        {
+          dp::util::alignedFree( m_chunks[index] );
+        }
+      }
+
+      ObjectArenaSharedPtr ObjectArena::getCurrent()
+      {
+        return( currentArena ? currentArena->shared_from_this() : ObjectArenaSharedPtr() );
+      }
+
+      void * ObjectArena::allocate( size_t size, ObjectType & type )
+      {
+        size_t const bytes = blockSize( size );
+        void * ptr = nullptr;
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+        if ( maxPooledSize < bytes )
+        {
+          ptr = dp::util::alignedMalloc( bytes, blockAlignment );
+          if ( !ptr )
+          {
+            throw std::bad_alloc();
+          }
+        }
+        else if ( m_freeLists[bytes / blockAlignment] )
+        {
+          FreeBlock * block = m_freeLists[bytes / blockAlignment];
+          m_freeLists[bytes / blockAlignment] = block->next;
+          ptr = block;
+        }
+        else
+        {
+          if ( m_end < m_current + bytes )
+          {
+            m_current = static_cast<char*>( dp::util::alignedMalloc( m_chunkSize, blockAlignment ) );
+            if ( !m_current )
+            {
+              throw std::bad_alloc();
+            }
+            m_end = m_current + m_chunkSize;
+            m_chunks.push_back( m_current );
+            m_reservedBytes += m_chunkSize;
+          }
+          ptr = m_current;
+          m_current += bytes;
+        }
+
+        if ( m_statistics.size() <= type.getIndex() )
+        {
+          m_statistics.resize( type.getIndex() + 1 );
+        }
+        ObjectStatistics & statistics = m_statistics[type.getIndex()];
+        ++statistics.objects;
+        ++statistics.totalObjects;
+        statistics.bytes += bytes;
+        m_usedBytes += bytes;
+        type.allocated( bytes );
+        return( ptr );
+      }
+
+      void ObjectArena::deallocate( void * ptr, size_t size, ObjectType & type )
+      {
+        size_t const bytes = blockSize( size );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+        if ( maxPooledSize < bytes )
+        {
+          dp::util::alignedFree( ptr );
+        }
+        else
+        {
+          FreeBlock * block = static_cast<FreeBlock*>( ptr );
+          block->next = m_freeLists[bytes / blockAlignment];
+          m_freeLists[bytes / blockAlignment] = block;
+        }
+
+        DP_ASSERT( type.getIndex() < m_statistics.size() );
+        ObjectStatistics & statistics = m_statistics[type.getIndex()];
+        --statistics.objects;
+        statistics.bytes -= bytes;
+        m_usedBytes -= bytes;
+        type.deallocated( bytes );
+      }
+
+      size_t ObjectArena::getReservedBytes() const
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return( m_reservedBytes );
+      }
+
+      size_t ObjectArena::getUsedBytes() const
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return( m_usedBytes );
+      }
+
+      std::vector<ObjectStatistics> ObjectArena::getStatistics() const
+      {
+        std::vector<ObjectStatistics> statistics;
+        {
+          std::lock_guard<std::mutex> lock( m_mutex );
+          statistics = m_statistics;
+        }
+
+        std::lock_guard<std::mutex> lock( typesMutex() );
+        for ( size_t index = 0; index < statistics.size(); ++index )
+        {
+          statistics[index].name = demangle( types()[index]->getName() );
+        }
+        return( statistics );
+      }
+
+    } // namespace core
+  } // namespace sg
+} // namespace dp
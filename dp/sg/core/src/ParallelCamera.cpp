@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/ParallelCamera.h>
+#include <dp/sg/core/ObjectArena.h>
 
 // enable memory leak detection
 
@@ -43,12 +44,12 @@ namespace dp
 
       ParallelCameraSharedPtr ParallelCamera::create()
       {
-        return( std::shared_ptr<ParallelCamera>( new ParallelCamera() ) );
+        return( createObject<ParallelCamera>() );
       }
 
       HandledObjectSharedPtr ParallelCamera::clone() const
       {
-        return( std::shared_ptr<ParallelCamera>( new ParallelCamera( *this ) ) );
+        return( createObject<ParallelCamera>( *this ) );
       }
 
       ParallelCamera::ParallelCamera(void)
@@ -31,6 +31,7 @@
 #include <dp/sg/core/Sampler.h>
 #include <dp/sg/core/TextureFile.h>
 #include <dp/sg/core/TextureHost.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <dp/util/File.h>
 #include <boost/algorithm/string.hpp>
 
@@ -53,17 +54,17 @@ namespace dp
 
       ParameterGroupDataSharedPtr ParameterGroupData::create( const ParameterGroupSpecSharedPtr & parameterGroupSpec )
       {
-        return( std::shared_ptr<ParameterGroupData>( new ParameterGroupData( parameterGroupSpec ) ) );
+        return( createObject<ParameterGroupData>( parameterGroupSpec ) );
       }
 
       ParameterGroupDataSharedPtr ParameterGroupData::create( const dp::fx::ParameterGroupDataSharedPtr & parameterGroupData )
       {
-        return( std::shared_ptr<ParameterGroupData>( new ParameterGroupData( parameterGroupData ) ) );
+        return( createObject<ParameterGroupData>( parameterGroupData ) );
       }
 
       HandledObjectSharedPtr ParameterGroupData::clone() const
       {
-        return( std::shared_ptr<ParameterGroupData>( new ParameterGroupData( *this ) ) );
+        return( createObject<ParameterGroupData>( *this ) );
       }
 
       template <typename ValueType>
@@ -28,6 +28,7 @@
 #include <dp/sg/core/Path.h>
 #include <dp/sg/core/LightSource.h>
 #include <dp/sg/core/Transform.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <dp/math/Matmnt.h>
 
 using namespace dp::math;
@@ -41,12 +42,12 @@ namespace dp
 
       PathSharedPtr Path::create()
       {
-        return( std::shared_ptr<Path>( new Path() ) );
+        return( createObject<Path>() );
       }
 
       PathSharedPtr Path::create( PathSharedPtr const& rhs )
       {
-        return( std::shared_ptr<Path>( new Path( rhs ) ) );
+        return( createObject<Path>( rhs ) );
       }
 
       Path::Path()
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/PerspectiveCamera.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -44,12 +45,12 @@ namespace dp
 
       PerspectiveCameraSharedPtr PerspectiveCamera::create()
       {
-        return( std::shared_ptr<PerspectiveCamera>( new PerspectiveCamera() ) );
+        return( createObject<PerspectiveCamera>() );
       }
 
       HandledObjectSharedPtr PerspectiveCamera::clone() const
       {
-        return( std::shared_ptr<PerspectiveCamera>( new PerspectiveCamera( *this ) ) );
+        return( createObject<PerspectiveCamera>( *this ) );
       }
 
       PerspectiveCamera::PerspectiveCamera(void)
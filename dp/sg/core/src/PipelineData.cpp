@@ -25,6 +25,7 @@
 
 #include <dp/sg/core/PipelineData.h>
 #include <dp/sg/core/TextureFile.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <dp/fx/EffectLibrary.h>
 
 using namespace dp::math;
@@ -123,7 +124,7 @@ namespace dp
 
       PipelineDataSharedPtr PipelineData::create( const EffectSpecSharedPtr & effectSpec )
       {
-        return( std::shared_ptr<PipelineData>( new PipelineData( effectSpec ) ) );
+        return( createObject<PipelineData>( effectSpec ) );
       }
 
       PipelineDataSharedPtr PipelineData::create( const dp::fx::EffectDataSharedPtr& effectData )
@@ -133,7 +134,7 @@ namespace dp
 
       HandledObjectSharedPtr PipelineData::clone() const
       {
-        return( std::shared_ptr<PipelineData>( new PipelineData( *this ) ) );
+        return( createObject<PipelineData>( *this ) );
       }
 
       PipelineData::PipelineData( const EffectSpecSharedPtr& effectSpec )
@@ -25,11 +25,18 @@
 
 
 #include <dp/Assert.h>
+#include <dp/math/PointBounds.h>
 #include <dp/math/Spherent.h>
+#include <dp/util/ThreadPool.h>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <dp/sg/core/Primitive.h>
 #include <dp/sg/core/IndexSet.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -47,17 +54,17 @@ namespace dp
       PrimitiveSharedPtr Primitive::create( PrimitiveType primitiveType )
       {
         DP_ASSERT( primitiveType != PrimitiveType::PATCHES );
-        return( std::shared_ptr<Primitive>( new Primitive( primitiveType, PatchesType::NONE, PatchesMode::TRIANGLES ) ) );
+        return( createObject<Primitive>( primitiveType, PatchesType::NONE, PatchesMode::TRIANGLES ) );
       }
 
       PrimitiveSharedPtr Primitive::create( PatchesType patchesType, PatchesMode patchesMode )
       {
-        return( std::shared_ptr<Primitive>( new Primitive( PrimitiveType::PATCHES, patchesType, patchesMode ) ) );
+        return( createObject<Primitive>( PrimitiveType::PATCHES, patchesType, patchesMode ) );
       }
 
       HandledObjectSharedPtr Primitive::clone() const
       {
-        return( std::shared_ptr<Primitive>( new Primitive( *this ) ) );
+        return( createObject<Primitive>( *this ) );
       }
 
       Primitive::Primitive( PrimitiveType primitiveType, PatchesType patchesType, PatchesMode patchesMode )
@@ -485,141 +492,184 @@ namespace dp
         }
       }
 
-      template <typename IndexType> Box3f getBoundingBoxForIndices( const IndexSetSharedPtr &indexSet, unsigned int offset, unsigned int count
-                                                                  , unsigned int primitiveRestartIndex, const Buffer::ConstIterator<Vec3f>::Type &points )
+      namespace
       {
-        Box3f bbox;
+        // Primitives are split into chunks of at least this number of elements.
+        const size_t minElementsPerTask = 256 * 1024;
 
-        Buffer::DataReadLock drl( indexSet->getBuffer() );
-        const IndexType* indices = drl.getPtr<IndexType>() + offset;
+        // Bounding volumes may be requested from several threads at once, e.g. while building a SceneTree.
+        // The first one gets the pool, the others process the chunks of their primitives on their own thread.
+        std::mutex boundingVolumeThreadPoolMutex;
 
-        for ( unsigned int i=0; i<count; ++i )
+        dp::util::ThreadPool * getBoundingVolumeThreadPool()
         {
-          // make sure to skip primitive restart index
-          if( indices[i] != primitiveRestartIndex )
+          // never destroyed, as joining the workers during static destruction is not safe on all platforms
+          static dp::util::ThreadPool * threadPool = ( 1 < std::thread::hardware_concurrency() ) ? new dp::util::ThreadPool() : nullptr;
+          return( threadPool );
+        }
+
+        // Split [0, count) into chunks, call task( begin, end, result ) for each, and return the results in chunk order.
+        // The chunks only depend on count, so the merged result is the same whether they run on the pool or serially.
+        template <typename Result, typename Task>
+        std::vector<Result> processChunks( size_t count, Result const& initialResult, Task const& task )
+        {
+          size_t numberOfChunks = std::max( size_t( 1 ), count / minElementsPerTask );
+          std::vector<Result> results( numberOfChunks, initialResult );
+          std::function<void( size_t )> chunkTask = [&]( size_t chunk )
+          {
+            task( chunk * count / numberOfChunks, ( chunk + 1 ) * count / numberOfChunks, results[chunk] );
+          };
+
+          std::unique_lock<std::mutex> lock( boundingVolumeThreadPoolMutex, std::defer_lock );
+          if ( ( 1 < numberOfChunks ) && getBoundingVolumeThreadPool() && lock.try_lock() )
           {
-            bbox.update(points[indices[i]]);
+            getBoundingVolumeThreadPool()->execute( numberOfChunks, chunkTask );
+          }
+          else
+          {
+            for ( size_t chunk = 0; chunk < numberOfChunks; ++chunk )
+            {
+              chunkTask( chunk );
+            }
           }
+          return( results );
         }
 
-        return bbox;
-      }
+        // The positions of a Primitive, mapped for the lifetime of this object.
+        class PrimitivePoints
+        {
+        public:
+          PrimitivePoints( const VertexAttributeSetSharedPtr & vertexAttributeSet, const IndexSetSharedPtr & indexSet, unsigned int offset, unsigned int count )
+            : m_vertexLock( vertexAttributeSet->getVertexBuffer( VertexAttributeSet::AttributeID::POSITION ) )
+            , m_begin( offset )
+            , m_end( offset + count )
+          {
+            DP_ASSERT( vertexAttributeSet->getSizeOfVertexData( VertexAttributeSet::AttributeID::POSITION ) == 3 );
+            DP_ASSERT( vertexAttributeSet->getTypeOfVertexData( VertexAttributeSet::AttributeID::POSITION ) == dp::DataType::FLOAT_32 );
 
-      Box3f Primitive::calculateBoundingBox() const
-      {
-        Box3f bbox;
+            unsigned int stride = vertexAttributeSet->getStrideOfVertexData( VertexAttributeSet::AttributeID::POSITION );
+            m_pointSet.points = m_vertexLock.getPtr<char>() + vertexAttributeSet->getOffsetOfVertexData( VertexAttributeSet::AttributeID::POSITION );
+            m_pointSet.stride = stride ? stride : sizeof(Vec3f);
+            m_pointSet.numberOfPoints = vertexAttributeSet->getNumberOfVertices();
 
-        unsigned int offset = getElementOffset();
-        unsigned int count  = getElementCount();
+            if ( indexSet )
+            {
+              // signed indices are handled like unsigned ones of the same size, negative values are out of range anyway
+              m_indexLock = Buffer::DataReadLock( indexSet->getBuffer() );
+              m_pointSet.indices = m_indexLock.getPtr();
+              m_pointSet.indexSize = dp::checked_cast<unsigned int>( dp::getSizeOf( indexSet->getIndexDataType() ) );
+              m_pointSet.restartIndex = indexSet->getPrimitiveRestartIndex();
+            }
+          }
 
-        Buffer::ConstIterator<Vec3f>::Type points = m_vertexAttributeSet->getVertices();
+          const PointSet & getPointSet() const { return( m_pointSet ); }
+          size_t getBegin() const { return( m_begin ); }
+          size_t getEnd() const { return( m_end ); }
 
-        if( isIndexed() )
+          void clampEnd( size_t end ) { m_end = std::min( m_end, end ); }
+
+        private:
+          Buffer::DataReadLock  m_vertexLock;
+          Buffer::DataReadLock  m_indexLock;
+          PointSet              m_pointSet;
+          size_t                m_begin;
+          size_t                m_end;
+        };
+
+        struct SphereResult
+        {
+          Sphere3f  sphere;
+          float     maxDistanceSquared;
+        };
+
+        unsigned int calculateExtremalPoints( const PrimitivePoints & points, ExtremalPoints & extremalPoints )
         {
-          // The general purpose IndexSet::ConstIterator is slow since each indexed access is a virtual function call.
-          // Instead use a templated version of the algorithm which is operation directly on the buffer of the IndexSet to gain speed.
-          const IndexSetSharedPtr &indexSet = getIndexSet();
-          unsigned int prIdx = indexSet->getPrimitiveRestartIndex();
-          switch (indexSet->getIndexDataType() )
+          size_t begin = points.getBegin();
+          std::vector<std::pair<ExtremalPoints, unsigned int>> results = processChunks( points.getEnd() - begin, std::make_pair( ExtremalPoints(), 0u )
+            , [&]( size_t chunkBegin, size_t chunkEnd, std::pair<ExtremalPoints, unsigned int> & result )
           {
-          case dp::DataType::UNSIGNED_INT_32:
-            bbox = getBoundingBoxForIndices<unsigned int>( indexSet, offset, count, prIdx, points );
-            break;
-          case dp::DataType::INT_32:
-            bbox = getBoundingBoxForIndices<int>( indexSet, offset, count, prIdx, points );
-            break;
-          case dp::DataType::UNSIGNED_INT_16:
-            bbox = getBoundingBoxForIndices<unsigned short>( indexSet, offset, count, prIdx, points );
-            break;
-          case dp::DataType::INT_16:
-            bbox = getBoundingBoxForIndices<short>( indexSet, offset, count, prIdx, points );
-            break;
-          case dp::DataType::UNSIGNED_INT_8:
-            bbox = getBoundingBoxForIndices<unsigned char>( indexSet, offset, count, prIdx, points );
-            break;
-          case dp::DataType::INT_8:
-            bbox = getBoundingBoxForIndices<char>( indexSet, offset, count, prIdx, points );
-            break;
-          default:
-            DP_ASSERT( 0 && "unsupported datatype for indexset");
+            result.second = dp::math::calculateExtremalPoints( points.getPointSet(), begin + chunkBegin, begin + chunkEnd, result.first );
+          } );
+
+          extremalPoints = results[0].first;
+          unsigned int skipped = results[0].second;
+          for ( size_t i = 1; i < results.size(); ++i )
+          {
+            mergeExtremalPoints( extremalPoints, results[i].first );
+            skipped += results[i].second;
           }
+          return( skipped );
         }
-        else
+      }
+
+      Box3f Primitive::calculateBoundingBox() const
+      {
+        if ( !m_vertexAttributeSet )
         {
-          DP_ASSERT( offset+count <= m_vertexAttributeSet->getNumberOfVertices() );
-          for( unsigned int i=offset; i < offset+count; ++i )
-          {
-            bbox.update( points[i] );
-          }
+          return( Box3f() );
+        }
+
+        PrimitivePoints points( m_vertexAttributeSet, isIndexed() ? getIndexSet() : IndexSetSharedPtr(), getElementOffset(), getElementCount() );
+        if ( !isIndexed() )
+        {
+          DP_ASSERT( points.getEnd() <= m_vertexAttributeSet->getNumberOfVertices() );
+          points.clampEnd( m_vertexAttributeSet->getNumberOfVertices() );
         }
 
-        return bbox;
+        ExtremalPoints extremalPoints;
+        calculateExtremalPoints( points, extremalPoints );
+        return( extremalPoints.box );
       }
 
       Sphere3f Primitive::calculateBoundingSphere() const
       {
-        unsigned int offset = getElementOffset();
-        unsigned int count  = getElementCount();
-
-        Sphere3f bsphere;
-        Box3f bbox = calculateBoundingBox();
-        Vec3f center = bbox.getCenter();
-
-        Buffer::ConstIterator<Vec3f>::Type points = m_vertexAttributeSet->getVertices();
+        if ( !m_vertexAttributeSet )
+        {
+          return( Sphere3f( Box3f().getCenter(), 0.0f ) );
+        }
 
-        // now determine min radius
-        float minRadius = 0.f;
-        if( isIndexed() )
+        PrimitivePoints points( m_vertexAttributeSet, isIndexed() ? getIndexSet() : IndexSetSharedPtr(), getElementOffset(), getElementCount() );
+        if ( !isIndexed() && ( m_vertexAttributeSet->getNumberOfVertices() < points.getEnd() ) )
         {
-          IndexSet::ConstIterator<unsigned int> indices( m_indexSet, offset );
+          std::cerr << "Primitive " << getName() << " references out of range vertices" << std::endl;
+          DP_ASSERT( false );
+          points.clampEnd( m_vertexAttributeSet->getNumberOfVertices() );
+        }
 
-          unsigned int primitiveRestartIndex = m_indexSet->getPrimitiveRestartIndex();
-          size_t numberOfVertices = m_vertexAttributeSet->getNumberOfVertices();
+        // first pass: bounding box and extremal points
+        ExtremalPoints extremalPoints;
+        if ( calculateExtremalPoints( points, extremalPoints ) )
+        {
+          std::cerr << "Primitive " << getName() << " contains out of range indices" << std::endl;
+          DP_ASSERT( false );
+        }
+        Vec3f center = extremalPoints.box.getCenter();
+        if ( !isValid( extremalPoints.box ) )
+        {
+          return( Sphere3f( center, 0.0f ) );
+        }
 
-          bool invalidIndices = false;
-          for( unsigned int i = 0; i < count; i ++ )
-          {
-            unsigned int index = indices[i];
+        // second pass: grow Ritter's sphere, starting at the extremal points with the largest distance, and determine the
+        // radius needed around the box center
+        SphereResult initialResult = { initialBoundingSphere( extremalPoints ), 0.0f };
+        size_t begin = points.getBegin();
+        std::vector<SphereResult> results = processChunks( points.getEnd() - begin, initialResult
+          , [&]( size_t chunkBegin, size_t chunkEnd, SphereResult & result )
+        {
+          growBoundingSphere( points.getPointSet(), begin + chunkBegin, begin + chunkEnd, result.sphere, center, result.maxDistanceSquared );
+        } );
 
-            if ( (index != primitiveRestartIndex) && (index < numberOfVertices) )
-            {
-              float d = lengthSquared( points[index] - center );
-              if( minRadius < d )
-              {
-                minRadius = d;
-              }
-            }
-            else
-            {
-              invalidIndices |= ( index != primitiveRestartIndex );
-            }
-          }
-          if ( invalidIndices )
-          {
-            std::cerr << "Primitive " << getName() << " contains out of range indices" << std::endl;
-            DP_ASSERT( false );
-          }
-        }
-        else
+        Sphere3f ritterSphere = results[0].sphere;
+        float maxDistanceSquared = results[0].maxDistanceSquared;
+        for ( size_t i = 1; i < results.size(); ++i )
         {
-          unsigned int end = offset + count;
-          if ( end > m_vertexAttributeSet->getNumberOfVertices() )
-          {
-            std::cerr << "Primitive " << getName() << " references out of range vertices" << std::endl;
-            DP_ASSERT( false );
-            end = m_vertexAttributeSet->getNumberOfVertices();
-          }
-          for( unsigned int i = offset; i < end; i ++ )
-          {
-            float d = lengthSquared( points[i] - center );
-            if( minRadius < d )
-            {
-              minRadius = d;
-            }
-          }
+          ritterSphere = boundingSphere( ritterSphere, results[i].sphere );
+          maxDistanceSquared = std::max( maxDistanceSquared, results[i].maxDistanceSquared );
         }
 
-        return Sphere3f( center, sqrt(minRadius) );
+        // Ritter's sphere is usually tighter, but not always
+        float radius = sqrt( maxDistanceSquared );
+        return( ( ritterSphere.getRadius() < radius ) ? ritterSphere : Sphere3f( center, radius ) );
       }
 
       void Primitive::setElementRange( unsigned int offset, unsigned int count )
@@ -28,6 +28,7 @@
 #include <dp/sg/core/Sampler.h>
 #include <dp/sg/core/Sampler.h>
 #include <dp/sg/core/Texture.h>
+#include <dp/sg/core/ObjectArena.h>
 
 namespace dp
 {
@@ -57,12 +58,12 @@ namespace dp
 
       SamplerSharedPtr Sampler::create( const TextureSharedPtr & texture )
       {
-        return( std::shared_ptr<Sampler>( new Sampler( texture ) ) );
+        return( createObject<Sampler>( texture ) );
       }
 
       HandledObjectSharedPtr Sampler::clone() const
       {
-        return( std::shared_ptr<Sampler>( new Sampler( *this ) ) );
+        return( createObject<Sampler>( *this ) );
       }
 
       Sampler::Sampler( const TextureSharedPtr & texture )
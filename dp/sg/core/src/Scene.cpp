@@ -26,6 +26,7 @@
 
 #include <dp/sg/core/Scene.h>
 #include <dp/sg/core/Object.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 using std::vector;
@@ -50,12 +51,16 @@ namespace dp
 
       SceneSharedPtr Scene::create()
       {
-        return( std::shared_ptr<Scene>( new Scene() ) );
+        SceneSharedPtr scene = createObject<Scene>();
+        scene->m_objectArena = ObjectArena::getCurrent();
+        return( scene );
       }
 
       HandledObjectSharedPtr Scene::clone() const
       {
-        return( std::shared_ptr<Scene>( new Scene( *this ) ) );
+        SceneSharedPtr scene = createObject<Scene>( *this );
+        scene->m_objectArena = ObjectArena::getCurrent();
+        return( scene );
       }
 
       Scene::Scene()
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/Switch.h>
+#include <dp/sg/core/ObjectArena.h>
 
 #include <iterator>
 
@@ -88,12 +89,12 @@ namespace dp
 
       SwitchSharedPtr Switch::create()
       {
-        return( std::shared_ptr<Switch>( new Switch() ) );
+        return( createObject<Switch>() );
       }
 
       HandledObjectSharedPtr Switch::clone() const
       {
-        return( std::shared_ptr<Switch>( new Switch( *this ) ) );
+        return( createObject<Switch>( *this ) );
       }
 
       Switch::Switch()
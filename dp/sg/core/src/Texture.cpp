@@ -26,6 +26,7 @@
 
 #include <dp/fx/ParameterSpec.h>
 #include <dp/sg/core/Texture.h>
+#include <dp/util/HashGeneratorMurMur3.h>
 
 namespace dp
 {
@@ -123,9 +124,11 @@ namespace dp
       {
         if ( ! m_hashKeyValid )
         {
-          dp::util::HashGeneratorMurMur hg;
+          dp::util::HashGeneratorMurMur3 hg;
           feedHashGenerator( hg );
-          hg.finalize( (unsigned int *)&m_hashKey );
+          dp::util::HashKey128 hashKey;
+          hg.finalize( &hashKey );
+          m_hashKey = static_cast<dp::util::HashKey>( hashKey.low );
           m_hashKeyValid = true;
         }
         return( m_hashKey );
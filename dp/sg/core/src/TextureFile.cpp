@@ -26,6 +26,7 @@
 
 #include <dp/Types.h>
 #include <dp/sg/core/TextureFile.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <dp/util/Observer.h>
 #include <boost/make_shared.hpp>
 
@@ -101,7 +102,7 @@ namespace dp
           // if not create a new TextureFile object
           PayloadSharedPtr payload = Payload::create();
           payload->m_filename = filename;
-          TextureFileSharedPtr textureFile = std::shared_ptr<TextureFile>( new TextureFile( filename, textureTarget ) );
+          TextureFileSharedPtr textureFile = createObject<TextureFile>( filename, textureTarget );
           payload->m_textureFile = textureFile;
           textureFile->attach( &self, payload.operator->() );   // Big Hack !!
           it = self.m_cache.insert( std::make_pair( filename, payload) ).first;
@@ -136,7 +137,7 @@ namespace dp
 
       HandledObjectSharedPtr TextureFile::clone() const
       {
-        return( std::shared_ptr<TextureFile>( new TextureFile( *this ) ) );
+        return( createObject<TextureFile>( *this ) );
       }
 
       TextureFile::TextureFile( const std::string& filename, TextureTarget textureTarget )
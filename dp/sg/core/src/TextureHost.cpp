@@ -26,6 +26,7 @@
 
 #include <dp/sg/core/TextureHost.h>
 #include <dp/sg/core/BufferHost.h>
+#include <dp/sg/core/ObjectArena.h>
 #include <dp/util/File.h>
 #if defined(HAVE_HALF_FLOAT)
 #include <dp/math/half.h>
@@ -853,12 +854,12 @@ namespace dp
 
       TextureHostSharedPtr TextureHost::create( const std::string & filename )
       {
-        return( std::shared_ptr<TextureHost>( new TextureHost( filename ) ) );
+        return( createObject<TextureHost>( filename ) );
       }
 
       HandledObjectSharedPtr TextureHost::clone() const
       {
-        return( std::shared_ptr<TextureHost>( new TextureHost( *this ) ) );
+        return( createObject<TextureHost>( *this ) );
       }
 
       TextureHost::TextureHost( const std::string & filename )
@@ -2153,9 +2154,11 @@ namespace dp
               hg.update( reinterpret_cast<const unsigned char *>(&m_images[i][j].m_bpl), sizeof(m_images[i][j].m_bpl) );
               hg.update( reinterpret_cast<const unsigned char *>(&m_images[i][j].m_bps), sizeof(m_images[i][j].m_bps) );
               hg.update( reinterpret_cast<const unsigned char *>(&m_images[i][j].m_nob), sizeof(m_images[i][j].m_nob) );
-              // need to handle m_pixels here too !!
-              //util::HashKey hk = BufferLock(m_images[i][j].m_pixels)->getHashKey();
-              //hg.update( reinterpret_cast<const unsigned char *>(&hk), sizeof(hk) );
+              if ( m_images[i][j].m_pixels )
+              {
+                dp::util::HashKey128 const& contentHash = m_images[i][j].m_pixels->getContentHash();
+                hg.update( reinterpret_cast<const unsigned char *>(&contentHash), sizeof(contentHash) );
+              }
             }
           }
         }
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/core/Transform.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -57,12 +58,12 @@ namespace dp
 
       TransformSharedPtr Transform::create()
       {
-        return( std::shared_ptr<Transform>( new Transform() ) );
+        return( createObject<Transform>() );
       }
 
       HandledObjectSharedPtr Transform::clone() const
       {
-        return( std::shared_ptr<Transform>( new Transform( *this ) ) );
+        return( createObject<Transform>( *this ) );
       }
 
       Transform::Transform( void )
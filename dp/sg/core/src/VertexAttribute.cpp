@@ -220,13 +220,46 @@ namespace dp
         m_offset = 0;
       }
 
+      // hash count elements of size float or double components, ignoring the last byte of each component
+      static void feedFloatHash( util::HashGenerator & hg, const unsigned char * ptr, size_t count, size_t size, size_t strideInBytes, size_t componentBytes )
+      {
+        // copy the components with their last byte cleared into a block and hash whole blocks
+        unsigned char block[4096];
+        size_t blockBytes = 0;
+        size_t elementBytes = size * componentBytes;
+        DP_ASSERT( elementBytes <= sizeof(block) );
+        for ( size_t i=0 ; i<count ; ++i )
+        {
+          if ( sizeof(block) < blockBytes + elementBytes )
+          {
+            hg.update( block, dp::checked_cast<unsigned int>(blockBytes) );
+            blockBytes = 0;
+          }
+          memcpy( block + blockBytes, ptr, elementBytes );
+          for ( size_t j=0 ; j<size ; ++j )
+          {
+            block[blockBytes + componentBytes - 1] = 0;
+            blockBytes += componentBytes;
+          }
+          ptr += strideInBytes;
+        }
+        hg.update( block, dp::checked_cast<unsigned int>(blockBytes) );
+      }
+
       void VertexAttribute::feedHashGenerator( util::HashGenerator & hg ) const
       {
         hg.update( reinterpret_cast<const unsigned char *>(&m_count), sizeof(m_count) );
         hg.update( reinterpret_cast<const unsigned char *>(&m_size), sizeof(m_size) );
         hg.update( reinterpret_cast<const unsigned char *>(&m_type), sizeof(m_type) );
         hg.update( reinterpret_cast<const unsigned char *>(&m_bytes), sizeof(m_bytes) );
-        if ( m_buffer )
+        if ( m_buffer && isIntegerType( m_type ) && m_offset == 0 && m_strideInBytes == m_bytes && size_t(m_count) * m_bytes == m_buffer->getSize() )
+        {
+          // integer data filling the whole buffer: use its cached content hash
+          // float data is hashed below without the last byte of each component, which the content hash would include
+          dp::util::HashKey128 const& contentHash = m_buffer->getContentHash();
+          hg.update( reinterpret_cast<const unsigned char *>(&contentHash), sizeof(contentHash) );
+        }
+        else if ( m_buffer )
         {
           Buffer::DataReadLock lock( m_buffer, m_offset, m_count * m_strideInBytes);
           const unsigned char *ptr = lock.getPtr<unsigned char>();
@@ -242,30 +275,12 @@ namespace dp
           // that allows for more advanced approximate compares
           else if ( m_type == dp::DataType::FLOAT_32 )
           {
-            for ( size_t i=0 ; i<m_count ; ++i )
-            {
-              const unsigned char *p = ptr;
-              for ( size_t j=0 ; j<m_size ; ++j )
-              {
-                hg.update( p, sizeof(float)-1 );
-                p += sizeof(float);
-              }
-              ptr += m_strideInBytes;
-            }
+            feedFloatHash( hg, ptr, m_count, m_size, m_strideInBytes, sizeof(float) );
           }
           else
           {
             DP_ASSERT( m_type == dp::DataType::FLOAT_64 );
-            for ( size_t i=0 ; i<m_count ; ++i )
-            {
-              const unsigned char *p = ptr;
-              for ( size_t j=0 ; j<m_size ; ++j )
-              {
-                hg.update( p, sizeof(double) - 1 );
-                p += sizeof(double);
-              }
-              ptr += m_strideInBytes;
-            }
+            feedFloatHash( hg, ptr, m_count, m_size, m_strideInBytes, sizeof(double) );
           }
         }
       }
@@ -28,6 +28,7 @@
 #include <dp/util/Memory.h>
 #include <dp/sg/core/VertexAttributeSet.h>
 #include <dp/sg/core/BufferHost.h>
+#include <dp/sg/core/ObjectArena.h>
 
 using namespace dp::math;
 
@@ -51,12 +52,14 @@ namespace dp
 
       VertexAttributeSetSharedPtr VertexAttributeSet::create()
       {
-        return( std::shared_ptr<VertexAttributeSet>( new VertexAttributeSet() ) );
+        return( createObject<VertexAttributeSet>() );
       }
 
       HandledObjectSharedPtr VertexAttributeSet::clone() const
       {
-        return( std::shared_ptr<VertexAttributeSet>( new VertexAttributeSet( *this ) ) );
+        VertexAttributeSetSharedPtr vertexAttributeSet = createObject<VertexAttributeSet>( *this );
+        vertexAttributeSet->cloneBuffers();
+        return( vertexAttributeSet );
       }
 
       VertexAttributeSet::VertexAttributeSet()
@@ -75,6 +78,7 @@ namespace dp
       {
         m_bufferObserver.setVertexAttributeSet( this );
         m_objectCode = ObjectCode::VERTEX_ATTRIBUTE_SET;
+        subscribeBuffer( m_vattribs.begin() );
       }
 
       VertexAttributeSet::~VertexAttributeSet()
@@ -432,12 +436,8 @@ namespace dp
             unsubscribeBuffer( it );
             it->second.removeData();
           }
-          m_vattribs.clear();
-          for ( AttributeContainer::const_iterator it = rhs.m_vattribs.begin() ; it != rhs.m_vattribs.end() ; ++it )
-          {
-            m_vattribs[it->first] = it->second;
-            subscribeBuffer( it );
-          }
+          m_vattribs = rhs.m_vattribs;
+          subscribeBuffer( m_vattribs.begin() );
         }
         return *this;
       }
@@ -912,6 +912,30 @@ namespace dp
         setEnabled( id, enable );
       }
 
+      void VertexAttributeSet::cloneBuffers()
+      {
+        unsubscribeBuffer( m_vattribs.begin() );
+
+        // attributes sharing a buffer keep sharing the clone of that buffer, so interleaved data stays interleaved
+        std::map<const Buffer *, BufferSharedPtr> clonedBuffers;
+        for ( AttributeContainer::iterator it = m_vattribs.begin() ; it != m_vattribs.end() ; ++it )
+        {
+          VertexAttribute & va = it->second;
+          if ( va.getBuffer() )
+          {
+            BufferSharedPtr & clonedBuffer = clonedBuffers[va.getBuffer().get()];
+            if ( !clonedBuffer )
+            {
+              clonedBuffer = std::static_pointer_cast<Buffer>( va.getBuffer()->clone() );
+            }
+            va.setData( va.getVertexDataSize(), va.getVertexDataType(), clonedBuffer
+                      , va.getVertexDataOffsetInBytes(), va.getVertexDataStrideInBytes(), va.getVertexDataCount() );
+          }
+        }
+
+        subscribeBuffer( m_vattribs.begin() );
+      }
+
       void VertexAttributeSet::subscribeBuffer( const AttributeContainer::const_iterator & it )
       {
         if ( it != m_vattribs.end() && it->first == AttributeID::POSITION && it->second.getBuffer() )
@@ -938,7 +962,7 @@ namespace dp
           AttributeID id = static_cast<AttributeID>(index);
           if ( isEnabled( id ) )
           {
-            VertexAttribute attribute = getVertexAttribute( id );
+            const VertexAttribute & attribute = getVertexAttribute( id );
             stride += attribute.getVertexDataBytes();
 
             if ( !numberOfVertices )
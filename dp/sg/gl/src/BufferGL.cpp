@@ -116,7 +116,7 @@ namespace dp
       {
         if ( m_mapMode & MapMode::WRITE )
         {
-          notify( Event( this ) );
+          notifyDataChanged();
         }
 
         m_buffer->unmap();
@@ -149,6 +149,7 @@ namespace dp
         if ( (m_stateFlags & State::CAPABILITY_COPY) && std::dynamic_pointer_cast<BufferGL>(srcBuffer) )
         {
           copy( std::static_pointer_cast<BufferGL>(srcBuffer)->m_buffer, m_buffer, srcOffset, dstOffset, size );
+          notifyDataChanged();
         }
         else
         {
@@ -171,6 +172,7 @@ namespace dp
         DP_ASSERT( m_mapMode == MapMode::NONE );
 
         m_buffer->setSize(size);
+        invalidateContentHash();
       }
 
       dp::gl::BufferSharedPtr const& BufferGL::getBuffer() const
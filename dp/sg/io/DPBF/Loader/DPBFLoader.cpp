@@ -1856,6 +1856,17 @@ SceneSharedPtr DPBFLoader::load(const string& filename, dp::util::FileFinder con
     m_fm = new ReadMapping( filename );
     if ( m_fm->isValid() )
     {
+      // The user can request to reference the vertex and index data in the file instead of copying it, which allows
+      // loading scenes larger than the available memory.
+      if ( getenv( "DP_DPBF_MAPPED_BUFFERS" ) )
+      {
+        m_mappedFile = MappedFile::open( filename );
+        if ( !m_mappedFile->isValid() )
+        {
+          m_mappedFile.reset();
+        }
+      }
+
       {
         Offset_AutoPtr<NBFHeader> nbfHdr(m_fm, callback(), 0);
                                               //^ the NBF header always is at offset 0 for a valid NBF file!
@@ -2885,6 +2896,7 @@ SceneSharedPtr DPBFLoader::load(const string& filename, dp::util::FileFinder con
     m_materialToPipelineData.clear();
     m_pipelineData.reset();
     m_fileFinder.clear();
+    m_mappedFile.reset();
 
     // pass on caught exception to next handler
     throw;
@@ -2897,6 +2909,7 @@ SceneSharedPtr DPBFLoader::load(const string& filename, dp::util::FileFinder con
   m_materialToPipelineData.clear();
   DP_ASSERT( !m_pipelineData );
   m_fileFinder.clear();
+  m_mappedFile.reset();
 
   return scene;
 }
@@ -5930,11 +5943,20 @@ void DPBFLoader::readVertexAttributeSet( VertexAttributeSetSharedPtr const& dst,
     if ( src->vattribs[i].numVData )
     {
       uint_t sizeofVertex = dp::checked_cast<uint_t>(src->vattribs[i].size * dp::getSizeOf( convertDataType(src->vattribs[i].type) ));
-      Offset_AutoPtr<byte_t> vdata( m_fm, callback(), src->vattribs[i].vdata,
-        src->vattribs[i].numVData * sizeofVertex );
+      if ( m_mappedFile )
+      {
+        BufferMappedSharedPtr buffer = BufferMapped::create( m_mappedFile, src->vattribs[i].vdata, src->vattribs[i].numVData * sizeofVertex );
+        dst->setVertexData( id, src->vattribs[i].size, convertDataType(src->vattribs[i].type),
+          buffer, 0, sizeofVertex, src->vattribs[i].numVData );
+      }
+      else
+      {
+        Offset_AutoPtr<byte_t> vdata( m_fm, callback(), src->vattribs[i].vdata,
+          src->vattribs[i].numVData * sizeofVertex );
 
-      dst->setVertexData( id, src->vattribs[i].size, convertDataType(src->vattribs[i].type),
-        vdata, 0, src->vattribs[i].numVData );
+        dst->setVertexData( id, src->vattribs[i].size, convertDataType(src->vattribs[i].type),
+          vdata, 0, src->vattribs[i].numVData );
+      }
 
       // enable for rendering?
       DP_ASSERT(!(src->enableFlags & (1<<i)) || !(src->enableFlags & (1<<(i+16))));
@@ -5959,9 +5981,17 @@ IndexSetSharedPtr DPBFLoader::loadIndexSet( uint_t offset )
     if ( !loadSharedObject<IndexSet>( iset, isPtr ) )
     {
       unsigned int byteSize = dp::checked_cast<uint_t>(dp::getSizeOf( convertDataType(isPtr->dataType) ) * isPtr->numberOfIndices);
-      Offset_AutoPtr<byte_t> indicesPtr( m_fm, callback(), isPtr->idata, byteSize );
+      if ( m_mappedFile )
+      {
+        iset->setBuffer( BufferMapped::create( m_mappedFile, isPtr->idata, byteSize ), isPtr->numberOfIndices
+                       , convertDataType(isPtr->dataType), isPtr->primitiveRestartIndex );
+      }
+      else
+      {
+        Offset_AutoPtr<byte_t> indicesPtr( m_fm, callback(), isPtr->idata, byteSize );
 
-      iset->setData( indicesPtr, isPtr->numberOfIndices, convertDataType(isPtr->dataType), isPtr->primitiveRestartIndex );
+        iset->setData( indicesPtr, isPtr->numberOfIndices, convertDataType(isPtr->dataType), isPtr->primitiveRestartIndex );
+      }
     }
     mapObject( offset, iset );
   }
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <dp/sg/core/BufferMapped.h>
 #include <dp/sg/core/PipelineData.h>
 #include <dp/util/FileFinder.h>
 #include <dp/util/FileMapping.h>
@@ -162,6 +163,9 @@ private:
 
   dp::util::ReadMapping * m_fm;
 
+  // if set, vertex and index data is referenced in place instead of being copied
+  dp::sg::core::MappedFileSharedPtr m_mappedFile;
+
   // assign an object to an offset
   void mapObject(uint_t offset, const dp::sg::core::ObjectSharedPtr & object );
   void remapObject(uint_t offset, const dp::sg::core::ObjectSharedPtr & object );
@@ -81,10 +81,27 @@ namespace dp
             virtual void setRenderEngine( std::string const& renderEngine ) = 0;
             virtual std::string const& getRenderEngine() const = 0;
 
+            /** \brief Choose the RiX renderer library to load, "RiXGL.rdr" by default.
+                \param rixLibrary Name of the library without the platform specific "lib" prefix.
+                \remarks With "RiXNull.rdr" the SceneRenderer runs headless: no OpenGL calls are made, any
+                dp::ui::RenderTarget can be used, transparency is rendered with TransparencyMode::NONE,
+                OpenGL compute culling falls back to CPU culling and the environment map is not drawn.
+                Changing the library shuts down the current renderer.
+            **/
+            virtual void setRiXLibrary( std::string const& rixLibrary ) = 0;
+            virtual std::string const& getRiXLibrary() const = 0;
+
             virtual dp::sg::renderer::rix::gl::TransparencyMode getTransparencyMode() const = 0;
             virtual void setTransparencyMode( dp::sg::renderer::rix::gl::TransparencyMode mode ) = 0;
             virtual dp::sg::renderer::rix::gl::TransparencyManagerSharedPtr const & getTransparencyManager() const = 0;
 
+            /** \brief Cull objects whose projected bounding box is smaller than the given number of pixels in x and in y.
+                \param minimumPixelSize Minimum size in pixels. 0 disables the small feature culling, which is the default.
+                \remarks Small feature culling is supported by the CPU culling modes only.
+            **/
+            virtual void setMinimumPixelSize( float minimumPixelSize ) = 0;
+            virtual float getMinimumPixelSize() const = 0;
+
           protected:
             /** \brief Delete all primitive caches. Call this function only if an OpenGL context is active since resources need
             to be deleted.
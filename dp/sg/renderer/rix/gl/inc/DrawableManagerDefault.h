@@ -187,6 +187,7 @@ namespace dp
             virtual void updateDrawableInstance( Handle handle );
             virtual void setDrawableInstanceActive( Handle handle, bool visible );
             virtual void setDrawableInstanceTraversalMask( Handle handle, uint32_t traversalMask );
+            virtual void remapDrawableInstance( Handle handle, dp::sg::xbar::ObjectTreeIndex objectTreeIndex );
 
             virtual void setEnvironmentSampler( const dp::sg::core::SamplerSharedPtr & sampler );
             virtual const dp::sg::core::SamplerSharedPtr & getEnvironmentSampler() const;
@@ -200,6 +201,9 @@ namespace dp
 
             virtual void cull( const dp::sg::core::CameraSharedPtr &camera );
 
+            /** \brief Cull against multiple cameras in a single pass. An object is visible if it is visible for at least one camera. **/
+            virtual void cull( std::vector<dp::sg::core::CameraSharedPtr> const & cameras );
+
             dp::rix::core::RenderGroupSharedHandle getRenderGroup() { return m_renderGroups[RGL_OPAQUE][static_cast<size_t>(RenderGroupPass::FORWARD)]; }
             dp::rix::core::RenderGroupSharedHandle getRenderGroupDepthPass() { return m_renderGroups[RGL_OPAQUE][static_cast<size_t>(RenderGroupPass::DEPTH)]; }
             dp::rix::core::RenderGroupSharedHandle getRenderGroupTransparent() { return m_renderGroups[RGL_TRANSPARENT][static_cast<size_t>(RenderGroupPass::FORWARD)]; }
@@ -212,6 +216,9 @@ namespace dp
             void setCullingEnabled( bool enabled );
             bool isCullingEnabled( ) const;
 
+            void setMinimumPixelSize( float minimumPixelSize );
+            float getMinimumPixelSize() const;
+
           protected:
             class EffectDataObserver : public dp::util::Observer
             {
@@ -233,6 +240,8 @@ namespace dp
             friend class TransformObserver;
 
             void cullManager( const dp::sg::core::CameraSharedPtr &camera );
+            //! \brief Update the renderer visibility of the instances whose culling result has changed
+            void updateCullingVisibility();
             void setActiveTraversalMask( unsigned int nodeMask );
 
             dp::fx::Manager                         m_shaderManagerType;
@@ -254,6 +263,7 @@ namespace dp
             dp::sg::xbar::culling::CullingSharedPtr m_cullingManager;
             dp::sg::xbar::culling::ResultSharedPtr  m_cullingResult;
             bool                                    m_cullingEnabled;
+            float                                   m_minimumPixelSize;
 
           private:
             dp::sg::core::SamplerSharedPtr  m_environmentSampler;
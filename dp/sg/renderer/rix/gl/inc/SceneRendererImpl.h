@@ -113,12 +113,18 @@ namespace dp
             virtual void setCullingMode( dp::culling::Mode mode );
             virtual dp::culling::Mode getCullingMode( ) const;
 
+            virtual void setMinimumPixelSize( float minimumPixelSize );
+            virtual float getMinimumPixelSize() const;
+
             virtual void setShaderManager( dp::fx::Manager shaderManager );
             virtual dp::fx::Manager getShaderManager() const;
 
             virtual void setRenderEngine( std::string const& renderEngine );
             virtual std::string const& getRenderEngine() const;
 
+            virtual void setRiXLibrary( std::string const& rixLibrary );
+            virtual std::string const& getRiXLibrary() const;
+
             virtual dp::sg::renderer::rix::gl::TransparencyMode getTransparencyMode() const;
             virtual void setTransparencyMode( dp::sg::renderer::rix::gl::TransparencyMode mode );
 
@@ -136,14 +142,17 @@ namespace dp
             ResourceManagerSharedPtr                 m_resourceManager;
             dp::fx::Manager                          m_shaderManager;
             std::string                              m_renderEngineOptions;
+            std::string                              m_rixLibrary;
 
             bool                                     m_contextRegistered;
             bool                                     m_rendererInitialized;
+            bool                                     m_headless;              // true if m_renderer is not a RiXGL renderer
 
             dp::gl::RenderContextSharedPtr           m_userRenderContext;     // RenderContext provided by the user in the first render call
             dp::culling::Mode                        m_cullingMode;
 
             bool                                     m_cullingEnabled;
+            float                                    m_minimumPixelSize;
             bool                                     m_multicastEnabled;
 
             dp::math::Vec2ui                         m_viewportSize;
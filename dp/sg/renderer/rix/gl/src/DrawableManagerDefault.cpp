@@ -118,6 +118,7 @@ namespace dp
             , m_shaderManagerType( shaderManagerType )
             , m_cullingMode( cullingMode)
             , m_cullingEnabled( true )
+            , m_minimumPixelSize( 0.0f )
             , m_activeTraversalMask( ~0 )
             , m_viewportSize( 0, 0 )
             , m_transparencyManager( transparencyManager )
@@ -348,31 +349,72 @@ namespace dp
             }
           }
 
+          void DrawableManagerDefault::remapDrawableInstance( Handle handle, ObjectTreeIndex objectTreeIndex )
+          {
+            DP_ASSERT( std::dynamic_pointer_cast<DefaultHandleData>(handle) );
+            DefaultHandleDataSharedPtr const& handleData = std::static_pointer_cast<DefaultHandleData>(handle);
+
+            Instance& di = m_instances[handleData->m_index];
+            di.m_objectTreeIndex = objectTreeIndex;
+            if ( di.m_smartShaderObject )
+            {
+              di.m_smartShaderObject->objectTreeIndex = objectTreeIndex;
+            }
+            if ( di.m_smartShaderObjectDepthPass )
+            {
+              di.m_smartShaderObjectDepthPass->objectTreeIndex = objectTreeIndex;
+            }
+          }
+
           void DrawableManagerDefault::cull( const dp::sg::core::CameraSharedPtr &camera )
           {
             if ( m_cullingEnabled && !m_instances.empty() )
             {
               const Mat44f worldToViewProjection = camera->getWorldToViewMatrix() * camera->getProjection();
 
-              ObjectTree    &objectTree = getSceneTree()->getObjectTree();
-              dp::rix::core::Renderer* renderer = m_resourceManager->getRenderer();
-
               m_cullingManager->cull( m_cullingResult, worldToViewProjection );
+              updateCullingVisibility();
+            }
+          }
 
-              std::vector<ObjectTreeIndex> const & changed = m_cullingManager->resultGetChangedIndices( m_cullingResult );
-
-              for ( size_t index = 0;index < changed.size(); ++index )
+          void DrawableManagerDefault::cull( std::vector<dp::sg::core::CameraSharedPtr> const & cameras )
+          {
+            if ( cameras.size() == 1 )
+            {
+              cull( cameras.front() );
+            }
+            else if ( m_cullingEnabled && !m_instances.empty() )
+            {
+              std::vector<Mat44f> worldToViewProjections;
+              worldToViewProjections.reserve( cameras.size() );
+              for ( size_t index = 0; index < cameras.size(); ++index )
               {
-                DP_ASSERT( std::dynamic_pointer_cast<DefaultHandleData>(getDrawableInstance( changed[index] )) );
-                DefaultHandleDataSharedPtr const& defaultHandleData = std::static_pointer_cast<DefaultHandleData>(getDrawableInstance( changed[index] ));
-                Instance & instance = m_instances[defaultHandleData->m_index];
+                worldToViewProjections.push_back( cameras[index]->getWorldToViewMatrix() * cameras[index]->getProjection() );
+              }
 
-                bool newVisible = m_cullingManager->resultIsVisible( m_cullingResult, changed[index] );
-                if ( instance.m_isVisible != newVisible )
-                {
-                  instance.m_isVisible = newVisible;
-                  instance.updateRendererVisibility( renderer );
-                }
+              // all views are rendered with the same set of objects, cull all of them in a single pass
+              m_cullingManager->cullUnion( m_cullingResult, worldToViewProjections );
+              updateCullingVisibility();
+            }
+          }
+
+          void DrawableManagerDefault::updateCullingVisibility()
+          {
+            dp::rix::core::Renderer* renderer = m_resourceManager->getRenderer();
+
+            std::vector<ObjectTreeIndex> const & changed = m_cullingManager->resultGetChangedIndices( m_cullingResult );
+
+            for ( size_t index = 0;index < changed.size(); ++index )
+            {
+              DP_ASSERT( std::dynamic_pointer_cast<DefaultHandleData>(getDrawableInstance( changed[index] )) );
+              DefaultHandleDataSharedPtr const& defaultHandleData = std::static_pointer_cast<DefaultHandleData>(getDrawableInstance( changed[index] ));
+              Instance & instance = m_instances[defaultHandleData->m_index];
+
+              bool newVisible = m_cullingManager->resultIsVisible( m_cullingResult, changed[index] );
+              if ( instance.m_isVisible != newVisible )
+              {
+                instance.m_isVisible = newVisible;
+                instance.updateRendererVisibility( renderer );
               }
             }
           }
@@ -441,6 +483,10 @@ namespace dp
           {
             DP_ASSERT( m_viewportSize != viewportSize );
             m_viewportSize = viewportSize;
+            if ( m_cullingManager )
+            {
+              m_cullingManager->setViewportSize( viewportSize );
+            }
             if ( m_shaderManager )
             {
               m_shaderManager->updateFragmentParameter( std::string( "sys_ViewportSize" ), dp::rix::core::ContainerDataRaw( 0, &viewportSize[0], sizeof( dp::math::Vec2ui ) ) );
@@ -510,6 +556,20 @@ namespace dp
             return m_cullingEnabled;
           }
 
+          void DrawableManagerDefault::setMinimumPixelSize( float minimumPixelSize )
+          {
+            m_minimumPixelSize = minimumPixelSize;
+            if ( m_cullingManager )
+            {
+              m_cullingManager->setMinimumPixelSize( minimumPixelSize );
+            }
+          }
+
+          float DrawableManagerDefault::getMinimumPixelSize() const
+          {
+            return m_minimumPixelSize;
+          }
+
           void DrawableManagerDefault::detachEffectDataObserver()
           {
             for ( std::vector<Instance>::iterator it = m_instances.begin(); it != m_instances.end(); ++it )
@@ -534,6 +594,8 @@ namespace dp
               }
               m_cullingManager = dp::sg::xbar::culling::Culling::create( getSceneTree(), m_cullingMode );
               m_cullingResult = m_cullingManager->resultCreate();
+              m_cullingManager->setViewportSize( m_viewportSize );
+              m_cullingManager->setMinimumPixelSize( m_minimumPixelSize );
 
               switch ( m_shaderManagerType )
               {
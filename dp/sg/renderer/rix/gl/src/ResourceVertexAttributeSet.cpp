@@ -88,7 +88,7 @@ namespace dp
 
             for ( unsigned int i = 0; i < 16; ++i ) // FIXME Must match MAX_ATTRIBUTES, but that is only defined in inc\RendererAPI\RendererGL.h
             {
-              dp::sg::core::VertexAttribute va = m_vertexAttributeSet->getVertexAttribute( static_cast<dp::sg::core::VertexAttributeSet::AttributeID>(i) );
+              dp::sg::core::VertexAttribute const & va = m_vertexAttributeSet->getVertexAttribute( static_cast<dp::sg::core::VertexAttributeSet::AttributeID>(i) );
 
               if ( va.getBuffer() && va.getVertexDataCount() == numVertices )
               {
@@ -107,7 +107,9 @@ namespace dp
                   currentStream = static_cast<unsigned int>(std::distance( streams.begin(), it ));
                 }
 
-                vertexInfos.push_back( dp::rix::core::VertexFormatInfo( i, va.getVertexDataType(), va.getVertexDataSize(), false, currentStream, va.getVertexDataOffsetInBytes(), va.getVertexDataStrideInBytes()));
+                // the normalize flag is stored with the aliased generic attribute
+                bool normalized = m_vertexAttributeSet->isNormalizeEnabled( static_cast<dp::sg::core::VertexAttributeSet::AttributeID>(i + 16) );
+                vertexInfos.push_back( dp::rix::core::VertexFormatInfo( i, va.getVertexDataType(), va.getVertexDataSize(), normalized, currentStream, va.getVertexDataOffsetInBytes(), va.getVertexDataStrideInBytes()));
 
                 renderer->vertexDataSet( vertexData, currentStream, resourceBuffer->m_bufferHandle, 0, numVertices );
               }
@@ -106,10 +106,13 @@ namespace dp
             , m_drawableManager( nullptr )
             , m_contextRegistered( false )
             , m_rendererInitialized( false )
+            , m_headless( false )
             , m_shaderManager( shaderManagerType )
             , m_renderEngineOptions( renderEngineOptions )
+            , m_rixLibrary( "RiXGL.rdr" )
             , m_cullingMode( cullingMode )
             , m_cullingEnabled( true )
+            , m_minimumPixelSize( 0.0f )
             , m_viewportSize( 0, 0 )
             , m_multicastEnabled(false)
           {
@@ -136,6 +139,13 @@ namespace dp
 
               glStack.pop();
             }
+            else if ( m_headless )
+            {
+              delete m_drawableManager;
+
+              m_sceneTree.reset();
+              m_resourceManager.reset();
+            }
             m_environmentRenderer.reset();
           }
 
@@ -166,21 +176,25 @@ namespace dp
             {
               SceneRenderer::beginRendering( viewState, renderTarget );
 
-              dp::gl::RenderTargetSharedPtr renderTargetGL = std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
-
-              if ( !m_userRenderContext )
+              dp::gl::RenderTargetSharedPtr renderTargetGL;
+              if ( !m_headless )
               {
-                m_userRenderContext = renderTargetGL->getRenderContext();
-              }
-              else
-              {
-                DP_ASSERT( renderTargetGL->getRenderContext() == m_userRenderContext && "Current RenderContext is not the same as in the first call.");
+                renderTargetGL = std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
+
+                if ( !m_userRenderContext )
+                {
+                  m_userRenderContext = renderTargetGL->getRenderContext();
+                }
+                else
+                {
+                  DP_ASSERT( renderTargetGL->getRenderContext() == m_userRenderContext && "Current RenderContext is not the same as in the first call.");
+                }
               }
 
-              if ( renderTargetGL && ( ( m_viewportSize[0] != renderTargetGL->getWidth() ) || ( m_viewportSize[1] != renderTargetGL->getHeight() ) ) )
+              if ( renderTarget && ( ( m_viewportSize[0] != renderTarget->getWidth() ) || ( m_viewportSize[1] != renderTarget->getHeight() ) ) )
               {
-                m_viewportSize[0] = renderTargetGL->getWidth();
-                m_viewportSize[1] = renderTargetGL->getHeight();
+                m_viewportSize[0] = renderTarget->getWidth();
+                m_viewportSize[1] = renderTarget->getHeight();
                 if ( m_drawableManager )
                 {
                   m_drawableManager->update( m_viewportSize );
@@ -188,15 +202,22 @@ namespace dp
                 m_transparencyManager->setViewportSize( m_viewportSize );
               }
 
-              Vec4f bgColor = viewState->getScene()->getBackColor();
-              renderTargetGL->setClearColor( bgColor[0], bgColor[1], bgColor[2], bgColor[3] );
-              renderTargetGL->beginRendering();
-
-              if ( !m_contextRegistered )
+              if ( m_headless )
               {
-                DP_ASSERT( dynamic_cast<dp::rix::gl::RiXGL*>(m_renderer.get()) );
-                static_cast<dp::rix::gl::RiXGL*>(m_renderer.get())->registerContext();
-                m_contextRegistered = true;
+                renderTarget->beginRendering();
+              }
+              else
+              {
+                Vec4f bgColor = viewState->getScene()->getBackColor();
+                renderTargetGL->setClearColor( bgColor[0], bgColor[1], bgColor[2], bgColor[3] );
+                renderTargetGL->beginRendering();
+
+                if ( !m_contextRegistered )
+                {
+                  DP_ASSERT( dynamic_cast<dp::rix::gl::RiXGL*>(m_renderer.get()) );
+                  static_cast<dp::rix::gl::RiXGL*>(m_renderer.get())->registerContext();
+                  m_contextRegistered = true;
+                }
               }
 
               dp::sg::ui::RendererOptionsSharedPtr rendererOptions( viewState->getRendererOptions() );
@@ -208,8 +229,7 @@ namespace dp
           {
             if ( m_rendererInitialized )
             {
-              dp::gl::RenderTargetSharedPtr renderTargetGL = std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
-              renderTargetGL->endRendering();
+              renderTarget->endRendering();
 
               SceneRenderer::endRendering( viewState, renderTarget );
             }
@@ -224,7 +244,7 @@ namespace dp
           {
             if ( m_rendererInitialized )
             {
-              dp::gl::RenderTargetSharedPtr renderTargetGL = std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
+              dp::gl::RenderTargetSharedPtr renderTargetGL = m_headless ? dp::gl::RenderTargetSharedPtr() : std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
 
               if (viewState->getSceneTree() != m_sceneTree || m_multicastEnabled != renderTarget->isMulticastEnabled())
               {
@@ -260,9 +280,12 @@ namespace dp
 
           DrawableManager* SceneRendererImpl::createDrawableManager(const ResourceManagerSharedPtr &resourceManager, bool multicast) const
           {
-            DrawableManagerDefault * dmd = new DrawableManagerDefault( resourceManager, m_transparencyManager, m_shaderManager, m_cullingMode, multicast );
+            // OpenGL compute culling needs a context, which a headless renderer does not have
+            dp::culling::Mode cullingMode = ( m_headless && ( m_cullingMode == dp::culling::Mode::OPENGL_COMPUTE ) ) ? dp::culling::Mode::CPU : m_cullingMode;
+            DrawableManagerDefault * dmd = new DrawableManagerDefault( resourceManager, m_transparencyManager, m_shaderManager, cullingMode, multicast );
             dmd->setEnvironmentSampler( getEnvironmentSampler() );
             dmd->setCullingEnabled( m_cullingEnabled );
+            dmd->setMinimumPixelSize( m_minimumPixelSize );
 
             return( dmd );
           }
@@ -352,26 +375,41 @@ namespace dp
             // update the viewstate after updating the near/far planes of the camera
             ((DrawableManagerDefault*)m_drawableManager)->update( viewState, cameras );
 
-            // cull
-            drawableManagerDefault->cull( camera );
+            // cull, multicast rendering draws the same objects for all cameras and culls against all of them at once
+            if ( cameras.size() > 1 )
+            {
+              drawableManagerDefault->cull( cameras );
+            }
+            else
+            {
+              drawableManagerDefault->cull( camera );
+            }
 
             NSIGHT_START_RANGE( "Frame" );
-            dp::gl::RenderTargetSharedPtr const& renderTargetGL = std::static_pointer_cast<dp::gl::RenderTarget>(renderTarget);
-            dp::gl::TargetBufferMask clearMask = renderTargetGL->getClearMask();
-            if ( getEnvironmentRenderingEnabled() )
+            // a headless renderer has no OpenGL state to set and no backdrop to draw
+            if ( getEnvironmentRenderingEnabled() && !m_headless )
             {
               // render the backdrop instead of clearing the color buffer
               doRenderEnvironmentMap( viewState, renderTarget );
             }
 
-            glEnable(GL_DEPTH_TEST);
+            if ( !m_headless )
+            {
+              glEnable(GL_DEPTH_TEST);
+            }
             if ( m_depthPass )
             {
               NSIGHT_START_RANGE( "DepthPass" );
-              glDepthFunc(GL_LEQUAL);
-              glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+              if ( !m_headless )
+              {
+                glDepthFunc(GL_LEQUAL);
+                glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+              }
               m_renderer->render( drawableManagerDefault->getRenderGroupDepthPass() );
-              glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+              if ( !m_headless )
+              {
+                glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+              }
               NSIGHT_STOP_RANGE();
             }
 
@@ -426,6 +464,16 @@ namespace dp
 
           void SceneRendererImpl::onEnvironmentRenderingEnabledChanged()
           {
+            if ( m_headless )
+            {
+              // there is no backdrop in headless mode, just keep the DrawableManager in sync
+              if ( m_drawableManager )
+              {
+                m_drawableManager->setEnvironmentSampler( getEnvironmentRenderingEnabled() ? getEnvironmentSampler() : dp::sg::core::SamplerSharedPtr() );
+              }
+              return;
+            }
+
             DP_ASSERT( std::dynamic_pointer_cast<dp::gl::RenderTarget>(getRenderTarget()) );
             dp::gl::RenderTargetSharedPtr glRenderTarget = std::static_pointer_cast<dp::gl::RenderTarget>(getRenderTarget());
             if ( getEnvironmentRenderingEnabled() )
@@ -482,6 +530,21 @@ namespace dp
             return m_cullingMode;
           }
 
+          void SceneRendererImpl::setMinimumPixelSize( float minimumPixelSize )
+          {
+            m_minimumPixelSize = minimumPixelSize;
+            if ( m_drawableManager )
+            {
+              DP_ASSERT( dynamic_cast<DrawableManagerDefault*>(m_drawableManager) );
+              static_cast<DrawableManagerDefault*>(m_drawableManager)->setMinimumPixelSize( minimumPixelSize );
+            }
+          }
+
+          float SceneRendererImpl::getMinimumPixelSize() const
+          {
+            return m_minimumPixelSize;
+          }
+
           dp::sg::renderer::rix::gl::TransparencyMode SceneRendererImpl::getTransparencyMode() const
           {
             DP_ASSERT( m_transparencyManager );
@@ -490,6 +553,11 @@ namespace dp
 
           void SceneRendererImpl::setTransparencyMode( dp::sg::renderer::rix::gl::TransparencyMode mode )
           {
+            if ( m_headless )
+            {
+              // all other modes need OpenGL
+              mode = TransparencyMode::NONE;
+            }
             if ( mode != m_transparencyManager->getTransparencyMode() )
             {
               m_transparencyManager = createTransparencyManager( mode, m_viewportSize );
@@ -526,15 +594,31 @@ namespace dp
             return m_renderEngineOptions;
           }
 
+          void SceneRendererImpl::setRiXLibrary( std::string const& rixLibrary )
+          {
+            if ( rixLibrary != m_rixLibrary )
+            {
+              m_rixLibrary = rixLibrary;
+              shutdownRenderer();
+            }
+          }
+
+          std::string const& SceneRendererImpl::getRiXLibrary() const
+          {
+            return m_rixLibrary;
+          }
+
           void SceneRendererImpl::shutdownRenderer()
           {
             m_sceneTree.reset();
             delete m_drawableManager;
             m_drawableManager = 0;
             m_resourceManager.reset();
+            m_renderer.reset();
             m_rix.reset();
             m_contextRegistered = false;
             m_rendererInitialized = false;
+            m_headless = false;
           }
 
           bool SceneRendererImpl::initializeRenderer()
@@ -543,15 +627,22 @@ namespace dp
             {
               // clear all resources
 #if defined(DP_OS_WINDOWS)
-              m_rix = dp::util::DynamicLibrary::createFromFile( "RiXGL.rdr" );
+              m_rix = dp::util::DynamicLibrary::createFromFile( m_rixLibrary );
 #else
-              m_rix = dp::util::DynamicLibrary::createFromFile("libRiXGL.rdr");
+              m_rix = dp::util::DynamicLibrary::createFromFile( "lib" + m_rixLibrary );
 #endif
-              DP_ASSERT( m_rix && "Could not load dynamic library RiXGL.rdr" );
+              DP_ASSERT( m_rix && "Could not load RiX renderer library" );
 
               dp::rix::core::PFNCREATERENDERER createRenderer = reinterpret_cast<dp::rix::core::PFNCREATERENDERER>(m_rix->getSymbol("createRenderer"));
-              m_renderer.reset(dynamic_cast<dp::rix::gl::RiXGL*>((*createRenderer)( m_renderEngineOptions.c_str() )));
-              DP_ASSERT( m_renderer && "Could not create RiXGL renderer" );
+              m_renderer.reset( (*createRenderer)( m_renderEngineOptions.c_str() ) );
+              DP_ASSERT( m_renderer && "Could not create RiX renderer" );
+
+              // every renderer but RiXGL runs without an OpenGL context
+              m_headless = !dynamic_cast<dp::rix::gl::RiXGL*>( m_renderer.get() );
+              if ( m_headless && ( m_transparencyManager->getTransparencyMode() != TransparencyMode::NONE ) )
+              {
+                m_transparencyManager = createTransparencyManager( TransparencyMode::NONE, m_viewportSize );
+              }
 
               m_resourceManager = ResourceManager::create( m_renderer.get(), m_shaderManager );
 
@@ -303,7 +303,7 @@ namespace dp
             {
               ObjectTreeNode& otn = sceneTree->getObjectTreeNode(*itLight);
 
-              dp::sg::core::LightSourceSharedPtr ls = std::static_pointer_cast<dp::sg::core::LightSource>(otn.m_object);
+              dp::sg::core::LightSourceSharedPtr ls = std::static_pointer_cast<dp::sg::core::LightSource>(sceneTree->getObjectTree().getData(*itLight).m_object);
 
               ShaderLight &light = lightState.lights[lightId];
 
@@ -97,6 +97,9 @@ namespace dp
         DP_SG_XBAR_API virtual void setDrawableInstanceActive( Handle handle, bool visible ) = 0;
         DP_SG_XBAR_API virtual void setDrawableInstanceTraversalMask( Handle handle, uint32_t traversalMask ) = 0;
 
+        /** \brief Called when the SceneTree has been compacted and the GeoNode of the given handle got a new ObjectTreeIndex. **/
+        DP_SG_XBAR_API virtual void remapDrawableInstance( Handle handle, ObjectTreeIndex objectTreeIndex ) = 0;
+
       private:
         /** \brief Detach from current SceneTree. Called from setSceneTree. Calls removeDrawableInstance for all Drawables **/
         void detachSceneTree();
@@ -104,6 +107,9 @@ namespace dp
         /** \brief Attach to current SceneTree. Called from setSceneTree. Calls addDrawableInstance for all Drawables **/
         void attachSceneTree();
 
+        /** \brief Move the handles to the new ObjectTree indices. Called when the SceneTree has been compacted. **/
+        void remapIndices( std::vector<ObjectTreeIndex> const & newIndices );
+
         DP_SG_XBAR_API virtual void onSceneTreeChanged() = 0;
 
         friend class SceneTreeObserver;
@@ -0,0 +1,149 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/sg/xbar/xbar.h>
+#include <dp/sg/xbar/ObjectTree.h>
+#include <dp/sg/xbar/TransformTree.h>
+#include <dp/math/Matmnt.h>
+#include <dp/util/ThreadPool.h>
+#include <memory>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      DEFINE_PTR_TYPES( LODObserver );
+
+      /** \brief LODEvaluator selects the active child of all LODs in an ObjectTree. The center, ranges and current
+                 child of the LODs are kept in flat arrays. A LOD is evaluated only if the camera, the range scale, its world
+                 matrix or the LOD itself has changed since the last evaluation.
+      **/
+      class LODEvaluator
+      {
+      public:
+        /** \brief A LOD whose active child has changed during the last evaluation **/
+        struct ChangedLOD
+        {
+          ObjectTreeIndex index;       // index of the LOD in the ObjectTree
+          unsigned int    activeChild; // index of the active child or ~0 if the LOD has no children
+        };
+
+        typedef std::vector<ChangedLOD> ChangedLODs;
+
+        DP_SG_XBAR_API LODEvaluator();
+        DP_SG_XBAR_API ~LODEvaluator();
+
+        /** \brief Add a LOD located at the given ObjectTree index using the world matrix of the given transform. **/
+        DP_SG_XBAR_API void addLOD( dp::sg::core::LODSharedPtr const & lod, ObjectTreeIndex index, TransformIndex transform );
+        DP_SG_XBAR_API void removeLOD( ObjectTreeIndex index );
+        DP_SG_XBAR_API bool hasLOD( ObjectTreeIndex index ) const;
+
+        /** \brief Update the ObjectTree indices of all LODs after the ObjectTree has been compacted.
+            \param newIndices The new index for each old index as returned by ObjectTree::compact.
+        **/
+        DP_SG_XBAR_API void remapIndices( std::vector<ObjectTreeIndex> const & newIndices );
+
+        bool empty() const { return m_entries.empty(); }
+
+        /** \brief Select the active child of the LODs.
+            \param transformTree The computed TransformTree. Its changed world matrices determine the LODs to evaluate.
+            \param worldToView The world to view matrix of the camera.
+            \param rangeScale Scale factor for the ranges of all LODs. See LOD::getLODToUse.
+            \return The LODs whose active child has changed. Newly added and modified LODs are always reported.
+        **/
+        DP_SG_XBAR_API ChangedLODs const & evaluate( TransformTree const & transformTree, dp::math::Mat44f const & worldToView, float rangeScale );
+
+        /** \brief Set the hysteresis used to avoid switching a LOD back and forth at a range boundary.
+            \param hysteresis Relative size of the band around each range. A LOD switches to a coarser child once the distance
+                   exceeds range * (1 + hysteresis) and back to the finer child once it falls below range * (1 - hysteresis).
+                   The default of 0 selects the same children as LOD::getLODToUse.
+        **/
+        DP_SG_XBAR_API void setHysteresis( float hysteresis );
+        float getHysteresis() const { return m_hysteresis; }
+
+        /** \brief Set the number of threads used to evaluate the LODs. 0 uses one thread per hardware thread. The default is 1. **/
+        DP_SG_XBAR_API void setNumberOfThreads( unsigned int numberOfThreads );
+        DP_SG_XBAR_API unsigned int getNumberOfThreads() const;
+
+      private:
+        // per LOD data which is accessed during each evaluation
+        struct Entry
+        {
+          dp::math::Vec4f worldCenter;      // center in world space, updated when the world matrix changes
+          TransformIndex  transform;
+          unsigned int    firstRange;       // offset into m_ranges
+          unsigned int    numberOfRanges;   // number of ranges which are used, at most number of children - 1
+          unsigned int    fixedChild;       // child selected by a range lock or ~0 if no child exists, valid if isFixed
+          unsigned int    activeChild;
+          bool            isFixed;
+          bool            isDirty;          // the LOD has been added or modified since the last evaluation
+        };
+
+        // per LOD data which is only accessed when the LOD changes
+        struct Info
+        {
+          dp::sg::core::LODWeakPtr lod;
+          ObjectTreeIndex          index;
+          dp::math::Vec3f          center;
+          unsigned int             rangeCapacity; // number of ranges reserved at firstRange
+        };
+
+        void updateEntry( size_t entryIndex );
+        void evaluateEntries( size_t begin, size_t end, TransformTree const & transformTree, bool evaluateAll, ChangedLODs & changedLODs );
+        unsigned int selectChild( Entry const & entry, float distanceSquared ) const;
+        void compactRanges();
+
+      private:
+        std::vector<Entry>          m_entries;
+        std::vector<Info>           m_infos;
+        std::vector<unsigned int>   m_entryIndices;   // entry of each ObjectTree index or ~0
+        std::vector<float>          m_ranges;         // ranges of all LODs
+        size_t                      m_unusedRanges;   // number of ranges in m_ranges which are not referenced anymore
+
+        LODObserverSharedPtr          m_lodObserver;
+        std::vector<ObjectTreeIndex>  m_dirtyLODs;
+
+        dp::math::Mat44f  m_worldToView;
+        float             m_rangeScale;
+        float             m_hysteresis;
+        bool              m_viewValid;
+        bool              m_entriesDirty;     // true if any entry has been added or modified since the last evaluation
+
+        ChangedLODs               m_changedLODs;
+        std::vector<ChangedLODs>  m_taskChangedLODs;
+
+        std::unique_ptr<dp::util::ThreadPool> m_threadPool;
+      };
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
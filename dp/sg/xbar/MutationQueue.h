@@ -0,0 +1,127 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/sg/xbar/xbar.h>
+#include <dp/sg/core/CoreTypes.h>
+#include <dp/math/Matmnt.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      DEFINE_PTR_TYPES( MutationBuffer );
+      DEFINE_PTR_TYPES( MutationQueue );
+
+      /** \brief MutationBuffer records edits of the scene graph on one thread. The edits are executed by MutationQueue::apply,
+                 which is called by SceneTree::update on the thread updating the SceneTree. Recording never blocks and never
+                 waits for apply.
+          \remarks A MutationBuffer must only be used by one thread at a time. Objects which are part of the scene must
+                   only be edited through the buffer, objects which are not yet part of the scene can be edited directly.
+      **/
+      class MutationBuffer
+      {
+      public:
+        DP_SG_XBAR_API ~MutationBuffer();
+
+        DP_SG_XBAR_API void addChild( dp::sg::core::GroupSharedPtr const & group, dp::sg::core::NodeSharedPtr const & child );
+        DP_SG_XBAR_API void removeChild( dp::sg::core::GroupSharedPtr const & group, dp::sg::core::NodeSharedPtr const & child );
+
+        /** \brief Set the matrix of a transform. Only the last matrix recorded for a transform since the last apply is set. **/
+        DP_SG_XBAR_API void setMatrix( dp::sg::core::TransformSharedPtr const & transform, dp::math::Mat44f const & matrix );
+
+        DP_SG_XBAR_API void setActive( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int index );
+        DP_SG_XBAR_API void setInactive( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int index );
+        DP_SG_XBAR_API void setActiveMaskKey( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int maskKey );
+
+        /** \brief Record an arbitrary edit. The function is called by apply in the order of recording. **/
+        DP_SG_XBAR_API void execute( std::function<void()> const & function );
+
+      private:
+        friend class MutationQueue;
+
+        struct Command;
+        struct Chunk;
+
+        MutationBuffer();
+        MutationBuffer( MutationBuffer const & );
+        MutationBuffer & operator=( MutationBuffer const & );
+
+        // get the next free command and publish it once it has been filled in
+        Command & push();
+        void publish();
+
+      private:
+        Chunk * m_head;       // first chunk with commands which have not been applied, owned by the applying thread
+        size_t  m_applied;    // number of applied commands in m_head, owned by the applying thread
+        Chunk * m_tail;       // chunk receiving new commands, owned by the recording thread
+      };
+
+      /** \brief MutationQueue collects the MutationBuffers of all threads editing the scene while the SceneTree is being updated
+                 or rendered on another thread. Create one buffer per thread and attach the queue to the SceneTree with
+                 SceneTree::setMutationQueue.
+      **/
+      class MutationQueue
+      {
+      public:
+        DP_SG_XBAR_API static MutationQueueSharedPtr create();
+        DP_SG_XBAR_API ~MutationQueue();
+
+        /** \brief Create a buffer for the calling thread. The queue keeps the buffer until it has been released and all of its
+                   commands have been applied.
+        **/
+        DP_SG_XBAR_API MutationBufferSharedPtr createBuffer();
+
+        /** \brief Execute the commands recorded so far. The buffers are processed in the order of their creation, the commands
+                   of a buffer in the order of their recording. Commands recorded while apply is running are executed by the
+                   next call. Only one thread may call apply at a time.
+            \return The number of executed commands. Coalesced matrices are not counted.
+        **/
+        DP_SG_XBAR_API size_t apply();
+
+      protected:
+        MutationQueue();
+
+      private:
+        std::mutex                            m_buffersMutex;   // guards m_buffers against createBuffer
+        std::vector<MutationBufferSharedPtr>  m_buffers;
+
+        // sequence number of the last recorded matrix of each transform, reused by each apply
+        std::unordered_map<dp::sg::core::Object const *, size_t> m_lastMatrices;
+      };
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -76,8 +76,6 @@ namespace dp
         {
         }
 
-        dp::sg::core::ObjectSharedPtr m_object;         // the node's object in the tree
-
         // new transform hierarchy
         TransformIndex              m_transform;       // id in transform array
         ObjectTreeIndex             m_transformParent; // object index of parent in transform hierarchy
@@ -92,15 +90,19 @@ namespace dp
         bool                        m_isDrawable;
         bool                        m_isTransform;    // object is any kind of transform
         bool                        m_isBillboard;    // object is billboard
+      };
 
-        SmartClipPlaneGroup         m_clipPlaneGroup;
+      // data of an ObjectTreeNode which is not needed to traverse the tree, kept in a separate array to keep the nodes small
+      struct ObjectTreeNodeData
+      {
+        dp::sg::core::ObjectSharedPtr m_object;         // the node's object in the tree
+        SmartClipPlaneGroup           m_clipPlaneGroup;
       };
 
-      class ObjectTree : public TreeBaseClass< ObjectTreeNode, ObjectTreeIndex >
+      class ObjectTree : public TreeBaseClass< ObjectTreeNode, ObjectTreeIndex, ObjectTreeNodeData >
       {
       public:
-        std::map< ObjectTreeIndex, dp::sg::core::SwitchWeakPtr > m_switchNodes;
-        std::map< ObjectTreeIndex, dp::sg::core::LODWeakPtr >    m_LODs;
+        dp::util::BitArray m_switchNodes;   // bit i is set iff node i is a Switch observed by the SceneTree, the Switch is the node's object
       };
 
       typedef std::set< ObjectTreeIndex > ObjectTreeIndexSet;
@@ -33,6 +33,8 @@
 #include <dp/sg/core/ClipPlane.h>
 #include <dp/sg/ui/RendererOptions.h>
 #include <dp/sg/xbar/TransformTree.h>
+#include <dp/sg/xbar/LODEvaluator.h>
+#include <dp/sg/xbar/MutationQueue.h>
 
 #include <vector>
 #include <stack>
@@ -76,12 +78,14 @@ namespace dp
             , CHANGED
             , ACTIVE_CHANGED
             , TRAVERSAL_MASK_CHANGED
+            , INDICES_REMAPPED          // the event is a RemapEvent
           };
 
-          Event(ObjectTreeIndex index, ObjectTreeNode const& node, Type subType)
+          Event(ObjectTreeIndex index, ObjectTreeNode const& node, ObjectTreeNodeData const& data, Type subType)
             : m_type( subType )
             , m_index( index )
             , m_node( node )
+            , m_data( data )
           {
           }
 
@@ -89,16 +93,46 @@ namespace dp
           Type getType() const { return m_type; }
           ObjectTreeIndex getIndex() const { return m_index; }
           ObjectTreeNode const & getNode() const { return m_node; }
+          ObjectTreeNodeData const & getData() const { return m_data; }
 
         protected:
           Type               m_type;
           ObjectTreeIndex       m_index;
           ObjectTreeNode const& m_node;
+          ObjectTreeNodeData const& m_data;
 
         };
 
+        /** \brief Sent by compact after the nodes of the ObjectTree have been renumbered. Index and node of the event are the ones of the sentinel. **/
+        class RemapEvent : public Event
+        {
+        public:
+          RemapEvent( ObjectTreeIndex index, ObjectTreeNode const& node, ObjectTreeNodeData const& data, std::vector<ObjectTreeIndex> const & newIndices )
+            : Event( index, node, data, Type::INDICES_REMAPPED )
+            , m_newIndices( newIndices )
+          {
+          }
+
+          /** \brief The new index of each old index or ~0 if the old index has not been in use. **/
+          std::vector<ObjectTreeIndex> const & getNewIndices() const { return m_newIndices; }
+
+        protected:
+          std::vector<ObjectTreeIndex> const & m_newIndices;
+        };
+
       public:
-        DP_SG_XBAR_API static SceneTreeSharedPtr create( dp::sg::core::SceneSharedPtr const & scene );
+        enum class BuildMode
+        {
+            BULK          // size all trees once and build disjoint subtrees in parallel
+          , INCREMENTAL   // add the nodes one by one as done for nodes added to an existing tree
+        };
+
+        /** \brief Create the SceneTree of a scene.
+            \param scene The scene to build the tree for.
+            \param buildMode BULK builds the same tree as INCREMENTAL. Scenes with clip planes are always built incrementally.
+            \param numberOfThreads Number of threads used by the bulk build. 0 uses one thread per hardware thread.
+        **/
+        DP_SG_XBAR_API static SceneTreeSharedPtr create( dp::sg::core::SceneSharedPtr const & scene, BuildMode buildMode = BuildMode::BULK, unsigned int numberOfThreads = 0 );
         virtual ~SceneTree();
 
         DP_SG_XBAR_API dp::sg::core::SceneSharedPtr const & getScene() const;
@@ -120,8 +154,15 @@ namespace dp
 
         DP_SG_XBAR_API void update(dp::sg::core::CameraSharedPtr const& camera, float lodScaleRange);
 
+        /** \brief Renumber the nodes of the ObjectTree in pre-order and release the memory of unused nodes. After many nodes have been added
+                   and removed the nodes of a subtree are scattered over the ObjectTree, compacting puts them back into consecutive memory.
+                   Observers of the SceneTree receive a RemapEvent with the new index of each node. Compare getObjectTree().getNumberOfNodes()
+                   with getObjectTree().size() to decide if compacting is worthwhile.
+        **/
+        DP_SG_XBAR_API void compact();
+
         //! Add a new object to the Tree
-        DP_SG_XBAR_API ObjectTreeIndex addObject( const ObjectTreeNode & node, ObjectTreeIndex parentIndex, ObjectTreeIndex siblingIndex );
+        DP_SG_XBAR_API ObjectTreeIndex addObject( const ObjectTreeNode & node, const ObjectTreeNodeData & data, ObjectTreeIndex parentIndex, ObjectTreeIndex siblingIndex );
 
         // special functions to mark object tree indices as special nodes
         DP_SG_XBAR_API void addLOD( dp::sg::core::LODSharedPtr const& lod, ObjectTreeIndex index );
@@ -139,6 +180,11 @@ namespace dp
 
         const std::set< ObjectTreeIndex >& getLightSources() const { return m_lightSources; }
         TransformTree & getTransformTree() { return m_transformTree; }
+        LODEvaluator & getLODEvaluator() { return m_lodEvaluator; }
+
+        /** \brief Set a queue of edits recorded by other threads. update applies the recorded edits before updating the tree. **/
+        void setMutationQueue( MutationQueueSharedPtr const & mutationQueue ) { m_mutationQueue = mutationQueue; }
+        MutationQueueSharedPtr const & getMutationQueue() const { return m_mutationQueue; }
 
       protected:
         // remove a transform from the transform array
@@ -149,13 +195,14 @@ namespace dp
         DP_SG_XBAR_API void onRootNodeChanged( );
 
       private:
-        void init();
+        void init( BuildMode buildMode, unsigned int numberOfThreads );
 
         friend class UpdateTransformVisitor;
         friend class UpdateObjectVisitor;
         friend class SceneObserver;
         friend class SceneGenerator;
         friend class GeneratorState;
+        friend class SceneTreeBuilder;
 
         dp::sg::core::SceneSharedPtr m_scene;
         // keep a reference to the root node of the scene so that treplaceSubTree works if the root node of the scene gets exchanged.
@@ -173,10 +220,14 @@ namespace dp
         ObjectTreeIndex                          m_objectTreeSentinel;
         ObjectTreeIndex                          m_objectTreeRootNode;
         std::vector< ObjectTreeIndex >           m_objectIndexStack;    // temp variable
+        std::vector< TransformIndex >            m_removedTransforms;   // temp variable, transforms of a removed subtree
 
         std::set< ObjectTreeIndex >              m_lightSources;
 
         TransformTree m_transformTree;
+        LODEvaluator  m_lodEvaluator;
+
+        MutationQueueSharedPtr m_mutationQueue;
       };
 
       /*===========================================================================*/
@@ -0,0 +1,165 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/sg/xbar/xbar.h>
+#include <dp/sg/xbar/SceneTree.h>
+#include <dp/math/Matmnt.h>
+#include <dp/util/BitArray.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      DEFINE_PTR_TYPES( SceneTreeSnapshot );
+
+      /** \brief SceneTreeSnapshot decouples the thread updating a SceneTree from the thread rendering it. The update thread publishes
+                 the world matrices, the active flags and the visibility of the SceneTree as an immutable frame after each update, the
+                 render thread acquires the last published frame and reads it while the next frame is being updated.
+          \remarks The snapshot keeps two frames. Publishing a frame copies only the entries which have changed since the frame has
+                   been published before, i.e. the changes of the last two updates, so the cost is bounded by the number of changes
+                   instead of the size of the tree. publish waits until the render thread has released the frame it is going to
+                   overwrite.
+      **/
+      class SceneTreeSnapshot : public dp::util::Observer
+      {
+      public:
+        class Frame
+        {
+        public:
+          /** \brief Number of the frame, counting the calls to publish. Compare it with the number of the last frame read to detect
+                     skipped frames, whose changes are not contained in getChangedWorldMatrices and getChangedObjects.
+          **/
+          size_t getFrameNumber() const { return m_frameNumber; }
+
+          size_t getNumberOfTransforms() const { return m_worldMatrices.size(); }
+          dp::math::Mat44f const & getWorldMatrix( TransformIndex transformIndex ) const { return m_worldMatrices[transformIndex]; }
+
+          /** \brief The active flags are tracked for the GeoNodes, the visibility for the objects passed to setVisible. **/
+          size_t getNumberOfObjects() const { return m_active.getSize(); }
+          bool isActive( ObjectTreeIndex objectTreeIndex ) const { return m_active.getBit( objectTreeIndex ); }
+          bool isVisible( ObjectTreeIndex objectTreeIndex ) const { return m_visible.getBit( objectTreeIndex ); }
+
+          /** \brief World matrices which have changed since the previous frame **/
+          dp::util::BitArray const & getChangedWorldMatrices() const { return m_changedWorldMatrices; }
+
+          /** \brief Objects whose active flag or visibility has changed since the previous frame **/
+          dp::util::BitArray const & getChangedObjects() const { return m_changedObjects; }
+
+        private:
+          friend class SceneTreeSnapshot;
+
+          Frame();
+
+          size_t                        m_frameNumber;
+          std::vector<dp::math::Mat44f> m_worldMatrices;
+          dp::util::BitArray            m_active;
+          dp::util::BitArray            m_visible;
+          dp::util::BitArray            m_changedWorldMatrices;
+          dp::util::BitArray            m_changedObjects;
+          unsigned int                  m_readers;    // number of acquired references, guarded by the mutex of the snapshot
+        };
+
+        typedef std::shared_ptr<Frame const> FrameSharedPtr;
+
+      public:
+        /** \brief Create a snapshot of the given SceneTree. The first call to publish copies the whole tree. **/
+        DP_SG_XBAR_API static SceneTreeSnapshotSharedPtr create( SceneTreeSharedPtr const & sceneTree );
+        DP_SG_XBAR_API virtual ~SceneTreeSnapshot();
+
+        /** \brief Set the visibility of an object for the next published frame, e.g. for the objects reported by
+                   Culling::resultGetChangedIndices after culling the updated tree. Objects are visible by default.
+                   Call on the update thread only.
+        **/
+        DP_SG_XBAR_API void setVisible( ObjectTreeIndex objectTreeIndex, bool visible );
+
+        /** \brief Publish the current state of the SceneTree as the new frame. Call on the update thread after SceneTree::update
+                   and after the visibility has been set. Blocks while the frame to overwrite is still acquired by a reader.
+        **/
+        DP_SG_XBAR_API void publish();
+
+        /** \brief Get the last published frame. The frame does not change while the returned reference is being held, release it
+                   before the next frame is acquired to not block the update thread. All frames must have been released
+                   before the snapshot is destroyed.
+        **/
+        DP_SG_XBAR_API FrameSharedPtr acquire();
+
+      protected:
+        SceneTreeSnapshot( SceneTreeSharedPtr const & sceneTree );
+
+        // observer framework
+        virtual void onNotify( dp::util::Event const & event, dp::util::Payload * payload );
+        virtual void onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload );
+
+      private:
+        class TransformObserver : public dp::util::Observer
+        {
+        public:
+          TransformObserver( SceneTreeSnapshot & snapshot )
+            : m_snapshot( snapshot )
+          {
+          }
+
+          virtual void onNotify( dp::util::Event const & event, dp::util::Payload * payload );
+          virtual void onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload );
+
+        private:
+          SceneTreeSnapshot & m_snapshot;
+        };
+
+        void setChangedObject( ObjectTreeIndex objectTreeIndex );
+        void reserveObjects( size_t numberOfObjects );
+        void remapIndices( std::vector<ObjectTreeIndex> const & newIndices );
+        void release( Frame const * frame );
+
+      private:
+        SceneTreeSharedPtr const           m_sceneTree;
+        std::unique_ptr<TransformObserver> m_transformObserver;
+
+        // state of the update thread which has not been published yet
+        dp::util::BitArray m_active;                  // current active flag of each object
+        dp::util::BitArray m_visible;                 // current visibility of each object
+        dp::util::BitArray m_changedWorldMatrices;    // world matrices changed since the last publish
+        dp::util::BitArray m_changedObjects;          // objects changed since the last publish
+        bool               m_refresh;                 // copy everything with the next publish
+
+        std::mutex              m_mutex;
+        std::condition_variable m_released;
+        Frame                   m_frames[2];
+        unsigned int            m_front;              // index of the last published frame, guarded by m_mutex
+      };
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
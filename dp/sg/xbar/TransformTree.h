@@ -28,7 +28,10 @@
 #include <dp/sg/xbar/xbar.h>
 #include <dp/math/Matmnt.h>
 #include <dp/util/BitArray.h>
+#include <dp/util/ThreadPool.h>
 #include <dp/sg/core/CoreTypes.h>
+#include <memory>
+#include <vector>
 
 namespace dp
 {
@@ -76,12 +79,32 @@ namespace dp
         TransformIndex addBillboard(TransformIndex parentIndex, dp::sg::core::BillboardSharedPtr const & billboard);
         void removeBillboard(TransformIndex transformIndex);
 
-        //! \brief Recompute the values in the transform tree
+        /** \brief Remove the given transforms and billboards at once. The entries of each affected level are compacted in a single
+                   pass, which keeps them sorted, instead of being swapped out one by one. Use this to remove whole subtrees.
+        **/
+        void removeTransforms(std::vector<TransformIndex> const & transformIndices);
+
+        //! \brief Allocate the storage for the given number of additional transforms and billboards at once
+        void reserve(size_t numberOfTransforms);
+
+        /** \brief Recompute the values in the transform tree. The levels of the tree are computed one after another, the entries
+                   of a level are independent and distributed over the threads of the tree.
+        **/
         void compute(dp::sg::core::CameraSharedPtr const & camera);
 
+        /** \brief Set the number of threads used to compute large levels of the tree.
+            \param numberOfThreads Number of threads including the calling thread. 1 computes on the calling thread only,
+                   0 uses one thread per hardware thread. The default is 1.
+        **/
+        DP_SG_XBAR_API void setNumberOfThreads(unsigned int numberOfThreads);
+        DP_SG_XBAR_API unsigned int getNumberOfThreads() const;
+
         dp::math::Mat44f const & getWorldMatrix(TransformIndex transformIndex) const { return m_transforms[transformIndex].world; }
         Transforms const & getTransforms() const { return m_transforms; }
 
+        //! \brief Get the world matrices which have been changed by the last call to compute
+        dp::util::BitArray const & getChangedWorldMatrices() const { return m_dirtyWorldMatrices; }
+
         //! \brief Get index of the virtual root node
         TransformIndex getSentinel() const { return 0; }
 
@@ -89,6 +112,9 @@ namespace dp
         //! \brief Resize data structures to new size
         void resizeDataStructures(size_t newSize);
 
+        //! \brief Remove the entry of the given transform or billboard from its level by moving the last entry into its place
+        void removeEntry(TransformIndex transformIndex);
+
         TransformIndex allocateIndex();
         void freeIndex(TransformIndex transformIndex);
         bool isValidIndex(TransformIndex transformIndex)
@@ -97,9 +123,15 @@ namespace dp
         }
 
         dp::util::BitArray m_transformFreeVector; // free if bit is true, occupied otherwise
+        size_t             m_firstFreeIndex;      // all indices below are occupied
         dp::util::BitArray m_dirtyTransforms; // true if a transform has been changed
         dp::util::BitArray m_dirtyWorldMatrices; // a bitarray which specifies which world matrices has changed during the last compute iteration
 
+        // Incarnation of the compute call which changed the world matrix of each transform. Threads compare the incarnation of the
+        // parent instead of reading m_dirtyWorldMatrices, whose words might be written by other threads at the same time.
+        std::vector<uint32_t> m_worldIncarnations;
+        uint32_t              m_computeIncarnation;
+
         Transforms m_transforms; // array with all transforms
 
         struct TransformListEntry {
@@ -116,9 +148,14 @@ namespace dp
         typedef std::vector<TransformListEntry> TransformListEntries;
         typedef std::vector<BillboardListEntry> BillboardListEntries;
 
+        // The entries of a level are kept sorted by their transform index. Thus the matrices are accessed in memory order and
+        // each thread can be assigned a range of entries which writes its own words of m_dirtyWorldMatrices.
         struct TransformLevel {
+          TransformLevel() : sorted(true) {}
+
           TransformListEntries transformListEntries;
           BillboardListEntries billboardListEntries;
+          bool sorted; // false if the entries have to be sorted before the next compute
         };
 
         typedef std::vector<TransformLevel> TransformLevels;
@@ -128,6 +165,8 @@ namespace dp
         struct TransformInfo {
           dp::sg::core::ObjectSharedPtr object;
           uint32_t                      level;
+          uint32_t                      entry;        // position in the transform or billboard list of the level
+          bool                          isBillboard;
         };
 
         typedef std::vector<TransformInfo> TransformInfos;
@@ -135,6 +174,8 @@ namespace dp
 
         TransformObserverSharedPtr m_transformObserver;
         bool m_firstCompute;
+
+        std::unique_ptr<dp::util::ThreadPool> m_threadPool;
       };
 
     } // namespace xbar
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
 #include <vector>
 #include <dp/Assert.h>
@@ -38,34 +39,58 @@ namespace dp
     {
       typedef uint32_t ObjectTreeIndex;
 
-      template< class NodeClass, class IndexClass >
+      // The nodes of a tree are split into two arrays. NodeClass holds the links and the data accessed by the traversals,
+      // DataClass holds the data which is only accessed when a node is added, removed or changed.
+      template< class NodeClass, class IndexClass, class DataClass >
       class TreeBaseClass
       {
       public:
         // typedefs for traversers
         typedef NodeClass  NodeType;
         typedef IndexClass IndexType;
+        typedef DataClass  DataType;
 
         TreeBaseClass();
         virtual ~TreeBaseClass();
 
         IndexClass getFreeNode();
 
-        IndexClass insertNode( const NodeClass & node, IndexClass parentIndex, IndexClass prevSiblingIndex );
+        IndexClass insertNode( const NodeClass & node, const DataClass & data, IndexClass parentIndex, IndexClass prevSiblingIndex );
+
+        // allocate count consecutive nodes without linking them into the tree. The nodes get the same indices insertNode would
+        // assign to them as long as no node has been deleted, i.e. the free list is the consecutive range at the end of the tree.
+        IndexClass allocateNodes( size_t count );
 
         void deleteNode( IndexClass index );
 
+        // renumber the nodes reachable from the root at index 0 in pre-order and shrink the tree to the smallest size which holds them.
+        // newIndices[index] is set to the new index of the node at index or ~0 if the index has not been in use.
+        void compact( std::vector<IndexClass> & newIndices );
+
         NodeClass& operator[]( const IndexClass index );
 
         const NodeClass& operator[]( const IndexClass index ) const;
 
+        DataClass& getData( const IndexClass index );
+
+        const DataClass& getData( const IndexClass index ) const;
+
+        // number of allocated nodes, including the free ones
         size_t size() const;
 
+        // number of nodes in use
+        size_t getNumberOfNodes() const;
+
         void markDirty( const IndexClass index, unsigned int bits );
 
         IndexClass               m_firstFreeIndex;
+        size_t                   m_numberOfNodes;
         std::vector< NodeClass > m_tree;
+        std::vector< DataClass > m_data;
         std::vector< IndexClass> m_dirtyObjects;
+
+      private:
+        static size_t getGrownSize( size_t size );
       };
 
       template <typename TreeType, typename TreeNodeVisitor>
@@ -83,27 +108,36 @@ namespace dp
         TreeNodeVisitor *m_visitor;
       };
 
-      template< class NodeClass, class IndexClass >
-      TreeBaseClass<NodeClass, IndexClass>::TreeBaseClass()
+      template< class NodeClass, class IndexClass, class DataClass >
+      TreeBaseClass<NodeClass, IndexClass, DataClass>::TreeBaseClass()
       {
         // initialize object tree with some free indices
         IndexType n( 65536 );
         m_tree.resize( n );
+        m_data.resize( n );
         // generate a chain of free objects, leave last index as initialized (~0)
         for( IndexType i=0; i<n-1; ++i )
         {
           m_tree[i].m_nextSibling = i+1;
         }
         m_firstFreeIndex = 0;
+        m_numberOfNodes = 0;
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      TreeBaseClass<NodeClass, IndexClass, DataClass>::~TreeBaseClass()
+      {
       }
 
-      template< class NodeClass, class IndexClass >
-      TreeBaseClass<NodeClass, IndexClass>::~TreeBaseClass()
+      template< class NodeClass, class IndexClass, class DataClass >
+      size_t TreeBaseClass<NodeClass, IndexClass, DataClass>::getGrownSize( size_t size )
       {
+        // resize to factor of old size
+        return dp::checked_cast<size_t>( size * 1.5f );
       }
 
-      template< class NodeClass, class IndexClass >
-      IndexClass dp::sg::xbar::TreeBaseClass<NodeClass, IndexClass>::getFreeNode()
+      template< class NodeClass, class IndexClass, class DataClass >
+      IndexClass dp::sg::xbar::TreeBaseClass<NodeClass, IndexClass, DataClass>::getFreeNode()
       {
         // check if this is the last free index -> allocate more
         if( m_tree[m_firstFreeIndex].m_nextSibling == ~0 )
@@ -111,8 +145,8 @@ namespace dp
           IndexType size = IndexType(m_tree.size());
           IndexClass firstNew = size;
 
-          // resize to factor of old size
-          m_tree.resize( dp::checked_cast<size_t>(size * 1.5f) );
+          m_tree.resize( getGrownSize( size ) );
+          m_data.resize( m_tree.size() );
           IndexType newSize = IndexType(m_tree.size());
 
           // generate a new chain of free objects, with the last one pointing to ~0
@@ -125,11 +159,12 @@ namespace dp
 
         IndexType index = m_firstFreeIndex;
         m_firstFreeIndex = m_tree[m_firstFreeIndex].m_nextSibling;
+        ++m_numberOfNodes;
         return index;
       }
 
-      template< class NodeClass, class IndexClass >
-      IndexClass TreeBaseClass<NodeClass, IndexClass>::insertNode( const NodeClass & node, IndexClass parentIndex, IndexClass prevSiblingIndex )
+      template< class NodeClass, class IndexClass, class DataClass >
+      IndexClass TreeBaseClass<NodeClass, IndexClass, DataClass>::insertNode( const NodeClass & node, const DataClass & data, IndexClass parentIndex, IndexClass prevSiblingIndex )
       {
         IndexClass index = getFreeNode();
 
@@ -137,6 +172,7 @@ namespace dp
 
         // put node into tree
         newNode = node;
+        m_data[index] = data;
 
         // connect node in tree
         newNode.m_parentIndex = parentIndex;
@@ -174,8 +210,38 @@ namespace dp
         return index;
       }
 
-      template< class NodeClass, class IndexClass >
-      void TreeBaseClass<NodeClass, IndexClass>::deleteNode( IndexClass index )
+      template< class NodeClass, class IndexClass, class DataClass >
+      IndexClass TreeBaseClass<NodeClass, IndexClass, DataClass>::allocateNodes( size_t count )
+      {
+        IndexClass firstIndex = m_firstFreeIndex;
+        DP_ASSERT( m_tree[firstIndex].m_nextSibling == ~0 || m_tree[firstIndex].m_nextSibling == firstIndex + 1 );
+
+        // grow in the same steps as getFreeNode would do while allocating the nodes one by one
+        size_t oldSize = m_tree.size();
+        size_t newSize = oldSize;
+        while ( newSize <= firstIndex + count )
+        {
+          newSize = getGrownSize( newSize );
+        }
+
+        if ( newSize != oldSize )
+        {
+          m_tree.resize( newSize );
+          m_data.resize( newSize );
+          m_tree[oldSize - 1].m_nextSibling = IndexType(oldSize);
+          for( IndexType i = IndexType(oldSize); i < newSize - 1; ++i )
+          {
+            m_tree[i].m_nextSibling = i+1;
+          }
+        }
+
+        m_firstFreeIndex = IndexClass(firstIndex + count);
+        m_numberOfNodes += count;
+        return firstIndex;
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      void TreeBaseClass<NodeClass, IndexClass, DataClass>::deleteNode( IndexClass index )
       {
         DP_ASSERT( index != ~0 );
         NodeClass& node = m_tree[index];
@@ -231,6 +297,8 @@ namespace dp
           // disconnect node from parents and children
           current.m_firstChild  = ~0;
           current.m_parentIndex = ~0;
+          m_data[currentIndex] = DataClass();
+          --m_numberOfNodes;
 
           // put node into free list
           if( lastIndex != ~0 )
@@ -243,26 +311,120 @@ namespace dp
         m_firstFreeIndex = index;
       }
 
-      template< class NodeClass, class IndexClass >
-      NodeClass& TreeBaseClass<NodeClass, IndexClass>::operator[]( const IndexClass index )
+      template< class NodeClass, class IndexClass, class DataClass >
+      void TreeBaseClass<NodeClass, IndexClass, DataClass>::compact( std::vector<IndexClass> & newIndices )
+      {
+        DP_ASSERT( m_tree[0].m_parentIndex == ~0 && m_tree[0].m_nextSibling == ~0 );
+
+        // number the nodes in pre-order: descend to the first child, otherwise continue with the next sibling of the node or of its closest ancestor
+        newIndices.assign( m_tree.size(), ~0 );
+        IndexClass count = 0;
+        IndexClass index = 0;
+        while ( index != ~0 )
+        {
+          newIndices[index] = count++;
+          if ( m_tree[index].m_firstChild != ~0 )
+          {
+            index = m_tree[index].m_firstChild;
+          }
+          else
+          {
+            while ( index != ~0 && m_tree[index].m_nextSibling == ~0 )
+            {
+              index = m_tree[index].m_parentIndex;
+            }
+            if ( index != ~0 )
+            {
+              index = m_tree[index].m_nextSibling;
+            }
+          }
+        }
+        DP_ASSERT( count == m_numberOfNodes );
+
+        // grow in the same steps as getFreeNode from the initial size, keeping at least one free node at the end of the free list
+        size_t newSize = 65536;
+        while ( newSize <= count )
+        {
+          newSize = getGrownSize( newSize );
+        }
+
+        // copy the nodes to their new location in fresh arrays, which releases the memory of the old ones
+        std::vector< NodeClass > tree( newSize );
+        std::vector< DataClass > data( newSize );
+        for ( size_t oldIndex = 0; oldIndex < m_tree.size(); ++oldIndex )
+        {
+          IndexClass newIndex = newIndices[oldIndex];
+          if ( newIndex != ~0 )
+          {
+            NodeClass & node = tree[newIndex];
+            node = m_tree[oldIndex];
+            node.m_parentIndex = ( node.m_parentIndex != ~0 ) ? newIndices[node.m_parentIndex] : node.m_parentIndex;
+            node.m_nextSibling = ( node.m_nextSibling != ~0 ) ? newIndices[node.m_nextSibling] : node.m_nextSibling;
+            node.m_firstChild = ( node.m_firstChild != ~0 ) ? newIndices[node.m_firstChild] : node.m_firstChild;
+            std::swap( data[newIndex], m_data[oldIndex] );
+          }
+        }
+
+        // chain the free nodes behind the used ones, leave the last index as initialized (~0)
+        for ( IndexType i = count; i < newSize - 1; ++i )
+        {
+          tree[i].m_nextSibling = i + 1;
+        }
+        m_firstFreeIndex = count;
+
+        m_tree.swap( tree );
+        m_data.swap( data );
+
+        // deleted nodes might still be in the dirty list
+        size_t numberOfDirtyObjects = 0;
+        for ( size_t i = 0; i < m_dirtyObjects.size(); ++i )
+        {
+          if ( newIndices[m_dirtyObjects[i]] != ~0 )
+          {
+            m_dirtyObjects[numberOfDirtyObjects++] = newIndices[m_dirtyObjects[i]];
+          }
+        }
+        m_dirtyObjects.resize( numberOfDirtyObjects );
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      NodeClass& TreeBaseClass<NodeClass, IndexClass, DataClass>::operator[]( const IndexClass index )
       {
         return m_tree[index];
       }
 
-      template< class NodeClass, class IndexClass >
-      const NodeClass& TreeBaseClass<NodeClass, IndexClass>::operator[]( const IndexClass index ) const
+      template< class NodeClass, class IndexClass, class DataClass >
+      const NodeClass& TreeBaseClass<NodeClass, IndexClass, DataClass>::operator[]( const IndexClass index ) const
       {
         return m_tree[index];
       }
 
-      template< class NodeClass, class IndexClass >
-      size_t TreeBaseClass<NodeClass, IndexClass>::size() const
+      template< class NodeClass, class IndexClass, class DataClass >
+      DataClass& TreeBaseClass<NodeClass, IndexClass, DataClass>::getData( const IndexClass index )
+      {
+        return m_data[index];
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      const DataClass& TreeBaseClass<NodeClass, IndexClass, DataClass>::getData( const IndexClass index ) const
+      {
+        return m_data[index];
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      size_t TreeBaseClass<NodeClass, IndexClass, DataClass>::size() const
       {
         return m_tree.size();
       }
 
-      template< class NodeClass, class IndexClass >
-      void TreeBaseClass<NodeClass, IndexClass>::markDirty( const IndexClass index, unsigned int bits )
+      template< class NodeClass, class IndexClass, class DataClass >
+      size_t TreeBaseClass<NodeClass, IndexClass, DataClass>::getNumberOfNodes() const
+      {
+        return m_numberOfNodes;
+      }
+
+      template< class NodeClass, class IndexClass, class DataClass >
+      void TreeBaseClass<NodeClass, IndexClass, DataClass>::markDirty( const IndexClass index, unsigned int bits )
       {
         if ( !m_tree[index].m_dirtyBits )
         {
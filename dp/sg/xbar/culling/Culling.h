@@ -71,11 +71,48 @@ namespace dp
           /** \brief Get the list of ObjectTree indices whose visibility has changed during the last cull call **/
           DP_SG_XBAR_CULLING_API virtual std::vector<dp::sg::xbar::ObjectTreeIndex> const & resultGetChangedIndices( ResultSharedPtr const & ) const = 0;
 
-          /** \brief Cull the SceneTree against the given world2ViewProjection matrix and update the given result **/
+          /** \brief Cull the SceneTree against the given world2ViewProjection matrix and update the given result.
+                     If occlusion culling is enabled objects hidden behind occluders are culled in a second pass.
+          **/
           DP_SG_XBAR_CULLING_API virtual void cull( ResultSharedPtr const& result, dp::math::Mat44f const & world2ViewProjection ) = 0;
 
+          /** \brief Cull the SceneTree against multiple views in a single pass. results[i] is updated with the visibility for
+                     world2ViewProjections[i]. This is faster than culling each view separately since the objects are traversed only once.
+          **/
+          DP_SG_XBAR_CULLING_API virtual void cull( std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & world2ViewProjections ) = 0;
+
+          /** \brief Cull the SceneTree against multiple views and update the given result with the union of the visible objects,
+                     e.g. for stereo rendering where both eyes render the same set of objects.
+          **/
+          DP_SG_XBAR_CULLING_API virtual void cullUnion( ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & world2ViewProjections ) = 0;
+
           /** \brief Calculate the bounding box of the SceneTree. Currently all active and inactive objects are used to calculate the result **/
           DP_SG_XBAR_CULLING_API virtual dp::math::Box3f getBoundingBox( ) = 0;
+
+          /** \brief Enable the occlusion culling pass after the frustum culling. Objects hidden behind the largest visible occluders
+                     are reported as invisible. Occlusion culling is supported by the CPU culling modes only and disabled by default.
+              \return true if the occlusion culling state could be set.
+          **/
+          DP_SG_XBAR_CULLING_API virtual bool setOcclusionCulling( bool enabled ) = 0;
+          DP_SG_XBAR_CULLING_API virtual bool isOcclusionCulling() const = 0;
+
+          /** \brief Use an object as occluder for the occlusion culling pass.
+              \param objectTreeIndex The object to use as occluder.
+              \param occluderBox Box in object space which is completely covered by the geometry of the object, e.g. the inner box of a wall.
+                     An invalid box removes the object from the list of occluders.
+          **/
+          DP_SG_XBAR_CULLING_API virtual void setOccluder( ObjectTreeIndex objectTreeIndex, dp::math::Box3f const & occluderBox ) = 0;
+
+          /** \brief Set the size of the viewport in pixels which is used by the small feature culling **/
+          DP_SG_XBAR_CULLING_API virtual void setViewportSize( dp::math::Vec2ui const & viewportSize ) = 0;
+
+          /** \brief Cull objects whose projected bounding box is smaller than the given number of pixels in x and in y.
+                     The threshold has a hysteresis to avoid flickering of objects close to it. Small feature culling is supported
+                     by the CPU culling modes only.
+              \param minimumPixelSize Minimum size in pixels. 0 disables the small feature culling, which is the default.
+          **/
+          DP_SG_XBAR_CULLING_API virtual void setMinimumPixelSize( float minimumPixelSize ) = 0;
+          DP_SG_XBAR_CULLING_API virtual float getMinimumPixelSize() const = 0;
         };
 
       } // namespace culling
@@ -28,6 +28,7 @@
 
 #include <dp/sg/xbar/culling/Culling.h>
 #include <dp/culling/Manager.h>
+#include <dp/culling/cpu/Manager.h>
 
 namespace dp
 {
@@ -38,6 +39,7 @@ namespace dp
       namespace culling
       {
         DEFINE_PTR_TYPES( CullingImpl );
+        class ResultImpl;
 
         class CullingImpl : public Culling, dp::util::Observer
         {
@@ -49,8 +51,17 @@ namespace dp
           virtual bool resultIsVisible( ResultSharedPtr const & result, ObjectTreeIndex objectTreeIndex ) const;
           virtual std::vector<dp::sg::xbar::ObjectTreeIndex> const & resultGetChangedIndices( ResultSharedPtr const & result ) const;
           virtual void cull( ResultSharedPtr const & result, dp::math::Mat44f const & world2ViewProjection );
+          virtual void cull( std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & world2ViewProjections );
+          virtual void cullUnion( ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & world2ViewProjections );
           virtual dp::math::Box3f getBoundingBox();
 
+          virtual bool setOcclusionCulling( bool enabled );
+          virtual bool isOcclusionCulling() const;
+          virtual void setOccluder( ObjectTreeIndex objectTreeIndex, dp::math::Box3f const & occluderBox );
+          virtual void setViewportSize( dp::math::Vec2ui const & viewportSize );
+          virtual void setMinimumPixelSize( float minimumPixelSize );
+          virtual float getMinimumPixelSize() const;
+
         protected:
           CullingImpl( SceneTreeSharedPtr const & sceneTree, dp::culling::Mode cullingMode );
 
@@ -65,37 +76,19 @@ namespace dp
           //! \brief Update bounding box for the given ObjectTreeIndex
           void updateBoundingBox( ObjectTreeIndex objectTreeIndex );
 
-        private:
-          SceneTreeSharedPtr const m_sceneTree;
-
-          // culling data
-
-          //! \brief Payload class which assigns an ObjectTreeIndex to each culling object.
-          DEFINE_PTR_TYPES( Payload );
-          class Payload : public dp::culling::Payload
-          {
-          public:
-            static PayloadSharedPtr create( ObjectTreeIndex objectTreeIndex )
-            {
-              return( std::shared_ptr<Payload>( new Payload( objectTreeIndex ) ) );
-            }
-
-            virtual ~Payload()
-            {
-            }
+          // move the culling objects to the new ObjectTree indices after the SceneTree has been compacted
+          void remapIndices( std::vector<ObjectTreeIndex> const & newIndices );
 
-            ObjectTreeIndex getObjectTreeIndex() const { return m_objectTreeIndex; }
+          //! \brief Pass the current world matrices of the TransformTree to the culling group
+          void updateMatrices();
 
-          protected:
-            Payload( ObjectTreeIndex objectTreeIndex )
-              : m_objectTreeIndex( objectTreeIndex )
-            {
-            }
+          //! \brief Get the ObjectTree indices of the changed objects of the culling result without allocations or reference counting
+          void updateChangedIndices( ResultImpl & result );
 
-          private:
-            ObjectTreeIndex m_objectTreeIndex;
-          };
+        private:
+          SceneTreeSharedPtr const m_sceneTree;
 
+          // culling data, the user id of each culling object is its ObjectTreeIndex
           class TransformObserver : public dp::util::Observer
           {
           public:
@@ -111,8 +104,11 @@ namespace dp
           };
 
           std::unique_ptr<dp::culling::Manager>  m_culling;
+          dp::culling::cpu::Manager *            m_cpuCulling; // m_culling if the CPU culling is being used, nullptr otherwise
+          std::unique_ptr<TransformObserver>     m_transformObserver;
           dp::culling::GroupSharedPtr               m_cullingGroup;
           std::vector<dp::culling::ObjectSharedPtr> m_objects;
+          std::vector<dp::culling::ResultSharedPtr> m_cullingResults; // reused by cull for multiple views to avoid an allocation per frame
         };
 
       } // namespace culling
@@ -47,7 +47,7 @@ namespace dp
           static ResultImplSharedPtr create( dp::culling::ResultSharedPtr const & result );
 
         public:
-          dp::culling::ResultSharedPtr getResult() const { return m_result; }
+          dp::culling::ResultSharedPtr const & getResult() const { return m_result; }
           std::vector<ObjectTreeIndex> & getChanged() { return m_changed; }
 
         protected:
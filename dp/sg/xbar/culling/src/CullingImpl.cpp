@@ -48,18 +48,25 @@ namespace dp
 
         CullingImpl::CullingImpl( SceneTreeSharedPtr const & sceneTree, dp::culling::Mode cullingMode )
           : m_sceneTree( sceneTree )
+          , m_cpuCulling( nullptr )
         {
           switch ( cullingMode )
           {
           case dp::culling::Mode::CPU:
-            m_culling.reset(dp::culling::cpu::Manager::create());
+            m_cpuCulling = dp::culling::cpu::Manager::create();
+            m_culling.reset(m_cpuCulling);
+            break;
+          case dp::culling::Mode::CPU_BVH:
+            m_cpuCulling = dp::culling::cpu::Manager::createBVH();
+            m_culling.reset(m_cpuCulling);
             break;
           case dp::culling::Mode::OPENGL_COMPUTE:
             m_culling.reset(dp::culling::opengl::Manager::create());
             break;
           default:
             std::cerr << "unknown culling mode, falling back to CPU version" << std::endl;
-            m_culling.reset(dp::culling::cpu::Manager::create());
+            m_cpuCulling = dp::culling::cpu::Manager::create();
+            m_culling.reset(m_cpuCulling);
           }
           m_cullingGroup = m_culling->groupCreate();
 
@@ -100,10 +107,15 @@ namespace dp
 
           // and attach to SceneTree get update events
           m_sceneTree->attach( this );
+
+          // report changed world matrices to the culling manager so that it can update its caches incrementally
+          m_transformObserver.reset( new TransformObserver( *this ) );
+          m_sceneTree->getTransformTree().attach( m_transformObserver.get() );
         }
 
         CullingImpl::~CullingImpl()
         {
+          m_sceneTree->getTransformTree().detach( m_transformObserver.get() );
           m_cullingGroup.reset();
           m_sceneTree->detach( this );
         }
@@ -125,40 +137,102 @@ namespace dp
 
         void CullingImpl::cull( ResultSharedPtr const & result, dp::math::Mat44f const & world2ViewProjection )
         {
-          ResultImplSharedPtr const & resultImpl = std::static_pointer_cast<ResultImpl>(result);
-          dp::sg::xbar::TransformTree::Transforms const & transforms = m_sceneTree->getTransformTree().getTransforms();
-          if (!transforms.empty())
-          {
-            m_culling->groupSetMatrices(m_cullingGroup, &transforms[0].world, transforms.size(), sizeof(transforms[0]));
-          }
-          m_culling->cull( m_cullingGroup, resultImpl->getResult(), world2ViewProjection );
+          ResultImpl & resultImpl = static_cast<ResultImpl &>(*result);
+          updateMatrices();
+          m_culling->cull( m_cullingGroup, resultImpl.getResult(), world2ViewProjection );
+          updateChangedIndices( resultImpl );
+        }
 
-          std::vector<dp::culling::ObjectSharedPtr> const & changedObjects = m_culling->resultGetChanged( resultImpl->getResult() );
-          std::vector<ObjectTreeIndex> & changedIndices = resultImpl->getChanged();
+        void CullingImpl::cull( std::vector<ResultSharedPtr> const & results, std::vector<dp::math::Mat44f> const & world2ViewProjections )
+        {
+          DP_ASSERT( results.size() == world2ViewProjections.size() );
 
-          // clear the previous list of indices and get new the indices from the culling result
-          changedIndices.clear();
-          for ( size_t index = 0;index < changedObjects.size(); ++index )
+          m_cullingResults.clear();
+          for ( size_t index = 0; index < results.size(); ++index )
           {
-            PayloadSharedPtr const & p = std::static_pointer_cast<Payload>(m_culling->objectGetUserData(changedObjects[index]));
+            m_cullingResults.push_back( static_cast<ResultImpl const &>(*results[index]).getResult() );
+          }
 
-            changedIndices.push_back( p->getObjectTreeIndex() );
+          updateMatrices();
+          m_culling->cullViews( m_cullingGroup, m_cullingResults, world2ViewProjections );
+          m_cullingResults.clear();
+          for ( size_t index = 0; index < results.size(); ++index )
+          {
+            updateChangedIndices( static_cast<ResultImpl &>(*results[index]) );
           }
         }
 
-        dp::math::Box3f CullingImpl::getBoundingBox()
+        void CullingImpl::cullUnion( ResultSharedPtr const & result, std::vector<dp::math::Mat44f> const & world2ViewProjections )
+        {
+          ResultImpl & resultImpl = static_cast<ResultImpl &>(*result);
+          updateMatrices();
+          m_culling->cullUnion( m_cullingGroup, resultImpl.getResult(), world2ViewProjections );
+          updateChangedIndices( resultImpl );
+        }
+
+        void CullingImpl::updateMatrices()
         {
           dp::sg::xbar::TransformTree::Transforms const & transforms = m_sceneTree->getTransformTree().getTransforms();
           if (!transforms.empty())
           {
             m_culling->groupSetMatrices(m_cullingGroup, &transforms[0].world, transforms.size(), sizeof(transforms[0]));
           }
+        }
+
+        void CullingImpl::updateChangedIndices( ResultImpl & result )
+        {
+          // the user id of each culling object is its ObjectTreeIndex. The list of changed indices keeps its capacity between the frames.
+          m_culling->resultGetChangedIds( result.getResult(), result.getChanged() );
+        }
+
+        dp::math::Box3f CullingImpl::getBoundingBox()
+        {
+          updateMatrices();
           return m_culling->getBoundingBox(m_cullingGroup);
         }
 
+        bool CullingImpl::setOcclusionCulling( bool enabled )
+        {
+          if ( m_cpuCulling )
+          {
+            m_cpuCulling->setOcclusionCulling( enabled );
+            return true;
+          }
+          return !enabled;
+        }
+
+        bool CullingImpl::isOcclusionCulling() const
+        {
+          return m_cpuCulling && m_cpuCulling->isOcclusionCulling();
+        }
+
+        void CullingImpl::setOccluder( ObjectTreeIndex objectTreeIndex, dp::math::Box3f const & occluderBox )
+        {
+          DP_ASSERT( objectTreeIndex < m_objects.size() && m_objects[objectTreeIndex] && "no culling object available for the given index" );
+          if ( m_cpuCulling )
+          {
+            m_cpuCulling->objectSetOccluder( m_objects[objectTreeIndex], occluderBox );
+          }
+        }
+
+        void CullingImpl::setViewportSize( dp::math::Vec2ui const & viewportSize )
+        {
+          m_culling->setViewportSize( viewportSize );
+        }
+
+        void CullingImpl::setMinimumPixelSize( float minimumPixelSize )
+        {
+          m_culling->setMinimumPixelSize( minimumPixelSize );
+        }
+
+        float CullingImpl::getMinimumPixelSize() const
+        {
+          return m_culling->getMinimumPixelSize();
+        }
+
         void CullingImpl::updateBoundingBox( ObjectTreeIndex objectTreeIndex )
         {
-          dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(m_sceneTree->getObjectTreeNode( objectTreeIndex ).m_object);
+          dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(m_sceneTree->getObjectTree().getData( objectTreeIndex ).m_object);
           m_culling->objectSetBoundingBox( m_objects[objectTreeIndex], geoNode->getBoundingBox() );
         }
 
@@ -176,12 +250,29 @@ namespace dp
 
           // create a new culling object and add it to the culling group
           ObjectTreeNode const &node = m_sceneTree->getObjectTreeNode( index );
-          m_objects[index] = m_culling->objectCreate( Payload::create( index ) );
+          m_objects[index] = m_culling->objectCreate( dp::culling::PayloadSharedPtr() );
+          m_culling->objectSetUserId( m_objects[index], index );
           m_culling->groupAddObject( m_cullingGroup, m_objects[index] );
           m_culling->objectSetTransformIndex(m_objects[index], node.m_transform);
           updateBoundingBox( index );
         }
 
+        void CullingImpl::remapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+        {
+          std::vector<dp::culling::ObjectSharedPtr> objects( m_sceneTree->getObjectTree().size() );
+          for ( size_t index = 0; index < m_objects.size(); ++index )
+          {
+            if ( m_objects[index] )
+            {
+              ObjectTreeIndex newIndex = newIndices[index];
+              DP_ASSERT( newIndex != ~0 );
+              m_culling->objectSetUserId( m_objects[index], newIndex );
+              objects[newIndex].swap( m_objects[index] );
+            }
+          }
+          m_objects.swap( objects );
+        }
+
         void CullingImpl::onNotify( dp::util::Event const & event, dp::util::Payload * payload )
         {
           SceneTree::Event const & eventObject = static_cast<SceneTree::Event const&>(event);
@@ -206,6 +297,10 @@ namespace dp
             // TODO update bounding box!
             break;
 
+          case SceneTree::Event::Type::INDICES_REMAPPED:
+            remapIndices( static_cast<SceneTree::RemapEvent const&>(event).getNewIndices() );
+            break;
+
           default:
             break;
           }
@@ -58,6 +58,19 @@ namespace dp
           m_dirtyGeoNodes.erase( index );
         }
 
+        virtual void onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+        {
+          ObjectTreeIndexSet dirtyGeoNodes;
+          for ( ObjectTreeIndexSet::const_iterator it = m_dirtyGeoNodes.begin(); it != m_dirtyGeoNodes.end(); ++it )
+          {
+            if ( newIndices[*it] != ~0 )
+            {
+              dirtyGeoNodes.insert( newIndices[*it] );
+            }
+          }
+          m_dirtyGeoNodes.swap( dirtyGeoNodes );
+        }
+
         void popDirtyGeoNodes( ObjectTreeIndexSet & currentSet ) const
         {
           currentSet = m_dirtyGeoNodes;
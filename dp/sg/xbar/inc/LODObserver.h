@@ -0,0 +1,77 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/sg/xbar/inc/Observer.h>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+      DEFINE_PTR_TYPES( LODObserver );
+
+      /** \brief Collects the indices of the LODs whose ranges, center, range lock or children have changed. **/
+      class LODObserver : public Observer<ObjectTreeIndex>
+      {
+      public:
+        static LODObserverSharedPtr create()
+        {
+          return( std::shared_ptr<LODObserver>( new LODObserver() ) );
+        }
+
+      public:
+        ~LODObserver()
+        {
+        }
+
+        void attach( dp::sg::core::LODSharedPtr const & lod, ObjectTreeIndex index );
+
+        /** \brief Get the indices of the changed LODs since the last call. An index might be reported multiple times. **/
+        void popDirtyLODs( std::vector<ObjectTreeIndex> & dirtyLODs )
+        {
+          dirtyLODs.swap( m_dirtyLODs );
+          m_dirtyLODs.clear();
+        }
+
+      protected:
+        LODObserver()
+          : Observer<ObjectTreeIndex>()
+        {
+        }
+
+        void onNotify( dp::util::Event const & event, dp::util::Payload * payload );
+        virtual void onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices );
+
+      private:
+        std::vector<ObjectTreeIndex> m_dirtyLODs;
+      };
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -30,6 +30,7 @@
 #include <dp/util/Reflection.h>
 #include <dp/sg/core/Group.h>
 #include <dp/sg/core/Switch.h>
+#include <dp/util/BitArray.h>
 
 namespace dp
 {
@@ -47,7 +48,6 @@ namespace dp
           unsigned int m_hints;
           unsigned int m_mask;
         };
-        typedef std::map< ObjectTreeIndex, CacheData >  NewCacheData;
 
       public:
         virtual ~ObjectObserver();
@@ -58,27 +58,46 @@ namespace dp
         }
 
         void attach( dp::sg::core::ObjectSharedPtr const& obj, ObjectTreeIndex index );
+
+        // attach to an object whose node already contains the current hints and traversal mask
+        void attachInitialized( dp::sg::core::ObjectSharedPtr const& obj, ObjectTreeIndex index );
         virtual void onDetach( ObjectTreeIndex index );
 
-        void popNewCacheData( NewCacheData & currentData ) const
+        /** \brief Call visitor( ObjectTreeIndex index, CacheData const & data ) in ascending order of the indices whose
+                   hints or traversal mask have changed since the last call and forget the changes.
+        **/
+        template <typename Visitor>
+        void popNewCacheData( Visitor visitor ) const
         {
-          currentData = m_newCacheData;
-          m_newCacheData.clear();
+          if ( m_hasNewCacheData )
+          {
+            std::vector<CacheData> const & cacheData = m_cacheData;
+            m_newCacheData.traverseBits( [&]( size_t index ) { visitor( ObjectTreeIndex( index ), cacheData[index] ); } );
+            m_newCacheData.clear();
+            m_hasNewCacheData = false;
+          }
         }
 
       protected:
         ObjectObserver(SceneTreeSharedPtr const & sceneTree)
           : Observer<ObjectTreeIndex>()
           , m_sceneTree(sceneTree)
+          , m_hasNewCacheData(false)
         {
         }
         void onNotify( const dp::util::Event &event, dp::util::Payload * payload );
+        virtual void onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices );
         virtual void onPreRemoveChild( dp::sg::core::GroupSharedPtr const& group, dp::sg::core::NodeSharedPtr const & child, unsigned int index, Payload * payload );
         virtual void onPostAddChild( dp::sg::core::GroupSharedPtr const& group, dp::sg::core::NodeSharedPtr const & child, unsigned int index, Payload * payload );
 
       private:
-        mutable NewCacheData m_newCacheData;
-        SceneTreeSharedPtr m_sceneTree;
+        void setNewCacheData( ObjectTreeIndex index, dp::sg::core::Object const * object );
+
+      private:
+        SceneTreeSharedPtr              m_sceneTree;
+        std::vector<CacheData>          m_cacheData;        // indexed by ObjectTreeIndex, valid where m_newCacheData is set
+        mutable dp::util::BitArray      m_newCacheData;
+        mutable bool                    m_hasNewCacheData;
       };
 
     } // namespace xbar
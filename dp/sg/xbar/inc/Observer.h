@@ -27,6 +27,7 @@
 #pragma once
 
 #include <dp/sg/xbar/SceneTree.h>
+#include <vector>
 
 namespace dp
 {
@@ -66,9 +67,13 @@ namespace dp
         void detach( IndexType index );
         void detachAll();
 
+        // replace each attached index by newIndices[index], e.g. after the ObjectTree has been compacted
+        void remapIndices( std::vector<IndexType> const & newIndices );
+
         virtual void onDestroyed( dp::util::Subject const& subject, dp::util::Payload * payload );
       protected:
         virtual void onDetach( IndexType index ) {};
+        virtual void onRemapIndices( std::vector<IndexType> const & newIndices ) {};
 
         typedef std::multimap<ObjectTreeIndex, std::pair<dp::util::SubjectWeakPtr, PayloadSharedPtr> > IndexMap;
         IndexMap m_indexMap;
@@ -88,7 +93,8 @@ namespace dp
       template <typename IndexType>
       void Observer<IndexType>::attach( dp::util::SubjectSharedPtr const& subject, PayloadSharedPtr const& payload )
       {
-        m_indexMap.insert( std::make_pair(payload->m_index, std::make_pair( dp::util::SubjectWeakPtr(subject), payload ) ) );
+        // indices are usually attached in ascending order, the hint makes the insertion constant time in this case
+        m_indexMap.insert( m_indexMap.end(), std::make_pair(payload->m_index, std::make_pair( dp::util::SubjectWeakPtr(subject), payload ) ) );
         subject->attach( this, payload.operator->() );    // BIG HACK!! we somehow need to align dp::util::Payload and dp::sg::xbar::Observer<IndexType::Payload
       }
 
@@ -116,6 +122,47 @@ namespace dp
         m_indexMap.clear();
       }
 
+      template <typename IndexType>
+      void Observer<IndexType>::remapIndices( std::vector<IndexType> const & newIndices )
+      {
+        typedef std::pair<ObjectTreeIndex, typename IndexMap::mapped_type> Entry;
+        std::vector<Entry> entries;
+        entries.reserve( m_indexMap.size() );
+
+        // count the entries per new index to sort them by new index in linear time
+        std::vector<size_t> offsets( newIndices.size() + 1, 0 );
+        typename IndexMap::iterator it, it_end = m_indexMap.end();
+        for( it = m_indexMap.begin(); it != it_end; ++it )
+        {
+          IndexType newIndex = newIndices[it->first];
+          DP_ASSERT( newIndex != ~0 );
+
+          // the subject passes the payload on each notification, update the index in place
+          it->second.second->m_index = newIndex;
+          entries.push_back( Entry( newIndex, std::move( it->second ) ) );
+          ++offsets[newIndex + 1];
+        }
+        m_indexMap.clear();
+
+        for ( size_t index = 1; index < offsets.size(); ++index )
+        {
+          offsets[index] += offsets[index - 1];
+        }
+        std::vector<size_t> order( entries.size() );
+        for ( size_t index = 0; index < entries.size(); ++index )
+        {
+          order[offsets[entries[index].first]++] = index;
+        }
+
+        // insert in ascending order, the hint makes each insertion constant time
+        for ( size_t index = 0; index < order.size(); ++index )
+        {
+          m_indexMap.insert( m_indexMap.end(), std::move( entries[order[index]] ) );
+        }
+
+        onRemapIndices( newIndices );
+      }
+
 
       template <typename IndexType>
       void Observer<IndexType>::onDestroyed( dp::util::Subject const& subject, dp::util::Payload * payload )
@@ -0,0 +1,110 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/sg/xbar/SceneTree.h>
+#include <dp/util/ThreadPool.h>
+#include <memory>
+#include <vector>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      /** \brief SceneTreeBuilder builds the ObjectTree and TransformTree of a scene in bulk. It creates the same tree as the
+                 SceneTreeGenerator, which adds the nodes one by one. The number of nodes and transforms is counted first to size
+                 all trees once, then the nodes of disjoint subtrees are filled in parallel. Linking the transforms and registering the nodes at the
+                 observers and the TransformTree is done in a final serial pass in pre-order.
+      **/
+      class SceneTreeBuilder
+      {
+      public:
+        SceneTreeBuilder( SceneTree & sceneTree, unsigned int numberOfThreads );
+        ~SceneTreeBuilder();
+
+        /** \brief Build the tree for the given root node below parentIndex. The trees must not have had any nodes removed yet.
+            \return false if the subtree has to be built by the SceneTreeGenerator, which is the case for clip planes.
+        **/
+        bool build( dp::sg::core::NodeSharedPtr const & root, ObjectTreeIndex parentIndex );
+
+      private:
+        enum class NodeKind
+        {
+            GROUP
+          , LOD
+          , SWITCH
+          , TRANSFORM
+          , BILLBOARD
+          , GEO_NODE
+          , LIGHT_SOURCE
+          , NONE          // not part of the tree
+        };
+
+        // a subtree which is counted and filled by a single thread
+        struct Task
+        {
+          dp::sg::core::NodeSharedPtr const * node;
+          ObjectTreeIndex                     parentIndex;
+          ObjectTreeIndex                     index;
+          size_t                              numberOfNodes;
+          size_t                              numberOfTransforms;
+          bool                                hasClipPlanes;
+        };
+
+        static NodeKind getNodeKind( dp::sg::core::Object const * object );
+        static bool isGroup( NodeKind kind ) { return kind <= NodeKind::BILLBOARD; }
+
+        void collectTasks( dp::sg::core::NodeSharedPtr const & node, NodeKind kind, unsigned int depth );
+        void countSubtree( dp::sg::core::Node const * node, NodeKind kind, Task & task ) const;
+        ObjectTreeIndex buildTop( dp::sg::core::NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex, unsigned int depth );
+        ObjectTreeIndex fillSubtree( dp::sg::core::NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex, ObjectTreeIndex & nextIndex );
+        void fillNode( ObjectTreeIndex index, dp::sg::core::NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex );
+        void linkChild( ObjectTreeIndex parentIndex, ObjectTreeIndex previousIndex, ObjectTreeIndex childIndex );
+        void registerNodes( ObjectTreeIndex firstIndex, size_t numberOfNodes );
+        void execute( size_t numberOfTasks, std::function<void( size_t )> const & task );
+
+      private:
+        SceneTree &                            m_sceneTree;
+        ObjectTree &                           m_objectTree;
+        std::unique_ptr<dp::util::ThreadPool>  m_threadPool;
+
+        unsigned int                           m_splitDepth;      // nodes above this depth are filled serially
+        std::vector<Task>                      m_tasks;
+        size_t                                 m_currentTask;
+        size_t                                 m_numberOfNodes;      // number of nodes above the split depth
+        size_t                                 m_numberOfTransforms; // number of transforms above the split depth
+        bool                                   m_hasClipPlanes;
+        ObjectTreeIndex                        m_nextIndex;
+        SmartClipPlaneGroup                    m_clipPlaneGroup;
+      };
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <dp/sg/xbar/inc/Observer.h>
+#include <dp/util/BitArray.h>
 
 namespace dp
 {
@@ -75,10 +76,18 @@ namespace dp
 
         bool isChanged() const { return m_changed; }
 
-        void popDirtySwitches( ObjectTreeIndexSet currentSet )
+        /** \brief Call visitor( ObjectTreeIndex index ) in ascending order of the switches whose active children may have
+                   changed since the last call and forget the changes.
+        **/
+        template <typename Visitor>
+        void popDirtySwitches( Visitor visitor )
         {
-          currentSet = m_dirtySwitches;
-          m_dirtySwitches.clear();
+          if ( m_changed )
+          {
+            m_dirtySwitches.traverseBits( [&]( size_t index ) { visitor( ObjectTreeIndex( index ) ); } );
+            m_dirtySwitches.clear();
+            m_changed = false;
+          }
         }
 
       protected:
@@ -90,10 +99,14 @@ namespace dp
 
         void onNotify(dp::util::Event const & event, dp::util::Payload * payload);
         virtual void onDetach(ObjectTreeIndex index);
+        virtual void onRemapIndices(std::vector<ObjectTreeIndex> const & newIndices);
+
+      private:
+        void markDirty( ObjectTreeIndex index );
 
       private:
-        mutable bool               m_changed;
-        mutable ObjectTreeIndexSet m_dirtySwitches;
+        bool               m_changed;         // true if any bit in m_dirtySwitches is set
+        dp::util::BitArray m_dirtySwitches;   // indexed by ObjectTreeIndex
       };
 
     } // namespace xbar
@@ -79,6 +79,7 @@ namespace dp
         }
 
         void onNotify(dp::util::Event const & event, dp::util::Payload * payload);
+        void onNotifyBatch(dp::util::Notification const * notifications, size_t numberOfNotifications);
 
       private:
         dp::util::BitArray & m_dirtyTransforms;
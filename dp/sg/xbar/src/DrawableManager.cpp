@@ -66,8 +66,14 @@ namespace dp
       void SceneTreeObserver::onNotify( dp::util::Event const & event, dp::util::Payload * payload )
       {
         SceneTree::Event const& eventObject = static_cast<SceneTree::Event const&>(event);
+        if ( eventObject.getType() == SceneTree::Event::Type::INDICES_REMAPPED )
+        {
+          m_drawableManager->remapIndices( static_cast<SceneTree::RemapEvent const&>(event).getNewIndices() );
+          return;
+        }
+
         ObjectTreeNode const &node = eventObject.getNode();
-        dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(node.m_object);
+        dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(eventObject.getData().m_object);
 
         if ( m_drawableManager->m_dis.size() != m_drawableManager->m_sceneTree->getObjectTree().size() )
         {
@@ -100,6 +106,8 @@ namespace dp
           DP_ASSERT( m_drawableManager->m_dis[eventObject.getIndex()] );
           m_drawableManager->setDrawableInstanceTraversalMask( m_drawableManager->m_dis[eventObject.getIndex()], node.m_worldMask );
           break;
+        case SceneTree::Event::Type::INDICES_REMAPPED:
+          break;
         }
       }
 
@@ -164,7 +172,7 @@ namespace dp
             if ( m_objectTree[index].m_isDrawable )
             {
               ObjectTreeNode const &node = m_objectTree[index];
-              dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(node.m_object);
+              dp::sg::core::GeoNodeSharedPtr geoNode = std::static_pointer_cast<dp::sg::core::GeoNode>(m_objectTree.getData(index).m_object);
 
               m_drawableManager->m_dis[index] = m_drawableManager->addDrawableInstance( geoNode, index );
               m_drawableManager->setDrawableInstanceActive( m_drawableManager->m_dis[index], node.m_worldActive );
@@ -244,6 +252,27 @@ namespace dp
         m_geoNodeObserver.reset();
       }
 
+      void DrawableManager::remapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        std::vector<Handle> dis( m_sceneTree->getObjectTree().size() );
+        for ( size_t index = 0; index < m_dis.size(); ++index )
+        {
+          if ( m_dis[index] )
+          {
+            ObjectTreeIndex newIndex = newIndices[index];
+            DP_ASSERT( newIndex != ~0 );
+            if ( newIndex != index )
+            {
+              remapDrawableInstance( m_dis[index], newIndex );
+            }
+            dis[newIndex].swap( m_dis[index] );
+          }
+        }
+        m_dis.swap( dis );
+
+        m_geoNodeObserver->remapIndices( newIndices );
+      }
+
       void DrawableManager::update()
       {
         ObjectTreeIndexSet dirtyGeoNodes;
@@ -256,7 +285,7 @@ namespace dp
           DP_ASSERT( m_dis[index] );
           // Remove/Add to change GeometryInstance
           removeDrawableInstance( m_dis[index] );
-          m_dis[index] = addDrawableInstance( std::static_pointer_cast<dp::sg::core::GeoNode>(node.m_object), index );    // TODO, don't pass geonode?
+          m_dis[index] = addDrawableInstance( std::static_pointer_cast<dp::sg::core::GeoNode>(m_sceneTree->getObjectTree().getData(index).m_object), index );    // TODO, don't pass geonode?
           setDrawableInstanceActive( m_dis[index], node.m_worldActive );
           break;
         }
@@ -65,10 +65,10 @@ namespace dp
       {
         m_objectParentSiblingStack.push( make_pair( parentIndex, siblingIndex ) );
 
-        ObjectTreeNode &node = m_sceneTree->getObjectTree()[parentIndex];
+        ObjectTreeNodeData &data = m_sceneTree->getObjectTree().getData( parentIndex );
 
         // push ClipPlaneGroup state of parent as starting state
-        m_clipPlaneGroups.push_back( node.m_clipPlaneGroup );
+        m_clipPlaneGroups.push_back( data.m_clipPlaneGroup );
       }
 
       ObjectTreeIndex GeneratorState::insertNode( ObjectSharedPtr const& o )
@@ -78,11 +78,12 @@ namespace dp
 
         // Create node and fill with information
         ObjectTreeNode node;
-        node.m_object         = o;
-        node.m_clipPlaneGroup = m_clipPlaneGroups.back();
+        ObjectTreeNodeData data;
+        data.m_object         = o;
+        data.m_clipPlaneGroup = m_clipPlaneGroups.back();
 
         // add node to tree
-        ObjectTreeIndex index = m_sceneTree->addObject( node, parentIndex, siblingIndex );
+        ObjectTreeIndex index = m_sceneTree->addObject( node, data, parentIndex, siblingIndex );
 
         // update info for next node insertion
         if( !m_objectParentSiblingStack.empty() )
@@ -176,8 +177,8 @@ namespace dp
         m_clipPlaneGroups.push_back( ClipPlaneGroup::create( m_clipPlaneGroups.back()));
 
         // store LightGroup in current node
-        ObjectTreeNode &node = m_sceneTree->getObjectTree()[getParentObjectIndex()];
-        node.m_clipPlaneGroup = m_clipPlaneGroups.back();
+        ObjectTreeNodeData &data = m_sceneTree->getObjectTree().getData( getParentObjectIndex() );
+        data.m_clipPlaneGroup = m_clipPlaneGroups.back();
       }
 
       void GeneratorState::popClipPlaneSet()
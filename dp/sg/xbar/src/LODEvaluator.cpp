@@ -0,0 +1,345 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/xbar/LODEvaluator.h>
+#include <dp/sg/xbar/inc/LODObserver.h>
+#include <dp/sg/core/LOD.h>
+#include <algorithm>
+#include <thread>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      namespace
+      {
+        // Minimum number of LODs per thread. Smaller sets of LODs are evaluated on the calling thread.
+        const size_t minLODsPerTask = 4096;
+
+        inline float square( float value )
+        {
+          return value * value;
+        }
+      }
+
+      LODEvaluator::LODEvaluator()
+        : m_unusedRanges( 0 )
+        , m_lodObserver( LODObserver::create() )
+        , m_rangeScale( 1.0f )
+        , m_hysteresis( 0.0f )
+        , m_viewValid( false )
+        , m_entriesDirty( false )
+      {
+      }
+
+      LODEvaluator::~LODEvaluator()
+      {
+      }
+
+      void LODEvaluator::addLOD( dp::sg::core::LODSharedPtr const & lod, ObjectTreeIndex index, TransformIndex transform )
+      {
+        DP_ASSERT( !hasLOD( index ) );
+
+        if ( m_entryIndices.size() <= index )
+        {
+          m_entryIndices.resize( std::max( size_t(index) + 1, 2 * m_entryIndices.size() ), ~0 );
+        }
+        m_entryIndices[index] = dp::checked_cast<unsigned int>(m_entries.size());
+
+        Entry entry;
+        entry.transform = transform;
+        entry.firstRange = dp::checked_cast<unsigned int>(m_ranges.size());
+        entry.numberOfRanges = 0;
+        entry.fixedChild = ~0;
+        entry.activeChild = ~0;
+        entry.isFixed = true;
+        entry.isDirty = true;
+        m_entries.push_back( entry );
+
+        Info info;
+        info.lod = lod;
+        info.index = index;
+        info.rangeCapacity = 0;
+        m_infos.push_back( info );
+
+        m_lodObserver->attach( lod, index );
+        updateEntry( m_entries.size() - 1 );
+      }
+
+      void LODEvaluator::removeLOD( ObjectTreeIndex index )
+      {
+        DP_ASSERT( hasLOD( index ) );
+
+        m_lodObserver->detach( index );
+
+        // move the last entry into the gap to keep the arrays dense
+        unsigned int entryIndex = m_entryIndices[index];
+        m_unusedRanges += m_infos[entryIndex].rangeCapacity;
+        if ( entryIndex + 1 != m_entries.size() )
+        {
+          m_entries[entryIndex] = m_entries.back();
+          m_infos[entryIndex] = m_infos.back();
+          m_entryIndices[m_infos[entryIndex].index] = entryIndex;
+        }
+        m_entries.pop_back();
+        m_infos.pop_back();
+        m_entryIndices[index] = ~0;
+
+        if ( m_ranges.size() < 2 * m_unusedRanges )
+        {
+          compactRanges();
+        }
+      }
+
+      bool LODEvaluator::hasLOD( ObjectTreeIndex index ) const
+      {
+        return index < m_entryIndices.size() && m_entryIndices[index] != ~0;
+      }
+
+      void LODEvaluator::remapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        m_lodObserver->remapIndices( newIndices );
+
+        // removed LODs have already been removed from the evaluator, so each remaining LOD has a new index
+        size_t size = 0;
+        for ( size_t index = 0; index < m_infos.size(); ++index )
+        {
+          DP_ASSERT( newIndices[m_infos[index].index] != ~0 );
+          m_infos[index].index = newIndices[m_infos[index].index];
+          size = std::max( size, size_t(m_infos[index].index) + 1 );
+        }
+
+        m_entryIndices.assign( size, ~0 );
+        for ( size_t index = 0; index < m_infos.size(); ++index )
+        {
+          m_entryIndices[m_infos[index].index] = dp::checked_cast<unsigned int>(index);
+        }
+        m_changedLODs.clear();
+      }
+
+      void LODEvaluator::updateEntry( size_t entryIndex )
+      {
+        Entry & entry = m_entries[entryIndex];
+        Info & info = m_infos[entryIndex];
+
+        dp::sg::core::LODSharedPtr lod = info.lod.lock();
+        DP_ASSERT( lod );
+
+        unsigned int numberOfChildren = lod->getNumberOfChildren();
+        unsigned int numberOfRanges = numberOfChildren ? std::min( lod->getNumberOfRanges(), numberOfChildren - 1 ) : 0;
+        if ( info.rangeCapacity < numberOfRanges )
+        {
+          m_unusedRanges += info.rangeCapacity;
+          entry.firstRange = dp::checked_cast<unsigned int>(m_ranges.size());
+          info.rangeCapacity = numberOfRanges;
+          m_ranges.resize( m_ranges.size() + numberOfRanges );
+        }
+        std::copy( lod->getRanges(), lod->getRanges() + numberOfRanges, m_ranges.begin() + entry.firstRange );
+        entry.numberOfRanges = numberOfRanges;
+
+        entry.isFixed = !numberOfChildren || lod->isRangeLockEnabled();
+        entry.fixedChild = numberOfChildren ? std::min( lod->getRangeLock(), numberOfChildren - 1 ) : ~0;
+        entry.isDirty = true;
+        m_entriesDirty = true;
+
+        info.center = lod->getCenter();
+      }
+
+      void LODEvaluator::compactRanges()
+      {
+        std::vector<float> ranges;
+        ranges.reserve( m_ranges.size() - m_unusedRanges );
+        for ( size_t index = 0; index < m_entries.size(); ++index )
+        {
+          Entry & entry = m_entries[index];
+          Info & info = m_infos[index];
+
+          unsigned int firstRange = dp::checked_cast<unsigned int>(ranges.size());
+          ranges.insert( ranges.end(), m_ranges.begin() + entry.firstRange, m_ranges.begin() + entry.firstRange + info.rangeCapacity );
+          entry.firstRange = firstRange;
+        }
+        m_ranges.swap( ranges );
+        m_unusedRanges = 0;
+      }
+
+      unsigned int LODEvaluator::selectChild( Entry const & entry, float distanceSquared ) const
+      {
+        if ( entry.isFixed )
+        {
+          return entry.fixedChild;
+        }
+
+        // same selection as LOD::getLODToUse
+        float const * ranges = &m_ranges[entry.firstRange];
+        unsigned int child = 0;
+        while ( child < entry.numberOfRanges && !( distanceSquared < square( ranges[child] * m_rangeScale ) ) )
+        {
+          ++child;
+        }
+
+        // starting at the current child, only cross a range if the distance is outside of the band around it
+        unsigned int level = entry.activeChild;
+        if ( 0.0f < m_hysteresis && level <= entry.numberOfRanges && level != child )
+        {
+          if ( level < child )
+          {
+            float scale = m_rangeScale * ( 1.0f + m_hysteresis );
+            while ( level < child && !( distanceSquared < square( ranges[level] * scale ) ) )
+            {
+              ++level;
+            }
+          }
+          else
+          {
+            float scale = m_rangeScale * ( 1.0f - m_hysteresis );
+            while ( child < level && distanceSquared < square( ranges[level - 1] * scale ) )
+            {
+              --level;
+            }
+          }
+          child = level;
+        }
+        return child;
+      }
+
+      void LODEvaluator::evaluateEntries( size_t begin, size_t end, TransformTree const & transformTree, bool evaluateAll, ChangedLODs & changedLODs )
+      {
+        dp::util::BitArray const & changedWorldMatrices = transformTree.getChangedWorldMatrices();
+
+        for ( size_t index = begin; index < end; ++index )
+        {
+          Entry & entry = m_entries[index];
+
+          bool worldChanged = entry.isDirty || changedWorldMatrices.getBit( entry.transform );
+          if ( worldChanged )
+          {
+            entry.worldCenter = dp::math::Vec4f( m_infos[index].center, 1.0f ) * transformTree.getWorldMatrix( entry.transform );
+          }
+
+          if ( entry.isDirty || ( !entry.isFixed && ( evaluateAll || worldChanged ) ) )
+          {
+            // the camera is located at the origin in view space
+            float distanceSquared = lengthSquared( dp::math::Vec3f( entry.worldCenter * m_worldToView ) );
+            unsigned int activeChild = selectChild( entry, distanceSquared );
+            if ( entry.isDirty || activeChild != entry.activeChild )
+            {
+              ChangedLOD changedLOD;
+              changedLOD.index = m_infos[index].index;
+              changedLOD.activeChild = activeChild;
+              changedLODs.push_back( changedLOD );
+
+              entry.activeChild = activeChild;
+              entry.isDirty = false;
+            }
+          }
+        }
+      }
+
+      LODEvaluator::ChangedLODs const & LODEvaluator::evaluate( TransformTree const & transformTree, dp::math::Mat44f const & worldToView, float rangeScale )
+      {
+        m_changedLODs.clear();
+
+        m_lodObserver->popDirtyLODs( m_dirtyLODs );
+        for ( ObjectTreeIndex index : m_dirtyLODs )
+        {
+          // LODs might have been removed after the notification
+          if ( hasLOD( index ) )
+          {
+            updateEntry( m_entryIndices[index] );
+          }
+        }
+        m_dirtyLODs.clear();
+
+        bool evaluateAll = !m_viewValid || rangeScale != m_rangeScale || worldToView != m_worldToView;
+        m_worldToView = worldToView;
+        m_rangeScale = rangeScale;
+        m_viewValid = true;
+
+        // nothing to do if neither the view, any LOD nor any world matrix has changed
+        dp::util::BitArray const & changedWorldMatrices = transformTree.getChangedWorldMatrices();
+        if ( !evaluateAll && !m_entriesDirty && changedWorldMatrices.countLeadingZeroes() == changedWorldMatrices.getSize() )
+        {
+          return m_changedLODs;
+        }
+        m_entriesDirty = false;
+
+        size_t const count = m_entries.size();
+        if ( !m_threadPool || count < 2 * minLODsPerTask )
+        {
+          evaluateEntries( 0, count, transformTree, evaluateAll, m_changedLODs );
+        }
+        else
+        {
+          size_t numberOfTasks = std::min( size_t(m_threadPool->getNumberOfThreads()), count / minLODsPerTask );
+          m_taskChangedLODs.resize( numberOfTasks );
+          m_threadPool->execute( numberOfTasks, [&]( size_t task )
+          {
+            m_taskChangedLODs[task].clear();
+            evaluateEntries( task * count / numberOfTasks, ( task + 1 ) * count / numberOfTasks, transformTree, evaluateAll, m_taskChangedLODs[task] );
+          } );
+          for ( size_t task = 0; task < numberOfTasks; ++task )
+          {
+            m_changedLODs.insert( m_changedLODs.end(), m_taskChangedLODs[task].begin(), m_taskChangedLODs[task].end() );
+          }
+        }
+
+        return m_changedLODs;
+      }
+
+      void LODEvaluator::setHysteresis( float hysteresis )
+      {
+        DP_ASSERT( 0.0f <= hysteresis && hysteresis < 1.0f );
+        if ( hysteresis != m_hysteresis )
+        {
+          m_hysteresis = hysteresis;
+          m_viewValid = false;
+        }
+      }
+
+      void LODEvaluator::setNumberOfThreads( unsigned int numberOfThreads )
+      {
+        if ( numberOfThreads == 0 )
+        {
+          numberOfThreads = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+
+        if ( numberOfThreads != getNumberOfThreads() )
+        {
+          m_threadPool.reset( numberOfThreads > 1 ? new dp::util::ThreadPool( numberOfThreads ) : nullptr );
+        }
+      }
+
+      unsigned int LODEvaluator::getNumberOfThreads() const
+      {
+        return m_threadPool ? m_threadPool->getNumberOfThreads() : 1;
+      }
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -0,0 +1,66 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/xbar/inc/LODObserver.h>
+#include <dp/sg/core/LOD.h>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      void LODObserver::attach( dp::sg::core::LODSharedPtr const & lod, ObjectTreeIndex index )
+      {
+        DP_ASSERT( m_indexMap.find( index ) == m_indexMap.end() );
+
+        Observer<ObjectTreeIndex>::attach( lod, Payload::create( index ) );
+      }
+
+      void LODObserver::onNotify( const dp::util::Event &event, dp::util::Payload *payload )
+      {
+        // every event of a LOD (ranges, center, range lock or children) might change the selected child
+        m_dirtyLODs.push_back( static_cast<Payload*>(payload)->m_index );
+      }
+
+      void LODObserver::onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        // LODs which have been removed after they have changed are not in the tree anymore
+        size_t numberOfDirtyLODs = 0;
+        for ( size_t index = 0; index < m_dirtyLODs.size(); ++index )
+        {
+          if ( newIndices[m_dirtyLODs[index]] != ~0 )
+          {
+            m_dirtyLODs[numberOfDirtyLODs++] = newIndices[m_dirtyLODs[index]];
+          }
+        }
+        m_dirtyLODs.resize( numberOfDirtyLODs );
+      }
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -0,0 +1,354 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/xbar/MutationQueue.h>
+#include <dp/sg/core/Group.h>
+#include <dp/sg/core/Switch.h>
+#include <dp/sg/core/Transform.h>
+#include <atomic>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      namespace
+      {
+        // Number of commands per chunk of a MutationBuffer
+        const size_t commandsPerChunk = 256;
+      }
+
+      struct MutationBuffer::Command
+      {
+        enum class Type
+        {
+            NONE
+          , ADD_CHILD
+          , REMOVE_CHILD
+          , SET_MATRIX
+          , SET_ACTIVE
+          , SET_INACTIVE
+          , SET_ACTIVE_MASK_KEY
+          , FUNCTION
+        };
+
+        Command()
+          : type( Type::NONE )
+          , value( 0 )
+        {
+        }
+
+        Type                          type;
+        dp::sg::core::ObjectSharedPtr object;   // group, transform or switch to edit
+        dp::sg::core::NodeSharedPtr   child;
+        dp::math::Mat44f              matrix;
+        unsigned int                  value;    // child index or mask key
+        std::function<void()>         function;
+      };
+
+      /** \brief The commands of a buffer are stored in a list of chunks. The recording thread publishes each command by
+                 incrementing count and each new chunk by setting next. The applying thread only reads commands below count
+                 and deletes a chunk once it has applied all of its commands and the recording thread has moved on.
+      **/
+      struct MutationBuffer::Chunk
+      {
+        Chunk()
+          : count( 0 )
+          , next( nullptr )
+        {
+        }
+
+        Command               commands[commandsPerChunk];
+        std::atomic<size_t>   count;
+        std::atomic<Chunk *>  next;
+      };
+
+      MutationBuffer::MutationBuffer()
+        : m_head( new Chunk )
+        , m_applied( 0 )
+      {
+        m_tail = m_head;
+      }
+
+      MutationBuffer::~MutationBuffer()
+      {
+        while ( m_head )
+        {
+          Chunk * next = m_head->next.load( std::memory_order_relaxed );
+          delete m_head;
+          m_head = next;
+        }
+      }
+
+      MutationBuffer::Command & MutationBuffer::push()
+      {
+        if ( m_tail->count.load( std::memory_order_relaxed ) == commandsPerChunk )
+        {
+          Chunk * chunk = new Chunk;
+          m_tail->next.store( chunk, std::memory_order_release );
+          m_tail = chunk;
+        }
+        return m_tail->commands[m_tail->count.load( std::memory_order_relaxed )];
+      }
+
+      void MutationBuffer::publish()
+      {
+        // the release store makes the command visible to the applying thread
+        m_tail->count.store( m_tail->count.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+      }
+
+      void MutationBuffer::addChild( dp::sg::core::GroupSharedPtr const & group, dp::sg::core::NodeSharedPtr const & child )
+      {
+        Command & command = push();
+        command.type = Command::Type::ADD_CHILD;
+        command.object = group;
+        command.child = child;
+        publish();
+      }
+
+      void MutationBuffer::removeChild( dp::sg::core::GroupSharedPtr const & group, dp::sg::core::NodeSharedPtr const & child )
+      {
+        Command & command = push();
+        command.type = Command::Type::REMOVE_CHILD;
+        command.object = group;
+        command.child = child;
+        publish();
+      }
+
+      void MutationBuffer::setMatrix( dp::sg::core::TransformSharedPtr const & transform, dp::math::Mat44f const & matrix )
+      {
+        Command & command = push();
+        command.type = Command::Type::SET_MATRIX;
+        command.object = transform;
+        command.matrix = matrix;
+        publish();
+      }
+
+      void MutationBuffer::setActive( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int index )
+      {
+        Command & command = push();
+        command.type = Command::Type::SET_ACTIVE;
+        command.object = switchNode;
+        command.value = index;
+        publish();
+      }
+
+      void MutationBuffer::setInactive( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int index )
+      {
+        Command & command = push();
+        command.type = Command::Type::SET_INACTIVE;
+        command.object = switchNode;
+        command.value = index;
+        publish();
+      }
+
+      void MutationBuffer::setActiveMaskKey( dp::sg::core::SwitchSharedPtr const & switchNode, unsigned int maskKey )
+      {
+        Command & command = push();
+        command.type = Command::Type::SET_ACTIVE_MASK_KEY;
+        command.object = switchNode;
+        command.value = maskKey;
+        publish();
+      }
+
+      void MutationBuffer::execute( std::function<void()> const & function )
+      {
+        Command & command = push();
+        command.type = Command::Type::FUNCTION;
+        command.function = function;
+        publish();
+      }
+
+      MutationQueueSharedPtr MutationQueue::create()
+      {
+        return( std::shared_ptr<MutationQueue>( new MutationQueue() ) );
+      }
+
+      MutationQueue::MutationQueue()
+      {
+      }
+
+      MutationQueue::~MutationQueue()
+      {
+      }
+
+      MutationBufferSharedPtr MutationQueue::createBuffer()
+      {
+        MutationBufferSharedPtr buffer( new MutationBuffer() );
+
+        std::lock_guard<std::mutex> lock( m_buffersMutex );
+        m_buffers.push_back( buffer );
+        return buffer;
+      }
+
+      size_t MutationQueue::apply()
+      {
+        typedef MutationBuffer::Chunk Chunk;
+        typedef MutationBuffer::Command Command;
+
+        std::vector<MutationBufferSharedPtr> buffers;
+        {
+          std::lock_guard<std::mutex> lock( m_buffersMutex );
+          buffers = m_buffers;
+        }
+
+        // determine the commands to apply, later commands are applied by the next call
+        std::vector<std::pair<Chunk *, size_t> > ends( buffers.size() );
+        for ( size_t index = 0; index < buffers.size(); ++index )
+        {
+          Chunk * chunk = buffers[index]->m_head;
+          size_t count = chunk->count.load( std::memory_order_acquire );
+          Chunk * next;
+          while ( count == commandsPerChunk && ( next = chunk->next.load( std::memory_order_acquire ) ) )
+          {
+            chunk = next;
+            count = chunk->count.load( std::memory_order_acquire );
+          }
+          ends[index] = std::make_pair( chunk, count );
+        }
+
+        // call visitor( command, sequence ) for each command to apply, sequence numbers all commands of all buffers
+        auto traverse = [&]( std::function<void( Command &, size_t )> const & visitor, bool release )
+        {
+          size_t sequence = 0;
+          for ( size_t index = 0; index < buffers.size(); ++index )
+          {
+            MutationBuffer & buffer = *buffers[index];
+            Chunk * chunk = buffer.m_head;
+            size_t begin = buffer.m_applied;
+            while ( true )
+            {
+              size_t end = ( chunk == ends[index].first ) ? ends[index].second : commandsPerChunk;
+              for ( size_t position = begin; position < end; ++position )
+              {
+                visitor( chunk->commands[position], sequence++ );
+              }
+              if ( chunk == ends[index].first )
+              {
+                break;
+              }
+
+              Chunk * next = chunk->next.load( std::memory_order_relaxed );
+              if ( release )
+              {
+                // the recording thread has moved on to the next chunk
+                delete chunk;
+              }
+              chunk = next;
+              begin = 0;
+            }
+
+            if ( release )
+            {
+              buffer.m_head = chunk;
+              buffer.m_applied = ends[index].second;
+            }
+          }
+        };
+
+        // only the last matrix of each transform is set
+        m_lastMatrices.clear();
+        traverse( [this]( Command & command, size_t sequence )
+        {
+          if ( command.type == Command::Type::SET_MATRIX )
+          {
+            m_lastMatrices[command.object.get()] = sequence;
+          }
+        }, false );
+
+        size_t numberOfCommands = 0;
+        traverse( [&]( Command & command, size_t sequence )
+        {
+          switch ( command.type )
+          {
+          case Command::Type::ADD_CHILD:
+            std::static_pointer_cast<dp::sg::core::Group>( command.object )->addChild( command.child );
+            break;
+          case Command::Type::REMOVE_CHILD:
+            std::static_pointer_cast<dp::sg::core::Group>( command.object )->removeChild( command.child );
+            break;
+          case Command::Type::SET_MATRIX:
+            if ( m_lastMatrices.find( command.object.get() )->second != sequence )
+            {
+              command = Command();
+              return;
+            }
+            std::static_pointer_cast<dp::sg::core::Transform>( command.object )->setMatrix( command.matrix );
+            break;
+          case Command::Type::SET_ACTIVE:
+            std::static_pointer_cast<dp::sg::core::Switch>( command.object )->setActive( command.value );
+            break;
+          case Command::Type::SET_INACTIVE:
+            std::static_pointer_cast<dp::sg::core::Switch>( command.object )->setInactive( command.value );
+            break;
+          case Command::Type::SET_ACTIVE_MASK_KEY:
+            std::static_pointer_cast<dp::sg::core::Switch>( command.object )->setActiveMaskKey( command.value );
+            break;
+          case Command::Type::FUNCTION:
+            command.function();
+            break;
+          default:
+            DP_ASSERT( !"unknown command" );
+            break;
+          }
+          ++numberOfCommands;
+
+          // release the references to the edited objects
+          command = Command();
+        }, true );
+
+        // drop the buffers which have been released by their threads and which have been applied completely
+        buffers.clear();
+        {
+          std::lock_guard<std::mutex> lock( m_buffersMutex );
+          size_t count = 0;
+          for ( size_t index = 0; index < m_buffers.size(); ++index )
+          {
+            // A buffer still referenced by its recording thread may get new commands at any time, so only look at
+            // released ones. The fence pairs with the release decrement of the reference count by the recording
+            // thread and makes its last commands visible before the chunk state is read.
+            bool released = m_buffers[index].use_count() == 1;
+            if ( released )
+            {
+              std::atomic_thread_fence( std::memory_order_acquire );
+            }
+            MutationBuffer const & buffer = *m_buffers[index];
+            if ( !released || buffer.m_head->count.load( std::memory_order_acquire ) != buffer.m_applied || buffer.m_head->next.load( std::memory_order_acquire ) )
+            {
+              m_buffers[count++].swap( m_buffers[index] );
+            }
+          }
+          m_buffers.resize( count );
+        }
+
+        return numberOfCommands;
+      }
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -25,6 +25,7 @@
 
 
 #include <dp/sg/xbar/inc/ObjectObserver.h>
+#include <algorithm>
 
 namespace dp
 {
@@ -45,21 +46,56 @@ namespace dp
         Observer<ObjectTreeIndex>::attach( obj, payload );
 
         // fill cache data entry with current data
-        CacheData data;
-        data.m_hints = obj->getHints();
-        data.m_mask  = obj->getTraversalMask();
+        setNewCacheData( index, obj.get() );
+      }
 
-        m_newCacheData[index] = data;
+      void ObjectObserver::attachInitialized( dp::sg::core::ObjectSharedPtr const& obj, ObjectTreeIndex index )
+      {
+        DP_ASSERT( m_indexMap.find(index) == m_indexMap.end() );
+
+        Observer<ObjectTreeIndex>::attach( obj, Payload::create( index ) );
       }
 
       void ObjectObserver::onDetach( ObjectTreeIndex index )
       {
-        // remove NewCacheData entry
-        NewCacheData::iterator it = m_newCacheData.find( index );
-        if (it != m_newCacheData.end() )
+        // drop the new cache data of the index
+        if ( index < m_newCacheData.getSize() )
+        {
+          m_newCacheData.disableBit( index );
+        }
+      }
+
+      void ObjectObserver::onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        // compacting never increases an index, the new indices fit into arrays of the old size
+        std::vector<CacheData> cacheData( newIndices.size() );
+        dp::util::BitArray newCacheData( newIndices.size() );
+        m_newCacheData.traverseBits( [&]( size_t index )
         {
-          m_newCacheData.erase( it );
+          if ( newIndices[index] != ~0 )
+          {
+            cacheData[newIndices[index]] = m_cacheData[index];
+            newCacheData.enableBit( newIndices[index] );
+          }
+        } );
+        m_cacheData.swap( cacheData );
+        m_newCacheData = newCacheData;
+      }
+
+      void ObjectObserver::setNewCacheData( ObjectTreeIndex index, dp::sg::core::Object const * object )
+      {
+        if ( m_newCacheData.getSize() <= index )
+        {
+          // grow with the ObjectTree, which grows geometrically
+          size_t newSize = std::max( size_t(index) + 1, m_sceneTree->getObjectTree().size() );
+          m_cacheData.resize( newSize );
+          m_newCacheData.resize( newSize );
         }
+
+        m_cacheData[index].m_hints = object->getHints();
+        m_cacheData[index].m_mask  = object->getTraversalMask();
+        m_newCacheData.enableBit( index );
+        m_hasNewCacheData = true;
       }
 
       void ObjectObserver::onNotify( const dp::util::Event &event, dp::util::Payload * payload )
@@ -72,14 +108,8 @@ namespace dp
             dp::util::PropertyId propertyId = propertyEvent.getPropertyId();
             if( propertyId == dp::sg::core::Object::PID_Hints || propertyId == dp::sg::core::Object::PID_TraversalMask )
             {
-              dp::sg::core::Object const* o = static_cast<dp::sg::core::Object const*>(propertyEvent.getSource());
-
-              CacheData data;
-              data.m_hints = o->getHints();
-              data.m_mask  = o->getTraversalMask();
-
               DP_ASSERT( dynamic_cast<Payload*>(payload) );
-              m_newCacheData[static_cast<Payload*>(payload)->m_index] = data;
+              setNewCacheData( static_cast<Payload*>(payload)->m_index, static_cast<dp::sg::core::Object const*>(propertyEvent.getSource()) );
             }
           }
           break;
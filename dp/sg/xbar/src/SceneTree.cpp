@@ -27,6 +27,7 @@
 #include <dp/sg/xbar/DrawableManager.h>
 #include <dp/sg/xbar/SceneTree.h>
 #include <dp/sg/xbar/inc/UpdateObjectVisitor.h>
+#include <dp/sg/xbar/inc/SceneTreeBuilder.h>
 #include <dp/sg/xbar/inc/SceneTreeGenerator.h>
 
 // observers
@@ -84,14 +85,14 @@ namespace dp
         m_sceneObserver.reset();
       }
 
-      SceneTreeSharedPtr SceneTree::create( SceneSharedPtr const & scene )
+      SceneTreeSharedPtr SceneTree::create( SceneSharedPtr const & scene, BuildMode buildMode, unsigned int numberOfThreads )
       {
         SceneTreeSharedPtr st = std::shared_ptr<SceneTree>( new SceneTree( scene ) );
-        st->init();
+        st->init( buildMode, numberOfThreads );
         return( st );
       }
 
-      void SceneTree::init()
+      void SceneTree::init( BuildMode buildMode, unsigned int numberOfThreads )
       {
         m_objectObserver = ObjectObserver::create( shared_from_this() );
         m_sceneObserver = SceneObserver::create( shared_from_this() );
@@ -100,12 +101,17 @@ namespace dp
         ObjectTreeNode objectTreeSentinel;
         objectTreeSentinel.m_transform = m_transformTree.getSentinel();
         objectTreeSentinel.m_transformParent = -1;
-        objectTreeSentinel.m_clipPlaneGroup = ClipPlaneGroup::create();
-        m_objectTreeSentinel = m_objectTree.insertNode( objectTreeSentinel, ~0, ~0 );
+        ObjectTreeNodeData objectTreeSentinelData;
+        objectTreeSentinelData.m_clipPlaneGroup = ClipPlaneGroup::create();
+        m_objectTreeSentinel = m_objectTree.insertNode( objectTreeSentinel, objectTreeSentinelData, ~0, ~0 );
 
-        SceneTreeGenerator rlg( this->shared_from_this() );
-        rlg.setCurrentObjectTreeData( m_objectTreeSentinel, ~0 );
-        rlg.apply( m_scene );
+        SceneTreeBuilder builder( *this, numberOfThreads );
+        if ( buildMode != BuildMode::BULK || !builder.build( m_scene->getRootNode(), m_objectTreeSentinel ) )
+        {
+          SceneTreeGenerator rlg( this->shared_from_this() );
+          rlg.setCurrentObjectTreeData( m_objectTreeSentinel, ~0 );
+          rlg.apply( m_scene );
+        }
 
         // root node is first child below sentinel
         m_objectTreeRootNode = m_objectTree[m_objectTreeSentinel].m_firstChild;
@@ -152,6 +158,13 @@ namespace dp
 
       void SceneTree::update(dp::sg::core::CameraSharedPtr const& camera, float lodScaleRange)
       {
+        // apply the edits of other threads, this notifies the observers of the tree on this thread
+        if ( m_mutationQueue )
+        {
+          dp::util::ProfileEntry p("Apply MutationQueue");
+          m_mutationQueue->apply();
+        }
+
         // for now it is important to update the transform tree first to clear the DIRTY_TRANSFORM bit
         {
           dp::util::ProfileEntry p("Update TransformTree");
@@ -176,70 +189,51 @@ namespace dp
         //
 
         // update dirty object hints & masks
+        m_objectObserver->popNewCacheData( [this]( ObjectTreeIndex index, ObjectObserver::CacheData const & data )
         {
-          ObjectObserver::NewCacheData cd;
-          m_objectObserver->popNewCacheData( cd );
+          ObjectTreeNode& node = m_objectTree[ index ];
+          node.m_localHints = data.m_hints;
+          node.m_localMask = data.m_mask;
 
-          ObjectObserver::NewCacheData::const_iterator it, it_end = cd.end();
-          for( it=cd.begin(); it!=it_end; ++it )
-          {
-            ObjectTreeNode& node = m_objectTree[ it->first ];
-            node.m_localHints = it->second.m_hints;
-            node.m_localMask = it->second.m_mask;
-
-            m_objectTree.markDirty( it->first, ObjectTreeNode::DEFAULT_DIRTY );
-          }
-        }
+          m_objectTree.markDirty( index, ObjectTreeNode::DEFAULT_DIRTY );
+        } );
 
         // update dirty switch information
-        ObjectTreeIndexSet dirtySwitches;
-        m_switchObserver->popDirtySwitches( dirtySwitches );
-        if( !dirtySwitches.empty() )
+        m_switchObserver->popDirtySwitches( [this]( ObjectTreeIndex index )
         {
-          ObjectTreeIndexSet::iterator it, it_end = dirtySwitches.end();
-          for( it=dirtySwitches.begin(); it!=it_end; ++it )
-          {
-            ObjectTreeIndex index = *it;
+          DP_ASSERT( m_objectTree.m_switchNodes.getBit( index ) );
+          DP_ASSERT( std::dynamic_pointer_cast<Switch>( m_objectTree.getData( index ).m_object ) );
+          Switch const * switchNode = static_cast<Switch const *>( m_objectTree.getData( index ).m_object.get() );
 
-            SwitchSharedPtr ssp = m_objectTree.m_switchNodes[ index ].lock();
-            DP_ASSERT( ssp );
+          ObjectTreeIndex childIndex = m_objectTree[index].m_firstChild;
+          // counter for the i-th child
+          size_t i = 0;
 
-            ObjectTreeIndex childIndex = m_objectTree[index].m_firstChild;
-            // counter for the i-th child
-            size_t i = 0;
+          while( childIndex != ~0 )
+          {
+            ObjectTreeNode& childNode = m_objectTree[childIndex];
+            DP_ASSERT( childNode.m_parentIndex == index );
 
-            while( childIndex != ~0 )
+            bool newActive = switchNode->isActive( dp::checked_cast<unsigned int>(i) );
+            if ( childNode.m_localActive != newActive )
             {
-              ObjectTreeNode& childNode = m_objectTree[childIndex];
-              DP_ASSERT( childNode.m_parentIndex == index );
-
-              bool newActive = ssp->isActive( dp::checked_cast<unsigned int>(i) );
-              if ( childNode.m_localActive != newActive )
-              {
-                childNode.m_localActive = newActive;
-                m_objectTree.markDirty( childIndex, ObjectTreeNode::DEFAULT_DIRTY );
-              }
-
-              childIndex = childNode.m_nextSibling;
-              ++i;
+              childNode.m_localActive = newActive;
+              m_objectTree.markDirty( childIndex, ObjectTreeNode::DEFAULT_DIRTY );
             }
+
+            childIndex = childNode.m_nextSibling;
+            ++i;
           }
-        }
+        } );
 
-        // update all lods
-        if( !m_objectTree.m_LODs.empty() )
+        // update the lods whose active child has changed
+        if( !m_lodEvaluator.empty() )
         {
-          const Mat44f& worldToView = camera->getWorldToViewMatrix();
-
-          std::map< ObjectTreeIndex, LODWeakPtr >::iterator it, it_end = m_objectTree.m_LODs.end();
-          for( it = m_objectTree.m_LODs.begin(); it != it_end; ++it )
+          LODEvaluator::ChangedLODs const & changedLODs = m_lodEvaluator.evaluate( m_transformTree, camera->getWorldToViewMatrix(), lodRangeScale );
+          for ( LODEvaluator::ChangedLOD const & changedLOD : changedLODs )
           {
-            ObjectTreeIndex index = it->first;
-            const ObjectTreeNode& node = m_objectTree[ index ];
-
-            Mat44f const & modelToWorld = m_transformTree.getWorldMatrix(node.m_transform);
-            const Mat44f modelToView = modelToWorld * worldToView;
-            ObjectTreeIndex activeIndex = it->second.lock()->getLODToUse( modelToView, lodRangeScale );
+            ObjectTreeIndex index = changedLOD.index;
+            ObjectTreeIndex activeIndex = changedLOD.activeChild;
 
             ObjectTreeIndex childIndex = m_objectTree[index].m_firstChild;
             // counter for the i-th child
@@ -274,26 +268,59 @@ namespace dp
         m_objectTree.m_dirtyObjects.clear();
       }
 
-      ObjectTreeIndex SceneTree::addObject( const ObjectTreeNode & node, ObjectTreeIndex parentIndex, ObjectTreeIndex siblingIndex )
+      void SceneTree::compact()
+      {
+        std::vector<ObjectTreeIndex> newIndices;
+        m_objectTree.compact( newIndices );
+
+        m_objectTreeSentinel = newIndices[m_objectTreeSentinel];
+        if ( m_objectTreeRootNode != ~0 )
+        {
+          m_objectTreeRootNode = newIndices[m_objectTreeRootNode];
+        }
+
+        std::set< ObjectTreeIndex > lightSources;
+        for ( std::set< ObjectTreeIndex >::const_iterator it = m_lightSources.begin(); it != m_lightSources.end(); ++it )
+        {
+          lightSources.insert( newIndices[*it] );
+        }
+        m_lightSources.swap( lightSources );
+
+        dp::util::BitArray switchNodes( m_objectTree.size() );
+        m_objectTree.m_switchNodes.traverseBits( [&]( size_t index ) { switchNodes.enableBit( newIndices[index] ); } );
+        m_objectTree.m_switchNodes = switchNodes;
+
+        m_objectObserver->remapIndices( newIndices );
+        m_switchObserver->remapIndices( newIndices );
+        m_lodEvaluator.remapIndices( newIndices );
+
+        // the stack is sized to the tree
+        std::vector< ObjectTreeIndex >().swap( m_objectIndexStack );
+
+        notify( RemapEvent( m_objectTreeSentinel, m_objectTree[m_objectTreeSentinel], m_objectTree.getData( m_objectTreeSentinel ), newIndices ) );
+      }
+
+      ObjectTreeIndex SceneTree::addObject( const ObjectTreeNode & node, const ObjectTreeNodeData & data, ObjectTreeIndex parentIndex, ObjectTreeIndex siblingIndex )
       {
         // add object to object tree
-        ObjectTreeIndex index = m_objectTree.insertNode( node, parentIndex, siblingIndex );
+        ObjectTreeIndex index = m_objectTree.insertNode( node, data, parentIndex, siblingIndex );
 
         // observe object
-        m_objectObserver->attach( node.m_object, index );
+        m_objectObserver->attach( data.m_object, index );
 
         ObjectTreeNode const & parentNode = m_objectTree[parentIndex];
         ObjectTreeNode & newNode = m_objectTree[index];
-        if (std::dynamic_pointer_cast<dp::sg::core::Transform>(node.m_object))
+        ObjectCode objectCode = data.m_object->getObjectCode();
+        if ( objectCode == ObjectCode::TRANSFORM )
         {
           newNode.m_transformParent = parentNode.m_transform;
-          newNode.m_transform = m_transformTree.addTransform(parentNode.m_transform, std::static_pointer_cast<dp::sg::core::Transform>(node.m_object));
+          newNode.m_transform = m_transformTree.addTransform(parentNode.m_transform, std::static_pointer_cast<dp::sg::core::Transform>(data.m_object));
           newNode.m_isTransform = true;
         }
-        else if(std::dynamic_pointer_cast<dp::sg::core::Billboard>(node.m_object))
+        else if ( objectCode == ObjectCode::BILLBOARD )
         {
           newNode.m_transformParent = parentNode.m_transform;
-          newNode.m_transform = m_transformTree.addBillboard(parentNode.m_transform, std::static_pointer_cast<dp::sg::core::Billboard>(node.m_object));
+          newNode.m_transform = m_transformTree.addBillboard(parentNode.m_transform, std::static_pointer_cast<dp::sg::core::Billboard>(data.m_object));
           newNode.m_isBillboard = true;
         }
 
@@ -302,14 +329,18 @@ namespace dp
 
       void SceneTree::addLOD( LODSharedPtr const& lod, ObjectTreeIndex index )
       {
-        DP_ASSERT( m_objectTree.m_LODs.find(index) == m_objectTree.m_LODs.end() );
-        m_objectTree.m_LODs[index] = lod;
+        m_lodEvaluator.addLOD( lod, index, m_objectTree[index].m_transform );
       }
 
       void SceneTree::addSwitch( const SwitchSharedPtr& s, ObjectTreeIndex index )
       {
-        DP_ASSERT( m_objectTree.m_switchNodes.find(index) == m_objectTree.m_switchNodes.end() );
-        m_objectTree.m_switchNodes[index] = s;
+        if ( m_objectTree.m_switchNodes.getSize() <= index )
+        {
+          // grow with the ObjectTree, which grows geometrically
+          m_objectTree.m_switchNodes.resize( std::max( size_t(index) + 1, m_objectTree.size() ) );
+        }
+        DP_ASSERT( !m_objectTree.m_switchNodes.getBit( index ) );
+        m_objectTree.m_switchNodes.enableBit( index );
 
         // attach switch observer to switch
         m_switchObserver->attach( s, index );
@@ -319,12 +350,13 @@ namespace dp
       {
         // attach observer
         m_objectTree[index].m_isDrawable = true;
-        notify( Event( index, m_objectTree[index], Event::Type::ADDED ) );
+        notify( Event( index, m_objectTree[index], m_objectTree.getData( index ), Event::Type::ADDED ) );
       }
 
       void SceneTree::addLightSource( ObjectTreeIndex index )
       {
-        m_lightSources.insert(index);
+        // the bulk build adds the light sources in ascending order, the hint makes this constant time
+        m_lightSources.insert(m_lightSources.end(), index);
       }
 
       void SceneTree::removeObjectTreeIndex( ObjectTreeIndex index )
@@ -334,6 +366,7 @@ namespace dp
 
         // vector for stack-simulation to eliminate overhead of std::stack
         m_objectIndexStack.resize( m_objectTree.size() );
+        m_removedTransforms.clear();
         size_t begin = 0;
         size_t end   = 0;
 
@@ -346,52 +379,44 @@ namespace dp
           ObjectTreeIndex currentIndex = m_objectIndexStack[begin];
           ++begin;
           ObjectTreeNode& current = m_objectTree[currentIndex];
+          ObjectTreeNodeData& currentData = m_objectTree.getData( currentIndex );
 
-          if ( std::dynamic_pointer_cast<dp::sg::core::LightSource>(m_objectTree[currentIndex].m_object) )
+          if ( currentData.m_object->getObjectCode() == ObjectCode::LIGHT_SOURCE )
           {
             DP_VERIFY( m_lightSources.erase( currentIndex ) == 1 );
           }
 
           if ( m_objectTree[currentIndex].m_isDrawable )
           {
-            notify( Event( currentIndex, m_objectTree[currentIndex], Event::Type::REMOVED) );
+            notify( Event( currentIndex, m_objectTree[currentIndex], currentData, Event::Type::REMOVED) );
             m_objectTree[index].m_isDrawable = false;
           }
 
-          current.m_clipPlaneGroup.reset();
+          currentData.m_clipPlaneGroup.reset();
 
           // detach current index from object observer
           m_objectObserver->detach( currentIndex );
 
           // TODO: add observer flag to specify which observers must be detached?
-          std::map< ObjectTreeIndex, SwitchWeakPtr >::iterator itSwitch = m_objectTree.m_switchNodes.find( currentIndex );
-          if ( itSwitch != m_objectTree.m_switchNodes.end() )
+          if ( currentIndex < m_objectTree.m_switchNodes.getSize() && m_objectTree.m_switchNodes.getBit( currentIndex ) )
           {
             m_switchObserver->detach( currentIndex );
-            m_objectTree.m_switchNodes.erase( itSwitch );
+            m_objectTree.m_switchNodes.disableBit( currentIndex );
           }
 
-          std::map< ObjectTreeIndex, LODWeakPtr >::iterator itLod = m_objectTree.m_LODs.find( currentIndex );
-          if ( itLod != m_objectTree.m_LODs.end() )
+          if ( m_lodEvaluator.hasLOD( currentIndex ) )
           {
-            m_objectTree.m_LODs.erase( itLod );
+            m_lodEvaluator.removeLOD( currentIndex );
           }
 
-          // check if a transform needs to be removed
+          // collect the transforms and billboards of the subtree to remove them at once
           DP_ASSERT( current.m_parentIndex != ~0 );
-          const ObjectTreeNode& curParent = m_objectTree[current.m_parentIndex];
-
-          // only remove the topmost transforms below or at index (so transforms are only removed once)
-          if (current.m_isTransform)
+          if (current.m_isTransform || current.m_isBillboard)
           {
-            m_transformTree.removeTransform(current.m_transform);
-          }
-          else if (current.m_isBillboard)
-          {
-            m_transformTree.removeBillboard(current.m_transform);
+            m_removedTransforms.push_back(current.m_transform);
           }
 
-          current.m_object.reset();
+          currentData.m_object.reset();
 
           // insert all children into stack for further traversal
           ObjectTreeIndex child = current.m_firstChild;
@@ -403,6 +428,8 @@ namespace dp
           }
         }
 
+        m_transformTree.removeTransforms( m_removedTransforms );
+
         // delete the node and its children from the object tree
         m_objectTree.deleteNode( index );
       }
@@ -0,0 +1,428 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/xbar/inc/SceneTreeBuilder.h>
+#include <dp/sg/xbar/inc/ObjectObserver.h>
+
+#include <dp/sg/core/Billboard.h>
+#include <dp/sg/core/Group.h>
+#include <dp/sg/core/LOD.h>
+#include <dp/sg/core/Switch.h>
+#include <dp/sg/core/Transform.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace dp::sg::core;
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      namespace
+      {
+        // Number of subtrees per thread. More subtrees than threads balance subtrees of different size.
+        const size_t tasksPerThread = 8;
+
+        // Nodes deeper than this are never filled serially, even if there are not enough subtrees for all threads.
+        const unsigned int maximumSplitDepth = 8;
+      }
+
+      SceneTreeBuilder::SceneTreeBuilder( SceneTree & sceneTree, unsigned int numberOfThreads )
+        : m_sceneTree( sceneTree )
+        , m_objectTree( sceneTree.getObjectTree() )
+        , m_splitDepth( 0 )
+        , m_currentTask( 0 )
+        , m_numberOfNodes( 0 )
+        , m_numberOfTransforms( 0 )
+        , m_hasClipPlanes( false )
+        , m_nextIndex( ~0 )
+      {
+        if ( numberOfThreads == 0 )
+        {
+          numberOfThreads = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+        if ( numberOfThreads > 1 )
+        {
+          m_threadPool.reset( new dp::util::ThreadPool( numberOfThreads ) );
+        }
+      }
+
+      SceneTreeBuilder::~SceneTreeBuilder()
+      {
+      }
+
+      SceneTreeBuilder::NodeKind SceneTreeBuilder::getNodeKind( Object const * object )
+      {
+        // same handlers as used by the SceneTreeGenerator
+        switch ( object->getObjectCode() )
+        {
+        case ObjectCode::GROUP:
+          return NodeKind::GROUP;
+        case ObjectCode::LOD:
+          return NodeKind::LOD;
+        case ObjectCode::SWITCH:
+          return NodeKind::SWITCH;
+        case ObjectCode::TRANSFORM:
+          return NodeKind::TRANSFORM;
+        case ObjectCode::BILLBOARD:
+          return NodeKind::BILLBOARD;
+        case ObjectCode::GEO_NODE:
+          return NodeKind::GEO_NODE;
+        case ObjectCode::LIGHT_SOURCE:
+          return NodeKind::LIGHT_SOURCE;
+        default:
+          return NodeKind::NONE;
+        }
+      }
+
+      void SceneTreeBuilder::execute( size_t numberOfTasks, std::function<void( size_t )> const & task )
+      {
+        if ( m_threadPool && 1 < numberOfTasks )
+        {
+          m_threadPool->execute( numberOfTasks, task );
+        }
+        else
+        {
+          for ( size_t index = 0; index < numberOfTasks; ++index )
+          {
+            task( index );
+          }
+        }
+      }
+
+      bool SceneTreeBuilder::build( NodeSharedPtr const & root, ObjectTreeIndex parentIndex )
+      {
+        NodeKind rootKind = root ? getNodeKind( root.get() ) : NodeKind::NONE;
+        if ( rootKind == NodeKind::NONE )
+        {
+          return true;
+        }
+
+        // determine the depth at which there are enough subtrees to keep all threads busy
+        m_splitDepth = 0;
+        if ( m_threadPool )
+        {
+          size_t minimumNumberOfTasks = tasksPerThread * m_threadPool->getNumberOfThreads();
+          std::vector<Node const *> level( 1, root.get() );
+          std::vector<Node const *> nextLevel;
+          while ( level.size() < minimumNumberOfTasks && m_splitDepth < maximumSplitDepth )
+          {
+            nextLevel.clear();
+            for ( Node const * node : level )
+            {
+              if ( isGroup( getNodeKind( node ) ) )
+              {
+                Group const * group = static_cast<Group const *>(node);
+                for ( Group::ChildrenConstIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+                {
+                  if ( getNodeKind( it->get() ) != NodeKind::NONE )
+                  {
+                    nextLevel.push_back( it->get() );
+                  }
+                }
+              }
+            }
+            if ( nextLevel.empty() )
+            {
+              break;
+            }
+            level.swap( nextLevel );
+            ++m_splitDepth;
+          }
+        }
+
+        // count the nodes and transforms of all subtrees
+        m_tasks.clear();
+        m_numberOfNodes = 0;
+        m_numberOfTransforms = 0;
+        m_hasClipPlanes = false;
+        collectTasks( root, rootKind, 0 );
+
+        size_t numberOfChunks = std::min( m_tasks.size(), m_threadPool ? tasksPerThread * m_threadPool->getNumberOfThreads() : 1 );
+        execute( numberOfChunks, [&]( size_t chunk )
+        {
+          size_t end = ( chunk + 1 ) * m_tasks.size() / numberOfChunks;
+          for ( size_t index = chunk * m_tasks.size() / numberOfChunks; index < end; ++index )
+          {
+            Task & task = m_tasks[index];
+            countSubtree( task.node->get(), getNodeKind( task.node->get() ), task );
+          }
+        } );
+
+        size_t numberOfNodes = m_numberOfNodes;
+        size_t numberOfTransforms = m_numberOfTransforms;
+        for ( Task const & task : m_tasks )
+        {
+          m_hasClipPlanes |= task.hasClipPlanes;
+          numberOfNodes += task.numberOfNodes;
+          numberOfTransforms += task.numberOfTransforms;
+        }
+
+        // clip plane groups depend on the traversal order, leave them to the SceneTreeGenerator
+        if ( m_hasClipPlanes )
+        {
+          return false;
+        }
+
+        // allocate all nodes at once. The nodes get consecutive indices in pre-order like they get from insertNode.
+        ObjectTreeIndex firstIndex = m_objectTree.allocateNodes( numberOfNodes );
+        m_sceneTree.m_transformTree.reserve( numberOfTransforms );
+        m_clipPlaneGroup = m_objectTree.getData( parentIndex ).m_clipPlaneGroup;
+
+        // fill the nodes above the split depth and assign the index ranges of the subtrees
+        m_nextIndex = firstIndex;
+        m_currentTask = 0;
+        ObjectTreeIndex rootIndex = buildTop( root, rootKind, parentIndex, 0 );
+        DP_ASSERT( m_currentTask == m_tasks.size() && m_nextIndex == firstIndex + numberOfNodes );
+
+        // insert the root as first child of the parent like the SceneTreeGenerator does
+        m_objectTree[rootIndex].m_nextSibling = m_objectTree[parentIndex].m_firstChild;
+        m_objectTree[parentIndex].m_firstChild = rootIndex;
+
+        // fill the subtrees
+        execute( numberOfChunks, [&]( size_t chunk )
+        {
+          size_t end = ( chunk + 1 ) * m_tasks.size() / numberOfChunks;
+          for ( size_t index = chunk * m_tasks.size() / numberOfChunks; index < end; ++index )
+          {
+            Task const & task = m_tasks[index];
+            ObjectTreeIndex nextIndex = task.index;
+            fillSubtree( *task.node, getNodeKind( task.node->get() ), task.parentIndex, nextIndex );
+            DP_ASSERT( nextIndex == task.index + task.numberOfNodes );
+          }
+        } );
+        m_tasks.clear();
+
+        registerNodes( firstIndex, numberOfNodes );
+
+        // all new nodes are dirty, updating the root updates all of them
+        m_objectTree.m_dirtyObjects.push_back( rootIndex );
+
+        return true;
+      }
+
+      void SceneTreeBuilder::collectTasks( NodeSharedPtr const & node, NodeKind kind, unsigned int depth )
+      {
+        if ( depth < m_splitDepth && isGroup( kind ) )
+        {
+          Group const * group = static_cast<Group const *>(node.get());
+          m_hasClipPlanes |= !!group->getNumberOfClipPlanes();
+          ++m_numberOfNodes;
+          m_numberOfTransforms += ( kind == NodeKind::TRANSFORM || kind == NodeKind::BILLBOARD );
+
+          for ( Group::ChildrenConstIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+          {
+            NodeKind childKind = getNodeKind( it->get() );
+            if ( childKind != NodeKind::NONE )
+            {
+              collectTasks( *it, childKind, depth + 1 );
+            }
+          }
+        }
+        else
+        {
+          Task task;
+          task.node = &node;
+          task.parentIndex = ~0;
+          task.index = ~0;
+          task.numberOfNodes = 0;
+          task.numberOfTransforms = 0;
+          task.hasClipPlanes = false;
+          m_tasks.push_back( task );
+        }
+      }
+
+      void SceneTreeBuilder::countSubtree( Node const * node, NodeKind kind, Task & task ) const
+      {
+        ++task.numberOfNodes;
+        task.numberOfTransforms += ( kind == NodeKind::TRANSFORM || kind == NodeKind::BILLBOARD );
+
+        if ( isGroup( kind ) )
+        {
+          Group const * group = static_cast<Group const *>(node);
+          task.hasClipPlanes |= !!group->getNumberOfClipPlanes();
+
+          for ( Group::ChildrenConstIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+          {
+            NodeKind childKind = getNodeKind( it->get() );
+            if ( childKind != NodeKind::NONE )
+            {
+              countSubtree( it->get(), childKind, task );
+            }
+          }
+        }
+      }
+
+      ObjectTreeIndex SceneTreeBuilder::buildTop( NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex, unsigned int depth )
+      {
+        if ( depth < m_splitDepth && isGroup( kind ) )
+        {
+          ObjectTreeIndex index = m_nextIndex++;
+          fillNode( index, node, kind, parentIndex );
+
+          ObjectTreeIndex previousIndex = ~0;
+          Group const * group = static_cast<Group const *>(node.get());
+          for ( Group::ChildrenConstIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+          {
+            NodeKind childKind = getNodeKind( it->get() );
+            if ( childKind != NodeKind::NONE )
+            {
+              ObjectTreeIndex childIndex = buildTop( *it, childKind, index, depth + 1 );
+              linkChild( index, previousIndex, childIndex );
+              previousIndex = childIndex;
+            }
+          }
+          return index;
+        }
+        else
+        {
+          // the subtree is filled later on, reserve its index range
+          Task & task = m_tasks[m_currentTask++];
+          DP_ASSERT( task.node == &node );
+          task.parentIndex = parentIndex;
+          task.index = m_nextIndex;
+          m_nextIndex += dp::checked_cast<ObjectTreeIndex>(task.numberOfNodes);
+          return task.index;
+        }
+      }
+
+      ObjectTreeIndex SceneTreeBuilder::fillSubtree( NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex, ObjectTreeIndex & nextIndex )
+      {
+        ObjectTreeIndex index = nextIndex++;
+        fillNode( index, node, kind, parentIndex );
+
+        if ( isGroup( kind ) )
+        {
+          ObjectTreeIndex previousIndex = ~0;
+          Group const * group = static_cast<Group const *>(node.get());
+          for ( Group::ChildrenConstIterator it = group->beginChildren(); it != group->endChildren(); ++it )
+          {
+            NodeKind childKind = getNodeKind( it->get() );
+            if ( childKind != NodeKind::NONE )
+            {
+              ObjectTreeIndex childIndex = fillSubtree( *it, childKind, index, nextIndex );
+              linkChild( index, previousIndex, childIndex );
+              previousIndex = childIndex;
+            }
+          }
+        }
+        return index;
+      }
+
+      void SceneTreeBuilder::fillNode( ObjectTreeIndex index, NodeSharedPtr const & node, NodeKind kind, ObjectTreeIndex parentIndex )
+      {
+        ObjectTreeNode & treeNode = m_objectTree[index];
+
+        // the next sibling is set by the parent of the node, which might have happened already for the root of a subtree
+        ObjectTreeIndex nextSibling = treeNode.m_nextSibling;
+        treeNode = ObjectTreeNode();
+        treeNode.m_nextSibling = nextSibling;
+
+        treeNode.m_parentIndex = parentIndex;
+        treeNode.m_dirtyBits = ~0;
+
+        ObjectTreeNodeData & data = m_objectTree.getData( index );
+        data.m_object = node;
+        data.m_clipPlaneGroup = m_clipPlaneGroup;
+
+        // the ObjectObserver would pass these on the first update
+        treeNode.m_localHints = node->getHints();
+        treeNode.m_localMask = node->getTraversalMask();
+
+        treeNode.m_isTransform = ( kind == NodeKind::TRANSFORM );
+        treeNode.m_isBillboard = ( kind == NodeKind::BILLBOARD );
+      }
+
+      void SceneTreeBuilder::linkChild( ObjectTreeIndex parentIndex, ObjectTreeIndex previousIndex, ObjectTreeIndex childIndex )
+      {
+        if ( previousIndex == ~0 )
+        {
+          m_objectTree[parentIndex].m_firstChild = childIndex;
+        }
+        else
+        {
+          m_objectTree[previousIndex].m_nextSibling = childIndex;
+        }
+        m_objectTree[childIndex].m_nextSibling = ~0;
+      }
+
+      void SceneTreeBuilder::registerNodes( ObjectTreeIndex firstIndex, size_t numberOfNodes )
+      {
+        TransformTree & transformTree = m_sceneTree.m_transformTree;
+        ObjectObserverSharedPtr const & objectObserver = m_sceneTree.m_objectObserver;
+
+        // pre-order, the parent of a node has always been processed before
+        for ( ObjectTreeIndex index = firstIndex; index < firstIndex + numberOfNodes; ++index )
+        {
+          ObjectTreeNode & treeNode = m_objectTree[index];
+          ObjectTreeNode const & parentNode = m_objectTree[treeNode.m_parentIndex];
+          ObjectSharedPtr const & object = m_objectTree.getData( index ).m_object;
+
+          objectObserver->attachInitialized( object, index );
+
+          if ( treeNode.m_isTransform )
+          {
+            treeNode.m_transformParent = parentNode.m_transform;
+            treeNode.m_transform = transformTree.addTransform( parentNode.m_transform, std::static_pointer_cast<Transform>(object) );
+          }
+          else if ( treeNode.m_isBillboard )
+          {
+            treeNode.m_transformParent = parentNode.m_transform;
+            treeNode.m_transform = transformTree.addBillboard( parentNode.m_transform, std::static_pointer_cast<Billboard>(object) );
+          }
+          else
+          {
+            treeNode.m_transform = parentNode.m_transform;
+            treeNode.m_transformParent = parentNode.m_transformParent;
+          }
+
+          switch ( getNodeKind( object.get() ) )
+          {
+          case NodeKind::LOD:
+            m_sceneTree.addLOD( std::static_pointer_cast<LOD>(object), index );
+            break;
+          case NodeKind::SWITCH:
+            m_sceneTree.addSwitch( std::static_pointer_cast<Switch>(object), index );
+            break;
+          case NodeKind::GEO_NODE:
+            m_sceneTree.addGeoNode( index );
+            break;
+          case NodeKind::LIGHT_SOURCE:
+            m_sceneTree.addLightSource( index );
+            break;
+          default:
+            break;
+          }
+        }
+      }
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -0,0 +1,279 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/sg/xbar/SceneTreeSnapshot.h>
+#include <algorithm>
+
+namespace dp
+{
+  namespace sg
+  {
+    namespace xbar
+    {
+
+      namespace
+      {
+        // Call visitor for each index set in published or pending. The frame being overwritten by publish misses the changes
+        // published with the other frame and the changes since then.
+        template <typename Visitor>
+        void traverseChanged( dp::util::BitArray const & published, dp::util::BitArray const & pending, Visitor visitor )
+        {
+          published.traverseBits( visitor );
+          pending.traverseBits( [&]( size_t index )
+          {
+            if ( index >= published.getSize() || !published.getBit( index ) )
+            {
+              visitor( index );
+            }
+          } );
+        }
+      }
+
+      SceneTreeSnapshot::Frame::Frame()
+        : m_frameNumber( 0 )
+        , m_readers( 0 )
+      {
+      }
+
+      SceneTreeSnapshotSharedPtr SceneTreeSnapshot::create( SceneTreeSharedPtr const & sceneTree )
+      {
+        return( std::shared_ptr<SceneTreeSnapshot>( new SceneTreeSnapshot( sceneTree ) ) );
+      }
+
+      SceneTreeSnapshot::SceneTreeSnapshot( SceneTreeSharedPtr const & sceneTree )
+        : m_sceneTree( sceneTree )
+        , m_refresh( true )
+        , m_front( 0 )
+      {
+        ObjectTree & objectTree = m_sceneTree->getObjectTree();
+        m_active.resize( objectTree.size() );
+        for ( size_t index = 0; index < objectTree.size(); ++index )
+        {
+          m_active.setBit( index, objectTree[ObjectTreeIndex(index)].m_worldActive );
+        }
+        m_visible.resize( objectTree.size(), true );
+        m_changedObjects.resize( objectTree.size() );
+        m_changedWorldMatrices.resize( m_sceneTree->getTransformTree().getTransforms().size() );
+
+        m_sceneTree->attach( this );
+
+        m_transformObserver.reset( new TransformObserver( *this ) );
+        m_sceneTree->getTransformTree().attach( m_transformObserver.get() );
+      }
+
+      SceneTreeSnapshot::~SceneTreeSnapshot()
+      {
+        DP_ASSERT( m_frames[0].m_readers == 0 && m_frames[1].m_readers == 0 && "frames of the snapshot are still acquired" );
+
+        m_sceneTree->getTransformTree().detach( m_transformObserver.get() );
+        m_sceneTree->detach( this );
+      }
+
+      void SceneTreeSnapshot::setVisible( ObjectTreeIndex objectTreeIndex, bool visible )
+      {
+        setChangedObject( objectTreeIndex );
+        m_visible.setBit( objectTreeIndex, visible );
+      }
+
+      void SceneTreeSnapshot::publish()
+      {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        Frame const & front = m_frames[m_front];
+        Frame & frame = m_frames[m_front ^ 1];
+        m_released.wait( lock, [&frame]() { return frame.m_readers == 0; } );
+        lock.unlock();
+
+        // the front frame is immutable and the back frame is not visible to the readers until it is published
+        TransformTree::Transforms const & transforms = m_sceneTree->getTransformTree().getTransforms();
+        size_t numberOfObjects = m_sceneTree->getObjectTree().size();
+        reserveObjects( numberOfObjects );
+
+        // nodes without events, i.e. all but the GeoNodes, keep their initial state
+        frame.m_worldMatrices.resize( transforms.size() );
+        frame.m_active.resize( numberOfObjects, true );
+        frame.m_visible.resize( numberOfObjects, true );
+        frame.m_changedWorldMatrices.resize( transforms.size() );
+        frame.m_changedObjects.resize( numberOfObjects );
+
+        if ( m_refresh )
+        {
+          for ( size_t index = 0; index < transforms.size(); ++index )
+          {
+            frame.m_worldMatrices[index] = transforms[index].world;
+          }
+          for ( size_t index = 0; index < numberOfObjects; ++index )
+          {
+            frame.m_active.setBit( index, m_active.getBit( index ) );
+            frame.m_visible.setBit( index, m_visible.getBit( index ) );
+          }
+
+          // the other frame has to be refreshed by the next publish as well
+          frame.m_changedWorldMatrices.fill();
+          frame.m_changedObjects.fill();
+          m_refresh = false;
+        }
+        else
+        {
+          traverseChanged( front.m_changedWorldMatrices, m_changedWorldMatrices, [&]( size_t index )
+          {
+            frame.m_worldMatrices[index] = transforms[index].world;
+          } );
+          traverseChanged( front.m_changedObjects, m_changedObjects, [&]( size_t index )
+          {
+            frame.m_active.setBit( index, m_active.getBit( index ) );
+            frame.m_visible.setBit( index, m_visible.getBit( index ) );
+          } );
+
+          frame.m_changedWorldMatrices.clear();
+          m_changedWorldMatrices.traverseBits( [&]( size_t index ) { frame.m_changedWorldMatrices.enableBit( index ); } );
+          frame.m_changedObjects.clear();
+          m_changedObjects.traverseBits( [&]( size_t index ) { frame.m_changedObjects.enableBit( index ); } );
+        }
+        frame.m_frameNumber = front.m_frameNumber + 1;
+
+        m_changedWorldMatrices.clear();
+        m_changedObjects.clear();
+
+        lock.lock();
+        m_front ^= 1;
+      }
+
+      SceneTreeSnapshot::FrameSharedPtr SceneTreeSnapshot::acquire()
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        Frame & frame = m_frames[m_front];
+        ++frame.m_readers;
+        return( FrameSharedPtr( &frame, [this]( Frame const * frame ) { release( frame ); } ) );
+      }
+
+      void SceneTreeSnapshot::release( Frame const * frame )
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        Frame & acquired = m_frames[frame == &m_frames[0] ? 0 : 1];
+        DP_ASSERT( acquired.m_readers );
+        if ( --acquired.m_readers == 0 )
+        {
+          m_released.notify_one();
+        }
+      }
+
+      void SceneTreeSnapshot::setChangedObject( ObjectTreeIndex objectTreeIndex )
+      {
+        reserveObjects( size_t(objectTreeIndex) + 1 );
+        m_changedObjects.enableBit( objectTreeIndex );
+      }
+
+      void SceneTreeSnapshot::reserveObjects( size_t numberOfObjects )
+      {
+        if ( m_changedObjects.getSize() < numberOfObjects )
+        {
+          // grow geometrically, nodes are added one by one
+          size_t newSize = std::max( numberOfObjects, 2 * m_changedObjects.getSize() );
+          m_active.resize( newSize, true );
+          m_visible.resize( newSize, true );
+          m_changedObjects.resize( newSize );
+        }
+      }
+
+      void SceneTreeSnapshot::remapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        size_t numberOfObjects = m_sceneTree->getObjectTree().size();
+        dp::util::BitArray active( numberOfObjects );
+        dp::util::BitArray visible( numberOfObjects );
+        for ( size_t index = 0; index < newIndices.size() && index < m_active.getSize(); ++index )
+        {
+          if ( newIndices[index] != ~0 )
+          {
+            active.setBit( newIndices[index], m_active.getBit( index ) );
+            visible.setBit( newIndices[index], m_visible.getBit( index ) );
+          }
+        }
+        m_active = active;
+        m_visible = visible;
+        m_changedObjects.resize( numberOfObjects );
+        m_changedObjects.clear();
+
+        // the published frames still use the old indices
+        m_refresh = true;
+      }
+
+      void SceneTreeSnapshot::onNotify( dp::util::Event const & event, dp::util::Payload * payload )
+      {
+        SceneTree::Event const & eventObject = static_cast<SceneTree::Event const&>(event);
+        ObjectTreeIndex index = eventObject.getIndex();
+
+        switch ( eventObject.getType() )
+        {
+        case SceneTree::Event::Type::ADDED:
+          setChangedObject( index );
+          m_active.setBit( index, eventObject.getNode().m_worldActive );
+          m_visible.enableBit( index );
+          break;
+
+        case SceneTree::Event::Type::REMOVED:
+          setChangedObject( index );
+          m_active.disableBit( index );
+          break;
+
+        case SceneTree::Event::Type::ACTIVE_CHANGED:
+          setChangedObject( index );
+          m_active.setBit( index, eventObject.getNode().m_worldActive );
+          break;
+
+        case SceneTree::Event::Type::INDICES_REMAPPED:
+          remapIndices( static_cast<SceneTree::RemapEvent const &>(event).getNewIndices() );
+          break;
+
+        default:
+          break;
+        }
+      }
+
+      void SceneTreeSnapshot::onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload )
+      {
+      }
+
+      void SceneTreeSnapshot::TransformObserver::onNotify( dp::util::Event const & event, dp::util::Payload * payload )
+      {
+        TransformTree::EventTransform const & eventTransform = static_cast<TransformTree::EventTransform const&>(event);
+        dp::util::BitArray const & changedWorldMatrices = eventTransform.getChangedWorldMatrices();
+
+        // update may be called more than once per publish, collect the changes of all calls
+        dp::util::BitArray & pending = m_snapshot.m_changedWorldMatrices;
+        if ( pending.getSize() != changedWorldMatrices.getSize() )
+        {
+          pending.resize( changedWorldMatrices.getSize() );
+        }
+        pending |= changedWorldMatrices;
+      }
+
+      void SceneTreeSnapshot::TransformObserver::onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload )
+      {
+      }
+
+    } // namespace xbar
+  } // namespace sg
+} // namespace dp
@@ -26,6 +26,7 @@
 
 #include <dp/sg/xbar/inc/SwitchObserver.h>
 #include <dp/sg/core/Switch.h>
+#include <algorithm>
 
 namespace dp
 {
@@ -43,20 +44,43 @@ namespace dp
 
         if( s->getHints(dp::sg::core::Object::DP_SG_HINT_DYNAMIC) )
         {
-          m_dirtySwitches.insert( index );
+          markDirty( index );
         }
       }
 
       void SwitchObserver::onDetach( ObjectTreeIndex index )
       {
-        // remove from dirty switches indexset
-        ObjectTreeIndexSet::iterator it = m_dirtySwitches.find( index );
-        if ( it != m_dirtySwitches.end() )
+        // remove from dirty switches
+        if ( index < m_dirtySwitches.getSize() )
         {
-          m_dirtySwitches.erase( it );
+          m_dirtySwitches.disableBit( index );
         }
       }
 
+      void SwitchObserver::onRemapIndices( std::vector<ObjectTreeIndex> const & newIndices )
+      {
+        // compacting never increases an index, the new indices fit into an array of the old size
+        dp::util::BitArray dirtySwitches( newIndices.size() );
+        m_dirtySwitches.traverseBits( [&]( size_t index )
+        {
+          if ( newIndices[index] != ~0 )
+          {
+            dirtySwitches.enableBit( newIndices[index] );
+          }
+        } );
+        m_dirtySwitches = dirtySwitches;
+      }
+
+      void SwitchObserver::markDirty( ObjectTreeIndex index )
+      {
+        if ( m_dirtySwitches.getSize() <= index )
+        {
+          m_dirtySwitches.resize( std::max( size_t(index) + 1, 2 * m_dirtySwitches.getSize() ) );
+        }
+        m_dirtySwitches.enableBit( index );
+        m_changed = true;
+      }
+
       void SwitchObserver::onNotify( const dp::util::Event &event, dp::util::Payload *payload )
       {
         switch ( event.getType() )
@@ -67,7 +91,7 @@ namespace dp
 
             if( propertyEvent.getPropertyId() == dp::sg::core::Switch::PID_ActiveSwitchMask )
             {
-                m_dirtySwitches.insert( static_cast<SwitchObserverPayload*>(payload)->m_index );
+                markDirty( static_cast<SwitchObserverPayload*>(payload)->m_index );
             }
           }
           break;
@@ -63,6 +63,20 @@ namespace dp
         }
       }
 
+      void TransformObserver::onNotifyBatch( dp::util::Notification const * notifications, size_t numberOfNotifications )
+      {
+        // a batch contains the matrix changes of many transforms, mark them without a virtual call per event
+        for ( size_t index = 0; index < numberOfNotifications; ++index )
+        {
+          dp::util::Event const & event = *notifications[index].event;
+          if ( event.getType() == dp::util::Event::Type::PROPERTY
+            && static_cast<dp::util::Reflection::PropertyEvent const&>(event).getPropertyId() == dp::sg::core::Transform::PID_Matrix )
+          {
+            m_dirtyTransforms.enableBit( static_cast<DirtyPayload*>(notifications[index].payload)->m_index );
+          }
+        }
+      }
+
     } // namespace xbar
   } // namespace sg
 } // namespace dp
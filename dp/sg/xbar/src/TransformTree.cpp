@@ -27,6 +27,11 @@
 #include <dp/sg/xbar/inc/TransformObserver.h>
 #include <dp/sg/core/Transform.h>
 #include <dp/sg/core/Billboard.h>
+#include <algorithm>
+
+#if defined(DP_ARCH_X86_64)
+#include <emmintrin.h>
+#endif
 
 namespace dp
 {
@@ -38,10 +43,110 @@ namespace dp
       namespace
       {
         const size_t VectorGrowth = 65536;
+
+        // Minimum number of entries per thread. Smaller levels are computed on the calling thread.
+        const size_t minEntriesPerTask = 4096;
+
+        /** \brief Compute result = a * b. The SSE version evaluates each element like the Mat44f multiplication of dp::math,
+                   a0*b0 + a1*b1 + a2*b2 + a3*b3 from left to right, and thus produces the same result as long as the compiler
+                   does not contract the scalar code into fused multiply-adds.
+        **/
+        inline void multiply(dp::math::Mat44f const & a, dp::math::Mat44f const & b, dp::math::Mat44f & result)
+        {
+#if defined(DP_ARCH_X86_64)
+          __m128 b0 = _mm_loadu_ps(&b[0][0]);
+          __m128 b1 = _mm_loadu_ps(&b[1][0]);
+          __m128 b2 = _mm_loadu_ps(&b[2][0]);
+          __m128 b3 = _mm_loadu_ps(&b[3][0]);
+          for (unsigned int row = 0; row < 4; ++row)
+          {
+            __m128 r = _mm_mul_ps(_mm_set1_ps(a[row][0]), b0);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row][1]), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row][2]), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row][3]), b3));
+            _mm_storeu_ps(&result[row][0], r);
+          }
+#else
+          result = a * b;
+#endif
+        }
+
+        template <typename Entry>
+        inline bool compareTransformIndex(Entry const & lhs, Entry const & rhs)
+        {
+          return lhs.transform < rhs.transform;
+        }
+
+        //! \brief Store the position of each entry starting at begin in the info of its transform
+        template <typename Entries, typename Infos>
+        inline void updateEntryPositions(Entries const & entries, size_t begin, Infos & infos)
+        {
+          for (size_t index = begin; index < entries.size(); ++index)
+          {
+            infos[entries[index].transform].entry = checked_cast<uint32_t>(index);
+          }
+        }
+
+        /** \brief Remove all entries whose transform index is marked as free, keeping the order of the remaining entries.
+            \return The position of the first removed entry or the size of the entries if none has been removed.
+        **/
+        template <typename Entries>
+        inline size_t removeFreeEntries(Entries & entries, dp::util::BitArray const & freeVector)
+        {
+          size_t first = 0;
+          while (first < entries.size() && !freeVector.getBit(entries[first].transform))
+          {
+            ++first;
+          }
+
+          size_t count = first;
+          for (size_t index = first; index < entries.size(); ++index)
+          {
+            if (!freeVector.getBit(entries[index].transform))
+            {
+              entries[count++] = std::move(entries[index]);
+            }
+          }
+          entries.resize(count);
+          return first;
+        }
+
+        /** \brief Call task(begin, end) for ranges of the entries, which are sorted by their transform index. Each range ends at a
+                   boundary of the words of a BitArray, thus each task owns the words of the dirty bits of its transforms.
+        **/
+        template <typename Entries, typename Task>
+        void executeEntries(dp::util::ThreadPool * threadPool, Entries const & entries, Task const & task)
+        {
+          size_t const count = entries.size();
+          if (!threadPool || count < 2 * minEntriesPerTask)
+          {
+            task(0, count);
+            return;
+          }
+
+          size_t const bitsPerWord = sizeof(dp::util::BitArray::BitStorageType) * 8;
+          size_t const numberOfTasks = std::min(size_t(threadPool->getNumberOfThreads()), count / minEntriesPerTask);
+          auto getBoundary = [&](size_t task)
+          {
+            size_t boundary = task * count / numberOfTasks;
+            while (0 < boundary && boundary < count && entries[boundary].transform / bitsPerWord == entries[boundary - 1].transform / bitsPerWord)
+            {
+              ++boundary;
+            }
+            return boundary;
+          };
+
+          threadPool->execute(numberOfTasks, [&](size_t index)
+          {
+            task(getBoundary(index), getBoundary(index + 1));
+          });
+        }
       }
 
       TransformTree::TransformTree()
-        : m_firstCompute(true)
+        : m_firstFreeIndex(1)
+        , m_computeIncarnation(0)
+        , m_firstCompute(true)
       {
         resizeDataStructures(VectorGrowth);
 
@@ -68,6 +173,7 @@ namespace dp
         TransformIndex newIndex = allocateIndex();
         m_transformInfos[newIndex].object = transform;
         m_transformInfos[newIndex].level = m_transformInfos[parentIndex].level + 1;
+        m_transformInfos[newIndex].isBillboard = false;
         m_dirtyTransforms.enableBit(newIndex);
 
         m_transformObserver->attach(transform, newIndex);
@@ -77,8 +183,10 @@ namespace dp
           m_transformLevels.resize(m_transformInfos[newIndex].level + 1);
         }
 
-        // TODO add parent info or entry to this list in transform info?
-        m_transformLevels[m_transformInfos[newIndex].level].transformListEntries.push_back(TransformListEntry { parentIndex, newIndex });
+        TransformLevel &level = m_transformLevels[m_transformInfos[newIndex].level];
+        level.sorted = level.sorted && (level.transformListEntries.empty() || level.transformListEntries.back().transform < newIndex);
+        m_transformInfos[newIndex].entry = checked_cast<uint32_t>(level.transformListEntries.size());
+        level.transformListEntries.push_back(TransformListEntry { parentIndex, newIndex });
 
         return newIndex;
       }
@@ -90,19 +198,13 @@ namespace dp
           throw std::runtime_error("TransformTree::removeTransform: Transform does not exist");
         }
 
-        // TODO store position in array in offset for efficient removal
-        TransformLevel &level = m_transformLevels[m_transformInfos[transformIndex].level];
-        for (size_t index = 0;index < level.transformListEntries.size();++index)
-        {
-          if (level.transformListEntries[index].transform == transformIndex)
-          {
-            level.transformListEntries[index] = level.transformListEntries.back();
-            level.transformListEntries.pop_back();
-          }
-        }
+        DP_ASSERT(!m_transformInfos[transformIndex].isBillboard);
+        removeEntry(transformIndex);
 
         m_transformObserver->detach(transformIndex);
 
+        // a transform which changed since the last compute must not be updated anymore
+        m_dirtyTransforms.disableBit(transformIndex);
         freeIndex(transformIndex);
 
         // this is slower than necessary depending on what should be cleared
@@ -120,14 +222,17 @@ namespace dp
         TransformIndex newIndex = allocateIndex();
         m_transformInfos[newIndex].object = billboard;
         m_transformInfos[newIndex].level = m_transformInfos[parentIndex].level + 1;
+        m_transformInfos[newIndex].isBillboard = true;
 
         if (m_transformLevels.size() <= m_transformInfos[newIndex].level)
         {
           m_transformLevels.resize(m_transformInfos[newIndex].level + 1);
         }
 
-        // TODO add parent info or entry to this list in transform info?
-        m_transformLevels[m_transformInfos[newIndex].level].billboardListEntries.push_back(BillboardListEntry{ parentIndex, newIndex });
+        TransformLevel &level = m_transformLevels[m_transformInfos[newIndex].level];
+        level.sorted = level.sorted && (level.billboardListEntries.empty() || level.billboardListEntries.back().transform < newIndex);
+        m_transformInfos[newIndex].entry = checked_cast<uint32_t>(level.billboardListEntries.size());
+        level.billboardListEntries.push_back(BillboardListEntry{ parentIndex, newIndex, billboard });
 
         return newIndex;
       }
@@ -139,31 +244,112 @@ namespace dp
           throw std::runtime_error("TransformTree::removeTransform: Transform does not exist");
         }
 
-        // TODO store position in array in offset for efficient removal
-        TransformLevel &level = m_transformLevels[m_transformInfos[billboardIndex].level];
-        for (size_t index = 0; index < level.billboardListEntries.size(); ++index)
+        DP_ASSERT(m_transformInfos[billboardIndex].isBillboard);
+        removeEntry(billboardIndex);
+
+        freeIndex(billboardIndex);
+
+        // this is slower than necessary depending on what should be cleared
+        m_transformInfos[billboardIndex] = TransformInfo();
+      }
+
+      void TransformTree::removeEntry(TransformIndex transformIndex)
+      {
+        TransformInfo const & info = m_transformInfos[transformIndex];
+        TransformLevel &level = m_transformLevels[info.level];
+        if (info.isBillboard)
         {
-          if (level.billboardListEntries[index].transform == billboardIndex)
+          DP_ASSERT(level.billboardListEntries[info.entry].transform == transformIndex);
+          if (info.entry + 1 != level.billboardListEntries.size())
           {
-            level.billboardListEntries[index] = level.billboardListEntries.back();
-            level.billboardListEntries.pop_back();
+            level.billboardListEntries[info.entry] = std::move(level.billboardListEntries.back());
+            m_transformInfos[level.billboardListEntries[info.entry].transform].entry = info.entry;
+            level.sorted = false;
           }
+          level.billboardListEntries.pop_back();
         }
+        else
+        {
+          DP_ASSERT(level.transformListEntries[info.entry].transform == transformIndex);
+          if (info.entry + 1 != level.transformListEntries.size())
+          {
+            level.transformListEntries[info.entry] = std::move(level.transformListEntries.back());
+            m_transformInfos[level.transformListEntries[info.entry].transform].entry = info.entry;
+            level.sorted = false;
+          }
+          level.transformListEntries.pop_back();
+        }
+      }
 
-        freeIndex(billboardIndex);
+      void TransformTree::removeTransforms(std::vector<TransformIndex> const & transformIndices)
+      {
+        for (size_t index = 0; index < transformIndices.size(); ++index)
+        {
+          if (!isValidIndex(transformIndices[index]))
+          {
+            throw std::runtime_error("TransformTree::removeTransforms: Transform does not exist");
+          }
+        }
 
-        // this is slower than necessary depending on what should be cleared
-        m_transformInfos[billboardIndex] = TransformInfo();
+        // free the indices first, the entries of the affected levels are then identified by their free transform index
+        std::vector<size_t> removedEntries(m_transformLevels.size(), 0);
+        for (size_t index = 0; index < transformIndices.size(); ++index)
+        {
+          TransformIndex transformIndex = transformIndices[index];
+          if (m_transformFreeVector.getBit(transformIndex))
+          {
+            // the index has been passed twice
+            continue;
+          }
+
+          TransformInfo & info = m_transformInfos[transformIndex];
+          ++removedEntries[info.level];
+          if (!info.isBillboard)
+          {
+            m_transformObserver->detach(transformIndex);
+            m_dirtyTransforms.disableBit(transformIndex);
+          }
+          freeIndex(transformIndex);
+          info = TransformInfo();
+        }
+
+        for (size_t levelIndex = 0; levelIndex < m_transformLevels.size(); ++levelIndex)
+        {
+          if (removedEntries[levelIndex])
+          {
+            TransformLevel & level = m_transformLevels[levelIndex];
+            updateEntryPositions(level.transformListEntries, removeFreeEntries(level.transformListEntries, m_transformFreeVector), m_transformInfos);
+            updateEntryPositions(level.billboardListEntries, removeFreeEntries(level.billboardListEntries, m_transformFreeVector), m_transformInfos);
+          }
+        }
       }
 
       TransformIndex TransformTree::allocateIndex()
       {
-        TransformIndex newIndex = checked_cast<TransformIndex>(m_transformFreeVector.countLeadingZeroes());
-        if (newIndex == m_transformFreeVector.getSize()) {
-          resizeDataStructures(m_transformFreeVector.getSize() + VectorGrowth);
+        // all indices below m_firstFreeIndex are in use, search the lowest free index from there. Skip whole words of
+        // occupied indices, after removing a batch of transforms the free indices might be far apart.
+        size_t size = m_transformFreeVector.getSize();
+        size_t const bitsPerWord = dp::util::BitArray::StorageBitsPerElement;
+        dp::util::BitArray::BitStorageType const * bits = m_transformFreeVector.getBits();
+        while (m_firstFreeIndex < size)
+        {
+          dp::util::BitArray::BitStorageType word = bits[m_firstFreeIndex / bitsPerWord] >> (m_firstFreeIndex % bitsPerWord);
+          if (word)
+          {
+            m_firstFreeIndex = std::min(size, m_firstFreeIndex + dp::util::ctz(word));
+            break;
+          }
+          m_firstFreeIndex = (m_firstFreeIndex / bitsPerWord + 1) * bitsPerWord;
+        }
+        m_firstFreeIndex = std::min(m_firstFreeIndex, size);
+
+        TransformIndex newIndex = checked_cast<TransformIndex>(m_firstFreeIndex);
+        if (newIndex == size) {
+          resizeDataStructures(size + VectorGrowth);
         }
 
         m_transformFreeVector.disableBit(newIndex);
+        ++m_firstFreeIndex;
 
         return newIndex;
       }
@@ -171,6 +357,23 @@ namespace dp
       void TransformTree::freeIndex(TransformIndex transformIndex)
       {
         m_transformFreeVector.enableBit(transformIndex);
+        m_firstFreeIndex = std::min(m_firstFreeIndex, size_t(transformIndex));
+      }
+
+      void TransformTree::reserve(size_t numberOfTransforms)
+      {
+        // grow in the same steps as allocateIndex
+        size_t size = m_transformFreeVector.getSize();
+        size_t newSize = size;
+        while (newSize < m_firstFreeIndex + numberOfTransforms)
+        {
+          newSize += VectorGrowth;
+        }
+
+        if (newSize != size)
+        {
+          resizeDataStructures(newSize);
+        }
       }
 
       void TransformTree::resizeDataStructures(size_t newSize)
@@ -180,45 +383,96 @@ namespace dp
         m_dirtyWorldMatrices.resize(newSize, false);
         m_transforms.resize(newSize);
         m_transformInfos.resize(newSize);
+        m_worldIncarnations.resize(newSize, 0);
+      }
+
+      void TransformTree::setNumberOfThreads(unsigned int numberOfThreads)
+      {
+        if (numberOfThreads == 0)
+        {
+          numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        if (numberOfThreads != getNumberOfThreads())
+        {
+          m_threadPool.reset(numberOfThreads > 1 ? new dp::util::ThreadPool(numberOfThreads) : nullptr);
+        }
+      }
+
+      unsigned int TransformTree::getNumberOfThreads() const
+      {
+        return m_threadPool ? m_threadPool->getNumberOfThreads() : 1;
       }
 
       void TransformTree::compute(dp::sg::core::CameraSharedPtr const & camera)
       {
         m_dirtyWorldMatrices.clear();
+
+        // a world matrix has changed in this compute call if its incarnation matches the current one
+        if (++m_computeIncarnation == 0)
+        {
+          std::fill(m_worldIncarnations.begin(), m_worldIncarnations.end(), 0);
+          m_computeIncarnation = 1;
+        }
+        uint32_t const incarnation = m_computeIncarnation;
+
         if (m_firstCompute) {
           // after first iteration world matrix 0 is dirty
           m_dirtyWorldMatrices.enableBit(0);
+          m_worldIncarnations[0] = incarnation;
           m_firstCompute = false;
         }
         m_dirtyTransforms.traverseBits([&](size_t index)
         {
             m_transforms[index].local = std::static_pointer_cast<dp::sg::core::Transform>(m_transformInfos[index].object)->getMatrix();
             m_dirtyWorldMatrices.enableBit(index);
+            m_worldIncarnations[index] = incarnation;
         } );
 
-        for (TransformLevel const &transformLevel : m_transformLevels)
+        for (TransformLevel &transformLevel : m_transformLevels)
         {
-          // update billboards
-          for (BillboardListEntry const &billboardEntry : transformLevel.billboardListEntries)
+          if (!transformLevel.sorted)
           {
-            dp::math::Mat44f parentMatrix = m_transforms[billboardEntry.parent].world;
-            parentMatrix.invert();
-            dp::math::Trafo t = std::static_pointer_cast<dp::sg::core::Billboard>(m_transformInfos[billboardEntry.transform].object)->getTrafo(camera, parentMatrix);
-            m_transforms[billboardEntry.transform].local = t.getMatrix();
-
-            m_transforms[billboardEntry.transform].world = m_transforms[billboardEntry.transform].local * m_transforms[billboardEntry.parent].world;
-            m_dirtyWorldMatrices.enableBit(billboardEntry.transform);
+            std::sort(transformLevel.transformListEntries.begin(), transformLevel.transformListEntries.end(), compareTransformIndex<TransformListEntry>);
+            std::sort(transformLevel.billboardListEntries.begin(), transformLevel.billboardListEntries.end(), compareTransformIndex<BillboardListEntry>);
+            updateEntryPositions(transformLevel.transformListEntries, 0, m_transformInfos);
+            updateEntryPositions(transformLevel.billboardListEntries, 0, m_transformInfos);
+            transformLevel.sorted = true;
           }
 
+          // update billboards
+          BillboardListEntries const & billboardEntries = transformLevel.billboardListEntries;
+          executeEntries(m_threadPool.get(), billboardEntries, [&](size_t begin, size_t end)
+          {
+            for (size_t index = begin; index < end; ++index)
+            {
+              BillboardListEntry const &billboardEntry = billboardEntries[index];
+              dp::math::Mat44f parentMatrix = m_transforms[billboardEntry.parent].world;
+              parentMatrix.invert();
+              dp::math::Trafo t = std::static_pointer_cast<dp::sg::core::Billboard>(m_transformInfos[billboardEntry.transform].object)->getTrafo(camera, parentMatrix);
+              m_transforms[billboardEntry.transform].local = t.getMatrix();
+
+              multiply(m_transforms[billboardEntry.transform].local, m_transforms[billboardEntry.parent].world, m_transforms[billboardEntry.transform].world);
+              m_dirtyWorldMatrices.enableBit(billboardEntry.transform);
+              m_worldIncarnations[billboardEntry.transform] = incarnation;
+            }
+          });
+
           // update transforms
-          for (TransformListEntry const &transformEntry : transformLevel.transformListEntries)
+          TransformListEntries const & transformEntries = transformLevel.transformListEntries;
+          executeEntries(m_threadPool.get(), transformEntries, [&](size_t begin, size_t end)
           {
-            if (m_dirtyWorldMatrices.getBit(transformEntry.parent) || m_dirtyWorldMatrices.getBit(transformEntry.transform))
+            for (size_t index = begin; index < end; ++index)
             {
-              m_transforms[transformEntry.transform].world = m_transforms[transformEntry.transform].local * m_transforms[transformEntry.parent].world;
-              m_dirtyWorldMatrices.enableBit(transformEntry.transform);
+              TransformListEntry const &transformEntry = transformEntries[index];
+              if (m_worldIncarnations[transformEntry.parent] == incarnation || m_worldIncarnations[transformEntry.transform] == incarnation)
+              {
+                multiply(m_transforms[transformEntry.transform].local, m_transforms[transformEntry.parent].world, m_transforms[transformEntry.transform].world);
+                m_dirtyWorldMatrices.enableBit(transformEntry.transform);
+                m_worldIncarnations[transformEntry.transform] = incarnation;
+              }
             }
-          }
+          });
         }
 
         notify(EventTransform(m_dirtyWorldMatrices));
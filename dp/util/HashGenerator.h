@@ -38,6 +38,23 @@ namespace dp
 
     typedef unsigned int HashKey;
 
+    /*! \brief A 128 bit hash value, as created by HashGeneratorMurMur3. */
+    struct HashKey128
+    {
+      unsigned long long low;
+      unsigned long long high;
+    };
+
+    inline bool operator==( HashKey128 const& lhs, HashKey128 const& rhs )
+    {
+      return( lhs.low == rhs.low && lhs.high == rhs.high );
+    }
+
+    inline bool operator!=( HashKey128 const& lhs, HashKey128 const& rhs )
+    {
+      return( !( lhs == rhs ) );
+    }
+
     /*! \brief HashGenerator is the interface defining class for creating a hash out of some arbitrary data.
      *  \par Namespace: dp::util */
     class HashGenerator
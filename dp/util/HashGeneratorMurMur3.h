@@ -0,0 +1,83 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Implementation of MurmurHash3 (x64, 128 bit) by Austin Appleby.
+#pragma once
+
+#include <dp/util/HashGenerator.h>
+#include <cstdint>
+
+namespace dp
+{
+  namespace util
+  {
+
+    /*! \brief HashGenerator creating a 128 bit hash.
+     *  \remarks The generator processes the data in blocks of 16 bytes with two independent 64 bit lanes, which is several
+     *  times faster than HashGeneratorMurMur on large inputs. The hash is written as a HashKey128 by finalize( void * ).
+     *  \par Namespace: dp::util */
+    class HashGeneratorMurMur3 : public HashGenerator
+    {
+      public:
+        DP_UTIL_API HashGeneratorMurMur3( unsigned int seed = 0 );
+        DP_UTIL_API virtual ~HashGeneratorMurMur3();
+
+        // import non-virtual update signature
+        using HashGenerator::update;
+
+        // update the hash with the input
+        DP_UTIL_API void update( const unsigned char * input, unsigned int byteCount );
+
+        // get the size of the hash value
+        DP_UTIL_API virtual unsigned int getSizeOfHash() const;
+
+        // do the final hash calculation and get the hash value
+        DP_UTIL_API virtual void finalize( void * hash );
+
+        DP_UTIL_API std::string finalize();
+
+        /*! \brief Hash a contiguous block of memory.
+         *  \param input A pointer to the constant data to hash.
+         *  \param byteCount The number of bytes to process at \a input.
+         *  \param hash The resulting hash.
+         *  \remarks Large blocks are split into chunks of a fixed size, which are hashed in parallel on a shared thread pool,
+         *  or on the calling thread while another thread uses the pool. The hash of the block is the hash of the chunk hashes. The result is independent of the number of threads, but differs from the
+         *  result of update and finalize on the same data. */
+        DP_UTIL_API static void hashTree( const unsigned char * input, size_t byteCount, HashKey128 & hash );
+
+      private:
+        void processBlocks( const unsigned char * input, size_t numberOfBlocks );
+
+        std::uint64_t m_h1;
+        std::uint64_t m_h2;
+        std::uint64_t m_size;
+        unsigned char m_tail[16];
+        unsigned int  m_tailSize;
+        unsigned int  m_seed;
+    };
+
+  } // namespace util
+} // namespace dp
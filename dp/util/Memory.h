@@ -28,6 +28,9 @@
 
 #include <dp/util/Config.h>
 #include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
 
 namespace dp
 {
@@ -45,7 +48,78 @@ namespace dp
      *  \remarks The result is undefined if src and dst overlap.
      **/
     DP_UTIL_API void stridedMemcpy( void *dst, size_t dstOffset, size_t dstStride, const void *src, size_t srcOffset, size_t srcStride, size_t elementSize, size_t elementCount );
-    
+
+    /** \brief Allocate a block of memory with the given alignment
+     *  \param size Number of bytes to allocate
+     *  \param alignment Alignment of the block in bytes. Must be a power of two and a multiple of sizeof(void*).
+     *  \return Pointer to the allocated block or nullptr if the allocation failed.
+     *  \remarks The returned block must be freed with alignedFree.
+     **/
+    DP_UTIL_API void* alignedMalloc( size_t size, size_t alignment );
+
+    /** \brief Free a block of memory allocated by alignedMalloc **/
+    DP_UTIL_API void alignedFree( void* ptr );
+
+    /** \brief Standard conforming allocator which returns memory aligned to Alignment bytes.
+     *  \remarks Use this allocator for std::vector storage which is being accessed by SSE/AVX loads and stores.
+     **/
+    template <typename T, size_t Alignment>
+    class AlignedAllocator
+    {
+    public:
+      typedef T         value_type;
+      typedef T*        pointer;
+      typedef T const*  const_pointer;
+      typedef T&        reference;
+      typedef T const&  const_reference;
+      typedef size_t    size_type;
+      typedef ptrdiff_t difference_type;
+
+      template <typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+      AlignedAllocator() {}
+      template <typename U> AlignedAllocator( AlignedAllocator<U, Alignment> const & ) {}
+
+      pointer allocate( size_type count, void const* = nullptr )
+      {
+        if ( count > max_size() )
+        {
+          throw std::bad_alloc();
+        }
+        void* ptr = alignedMalloc( count * sizeof(T), Alignment );
+        if ( !ptr && count )
+        {
+          throw std::bad_alloc();
+        }
+        return static_cast<pointer>(ptr);
+      }
+
+      void deallocate( pointer ptr, size_type )
+      {
+        alignedFree( ptr );
+      }
+
+      size_type max_size() const
+      {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+      }
+
+      template <typename U, typename... Args>
+      void construct( U* ptr, Args&&... args )
+      {
+        ::new(static_cast<void*>(ptr)) U( std::forward<Args>(args)... );
+      }
+
+      template <typename U>
+      void destroy( U* ptr )
+      {
+        ptr->~U();
+      }
+
+      template <typename U> bool operator==( AlignedAllocator<U, Alignment> const & ) const { return true; }
+      template <typename U> bool operator!=( AlignedAllocator<U, Alignment> const & ) const { return false; }
+    };
+
   } // namespace util
 } // namespace dp
 
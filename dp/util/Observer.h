@@ -28,6 +28,7 @@
 
 #include <dp/util/Config.h>
 #include <dp/util/PointerTypes.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -37,6 +38,7 @@ namespace dp
   {
     class Subject;
     class Observer;
+    class NotificationBatch;
 
     class Payload : public std::enable_shared_from_this<Payload>
     {
@@ -60,6 +62,18 @@ namespace dp
       virtual~ Event() {}
       Type getType() const { return m_eventType; }
 
+      /** \brief Check if the event can be deferred by a NotificationBatch. Events which only signal that a state of the subject
+                 has changed can be deferred, all other events are delivered immediately. The deferred events of a subject with
+                 the same type and key are coalesced into one.
+          \param subject The subject notifying the event.
+          \param key Receives the key of a deferrable event.
+          \return true if the event can be deferred.
+      **/
+      virtual bool getCoalescingKey( Subject const & /* subject */, size_t & /* key */ ) const { return false; }
+
+      /** \brief Create a copy of a deferrable event to be delivered when the NotificationBatch ends. **/
+      virtual Event * clone() const { return nullptr; }
+
       Event( Type type = Type::GENERIC )
         : m_eventType( type )
       {
@@ -75,8 +89,8 @@ namespace dp
       // Do not copy the list of observers during copy/assignment.
       // The observers won't know about the 'new' attachment and thus
       // it cannot detach itself;
-      Subject() : m_inNotify(false) {}
-      Subject( Subject const& ) : m_inNotify(false) {}
+      Subject() : m_inNotify(false), m_batch(nullptr), m_batchIndex(0) {}
+      Subject( Subject const& ) : m_inNotify(false), m_batch(nullptr), m_batchIndex(0) {}
       Subject& operator=( const Subject& /* rhs */ ) { return *this; }
 
       DP_UTIL_API virtual ~Subject();
@@ -93,18 +107,90 @@ namespace dp
       typedef std::vector<ObserverEntry> Observers;
 
     private:
+      friend class NotificationBatch;
+
       Observers m_observers;
-      bool      m_inNotify;
+      bool                m_inNotify;
+      NotificationBatch * m_batch;        // the batch holding the deferred events, nullptr if no events are deferred
+      uint32_t            m_batchIndex;   // 1 + position in m_batch
     };
 
     DEFINE_PTR_TYPES( Subject );
 
 
+    /** \brief An event deferred by a NotificationBatch together with the payload the observer has been attached with. **/
+    struct Notification
+    {
+      Event const * event;
+      Payload *     payload;
+    };
+
     class Observer
     {
     public:
       DP_UTIL_API virtual void onNotify( dp::util::Event const & event, dp::util::Payload * payload ) = 0;
       DP_UTIL_API virtual void onDestroyed( dp::util::Subject const & subject, dp::util::Payload * payload ) = 0;
+
+      /** \brief Called once per NotificationBatch with the deferred events of all subjects the observer is attached to.
+                 The default implementation calls onNotify for each event. Override it to process the events in bulk.
+      **/
+      DP_UTIL_API virtual void onNotifyBatch( Notification const * notifications, size_t numberOfNotifications );
+    };
+
+
+    /** \brief NotificationBatch suspends the notifications on the calling thread while it exists. Events which can be deferred
+               according to Event::getCoalescingKey are collected per subject, repeated events of a subject are coalesced into one. When the outermost batch of
+               the thread is destroyed, each observer gets the collected events of all its subjects in a single onNotifyBatch call.
+               All other events are delivered immediately and may therefore reach the observers before earlier deferred events.
+        \remarks Use a batch around bulk edits, e.g. setting the matrices of many transforms. Observers must not detach from or
+                 destroy the subjects of the batch while the deferred events are delivered. A subject with deferred events must only
+                 be notified and destroyed on the thread of the batch until the batch has ended, as the batch is not synchronized.
+    **/
+    class NotificationBatch
+    {
+    public:
+      DP_UTIL_API NotificationBatch();
+      DP_UTIL_API ~NotificationBatch();
+
+    private:
+      friend class Subject;
+
+      NotificationBatch( NotificationBatch const & );
+      NotificationBatch & operator=( NotificationBatch const & );
+
+      // returns false if the event has to be delivered immediately
+      bool defer( Subject & subject, Event const & event );
+      void remove( Subject & subject );
+      void flush();
+
+    private:
+      struct EventKey
+      {
+        Event::Type type;
+        size_t      key;
+      };
+
+      enum { numberOfInlineEventKeys = 2 };
+
+      struct SubjectEntry
+      {
+        Subject * subject;                        // nullptr if the subject has been destroyed
+        uint32_t  firstEvent;
+        uint32_t  numberOfEvents;
+        EventKey  keys[numberOfInlineEventKeys];  // keys of the first events
+      };
+
+      struct EventEntry
+      {
+        EventKey  key;
+        Event *   event;
+        uint32_t  nextEvent;
+      };
+
+      bool                      m_outermost;
+      bool                      m_flushing;
+      std::vector<SubjectEntry> m_subjects;
+      std::vector<EventEntry>   m_events;
     };
 
 
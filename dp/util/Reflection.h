@@ -1180,6 +1180,16 @@ namespace dp
 
       Reflection const* getSource() const { return m_source; }
       dp::util::PropertyId getPropertyId() const { return m_propertyId; }
+
+      // property events of the subject itself can be deferred, events forwarded from other objects are delivered immediately
+      virtual bool getCoalescingKey( dp::util::Subject const & subject, size_t & key ) const
+      {
+        key = reinterpret_cast<size_t>(m_propertyId);
+        return( m_source == &subject );
+      }
+
+      virtual dp::util::Event * clone() const { return new PropertyEvent( m_source, m_propertyId ); }
+
     private:
       Reflection const*    m_source;
       dp::util::PropertyId m_propertyId;
@@ -0,0 +1,97 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <dp/util/Config.h>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dp
+{
+  namespace util
+  {
+
+    /** \brief Fixed size pool of worker threads to execute data parallel loops.
+        \remarks The calling thread participates in the work. Thus a pool with n threads starts n - 1 worker threads.
+                 Only one thread may call execute at a time.
+    **/
+    class ThreadPool
+    {
+    public:
+      /** \brief Create a new pool.
+          \param numberOfThreads Total number of threads executing tasks including the calling thread.
+                 0 uses the number of hardware threads.
+      **/
+      DP_UTIL_API ThreadPool( unsigned int numberOfThreads = 0 );
+      DP_UTIL_API ~ThreadPool();
+
+      /** \brief Number of threads executing tasks including the calling thread **/
+      unsigned int getNumberOfThreads() const;
+
+      /** \brief Call task(index) for each index in [0, numberOfTasks) and return once all tasks have been completed.
+          \remarks The order of execution and the thread executing a task are undefined. Tasks must not throw.
+      **/
+      DP_UTIL_API void execute( size_t numberOfTasks, std::function<void( size_t )> const & task );
+
+      /** \brief Split the range [begin, end) into chunks of at least minChunkSize elements and call task(chunkBegin, chunkEnd)
+                 for each chunk. Chunk boundaries are multiples of granularity relative to begin.
+      **/
+      DP_UTIL_API void executeRange( size_t begin, size_t end, size_t minChunkSize, size_t granularity, std::function<void( size_t, size_t )> const & task );
+
+    private:
+      ThreadPool( ThreadPool const & );
+      ThreadPool & operator=( ThreadPool const & );
+
+      void workerLoop();
+      void processTasks();
+
+    private:
+      std::vector<std::thread>  m_workers;
+
+      std::mutex                m_mutex;
+      std::condition_variable   m_workAvailable;
+      std::condition_variable   m_workDone;
+
+      std::function<void( size_t )> const * m_task;
+      size_t                    m_numberOfTasks;
+      size_t                    m_nextTask;
+      size_t                    m_pendingTasks;
+      size_t                    m_generation;
+      bool                      m_shutdown;
+    };
+
+    inline unsigned int ThreadPool::getNumberOfThreads() const
+    {
+      return static_cast<unsigned int>( m_workers.size() + 1 );
+    }
+
+  } // namespace util
+} // namespace dp
@@ -0,0 +1,119 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/util/CPUFeatures.h>
+
+#if defined(DP_ARCH_X86) || defined(DP_ARCH_X86_64)
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+namespace dp
+{
+  namespace util
+  {
+
+    namespace
+    {
+
+      struct CPUFeatures
+      {
+        CPUFeatures()
+          : sse41( false )
+          , avx2( false )
+        {
+#if defined(DP_ARCH_X86) || defined(DP_ARCH_X86_64)
+          unsigned int leaf1[4] = { 0, 0, 0, 0 };
+          unsigned int leaf7[4] = { 0, 0, 0, 0 };
+          unsigned int maxLeaf = 0;
+
+# if defined(_MSC_VER)
+          int info[4];
+          __cpuid( info, 0 );
+          maxLeaf = info[0];
+          __cpuid( info, 1 );
+          for ( int i = 0;i < 4; ++i ) { leaf1[i] = info[i]; }
+          if ( maxLeaf >= 7 )
+          {
+            __cpuidex( info, 7, 0 );
+            for ( int i = 0;i < 4; ++i ) { leaf7[i] = info[i]; }
+          }
+# else
+          maxLeaf = __get_cpuid_max( 0, nullptr );
+          __get_cpuid( 1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3] );
+          if ( maxLeaf >= 7 )
+          {
+            __cpuid_count( 7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3] );
+          }
+# endif
+
+          sse41 = !!( leaf1[2] & (1 << 19) );
+
+          // AVX requires OSXSAVE and the OS saving the XMM and YMM register state (XCR0 bits 1 and 2)
+          bool osxsave = !!( leaf1[2] & (1 << 27) );
+          bool avx = !!( leaf1[2] & (1 << 28) );
+          if ( osxsave && avx )
+          {
+            unsigned long long xcr0;
+# if defined(_MSC_VER)
+            xcr0 = _xgetbv( 0 );
+# else
+            unsigned int eax, edx;
+            __asm__ __volatile__ ( "xgetbv" : "=a"(eax), "=d"(edx) : "c"(0) );
+            xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+# endif
+            avx2 = ( (xcr0 & 0x6) == 0x6 ) && !!( leaf7[1] & (1 << 5) );
+          }
+#endif
+        }
+
+        bool sse41;
+        bool avx2;
+      };
+
+      CPUFeatures const & getCPUFeatures()
+      {
+        static CPUFeatures features;
+        return features;
+      }
+
+    } // namespace anonymous
+
+    bool isSSE41Supported()
+    {
+      return getCPUFeatures().sse41;
+    }
+
+    bool isAVX2Supported()
+    {
+      return getCPUFeatures().avx2;
+    }
+
+  } // namespace util
+} // namespace dp
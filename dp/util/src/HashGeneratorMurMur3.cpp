@@ -0,0 +1,265 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Implementation of MurmurHash3 (x64, 128 bit) by Austin Appleby.
+
+#include <dp/util/HashGeneratorMurMur3.h>
+#include <dp/util/ThreadPool.h>
+#include <dp/Assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace dp
+{
+  namespace util
+  {
+
+    namespace
+    {
+      std::uint64_t const c1 = 0x87c37b91114253d5ULL;
+      std::uint64_t const c2 = 0x4cf5ad432745937fULL;
+
+      // size of the chunks hashed in parallel by hashTree
+      size_t const chunkSize = 1 << 20;
+
+      // minimum number of chunks to hash on the thread pool
+      size_t const minParallelChunks = 16;
+
+      // Large buffers may be hashed from several threads at once. The first one gets the pool, the others hash their
+      // chunks on their own thread.
+      std::mutex hashThreadPoolMutex;
+
+      ThreadPool * getHashThreadPool()
+      {
+        // never destroyed, as joining the workers during static destruction is not safe on all platforms
+        static ThreadPool * threadPool = ( 1 < std::thread::hardware_concurrency() ) ? new ThreadPool() : nullptr;
+        return( threadPool );
+      }
+
+      inline std::uint64_t rotl( std::uint64_t x, int r )
+      {
+        return ( x << r ) | ( x >> ( 64 - r ) );
+      }
+
+      inline std::uint64_t load( const unsigned char * input )
+      {
+        std::uint64_t k;
+        memcpy( &k, input, sizeof(k) );
+        return k;
+      }
+
+      inline std::uint64_t fmix( std::uint64_t k )
+      {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+      }
+
+      void hashBlock( const unsigned char * input, size_t byteCount, HashKey128 & hash )
+      {
+        HashGeneratorMurMur3 hg;
+        while ( byteCount )
+        {
+          unsigned int count = static_cast<unsigned int>( std::min( byteCount, chunkSize ) );
+          hg.update( input, count );
+          input += count;
+          byteCount -= count;
+        }
+        hg.finalize( &hash );
+      }
+    }
+
+    HashGeneratorMurMur3::HashGeneratorMurMur3( unsigned int seed )
+      : m_h1( seed )
+      , m_h2( seed )
+      , m_size( 0 )
+      , m_tailSize( 0 )
+      , m_seed( seed )
+    {
+    }
+
+    HashGeneratorMurMur3::~HashGeneratorMurMur3()
+    {
+    }
+
+    void HashGeneratorMurMur3::processBlocks( const unsigned char * input, size_t numberOfBlocks )
+    {
+      std::uint64_t h1 = m_h1;
+      std::uint64_t h2 = m_h2;
+      for ( size_t i = 0; i < numberOfBlocks; ++i, input += 16 )
+      {
+        std::uint64_t k1 = load( input );
+        std::uint64_t k2 = load( input + 8 );
+
+        k1 *= c1; k1 = rotl( k1, 31 ); k1 *= c2; h1 ^= k1;
+        h1 = rotl( h1, 27 ); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl( k2, 33 ); k2 *= c1; h2 ^= k2;
+        h2 = rotl( h2, 31 ); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+      }
+      m_h1 = h1;
+      m_h2 = h2;
+    }
+
+    void HashGeneratorMurMur3::update( const unsigned char * input, unsigned int byteCount )
+    {
+      m_size += byteCount;
+
+      // complete a block with the tail of the previous update
+      if ( m_tailSize )
+      {
+        unsigned int count = std::min( byteCount, 16 - m_tailSize );
+        memcpy( m_tail + m_tailSize, input, count );
+        m_tailSize += count;
+        input += count;
+        byteCount -= count;
+        if ( m_tailSize < 16 )
+        {
+          return;
+        }
+        processBlocks( m_tail, 1 );
+        m_tailSize = 0;
+      }
+
+      processBlocks( input, byteCount / 16 );
+
+      m_tailSize = byteCount % 16;
+      memcpy( m_tail, input + ( byteCount - m_tailSize ), m_tailSize );
+    }
+
+    void HashGeneratorMurMur3::finalize( void * hash )
+    {
+      std::uint64_t h1 = m_h1;
+      std::uint64_t h2 = m_h2;
+
+      if ( 8 < m_tailSize )
+      {
+        std::uint64_t k2 = 0;
+        for ( unsigned int i = m_tailSize; 8 < i; --i )
+        {
+          k2 ^= std::uint64_t( m_tail[i - 1] ) << ( ( i - 9 ) * 8 );
+        }
+        k2 *= c2; k2 = rotl( k2, 33 ); k2 *= c1; h2 ^= k2;
+      }
+      if ( m_tailSize )
+      {
+        std::uint64_t k1 = 0;
+        for ( unsigned int i = std::min( m_tailSize, 8u ); 0 < i; --i )
+        {
+          k1 ^= std::uint64_t( m_tail[i - 1] ) << ( ( i - 1 ) * 8 );
+        }
+        k1 *= c1; k1 = rotl( k1, 31 ); k1 *= c2; h1 ^= k1;
+      }
+
+      h1 ^= m_size;
+      h2 ^= m_size;
+
+      h1 += h2;
+      h2 += h1;
+
+      h1 = fmix( h1 );
+      h2 = fmix( h2 );
+
+      h1 += h2;
+      h2 += h1;
+
+      HashKey128 * result = reinterpret_cast<HashKey128*>( hash );
+      result->low = h1;
+      result->high = h2;
+
+      m_h1 = m_seed;
+      m_h2 = m_seed;
+      m_size = 0;
+      m_tailSize = 0;
+    }
+
+    std::string HashGeneratorMurMur3::finalize()
+    {
+      HashKey128 hash;
+      finalize( &hash );
+
+      std::stringstream str;
+      str << std::hex;
+      str.fill( '0' );
+      str.width( 16 );
+      str << hash.high;
+      str.width( 16 );
+      str << hash.low;
+      return str.str();
+    }
+
+    unsigned int HashGeneratorMurMur3::getSizeOfHash() const
+    {
+      return sizeof(HashKey128);
+    }
+
+    void HashGeneratorMurMur3::hashTree( const unsigned char * input, size_t byteCount, HashKey128 & hash )
+    {
+      if ( byteCount <= chunkSize )
+      {
+        hashBlock( input, byteCount, hash );
+        return;
+      }
+
+      size_t numberOfChunks = ( byteCount + chunkSize - 1 ) / chunkSize;
+      std::vector<HashKey128> chunkHashes( numberOfChunks );
+      auto task = [&]( size_t index )
+      {
+        size_t offset = index * chunkSize;
+        hashBlock( input + offset, std::min( chunkSize, byteCount - offset ), chunkHashes[index] );
+      };
+
+      std::unique_lock<std::mutex> lock( hashThreadPoolMutex, std::defer_lock );
+      if ( ( minParallelChunks <= numberOfChunks ) && getHashThreadPool() && lock.try_lock() )
+      {
+        getHashThreadPool()->execute( numberOfChunks, task );
+      }
+      else
+      {
+        for ( size_t index = 0; index < numberOfChunks; ++index )
+        {
+          task( index );
+        }
+      }
+
+      // the root of the tree hashes the chunk hashes and the total size
+      HashGeneratorMurMur3 hg;
+      hg.update( reinterpret_cast<const unsigned char *>( chunkHashes.data() ), static_cast<unsigned int>( numberOfChunks * sizeof(HashKey128) ) );
+      unsigned long long size = byteCount;
+      hg.update( reinterpret_cast<const unsigned char *>( &size ), sizeof(size) );
+      hg.finalize( &hash );
+    }
+
+  } // namespace util
+} // namespace dp
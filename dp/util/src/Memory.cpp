@@ -26,6 +26,11 @@
 
 #include <dp/util/Memory.h>
 #include <cstring>
+#include <cstdlib>
+
+#if defined(DP_OS_WINDOWS)
+#include <malloc.h>
+#endif
 
 namespace dp
 {
@@ -51,5 +56,24 @@ namespace dp
       }
     }
 
+    void* alignedMalloc( size_t size, size_t alignment )
+    {
+#if defined(DP_OS_WINDOWS)
+      return _aligned_malloc( size, alignment );
+#else
+      void* ptr = nullptr;
+      return ( posix_memalign( &ptr, alignment, size ) == 0 ) ? ptr : nullptr;
+#endif
+    }
+
+    void alignedFree( void* ptr )
+    {
+#if defined(DP_OS_WINDOWS)
+      _aligned_free( ptr );
+#else
+      free( ptr );
+#endif
+    }
+
   } // namespace util
 } // namespace dp
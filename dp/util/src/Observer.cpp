@@ -25,14 +25,22 @@
 
 
 #include <dp/util/Observer.h>
+#include <dp/Assert.h>
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace dp
 {
   namespace util
   {
 
+    namespace
+    {
+      // the outermost NotificationBatch of each thread
+      thread_local NotificationBatch * currentBatch = nullptr;
+    }
+
     Payload::~Payload()
     {
     }
@@ -43,6 +51,13 @@ namespace dp
 
     Subject::~Subject()
     {
+      // drop the deferred events from the batch which collected them, which is owned by this thread
+      if ( m_batch )
+      {
+        DP_ASSERT( m_batch == currentBatch && "subject with deferred events destroyed on another thread" );
+        m_batch->remove( *this );
+      }
+
       Observers::iterator it, itEnd = m_observers.end();
 
       for ( it = m_observers.begin(); it != itEnd;++it )
@@ -86,7 +101,7 @@ namespace dp
     {
       // notify the list ob observers, cleaning the list of observers set to nullptr on the way
       // don't clean the list first and notify then, this would mean iterating the list of observers twice
-      if( !m_observers.empty() )
+      if( !m_observers.empty() && !( currentBatch && currentBatch->defer( *this, event ) ) )
       {
         size_t idx;
         size_t last = m_observers.size() - 1;
@@ -133,6 +148,185 @@ namespace dp
       }
     }
 
+    /************************************************************************/
+    /* Observer                                                             */
+    /************************************************************************/
+
+    void Observer::onNotifyBatch( Notification const * notifications, size_t numberOfNotifications )
+    {
+      for ( size_t index = 0; index < numberOfNotifications; ++index )
+      {
+        onNotify( *notifications[index].event, notifications[index].payload );
+      }
+    }
+
+    /************************************************************************/
+    /* NotificationBatch                                                    */
+    /************************************************************************/
+
+    NotificationBatch::NotificationBatch()
+      : m_outermost( !currentBatch )
+      , m_flushing( false )
+    {
+      if ( m_outermost )
+      {
+        currentBatch = this;
+      }
+    }
+
+    NotificationBatch::~NotificationBatch()
+    {
+      if ( m_outermost )
+      {
+        flush();
+        currentBatch = nullptr;
+      }
+    }
+
+    bool NotificationBatch::defer( Subject & subject, Event const & event )
+    {
+      // events raised by the observers while flushing are delivered immediately
+      if ( m_flushing )
+      {
+        return false;
+      }
+
+      size_t key;
+      if ( !event.getCoalescingKey( subject, key ) )
+      {
+        return false;
+      }
+
+      if ( !subject.m_batch )
+      {
+        SubjectEntry subjectEntry = { &subject, ~0u, 0, {} };
+        m_subjects.push_back( subjectEntry );
+        subject.m_batch = this;
+        subject.m_batchIndex = uint32_t(m_subjects.size());
+      }
+      DP_ASSERT( subject.m_batch == this && "subject with deferred events notified on another thread" );
+
+      // the first events of a subject are compared without touching the list of events
+      SubjectEntry & subjectEntry = m_subjects[subject.m_batchIndex - 1];
+      EventKey eventKey = { event.getType(), key };
+      uint32_t numberOfInlineKeys = std::min( subjectEntry.numberOfEvents, uint32_t(numberOfInlineEventKeys) );
+      for ( uint32_t index = 0; index < numberOfInlineKeys; ++index )
+      {
+        if ( subjectEntry.keys[index].type == eventKey.type && subjectEntry.keys[index].key == eventKey.key )
+        {
+          return true;
+        }
+      }
+      if ( numberOfInlineEventKeys < subjectEntry.numberOfEvents )
+      {
+        for ( uint32_t index = subjectEntry.firstEvent; index != ~0u; index = m_events[index].nextEvent )
+        {
+          if ( m_events[index].key.type == eventKey.type && m_events[index].key.key == eventKey.key )
+          {
+            return true;
+          }
+        }
+      }
+
+      if ( subjectEntry.numberOfEvents < numberOfInlineEventKeys )
+      {
+        subjectEntry.keys[subjectEntry.numberOfEvents] = eventKey;
+      }
+      EventEntry eventEntry = { eventKey, event.clone(), subjectEntry.firstEvent };
+      subjectEntry.firstEvent = uint32_t(m_events.size());
+      ++subjectEntry.numberOfEvents;
+      m_events.push_back( eventEntry );
+      return true;
+    }
+
+    void NotificationBatch::remove( Subject & subject )
+    {
+      DP_ASSERT( subject.m_batch == this && m_subjects[subject.m_batchIndex - 1].subject == &subject );
+      m_subjects[subject.m_batchIndex - 1].subject = nullptr;
+      subject.m_batch = nullptr;
+      subject.m_batchIndex = 0;
+    }
+
+    void NotificationBatch::flush()
+    {
+      m_flushing = true;
+
+      // number the observers in the order they are found and count their events
+      std::vector<Observer *> observers;
+      std::vector<size_t> offsets;
+      std::vector<uint32_t> observerIndices;   // index of each observer of each subject
+      std::unordered_map<Observer *, uint32_t> indices;
+      indices.reserve( m_subjects.size() );
+      for ( std::vector<SubjectEntry>::const_iterator it = m_subjects.begin(); it != m_subjects.end(); ++it )
+      {
+        if ( it->subject )
+        {
+          it->subject->m_batch = nullptr;
+          it->subject->m_batchIndex = 0;
+
+          Subject::Observers const & subjectObservers = it->subject->m_observers;
+          for ( Subject::Observers::const_iterator observerIt = subjectObservers.begin(); observerIt != subjectObservers.end(); ++observerIt )
+          {
+            if ( observerIt->first )
+            {
+              std::pair<std::unordered_map<Observer *, uint32_t>::iterator, bool> inserted = indices.insert( std::make_pair( observerIt->first, uint32_t(observers.size()) ) );
+              if ( inserted.second )
+              {
+                observers.push_back( observerIt->first );
+                offsets.push_back( 0 );
+              }
+              observerIndices.push_back( inserted.first->second );
+              offsets[inserted.first->second] += it->numberOfEvents;
+            }
+          }
+        }
+      }
+
+      // sort the events into one array by observer, afterwards offsets[i] is the end of the events of observer i
+      size_t numberOfNotifications = 0;
+      for ( size_t index = 0; index < offsets.size(); ++index )
+      {
+        std::swap( offsets[index], numberOfNotifications );
+        numberOfNotifications += offsets[index];
+      }
+
+      std::vector<Notification> notifications( numberOfNotifications );
+      std::vector<uint32_t>::const_iterator observerIndexIt = observerIndices.begin();
+      for ( std::vector<SubjectEntry>::const_iterator it = m_subjects.begin(); it != m_subjects.end(); ++it )
+      {
+        if ( it->subject )
+        {
+          Subject::Observers const & subjectObservers = it->subject->m_observers;
+          for ( Subject::Observers::const_iterator observerIt = subjectObservers.begin(); observerIt != subjectObservers.end(); ++observerIt )
+          {
+            if ( observerIt->first )
+            {
+              size_t & offset = offsets[*observerIndexIt++];
+              for ( uint32_t index = it->firstEvent; index != ~0u; index = m_events[index].nextEvent )
+              {
+                Notification notification = { m_events[index].event, observerIt->second };
+                notifications[offset++] = notification;
+              }
+            }
+          }
+        }
+      }
+
+      for ( size_t index = 0; index < observers.size(); ++index )
+      {
+        size_t begin = index ? offsets[index - 1] : 0;
+        observers[index]->onNotifyBatch( &notifications[begin], offsets[index] - begin );
+      }
+
+      for ( std::vector<EventEntry>::iterator it = m_events.begin(); it != m_events.end(); ++it )
+      {
+        delete it->event;
+      }
+      m_events.clear();
+      m_subjects.clear();
+      m_flushing = false;
+    }
+
     /************************************************************************/
     /* SubjectTrackingObserver                                              */
     /************************************************************************/
@@ -0,0 +1,172 @@
+// Copyright (c) 2016, NVIDIA CORPORATION. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <dp/util/ThreadPool.h>
+#include <dp/Assert.h>
+#include <algorithm>
+
+namespace dp
+{
+  namespace util
+  {
+
+    ThreadPool::ThreadPool( unsigned int numberOfThreads )
+      : m_task( nullptr )
+      , m_numberOfTasks( 0 )
+      , m_nextTask( 0 )
+      , m_pendingTasks( 0 )
+      , m_generation( 0 )
+      , m_shutdown( false )
+    {
+      if ( !numberOfThreads )
+      {
+        numberOfThreads = std::max( 1u, std::thread::hardware_concurrency() );
+      }
+
+      m_workers.reserve( numberOfThreads - 1 );
+      for ( unsigned int index = 1; index < numberOfThreads; ++index )
+      {
+        m_workers.push_back( std::thread( &ThreadPool::workerLoop, this ) );
+      }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_shutdown = true;
+      }
+      m_workAvailable.notify_all();
+
+      for ( size_t index = 0; index < m_workers.size(); ++index )
+      {
+        m_workers[index].join();
+      }
+    }
+
+    void ThreadPool::execute( size_t numberOfTasks, std::function<void( size_t )> const & task )
+    {
+      if ( !numberOfTasks )
+      {
+        return;
+      }
+
+      // no need to wake up the workers for a single task
+      if ( numberOfTasks == 1 || m_workers.empty() )
+      {
+        for ( size_t index = 0; index < numberOfTasks; ++index )
+        {
+          task( index );
+        }
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        DP_ASSERT( !m_task && "ThreadPool::execute is not reentrant" );
+        m_task = &task;
+        m_numberOfTasks = numberOfTasks;
+        m_nextTask = 0;
+        m_pendingTasks = numberOfTasks;
+        ++m_generation;
+      }
+      m_workAvailable.notify_all();
+
+      processTasks();
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      while ( m_pendingTasks )
+      {
+        m_workDone.wait( lock );
+      }
+      m_task = nullptr;
+    }
+
+    void ThreadPool::executeRange( size_t begin, size_t end, size_t minChunkSize, size_t granularity, std::function<void( size_t, size_t )> const & task )
+    {
+      DP_ASSERT( granularity );
+      if ( begin >= end )
+      {
+        return;
+      }
+
+      size_t count = end - begin;
+
+      // split the range into one chunk per thread, but not smaller than minChunkSize and rounded up to the granularity
+      size_t chunkSize = std::max( std::max( minChunkSize, size_t(1) ), ( count + getNumberOfThreads() - 1 ) / getNumberOfThreads() );
+      chunkSize = ( chunkSize + granularity - 1 ) / granularity * granularity;
+      size_t numberOfChunks = ( count + chunkSize - 1 ) / chunkSize;
+
+      execute( numberOfChunks, [&]( size_t chunk )
+      {
+        size_t chunkBegin = begin + chunk * chunkSize;
+        task( chunkBegin, std::min( end, chunkBegin + chunkSize ) );
+      } );
+    }
+
+    void ThreadPool::processTasks()
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      while ( m_task && m_nextTask < m_numberOfTasks )
+      {
+        size_t index = m_nextTask++;
+        std::function<void( size_t )> const & task = *m_task;
+
+        lock.unlock();
+        task( index );
+        lock.lock();
+
+        if ( !--m_pendingTasks )
+        {
+          m_workDone.notify_all();
+        }
+      }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+      size_t generation = 0;
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock( m_mutex );
+          while ( !m_shutdown && generation == m_generation )
+          {
+            m_workAvailable.wait( lock );
+          }
+          if ( m_shutdown )
+          {
+            return;
+          }
+          generation = m_generation;
+        }
+
+        processTasks();
+      }
+    }
+
+  } // namespace util
+} // namespace dp
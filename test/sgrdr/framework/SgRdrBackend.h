@@ -78,6 +78,7 @@ namespace dp
           dp::gl::RenderContextFormat         m_format;
           dp::gl::RenderContextSharedPtr      m_context;
           int                                 m_windowId;
+          bool                                m_headless;     // RiXNull.rdr, no window and no OpenGL
 
           dp::sg::ui::SceneRendererSharedPtr  m_renderer;
         };
@@ -102,6 +103,8 @@ extern "C"
     {
     case 0:
       return "RiXGL.rdr";
+    case 1:
+      return "RiXNull.rdr";
     default:
       return nullptr;
     }
@@ -109,7 +112,7 @@ extern "C"
 
   DPTSGRDR_API bool isRendererSupported( const char* rendererName )
   {
-    return !strcmp(rendererName, "RiXGL.rdr");
+    return !strcmp(rendererName, "RiXGL.rdr") || !strcmp(rendererName, "RiXNull.rdr");
   }
 
   DPTSGRDR_API dp::sgrdr::test::framework::SgRdrBackend * create( const char* rendererName, const std::vector<std::string>* options )
@@ -96,15 +96,57 @@ namespace dp
           }
         }
 
+        /** \brief RenderTarget without any surface for the headless RiXNull.rdr renderer.
+        **/
+        class RenderTargetNull : public dp::ui::RenderTarget
+        {
+        public:
+          RenderTargetNull( unsigned int width, unsigned int height )
+            : m_width( width )
+            , m_height( height )
+          {
+          }
+
+          virtual void setSize( unsigned int width, unsigned int height )
+          {
+            m_width = width;
+            m_height = height;
+          }
+
+          virtual void getSize( unsigned int &width, unsigned int &height ) const
+          {
+            width = m_width;
+            height = m_height;
+          }
+
+          virtual dp::util::ImageSharedPtr getImage( dp::PixelFormat pixelFormat, dp::DataType pixelDataType, unsigned int index )
+          {
+            return dp::util::ImageSharedPtr();
+          }
+
+          virtual bool isValid()
+          {
+            return true;
+          }
+
+        private:
+          unsigned int m_width;
+          unsigned int m_height;
+        };
+
         // Backend
 
         SgRdrBackend::SgRdrBackend( const std::string& rendererName
                                   , const std::vector<std::string>& options )
+          : m_windowId( 0 )
+          , m_headless( rendererName == "RiXNull.rdr" )
         {
-          // Initialize freeglut
-          char* dummyChar[] = {"nothing"};
-          int dummyInt = 0;
-          glutInit(&dummyInt, nullptr);
+          if ( !m_headless )
+          {
+            // Initialize freeglut
+            int dummyInt = 0;
+            glutInit(&dummyInt, nullptr);
+          }
 
           // Parse options
           options::options_description od("Usage: DPTApp");
@@ -133,6 +175,10 @@ namespace dp
           {
             cullingMode = dp::culling::Mode::CPU;
           }
+          else if ( cullingEngine == "cpu_bvh" )
+          {
+            cullingMode = dp::culling::Mode::CPU_BVH;
+          }
           else if ( cullingEngine == "gl_compute" )
           {
             cullingMode = dp::culling::Mode::OPENGL_COMPUTE;
@@ -155,13 +201,15 @@ namespace dp
           dp::fx::Manager smt = getShaderManager( shaderManager );
 
           //The chosen renderer takes precedence over the chosen shader manager.
-          if( rendererName == "RiXGL.rdr" )
+          if( rendererName == "RiXGL.rdr" || rendererName == "RiXNull.rdr" )
           {
-            m_renderer = dp::sg::renderer::rix::gl::SceneRenderer::create
+            dp::sg::renderer::rix::gl::SceneRendererSharedPtr renderer = dp::sg::renderer::rix::gl::SceneRenderer::create
             (   renderEngine.c_str()
               , smt
               , cullingMode
             );
+            renderer->setRiXLibrary( rendererName );
+            m_renderer = renderer;
           }
           else
           {
@@ -200,16 +248,27 @@ namespace dp
 
           m_renderer->render( static_cast<RenderDataSgRdr*>(renderData)->getViewState(), renderTarget );
 
-          glutSwapBuffers();
+          if ( !m_headless )
+          {
+            glutSwapBuffers();
+          }
         }
 
         void SgRdrBackend::finish()
         {
-          glFinish();
+          if ( !m_headless )
+          {
+            glFinish();
+          }
         }
 
         dp::ui::RenderTargetSharedPtr SgRdrBackend::createDisplay( int width, int height, bool visible )
         {
+          if ( m_headless )
+          {
+            return std::make_shared<RenderTargetNull>( width, height );
+          }
+
           glutInitDisplayMode( GLUT_RGBA | GLUT_DOUBLE | GLUT_DEPTH | GLUT_ALPHA | GLUT_BORDERLESS );
           glutInitWindowSize( width, height );
           glutInitWindowPosition(0, 0);